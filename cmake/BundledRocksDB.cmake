@@ -18,13 +18,7 @@
 function(use_bundled_rocksdb SOURCE_DIR BINARY_DIR)
     message("Using bundled RocksDB")
 
-    if (NOT WIN32)
-        include(Zstd)
-        list(APPEND CMAKE_MODULE_PATH "${CMAKE_SOURCE_DIR}/cmake/zstd/dummy")
-
-        include(LZ4)
-        list(APPEND CMAKE_MODULE_PATH "${CMAKE_SOURCE_DIR}/cmake/lz4/dummy")
-    endif()
+    # zstd and lz4 are bundled by the top level CMakeLists.txt, because libminifi uses them as well
 
     # Patch to fix build issue on ARM7 architecture: https://github.com/facebook/rocksdb/issues/8609#issuecomment-1009572506
     set(PATCH_FILE "${SOURCE_DIR}/thirdparty/rocksdb/arm7.patch")
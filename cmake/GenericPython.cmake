@@ -17,7 +17,12 @@
 
 find_package(Python 3.6 REQUIRED COMPONENTS Development Interpreter)
 
-if(WIN32)
+if(ENABLE_PYTHON_SUBINTERPRETERS)
+  # subinterpreters with their own GIL are not part of the stable ABI, link the version specific library
+  if(Python_VERSION VERSION_LESS 3.12)
+    message(FATAL_ERROR "ENABLE_PYTHON_SUBINTERPRETERS requires Python 3.12 or newer, found ${Python_VERSION}")
+  endif()
+elseif(WIN32)
   set(Python_LIBRARIES ${Python_LIBRARY_DIRS}/python3.lib)
 else()
   find_library(generic_lib_python NAMES libpython3.so)
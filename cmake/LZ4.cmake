@@ -38,6 +38,7 @@ if(NOT lz4_POPULATED)
 endif()
 
 add_library(lz4::lz4 ALIAS lz4_static)
+target_include_directories(lz4_static INTERFACE "${lz4_SOURCE_DIR}/lib")
 
 # Set variables
 set(LZ4_FOUND "YES" CACHE STRING "" FORCE)
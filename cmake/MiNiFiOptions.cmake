@@ -36,6 +36,7 @@ endfunction()
 
 add_minifi_option(CI_BUILD "Build is used for CI." OFF)
 add_minifi_option(SKIP_TESTS "Skips building all tests." OFF)
+add_minifi_option(ENABLE_BENCHMARKS "Builds the minifi-benchmarks microbenchmark executable of the core data path." OFF)
 add_minifi_option(DOCKER_BUILD_ONLY "Disables all targets except docker build scripts. Ideal for systems without an up-to-date compiler." OFF)
 add_minifi_option(DOCKER_SKIP_TESTS "Skip building tests in docker image targets." ON)
 add_minifi_option(DOCKER_PUSH "Push created images to the specified tags" OFF)
@@ -105,6 +106,7 @@ add_minifi_option(ENABLE_PCAP "Enables the PCAP extension." OFF)
 add_minifi_option(ENABLE_LIBRDKAFKA "Enables the librdkafka extension." ON)
 add_minifi_option(ENABLE_LUA_SCRIPTING "Enables lua scripting" ON)
 add_minifi_option(ENABLE_PYTHON_SCRIPTING "Enables python scripting" ON)
+add_minifi_dependent_option(ENABLE_PYTHON_SUBINTERPRETERS "Builds the python extension against the full C API of Python 3.12+ instead of the stable ABI, to support running python processors in subinterpreters with their own GIL." OFF "ENABLE_PYTHON_SCRIPTING" OFF)
 add_minifi_option(ENABLE_SENSORS "Enables the Sensors package." OFF)
 add_minifi_option(ENABLE_USB_CAMERA "Enables USB camera support." OFF)
 add_minifi_option(ENABLE_AWS "Enables AWS support." ON)
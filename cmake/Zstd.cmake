@@ -42,6 +42,8 @@ if(NOT zstd_POPULATED)
 endif()
 
 add_library(zstd::zstd ALIAS libzstd_static)
+# the zstd build only sets directory level include directories
+target_include_directories(libzstd_static INTERFACE "${zstd_SOURCE_DIR}/lib")
 
 # Set variables
 set(ZSTD_FOUND "YES" CACHE STRING "" FORCE)
@@ -363,6 +363,24 @@ Feature: Sending data to using Kafka streaming platform using PublishKafka
 
     Then flowfiles with these contents are placed in the monitored directory in less than 45 seconds: "B,rb,p,Anette Tison ,nd T,lus T,ylor"
 
+  Scenario: Messages of the same partition are bundled into a single flowfile
+    Given a ConsumeKafka processor set up in a "kafka-consumer-flow" flow
+    And the "Offset Reset" property of the ConsumeKafka processor is set to "earliest"
+    And the "Max Bundle Message Count" property of the ConsumeKafka processor is set to "10"
+    And the "Bundle Demarcator" property of the ConsumeKafka processor is set to ", "
+    And a PutFile processor with the "Directory" property set to "/tmp/output" in the "kafka-consumer-flow" flow
+    And the "success" relationship of the ConsumeKafka processor is connected to the PutFile
+
+    And a kafka broker is set up in correspondence with the third-party kafka publisher
+    And the kafka broker is started
+    And the topic "ConsumeKafkaTest" is initialized on the kafka broker
+
+    When a message with content "Ulysses" is published to the "ConsumeKafkaTest" topic
+    And a message with content "James Joyce" is published to the "ConsumeKafkaTest" topic
+    And all other processes start up
+
+    Then a flowfile with the content "Ulysses, James Joyce" is placed in the monitored directory in less than 90 seconds
+
   Scenario Outline: The ConsumeKafka "Maximum Poll Records" property sets a limit on the messages processed in a single batch
     Given a ConsumeKafka processor set up in a "kafka-consumer-flow" flow
     And a LogAttribute processor in the "kafka-consumer-flow" flow
@@ -17,8 +17,16 @@
 
 #include "PutS3Object.h"
 
+#include <cctype>
+#include <cinttypes>
+#include <deque>
+#include <filesystem>
+#include <future>
 #include <string>
 #include <memory>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include "AWSCredentialsService.h"
 #include "properties/Properties.h"
@@ -27,10 +35,57 @@
 #include "core/ProcessContext.h"
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
+#include "core/TypedValues.h"
 #include "range/v3/algorithm/contains.hpp"
 
 namespace org::apache::nifi::minifi::aws::processors {
 
+namespace {
+constexpr uint64_t MIN_PART_SIZE = 5_MiB;
+constexpr uint64_t MAX_PART_COUNT = 10000;
+constexpr size_t SKIP_BUFFER_SIZE = 64_KiB;
+
+// the state is stored in a properties file, so the characters with a special meaning there are escaped
+std::string getMultipartUploadStateKey(const std::string& bucket, const std::string& object_key) {
+  static constexpr const char* HEX_DIGITS = "0123456789ABCDEF";
+  std::string state_key;
+  for (const unsigned char c : bucket + "/" + object_key) {
+    if (std::isalnum(c) || c == '/' || c == '.' || c == '-' || c == '_') {
+      state_key += static_cast<char>(c);
+    } else {
+      state_key += '%';
+      state_key += HEX_DIGITS[c >> 4];
+      state_key += HEX_DIGITS[c & 0xF];
+    }
+  }
+  return state_key;
+}
+
+bool readFully(io::InputStream& stream, std::span<std::byte> buffer) {
+  size_t read_size = 0;
+  while (read_size < buffer.size()) {
+    const auto ret = stream.read(buffer.subspan(read_size));
+    if (io::isError(ret) || ret == 0) {
+      return false;
+    }
+    read_size += ret;
+  }
+  return true;
+}
+
+bool skip(io::InputStream& stream, size_t size) {
+  std::vector<std::byte> buffer(std::min(size, SKIP_BUFFER_SIZE));
+  while (size > 0) {
+    const auto chunk = std::span(buffer).subspan(0, std::min(size, buffer.size()));
+    if (!readFully(stream, chunk)) {
+      return false;
+    }
+    size -= chunk.size();
+  }
+  return true;
+}
+}  // namespace
+
 void PutS3Object::initialize() {
   setSupportedProperties(Properties);
   setSupportedRelationships(Relationships);
@@ -76,6 +131,41 @@ void PutS3Object::onSchedule(const std::shared_ptr<core::ProcessContext> &contex
     use_virtual_addressing_ = !*use_path_style_access;
   }
 
+  if (auto multipart_threshold = context->getProperty<core::DataSizeValue>(MultipartThreshold)) {
+    multipart_threshold_ = multipart_threshold->getValue();
+  }
+  if (multipart_threshold_ > ReadCallback::MAX_SIZE) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Threshold is not valid, it must not be more than 5 GB");
+  }
+  logger_->log_debug("PutS3Object: Multipart Threshold %" PRIu64, multipart_threshold_);
+
+  if (auto multipart_part_size = context->getProperty<core::DataSizeValue>(MultipartPartSize)) {
+    multipart_part_size_ = multipart_part_size->getValue();
+  }
+  if (multipart_part_size_ < MIN_PART_SIZE || multipart_part_size_ > ReadCallback::MAX_SIZE) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Part Size is not valid, it must be between 5 MB and 5 GB");
+  }
+  logger_->log_debug("PutS3Object: Multipart Part Size %" PRIu64, multipart_part_size_);
+
+  if (auto multipart_upload_concurrency = context->getProperty<uint32_t>(MultipartUploadConcurrency)) {
+    multipart_upload_concurrency_ = *multipart_upload_concurrency;
+  }
+  if (multipart_upload_concurrency_ == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Upload Concurrency must be a positive integer");
+  }
+  logger_->log_debug("PutS3Object: Multipart Upload Concurrency %" PRIu32, multipart_upload_concurrency_);
+
+  if (auto max_age = context->getProperty<core::TimePeriodValue>(MultipartUploadMaxAgeThreshold)) {
+    multipart_upload_max_age_threshold_ = max_age->getMilliseconds();
+  }
+  logger_->log_debug("PutS3Object: Multipart Upload Max Age Threshold %" PRId64 " ms", int64_t{multipart_upload_max_age_threshold_.count()});
+
+  std::string state_directory;
+  if (!context->getProperty(TemporaryDirectoryMultipartState, state_directory) || state_directory.empty()) {
+    state_directory = std::filesystem::temp_directory_path().string();
+  }
+  multipart_upload_storage_ = std::make_unique<aws::s3::MultipartUploadStateStorage>(state_directory, getUUIDStr());
+
   fillUserMetadata(context);
 }
 
@@ -186,6 +276,140 @@ void PutS3Object::setAttributes(
   }
 }
 
+void PutS3Object::ageOffMultipartUploads(const aws::s3::PutObjectRequestParameters &put_s3_request_params) {
+  for (const auto& aged_state : multipart_upload_storage_->removeAgedStates(multipart_upload_max_age_threshold_)) {
+    logger_->log_info("Aborting multipart upload '%s' of '%s' in bucket '%s' as it exceeded the max age threshold", aged_state.upload_id, aged_state.key, aged_state.bucket);
+    s3_wrapper_.abortMultipartUpload(put_s3_request_params, aged_state.bucket, aged_state.key, aged_state.upload_id, put_s3_request_params.use_virtual_addressing);
+  }
+}
+
+std::optional<aws::s3::MultipartUploadState> PutS3Object::getOrCreateMultipartUploadState(
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params,
+    const std::string &state_key,
+    uint64_t flow_size) {
+  if (auto state = multipart_upload_storage_->getState(state_key)) {
+    if (state->bucket == put_s3_request_params.bucket && state->key == put_s3_request_params.object_key && state->full_size == flow_size && state->part_size > 0) {
+      logger_->log_info("Continuing multipart upload '%s' of '%s' to bucket '%s', %zu parts were already uploaded",
+        state->upload_id, state->key, state->bucket, state->uploaded_parts.size());
+      return state;
+    }
+    logger_->log_info("Aborting recorded multipart upload '%s' of '%s' in bucket '%s' as it does not match the flow file", state->upload_id, state->key, state->bucket);
+    s3_wrapper_.abortMultipartUpload(put_s3_request_params, state->bucket, state->key, state->upload_id, put_s3_request_params.use_virtual_addressing);
+    multipart_upload_storage_->removeState(state_key);
+  }
+
+  auto upload_id = s3_wrapper_.initiateMultipartUpload(put_s3_request_params);
+  if (!upload_id) {
+    return std::nullopt;
+  }
+  aws::s3::MultipartUploadState state;
+  state.upload_id = *upload_id;
+  state.bucket = put_s3_request_params.bucket;
+  state.key = put_s3_request_params.object_key;
+  state.full_size = flow_size;
+  // S3 allows at most 10000 parts in an upload
+  state.part_size = (std::max)(multipart_part_size_, (flow_size + MAX_PART_COUNT - 1) / MAX_PART_COUNT);
+  state.upload_time = std::chrono::system_clock::now();
+  multipart_upload_storage_->storeState(state_key, state);
+  logger_->log_debug("Started multipart upload '%s' of '%s' to bucket '%s' with part size %" PRIu64, state.upload_id, state.key, state.bucket, state.part_size);
+  return state;
+}
+
+bool PutS3Object::uploadParts(
+    const std::shared_ptr<core::ProcessSession> &session,
+    const std::shared_ptr<core::FlowFile> &flow_file,
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params,
+    const std::string &state_key,
+    aws::s3::MultipartUploadState &upload_state) {
+  const uint64_t part_size = upload_state.part_size;
+  const uint64_t part_count = (upload_state.full_size + part_size - 1) / part_size;
+
+  // upload the parts straight from the content repository if it can map the content, otherwise each part in flight is read into its own buffer
+  auto mapped_content_stream = session->getMappedFlowFileContentStream(flow_file);
+  auto content_stream = mapped_content_stream ? mapped_content_stream : session->getFlowFileContentStream(flow_file);
+  if (!content_stream) {
+    logger_->log_error("Failed to read the content of flow file %s", flow_file->getUUIDStr());
+    return false;
+  }
+
+  bool success = true;
+  std::deque<std::pair<size_t, std::future<std::optional<std::string>>>> parts_in_flight;
+  const auto finish_oldest_part = [&] {
+    auto [part_number, etag] = std::move(parts_in_flight.front());
+    parts_in_flight.pop_front();
+    if (auto part_etag = etag.get()) {
+      upload_state.uploaded_parts[part_number] = *part_etag;
+      multipart_upload_storage_->storeState(state_key, upload_state);
+    } else {
+      logger_->log_error("Failed to upload part %zu of '%s' to bucket '%s'", part_number, upload_state.key, upload_state.bucket);
+      success = false;
+    }
+  };
+
+  for (size_t part_number = 1; part_number <= part_count && success; ++part_number) {
+    const uint64_t offset = (part_number - 1) * part_size;
+    const auto size = gsl::narrow<size_t>((std::min)(part_size, upload_state.full_size - offset));
+    if (upload_state.uploaded_parts.contains(part_number)) {
+      if (!mapped_content_stream && !skip(*content_stream, size)) {
+        success = false;
+      }
+      continue;
+    }
+
+    if (parts_in_flight.size() >= multipart_upload_concurrency_) {
+      finish_oldest_part();
+      if (!success) {
+        break;
+      }
+    }
+
+    std::span<const std::byte> part_data;
+    std::shared_ptr<std::vector<std::byte>> part_buffer;
+    if (mapped_content_stream) {
+      part_data = mapped_content_stream->getBuffer().subspan(gsl::narrow<size_t>(offset), size);
+    } else {
+      part_buffer = std::make_shared<std::vector<std::byte>>(size);
+      if (!readFully(*content_stream, *part_buffer)) {
+        logger_->log_error("Failed to read part %zu of flow file %s", part_number, flow_file->getUUIDStr());
+        success = false;
+        break;
+      }
+      part_data = *part_buffer;
+    }
+    parts_in_flight.emplace_back(part_number, std::async(std::launch::async, [this, &put_s3_request_params, &upload_id = upload_state.upload_id, part_number, part_data, part_buffer] {
+      return s3_wrapper_.uploadPart(put_s3_request_params, upload_id, part_number, part_data);
+    }));
+  }
+  while (!parts_in_flight.empty()) {
+    finish_oldest_part();
+  }
+  return success;
+}
+
+std::optional<aws::s3::PutObjectResult> PutS3Object::uploadMultipart(
+    const std::shared_ptr<core::ProcessSession> &session,
+    const std::shared_ptr<core::FlowFile> &flow_file,
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params) {
+  ageOffMultipartUploads(put_s3_request_params);
+
+  const auto state_key = getMultipartUploadStateKey(put_s3_request_params.bucket, put_s3_request_params.object_key);
+  auto upload_state = getOrCreateMultipartUploadState(put_s3_request_params, state_key, flow_file->getSize());
+  if (!upload_state) {
+    return std::nullopt;
+  }
+
+  // the recorded state is kept on failure, so that the upload can be continued when the flow file is retried
+  if (!uploadParts(session, flow_file, put_s3_request_params, state_key, *upload_state)) {
+    return std::nullopt;
+  }
+
+  auto result = s3_wrapper_.completeMultipartUpload(put_s3_request_params, upload_state->upload_id, upload_state->uploaded_parts);
+  if (result) {
+    multipart_upload_storage_->removeState(state_key);
+  }
+  return result;
+}
+
 void PutS3Object::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
   logger_->log_trace("PutS3Object onTrigger");
   std::shared_ptr<core::FlowFile> flow_file = session->get();
@@ -206,13 +430,20 @@ void PutS3Object::onTrigger(const std::shared_ptr<core::ProcessContext> &context
     return;
   }
 
-  PutS3Object::ReadCallback callback(flow_file->getSize(), *put_s3_request_params, s3_wrapper_);
-  session->read(flow_file, std::ref(callback));
-  if (!callback.result_.has_value()) {
+  std::optional<minifi::aws::s3::PutObjectResult> result;
+  if (flow_file->getSize() > multipart_threshold_) {
+    result = uploadMultipart(session, flow_file, *put_s3_request_params);
+  } else {
+    PutS3Object::ReadCallback callback(flow_file->getSize(), *put_s3_request_params, s3_wrapper_);
+    session->read(flow_file, std::ref(callback));
+    result = callback.result_;
+  }
+
+  if (!result.has_value()) {
     logger_->log_error("Failed to upload S3 object to bucket '%s'", put_s3_request_params->bucket);
     session->transfer(flow_file, Failure);
   } else {
-    setAttributes(session, flow_file, *put_s3_request_params, *callback.result_);
+    setAttributes(session, flow_file, *put_s3_request_params, *result);
     logger_->log_debug("Successfully uploaded S3 object '%s' to bucket '%s'", put_s3_request_params->object_key, put_s3_request_params->bucket);
     session->transfer(flow_file, Success);
   }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <optional>
@@ -32,6 +33,7 @@
 #include "core/PropertyType.h"
 #include "io/StreamPipe.h"
 #include "S3Processor.h"
+#include "MultipartUploadStateStorage.h"
 #include "utils/ArrayUtils.h"
 #include "utils/gsl.h"
 #include "utils/Id.h"
@@ -47,10 +49,12 @@ class PutS3Object : public S3Processor {
   static constexpr auto STORAGE_CLASSES = minifi::utils::getKeys(minifi::aws::s3::STORAGE_CLASS_MAP);
   static constexpr auto SERVER_SIDE_ENCRYPTIONS = minifi::utils::getKeys(minifi::aws::s3::SERVER_SIDE_ENCRYPTION_MAP);
 
-  EXTENSIONAPI static constexpr const char* Description = "Puts FlowFiles to an Amazon S3 Bucket. The upload uses the PutS3Object method. "
-      "The PutS3Object method send the file in a single synchronous call, but it has a 5GB size limit. Larger files sent using the multipart upload methods are currently not supported. "
+  EXTENSIONAPI static constexpr const char* Description = "Puts FlowFiles to an Amazon S3 Bucket. The upload uses either the PutS3Object method or the multipart upload methods. "
+      "The PutS3Object method sends the file in a single synchronous call, but it has a 5GB size limit. Larger files are sent using the multipart upload methods, "
+      "which upload the parts of the file in parallel and can continue an interrupted upload, as the uploaded parts are recorded in a local state file. "
       "The AWS libraries select an endpoint URL based on the AWS region, but this can be overridden with the 'Endpoint Override URL' property for use with other S3-compatible endpoints. "
-      "The S3 API specifies that the maximum file size for a PutS3Object upload is 5GB.";
+      "The S3 API specifies that the maximum file size for a PutS3Object upload is 5GB. "
+      "It also requires that parts in a multipart upload must be at least 5MB in size, except for the last part.";
 
   EXTENSIONAPI static constexpr auto ObjectKey = core::PropertyDefinitionBuilder<>::createProperty("Object Key")
       .withDescription("The key of the S3 object. If none is given the filename attribute will be used by default.")
@@ -106,7 +110,39 @@ class PutS3Object : public S3Processor {
       .withDefaultValue("false")
       .isRequired(true)
       .build();
-  EXTENSIONAPI static constexpr auto Properties = minifi::utils::array_cat(S3Processor::Properties, std::array<core::PropertyReference, 10>{
+  EXTENSIONAPI static constexpr auto MultipartThreshold = core::PropertyDefinitionBuilder<>::createProperty("Multipart Threshold")
+      .withDescription("Specifies the file size threshold for switch from the PutS3Object API to the multipart upload API. "
+          "Flow files bigger than this limit will be sent using the multipart process. The maximum is 5 GB.")
+      .isRequired(true)
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("5 GB")
+      .build();
+  EXTENSIONAPI static constexpr auto MultipartPartSize = core::PropertyDefinitionBuilder<>::createProperty("Multipart Part Size")
+      .withDescription("Specifies the part size for use when the multipart upload API is used. Flow files will be broken into chunks of this size for the upload process, "
+          "but the last part sent can be smaller since it is not padded. The valid range is 5 MB to 5 GB. "
+          "The part size is increased if the file would be split into more than 10000 parts.")
+      .isRequired(true)
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("100 MB")
+      .build();
+  EXTENSIONAPI static constexpr auto MultipartUploadConcurrency = core::PropertyDefinitionBuilder<>::createProperty("Multipart Upload Concurrency")
+      .withDescription("The maximum number of parts of a flow file uploaded in parallel when the multipart upload API is used. "
+          "If the content repository cannot map the content into memory, one buffer of 'Multipart Part Size' is allocated for each part in flight.")
+      .isRequired(true)
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("4")
+      .build();
+  EXTENSIONAPI static constexpr auto MultipartUploadMaxAgeThreshold = core::PropertyDefinitionBuilder<>::createProperty("Multipart Upload Max Age Threshold")
+      .withDescription("Specifies the maximum age for unfinished multipart uploads. The recorded state of older uploads is removed, and the uploads are aborted.")
+      .isRequired(true)
+      .withPropertyType(core::StandardPropertyTypes::TIME_PERIOD_TYPE)
+      .withDefaultValue("7 days")
+      .build();
+  EXTENSIONAPI static constexpr auto TemporaryDirectoryMultipartState = core::PropertyDefinitionBuilder<>::createProperty("Temporary Directory Multipart State")
+      .withDescription("Directory in which the state of the unfinished multipart uploads is recorded, so that they can be continued after a restart. "
+          "If not set, the temporary directory of the system is used.")
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = minifi::utils::array_cat(S3Processor::Properties, std::array<core::PropertyReference, 15>{
       ObjectKey,
       ContentType,
       StorageClass,
@@ -116,7 +152,12 @@ class PutS3Object : public S3Processor {
       ReadACLUserList,
       WriteACLUserList,
       CannedACL,
-      UsePathStyleAccess
+      UsePathStyleAccess,
+      MultipartThreshold,
+      MultipartPartSize,
+      MultipartUploadConcurrency,
+      MultipartUploadMaxAgeThreshold,
+      TemporaryDirectoryMultipartState
   });
 
 
@@ -204,12 +245,32 @@ class PutS3Object : public S3Processor {
     const std::shared_ptr<core::ProcessContext> &context,
     const std::shared_ptr<core::FlowFile> &flow_file,
     const CommonProperties &common_properties) const;
+  std::optional<aws::s3::PutObjectResult> uploadMultipart(
+    const std::shared_ptr<core::ProcessSession> &session,
+    const std::shared_ptr<core::FlowFile> &flow_file,
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params);
+  std::optional<aws::s3::MultipartUploadState> getOrCreateMultipartUploadState(
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params,
+    const std::string &state_key,
+    uint64_t flow_size);
+  bool uploadParts(
+    const std::shared_ptr<core::ProcessSession> &session,
+    const std::shared_ptr<core::FlowFile> &flow_file,
+    const aws::s3::PutObjectRequestParameters &put_s3_request_params,
+    const std::string &state_key,
+    aws::s3::MultipartUploadState &upload_state);
+  void ageOffMultipartUploads(const aws::s3::PutObjectRequestParameters &put_s3_request_params);
 
   std::string user_metadata_;
   std::map<std::string, std::string> user_metadata_map_;
   std::string storage_class_;
   std::string server_side_encryption_;
   bool use_virtual_addressing_ = true;
+  uint64_t multipart_threshold_{};
+  uint64_t multipart_part_size_{};
+  uint32_t multipart_upload_concurrency_{};
+  std::chrono::milliseconds multipart_upload_max_age_threshold_{};
+  std::unique_ptr<aws::s3::MultipartUploadStateStorage> multipart_upload_storage_;
 };
 
 }  // namespace org::apache::nifi::minifi::aws::processors
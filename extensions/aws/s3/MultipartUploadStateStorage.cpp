@@ -0,0 +1,169 @@
+/**
+ * @file MultipartUploadStateStorage.cpp
+ * MultipartUploadStateStorage class implementation
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "MultipartUploadStateStorage.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <utility>
+
+#include "core/logging/LoggerFactory.h"
+#include "utils/StringUtils.h"
+#include "utils/file/FileUtils.h"
+
+namespace org::apache::nifi::minifi::aws::s3 {
+
+namespace {
+constexpr const char* UPLOAD_ID_SUFFIX = ".upload_id";
+constexpr const char* BUCKET_SUFFIX = ".bucket";
+constexpr const char* KEY_SUFFIX = ".key";
+constexpr const char* PART_SIZE_SUFFIX = ".part_size";
+constexpr const char* FULL_SIZE_SUFFIX = ".full_size";
+constexpr const char* UPLOAD_TIME_SUFFIX = ".upload_time";
+constexpr const char* UPLOADED_PARTS_SUFFIX = ".uploaded_parts";
+
+std::string serializeParts(const std::map<size_t, std::string>& uploaded_parts) {
+  std::vector<std::string> parts;
+  parts.reserve(uploaded_parts.size());
+  for (const auto& [part_number, etag] : uploaded_parts) {
+    parts.push_back(std::to_string(part_number) + ":" + etag);
+  }
+  return minifi::utils::StringUtils::join(",", parts);
+}
+
+std::map<size_t, std::string> deserializeParts(const std::string& value) {
+  std::map<size_t, std::string> uploaded_parts;
+  for (const auto& part : minifi::utils::StringUtils::split(value, ",")) {
+    const auto separator = part.find(':');
+    if (separator == std::string::npos) {
+      continue;
+    }
+    uploaded_parts.emplace(std::stoull(part.substr(0, separator)), part.substr(separator + 1));
+  }
+  return uploaded_parts;
+}
+}  // namespace
+
+MultipartUploadStateStorage::MultipartUploadStateStorage(const std::filesystem::path& state_directory, const std::string& state_id)
+    : state_file_path_(state_directory / ("minifi-s3-multipart-upload-" + state_id + ".properties")),
+      state_file_(std::ifstream{state_file_path_}),
+      logger_(core::logging::LoggerFactory<MultipartUploadStateStorage>::getLogger()) {
+  if (utils::file::create_dir(state_directory) != 0) {
+    logger_->log_error("Could not create multipart upload state directory %s", state_directory.string());
+  }
+}
+
+void MultipartUploadStateStorage::storeState(const std::string& state_key, const MultipartUploadState& state) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  eraseState(state_key);
+  state_file_.append(state_key + UPLOAD_ID_SUFFIX, state.upload_id);
+  state_file_.append(state_key + BUCKET_SUFFIX, state.bucket);
+  state_file_.append(state_key + KEY_SUFFIX, state.key);
+  state_file_.append(state_key + PART_SIZE_SUFFIX, std::to_string(state.part_size));
+  state_file_.append(state_key + FULL_SIZE_SUFFIX, std::to_string(state.full_size));
+  state_file_.append(state_key + UPLOAD_TIME_SUFFIX,
+    std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(state.upload_time.time_since_epoch()).count()));
+  state_file_.append(state_key + UPLOADED_PARTS_SUFFIX, serializeParts(state.uploaded_parts));
+  commitStateFile();
+}
+
+std::optional<MultipartUploadState> MultipartUploadStateStorage::getState(const std::string& state_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return getStateWithoutLock(state_key);
+}
+
+std::optional<MultipartUploadState> MultipartUploadStateStorage::getStateWithoutLock(const std::string& state_key) const {
+  const auto upload_id = state_file_.getValue(state_key + UPLOAD_ID_SUFFIX);
+  if (!upload_id) {
+    return std::nullopt;
+  }
+  try {
+    MultipartUploadState state;
+    state.upload_id = *upload_id;
+    state.bucket = state_file_.getValue(state_key + BUCKET_SUFFIX).value_or("");
+    state.key = state_file_.getValue(state_key + KEY_SUFFIX).value_or("");
+    state.part_size = std::stoull(state_file_.getValue(state_key + PART_SIZE_SUFFIX).value_or(""));
+    state.full_size = std::stoull(state_file_.getValue(state_key + FULL_SIZE_SUFFIX).value_or(""));
+    state.upload_time = std::chrono::system_clock::time_point{std::chrono::milliseconds{std::stoll(state_file_.getValue(state_key + UPLOAD_TIME_SUFFIX).value_or(""))}};
+    state.uploaded_parts = deserializeParts(state_file_.getValue(state_key + UPLOADED_PARTS_SUFFIX).value_or(""));
+    return state;
+  } catch (const std::exception&) {
+    logger_->log_error("Invalid multipart upload state stored for %s in %s", state_key, state_file_path_.string());
+    return std::nullopt;
+  }
+}
+
+void MultipartUploadStateStorage::removeState(const std::string& state_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  eraseState(state_key);
+  commitStateFile();
+}
+
+std::vector<MultipartUploadState> MultipartUploadStateStorage::removeAgedStates(std::chrono::system_clock::duration max_age) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto age_off_time = std::chrono::system_clock::now() - max_age;
+  std::set<std::string> state_keys;
+  for (const auto& line : state_file_) {
+    const auto key = line.getKey();
+    if (minifi::utils::StringUtils::endsWith(key, UPLOAD_ID_SUFFIX)) {
+      state_keys.insert(key.substr(0, key.size() - std::strlen(UPLOAD_ID_SUFFIX)));
+    }
+  }
+
+  std::vector<MultipartUploadState> aged_states;
+  bool changed = false;
+  for (const auto& state_key : state_keys) {
+    auto state = getStateWithoutLock(state_key);
+    if (!state || state->upload_time < age_off_time) {
+      changed = true;
+      if (state) {
+        logger_->log_info("Removing multipart upload state of '%s' in bucket '%s' started more than %" PRId64 " ms ago",
+          state->key, state->bucket, int64_t{std::chrono::duration_cast<std::chrono::milliseconds>(max_age).count()});
+        aged_states.push_back(std::move(*state));
+      }
+      eraseState(state_key);
+    }
+  }
+  if (changed) {
+    commitStateFile();
+  }
+  return aged_states;
+}
+
+void MultipartUploadStateStorage::eraseState(const std::string& state_key) {
+  for (const auto* suffix : {UPLOAD_ID_SUFFIX, BUCKET_SUFFIX, KEY_SUFFIX, PART_SIZE_SUFFIX, FULL_SIZE_SUFFIX, UPLOAD_TIME_SUFFIX, UPLOADED_PARTS_SUFFIX}) {
+    state_file_.erase(state_key + suffix);
+  }
+}
+
+void MultipartUploadStateStorage::commitStateFile() {
+  // write a new file and move it in place, so that a crash cannot leave a partially written state behind
+  auto temp_file_path = state_file_path_;
+  temp_file_path += ".tmp";
+  try {
+    state_file_.writeTo(temp_file_path);
+    std::filesystem::rename(temp_file_path, state_file_path_);
+  } catch (const std::exception& ex) {
+    logger_->log_error("Failed to persist multipart upload state to %s: %s", state_file_path_.string(), ex.what());
+  }
+}
+
+}  // namespace org::apache::nifi::minifi::aws::s3
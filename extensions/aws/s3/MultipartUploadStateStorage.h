@@ -0,0 +1,64 @@
+/**
+ * @file MultipartUploadStateStorage.h
+ * MultipartUploadStateStorage class declaration
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "S3Wrapper.h"
+#include "core/logging/Logger.h"
+#include "properties/PropertiesFile.h"
+
+namespace org::apache::nifi::minifi::aws::s3 {
+
+/**
+ * Keeps track of the parts uploaded in the ongoing multipart uploads of a processor. The state is written
+ * to a file after every change, so an upload interrupted by a restart can be continued from its last uploaded part.
+ */
+class MultipartUploadStateStorage {
+ public:
+  MultipartUploadStateStorage(const std::filesystem::path& state_directory, const std::string& state_id);
+
+  void storeState(const std::string& state_key, const MultipartUploadState& state);
+  std::optional<MultipartUploadState> getState(const std::string& state_key) const;
+  void removeState(const std::string& state_key);
+  /**
+   * Removes the states of the uploads started more than max_age ago.
+   * @return the removed states, so that the uploads can be aborted
+   */
+  std::vector<MultipartUploadState> removeAgedStates(std::chrono::system_clock::duration max_age);
+
+ private:
+  std::optional<MultipartUploadState> getStateWithoutLock(const std::string& state_key) const;
+  void eraseState(const std::string& state_key);
+  void commitStateFile();
+
+  mutable std::mutex mutex_;
+  std::filesystem::path state_file_path_;
+  PropertiesFile state_file_;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::aws::s3
@@ -139,4 +139,75 @@ std::optional<Aws::S3::Model::HeadObjectResult> S3ClientRequestSender::sendHeadO
   }
 }
 
+std::optional<Aws::S3::Model::CreateMultipartUploadResult> S3ClientRequestSender::sendCreateMultipartUploadRequest(
+    const Aws::S3::Model::CreateMultipartUploadRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config,
+    bool use_virtual_addressing) {
+  Aws::S3::S3Client s3_client(credentials, client_config, Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never, use_virtual_addressing);
+  auto outcome = s3_client.CreateMultipartUpload(request);
+
+  if (outcome.IsSuccess()) {
+    logger_->log_debug("Created multipart upload for S3 object '%s' in bucket '%s'", request.GetKey(), request.GetBucket());
+    return outcome.GetResultWithOwnership();
+  } else {
+    logger_->log_error("CreateMultipartUpload failed with the following: '%s'", outcome.GetError().GetMessage());
+    return std::nullopt;
+  }
+}
+
+std::optional<Aws::S3::Model::UploadPartResult> S3ClientRequestSender::sendUploadPartRequest(
+    const Aws::S3::Model::UploadPartRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config,
+    bool use_virtual_addressing) {
+  Aws::S3::S3Client s3_client(credentials, client_config, Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never, use_virtual_addressing);
+  auto outcome = s3_client.UploadPart(request);
+
+  if (outcome.IsSuccess()) {
+    logger_->log_debug("Uploaded part %d of S3 object '%s' to bucket '%s'", request.GetPartNumber(), request.GetKey(), request.GetBucket());
+    return outcome.GetResultWithOwnership();
+  } else {
+    logger_->log_error("UploadPart failed with the following: '%s'", outcome.GetError().GetMessage());
+    return std::nullopt;
+  }
+}
+
+std::optional<Aws::S3::Model::CompleteMultipartUploadResult> S3ClientRequestSender::sendCompleteMultipartUploadRequest(
+    const Aws::S3::Model::CompleteMultipartUploadRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config,
+    bool use_virtual_addressing) {
+  Aws::S3::S3Client s3_client(credentials, client_config, Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never, use_virtual_addressing);
+  auto outcome = s3_client.CompleteMultipartUpload(request);
+
+  if (outcome.IsSuccess()) {
+    logger_->log_debug("Completed multipart upload of S3 object '%s' to bucket '%s'", request.GetKey(), request.GetBucket());
+    return outcome.GetResultWithOwnership();
+  } else {
+    logger_->log_error("CompleteMultipartUpload failed with the following: '%s'", outcome.GetError().GetMessage());
+    return std::nullopt;
+  }
+}
+
+bool S3ClientRequestSender::sendAbortMultipartUploadRequest(
+    const Aws::S3::Model::AbortMultipartUploadRequest& request,
+    const Aws::Auth::AWSCredentials& credentials,
+    const Aws::Client::ClientConfiguration& client_config,
+    bool use_virtual_addressing) {
+  Aws::S3::S3Client s3_client(credentials, client_config, Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never, use_virtual_addressing);
+  auto outcome = s3_client.AbortMultipartUpload(request);
+
+  if (outcome.IsSuccess()) {
+    logger_->log_debug("Aborted multipart upload of S3 object '%s' in bucket '%s'", request.GetKey(), request.GetBucket());
+    return true;
+  } else if (outcome.GetError().GetErrorType() == Aws::S3::S3Errors::NO_SUCH_UPLOAD) {
+    logger_->log_debug("Multipart upload '%s' was not found in bucket '%s'", request.GetUploadId(), request.GetBucket());
+    return true;
+  } else {
+    logger_->log_error("AbortMultipartUpload failed with the following: '%s'", outcome.GetError().GetMessage());
+    return false;
+  }
+}
+
 }  // namespace org::apache::nifi::minifi::aws::s3
@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "aws/core/utils/stream/PreallocatedStreamBuf.h"
 #include "S3ClientRequestSender.h"
 #include "range/v3/algorithm/find.hpp"
 #include "utils/ArrayUtils.h"
@@ -45,7 +46,8 @@ S3Wrapper::S3Wrapper() : request_sender_(std::make_unique<S3ClientRequestSender>
 S3Wrapper::S3Wrapper(std::unique_ptr<S3RequestSender>&& request_sender) : request_sender_(std::move(request_sender)) {
 }
 
-void S3Wrapper::setCannedAcl(Aws::S3::Model::PutObjectRequest& request, const std::string& canned_acl) const {
+template<typename PutRequest>
+void S3Wrapper::setCannedAcl(PutRequest& request, const std::string& canned_acl) const {
   if (canned_acl.empty()) return;
 
   const auto it = ranges::find(CANNED_ACL_MAP, canned_acl, [](const auto& kv) { return kv.first; });
@@ -76,20 +78,25 @@ std::string S3Wrapper::getEncryptionString(Aws::S3::Model::ServerSideEncryption
   return "";
 }
 
-std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParameters& put_object_params, const std::shared_ptr<Aws::IOStream>& data_stream) {
-  Aws::S3::Model::PutObjectRequest request;
+template<typename PutRequest>
+void S3Wrapper::setPutRequestParameters(PutRequest& request, const PutObjectRequestParameters& put_object_params) const {
   request.SetBucket(put_object_params.bucket);
   request.SetKey(put_object_params.object_key);
   request.SetStorageClass(minifi::utils::at(STORAGE_CLASS_MAP, put_object_params.storage_class));
   request.SetServerSideEncryption(minifi::utils::at(SERVER_SIDE_ENCRYPTION_MAP, put_object_params.server_side_encryption));
   request.SetContentType(put_object_params.content_type);
   request.SetMetadata(put_object_params.user_metadata_map);
-  request.SetBody(data_stream);
   request.SetGrantFullControl(put_object_params.fullcontrol_user_list);
   request.SetGrantRead(put_object_params.read_permission_user_list);
   request.SetGrantReadACP(put_object_params.read_acl_user_list);
   request.SetGrantWriteACP(put_object_params.write_acl_user_list);
   setCannedAcl(request, put_object_params.canned_acl);
+}
+
+std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParameters& put_object_params, const std::shared_ptr<Aws::IOStream>& data_stream) {
+  Aws::S3::Model::PutObjectRequest request;
+  setPutRequestParameters(request, put_object_params);
+  request.SetBody(data_stream);
 
   auto aws_result = request_sender_->sendPutObjectRequest(request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
   if (!aws_result) {
@@ -108,6 +115,74 @@ std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParame
   return result;
 }
 
+std::optional<std::string> S3Wrapper::initiateMultipartUpload(const PutObjectRequestParameters& put_object_params) {
+  Aws::S3::Model::CreateMultipartUploadRequest request;
+  setPutRequestParameters(request, put_object_params);
+
+  auto aws_result = request_sender_->sendCreateMultipartUploadRequest(request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
+  if (!aws_result) {
+    return std::nullopt;
+  }
+  return aws_result->GetUploadId();
+}
+
+std::optional<std::string> S3Wrapper::uploadPart(const PutObjectRequestParameters& put_object_params, const std::string& upload_id, size_t part_number, std::span<const std::byte> data) {
+  // the part is sent straight from the caller's buffer, the stream buffer is only read from
+  Aws::Utils::Stream::PreallocatedStreamBuf stream_buffer(reinterpret_cast<unsigned char*>(const_cast<std::byte*>(data.data())), data.size());
+  auto body = std::make_shared<Aws::IOStream>(&stream_buffer);
+
+  Aws::S3::Model::UploadPartRequest request;
+  request.SetBucket(put_object_params.bucket);
+  request.SetKey(put_object_params.object_key);
+  request.SetUploadId(upload_id);
+  request.SetPartNumber(gsl::narrow<int>(part_number));
+  request.SetContentLength(gsl::narrow<int64_t>(data.size()));
+  request.SetBody(body);
+
+  auto aws_result = request_sender_->sendUploadPartRequest(request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
+  if (!aws_result) {
+    return std::nullopt;
+  }
+  return aws_result->GetETag();
+}
+
+std::optional<PutObjectResult> S3Wrapper::completeMultipartUpload(const PutObjectRequestParameters& put_object_params, const std::string& upload_id,
+    const std::map<size_t, std::string>& uploaded_parts) {
+  Aws::S3::Model::CompletedMultipartUpload completed_upload;
+  for (const auto& [part_number, etag] : uploaded_parts) {
+    Aws::S3::Model::CompletedPart part;
+    part.SetPartNumber(gsl::narrow<int>(part_number));
+    part.SetETag(etag);
+    completed_upload.AddParts(std::move(part));
+  }
+
+  Aws::S3::Model::CompleteMultipartUploadRequest request;
+  request.SetBucket(put_object_params.bucket);
+  request.SetKey(put_object_params.object_key);
+  request.SetUploadId(upload_id);
+  request.SetMultipartUpload(std::move(completed_upload));
+
+  auto aws_result = request_sender_->sendCompleteMultipartUploadRequest(request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
+  if (!aws_result) {
+    return std::nullopt;
+  }
+
+  PutObjectResult result;
+  result.etag = minifi::utils::StringUtils::removeFramingCharacters(aws_result->GetETag(), '"');
+  result.version = aws_result->GetVersionId();
+  result.expiration = getExpiration(aws_result->GetExpiration()).expiration_time;
+  result.ssealgorithm = getEncryptionString(aws_result->GetServerSideEncryption());
+  return result;
+}
+
+bool S3Wrapper::abortMultipartUpload(const RequestParameters& params, const std::string& bucket, const std::string& key, const std::string& upload_id, bool use_virtual_addressing) {
+  Aws::S3::Model::AbortMultipartUploadRequest request;
+  request.SetBucket(bucket);
+  request.SetKey(key);
+  request.SetUploadId(upload_id);
+  return request_sender_->sendAbortMultipartUploadRequest(request, params.credentials, params.client_config, use_virtual_addressing);
+}
+
 bool S3Wrapper::deleteObject(const DeleteObjectRequestParameters& params) {
   Aws::S3::Model::DeleteObjectRequest request;
   request.SetBucket(params.bucket);
@@ -20,9 +20,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -96,6 +98,17 @@ struct PutObjectResult {
   std::string ssealgorithm;
 };
 
+struct MultipartUploadState {
+  std::string upload_id;
+  std::string bucket;
+  std::string key;
+  uint64_t part_size = 0;
+  uint64_t full_size = 0;
+  std::chrono::system_clock::time_point upload_time;
+  // part number -> ETag of the uploaded part
+  std::map<size_t, std::string> uploaded_parts;
+};
+
 struct RequestParameters {
   RequestParameters(Aws::Auth::AWSCredentials creds, Aws::Client::ClientConfiguration config)
     : credentials(std::move(creds)),
@@ -207,12 +220,26 @@ class S3Wrapper {
   std::optional<std::map<std::string, std::string>> getObjectTags(const GetObjectTagsParameters& params);
   std::optional<HeadObjectResult> headObject(const HeadObjectRequestParameters& head_object_params);
 
+  std::optional<std::string> initiateMultipartUpload(const PutObjectRequestParameters& put_object_params);
+  /**
+   * Uploads a single part of a multipart upload, data has to stay valid until the call returns.
+   * Safe to call concurrently for different parts of the same upload.
+   * @return the ETag of the uploaded part
+   */
+  std::optional<std::string> uploadPart(const PutObjectRequestParameters& put_object_params, const std::string& upload_id, size_t part_number, std::span<const std::byte> data);
+  std::optional<PutObjectResult> completeMultipartUpload(const PutObjectRequestParameters& put_object_params, const std::string& upload_id,
+    const std::map<size_t, std::string>& uploaded_parts);
+  bool abortMultipartUpload(const RequestParameters& params, const std::string& bucket, const std::string& key, const std::string& upload_id, bool use_virtual_addressing);
+
   virtual ~S3Wrapper() = default;
 
  private:
   static Expiration getExpiration(const std::string& expiration);
 
-  void setCannedAcl(Aws::S3::Model::PutObjectRequest& request, const std::string& canned_acl) const;
+  template<typename PutRequest>
+  void setCannedAcl(PutRequest& request, const std::string& canned_acl) const;
+  template<typename PutRequest>
+  void setPutRequestParameters(PutRequest& request, const PutObjectRequestParameters& put_object_params) const;
   static int64_t writeFetchedBody(Aws::IOStream& source, int64_t data_size, io::OutputStream& output);
   static std::string getEncryptionString(Aws::S3::Model::ServerSideEncryption encryption);
 
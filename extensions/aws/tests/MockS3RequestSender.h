@@ -19,6 +19,7 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <sstream>
@@ -56,6 +57,7 @@ const std::map<std::string, std::string> S3_OBJECT_USER_METADATA {
 const std::string S3_KEY_MARKER = "continue_key";
 const std::string S3_VERSION_ID_MARKER = "continue_version";
 const std::string S3_CONTINUATION_TOKEN = "continue";
+const std::string S3_UPLOAD_ID = "upload-id-123";
 
 class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
  public:
@@ -244,6 +246,61 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
     return std::make_optional(std::move(head_s3_result));
   }
 
+  std::optional<Aws::S3::Model::CreateMultipartUploadResult> sendCreateMultipartUploadRequest(
+      const Aws::S3::Model::CreateMultipartUploadRequest& request,
+      const Aws::Auth::AWSCredentials& credentials,
+      const Aws::Client::ClientConfiguration& client_config,
+      bool use_virtual_addressing) override {
+    std::lock_guard<std::mutex> lock(multipart_mutex_);
+    create_multipart_upload_request = request;
+    ++create_multipart_upload_count;
+    credentials_ = credentials;
+    client_config_ = client_config;
+    use_virtual_addressing_ = use_virtual_addressing;
+    Aws::S3::Model::CreateMultipartUploadResult result;
+    result.SetUploadId(S3_UPLOAD_ID);
+    return result;
+  }
+
+  std::optional<Aws::S3::Model::UploadPartResult> sendUploadPartRequest(
+      const Aws::S3::Model::UploadPartRequest& request,
+      const Aws::Auth::AWSCredentials& /*credentials*/,
+      const Aws::Client::ClientConfiguration& /*client_config*/,
+      bool /*use_virtual_addressing*/) override {
+    // the body is only valid during the call
+    std::string body{std::istreambuf_iterator<char>(*request.GetBody()), std::istreambuf_iterator<char>()};
+    std::lock_guard<std::mutex> lock(multipart_mutex_);
+    uploaded_parts[request.GetPartNumber()] = std::make_pair(request.GetUploadId(), std::move(body));
+    Aws::S3::Model::UploadPartResult result;
+    result.SetETag(S3_ETAG_PREFIX + std::to_string(request.GetPartNumber()));
+    return result;
+  }
+
+  std::optional<Aws::S3::Model::CompleteMultipartUploadResult> sendCompleteMultipartUploadRequest(
+      const Aws::S3::Model::CompleteMultipartUploadRequest& request,
+      const Aws::Auth::AWSCredentials& /*credentials*/,
+      const Aws::Client::ClientConfiguration& /*client_config*/,
+      bool /*use_virtual_addressing*/) override {
+    std::lock_guard<std::mutex> lock(multipart_mutex_);
+    complete_multipart_upload_request = request;
+    Aws::S3::Model::CompleteMultipartUploadResult result;
+    result.SetVersionId(S3_VERSION_1);
+    result.SetETag(S3_ETAG);
+    result.SetExpiration(S3_EXPIRATION);
+    result.SetServerSideEncryption(S3_SSEALGORITHM);
+    return result;
+  }
+
+  bool sendAbortMultipartUploadRequest(
+      const Aws::S3::Model::AbortMultipartUploadRequest& request,
+      const Aws::Auth::AWSCredentials& /*credentials*/,
+      const Aws::Client::ClientConfiguration& /*client_config*/,
+      bool /*use_virtual_addressing*/) override {
+    std::lock_guard<std::mutex> lock(multipart_mutex_);
+    aborted_upload_ids.push_back(request.GetUploadId());
+    return true;
+  }
+
   Aws::Auth::AWSCredentials getCredentials() const {
     return credentials_;
   }
@@ -288,8 +345,15 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
   Aws::S3::Model::ListObjectVersionsRequest list_version_request;
   Aws::S3::Model::GetObjectTaggingRequest get_object_tagging_request;
   Aws::S3::Model::HeadObjectRequest head_object_request;
+  Aws::S3::Model::CreateMultipartUploadRequest create_multipart_upload_request;
+  size_t create_multipart_upload_count = 0;
+  // part number -> upload id and body
+  std::map<int, std::pair<std::string, std::string>> uploaded_parts;
+  Aws::S3::Model::CompleteMultipartUploadRequest complete_multipart_upload_request;
+  std::vector<std::string> aborted_upload_ids;
 
  private:
+  std::mutex multipart_mutex_;
   std::vector<Aws::S3::Model::ObjectVersion> listed_versions_;
   std::vector<Aws::S3::Model::Object> listed_objects_;
   bool delete_object_result_ = true;
@@ -18,6 +18,7 @@
 
 #include "S3TestsFixture.h"
 #include "processors/PutS3Object.h"
+#include "s3/MultipartUploadStateStorage.h"
 #include "utils/IntegrationTestUtils.h"
 
 namespace {
@@ -33,6 +34,40 @@ class PutS3ObjectTestsFixture : public FlowProcessorS3TestsFixture<minifi::aws::
     REQUIRE(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.sseAlgorithm value:" + S3_SSEALGORITHM_STR));
   }
 
+  // writes an input file of two full 5 MB parts and a smaller last part
+  std::string setUpMultipartUpload() {
+    std::string content;
+    content.reserve(MULTIPART_CONTENT_SIZE);
+    for (size_t i = 0; i < MULTIPART_CONTENT_SIZE; ++i) {
+      content += static_cast<char>('a' + i % 26);
+    }
+    std::ofstream(input_dir / INPUT_FILENAME, std::ios::binary) << content;
+    state_directory = test_controller.createTempDirectory();
+    plan->setProperty(s3_processor, "Multipart Threshold", "10 MB");
+    plan->setProperty(s3_processor, "Multipart Part Size", "5 MB");
+    plan->setProperty(s3_processor, "Temporary Directory Multipart State", state_directory.string());
+    return content;
+  }
+
+  minifi::aws::s3::MultipartUploadStateStorage getStateStorage() const {
+    return minifi::aws::s3::MultipartUploadStateStorage(state_directory, s3_processor->getUUIDStr());
+  }
+
+  minifi::aws::s3::MultipartUploadState createRecordedState(std::chrono::system_clock::time_point upload_time) const {
+    minifi::aws::s3::MultipartUploadState state;
+    state.upload_id = "recorded-upload-id";
+    state.bucket = S3_BUCKET;
+    state.key = INPUT_FILENAME;
+    state.part_size = 5_MiB;
+    state.full_size = MULTIPART_CONTENT_SIZE;
+    state.upload_time = upload_time;
+    state.uploaded_parts = {{1, "\"recorded-etag-1\""}};
+    return state;
+  }
+
+  static constexpr size_t MULTIPART_CONTENT_SIZE = 12_MiB + 100;
+  std::filesystem::path state_directory;
+
   static void checkEmptyPutObjectResults() {
     REQUIRE_FALSE(LogTestController::getInstance().contains("key:s3.version value:", std::chrono::seconds(0), std::chrono::milliseconds(0)));
     REQUIRE_FALSE(LogTestController::getInstance().contains("key:s3.etag value:", std::chrono::seconds(0), std::chrono::milliseconds(0)));
@@ -227,4 +262,110 @@ TEST_CASE_METHOD(PutS3ObjectTestsFixture, "Test path style access property", "[a
   REQUIRE(!mock_s3_request_sender_ptr->getUseVirtualAddressing());
 }
 
+TEST_CASE_METHOD(PutS3ObjectTestsFixture, "Invalid multipart upload settings", "[awsS3Config]") {
+  setRequiredProperties();
+
+  SECTION("Part size is too small") {
+    plan->setProperty(s3_processor, "Multipart Part Size", "1 MB");
+  }
+
+  SECTION("Threshold is too large") {
+    plan->setProperty(s3_processor, "Multipart Threshold", "6 GB");
+  }
+
+  SECTION("Concurrency is zero") {
+    plan->setProperty(s3_processor, "Multipart Upload Concurrency", "0");
+  }
+
+  REQUIRE_THROWS_AS(test_controller.runSession(plan, true), minifi::Exception);
+}
+
+TEST_CASE_METHOD(PutS3ObjectTestsFixture, "Test multipart upload", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  const auto content = setUpMultipartUpload();
+  plan->setDynamicProperty(update_attribute, "s3.contenttype", "text/plain");
+  plan->setProperty(s3_processor, "Content Type", "${s3.contenttype}");
+
+  SECTION("Sequential part uploads") {
+    plan->setProperty(s3_processor, "Multipart Upload Concurrency", "1");
+  }
+
+  SECTION("Parallel part uploads") {
+    plan->setProperty(s3_processor, "Multipart Upload Concurrency", "4");
+  }
+
+  test_controller.runSession(plan, true);
+  checkPutObjectResults();
+  REQUIRE(mock_s3_request_sender_ptr->put_object_request.GetBucket().empty());
+  REQUIRE(mock_s3_request_sender_ptr->create_multipart_upload_count == 1);
+  REQUIRE(mock_s3_request_sender_ptr->create_multipart_upload_request.GetBucket() == S3_BUCKET);
+  REQUIRE(mock_s3_request_sender_ptr->create_multipart_upload_request.GetKey() == INPUT_FILENAME);
+  REQUIRE(mock_s3_request_sender_ptr->create_multipart_upload_request.GetContentType() == "text/plain");
+
+  const auto& uploaded_parts = mock_s3_request_sender_ptr->uploaded_parts;
+  REQUIRE(uploaded_parts.size() == 3);
+  REQUIRE(uploaded_parts.at(1).second.size() == 5_MiB);
+  REQUIRE(uploaded_parts.at(2).second.size() == 5_MiB);
+  REQUIRE(uploaded_parts.at(1).first == S3_UPLOAD_ID);
+  REQUIRE(uploaded_parts.at(1).second + uploaded_parts.at(2).second + uploaded_parts.at(3).second == content);
+
+  const auto& complete_request = mock_s3_request_sender_ptr->complete_multipart_upload_request;
+  REQUIRE(complete_request.GetUploadId() == S3_UPLOAD_ID);
+  const auto& completed_parts = complete_request.GetMultipartUpload().GetParts();
+  REQUIRE(completed_parts.size() == 3);
+  for (size_t i = 0; i < completed_parts.size(); ++i) {
+    REQUIRE(completed_parts[i].GetPartNumber() == gsl::narrow<int>(i + 1));
+    REQUIRE(completed_parts[i].GetETag() == S3_ETAG_PREFIX + std::to_string(i + 1));
+  }
+  REQUIRE_FALSE(getStateStorage().getState(S3_BUCKET + "/" + INPUT_FILENAME));
+}
+
+TEST_CASE_METHOD(PutS3ObjectTestsFixture, "Test continuing a recorded multipart upload", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  const auto content = setUpMultipartUpload();
+  const auto state_key = S3_BUCKET + "/" + INPUT_FILENAME;
+  getStateStorage().storeState(state_key, createRecordedState(std::chrono::system_clock::now()));
+
+  test_controller.runSession(plan, true);
+  checkPutObjectResults();
+  REQUIRE(mock_s3_request_sender_ptr->create_multipart_upload_count == 0);
+  REQUIRE(mock_s3_request_sender_ptr->aborted_upload_ids.empty());
+  const auto& uploaded_parts = mock_s3_request_sender_ptr->uploaded_parts;
+  REQUIRE(uploaded_parts.size() == 2);
+  REQUIRE(uploaded_parts.at(2).first == "recorded-upload-id");
+  REQUIRE(uploaded_parts.at(2).second + uploaded_parts.at(3).second == content.substr(5_MiB));
+
+  const auto& complete_request = mock_s3_request_sender_ptr->complete_multipart_upload_request;
+  REQUIRE(complete_request.GetUploadId() == "recorded-upload-id");
+  const auto& completed_parts = complete_request.GetMultipartUpload().GetParts();
+  REQUIRE(completed_parts.size() == 3);
+  REQUIRE(completed_parts[0].GetETag() == "\"recorded-etag-1\"");
+  REQUIRE_FALSE(getStateStorage().getState(state_key));
+}
+
+TEST_CASE_METHOD(PutS3ObjectTestsFixture, "Test restarting a recorded multipart upload", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  setUpMultipartUpload();
+  const auto state_key = S3_BUCKET + "/" + INPUT_FILENAME;
+
+  SECTION("Recorded upload is too old") {
+    plan->setProperty(s3_processor, "Multipart Upload Max Age Threshold", "1 day");
+    getStateStorage().storeState(state_key, createRecordedState(std::chrono::system_clock::now() - std::chrono::hours(25)));
+  }
+
+  SECTION("Recorded upload has a different size") {
+    auto state = createRecordedState(std::chrono::system_clock::now());
+    state.full_size += 1;
+    getStateStorage().storeState(state_key, state);
+  }
+
+  test_controller.runSession(plan, true);
+  checkPutObjectResults();
+  REQUIRE(mock_s3_request_sender_ptr->aborted_upload_ids == std::vector<std::string>{"recorded-upload-id"});
+  REQUIRE(mock_s3_request_sender_ptr->create_multipart_upload_count == 1);
+  REQUIRE(mock_s3_request_sender_ptr->uploaded_parts.size() == 3);
+  REQUIRE(mock_s3_request_sender_ptr->complete_multipart_upload_request.GetUploadId() == S3_UPLOAD_ID);
+  REQUIRE_FALSE(getStateStorage().getState(state_key));
+}
+
 }  // namespace
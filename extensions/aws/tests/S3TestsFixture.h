@@ -132,7 +132,7 @@ class FlowProcessorS3TestsFixture : public S3TestsFixture<T> {
     LogTestController::getInstance().setTrace<minifi::processors::GetFile>();
     LogTestController::getInstance().setDebug<minifi::processors::UpdateAttribute>();
 
-    auto input_dir = this->test_controller.createTempDirectory();
+    input_dir = this->test_controller.createTempDirectory();
     std::ofstream input_file_stream(input_dir / INPUT_FILENAME);
     input_file_stream << INPUT_DATA;
     input_file_stream.close();
@@ -181,6 +181,7 @@ class FlowProcessorS3TestsFixture : public S3TestsFixture<T> {
   }
 
  protected:
+  std::filesystem::path input_dir;
   std::shared_ptr<core::Processor> update_attribute;
 };
 
@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include "ResourceClaim.h"
 #include "core/Resource.h"
 #include "utils/gsl.h"
 
@@ -239,6 +240,8 @@ ListenHTTP::Handler::Handler(std::string base_uri, core::ProcessContext *context
       process_context_(context) {
   context->getProperty(BufferSize, buffer_size_);
   logger_->log_debug("ListenHTTP using %s: %zu", std::string(BufferSize.name), buffer_size_);
+  context->getProperty(StreamRequestBody, stream_request_body_);
+  logger_->log_debug("ListenHTTP using %s: %s", std::string(StreamRequestBody.name), stream_request_body_ ? "true" : "false");
 }
 
 void ListenHTTP::Handler::sendHttp500(mg_connection* const conn) {
@@ -270,8 +273,11 @@ void ListenHTTP::Handler::setHeaderAttributes(const mg_request_info *req_info, c
   }
 }
 
-void ListenHTTP::Handler::enqueueRequest(mg_connection *conn, const mg_request_info *req_info, std::unique_ptr<io::BufferStream> content_buffer) {
-  auto flow_file = std::make_shared<FlowFileRecord>();
+bool ListenHTTP::Handler::isRequestBufferFull() const {
+  return buffer_size_ != 0 && request_buffer_.size() >= buffer_size_;
+}
+
+void ListenHTTP::Handler::enqueueRequest(mg_connection *conn, const mg_request_info *req_info, std::shared_ptr<FlowFileRecord> flow_file, std::unique_ptr<io::BufferStream> content_buffer) {
   auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
   if (flow_version != nullptr) {
     flow_file->setAttribute(core::SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
@@ -279,7 +285,7 @@ void ListenHTTP::Handler::enqueueRequest(mg_connection *conn, const mg_request_i
 
   setHeaderAttributes(req_info, flow_file);
 
-  if (buffer_size_ == 0 || request_buffer_.size() < buffer_size_) {
+  if (!isRequestBufferFull()) {
     request_buffer_.enqueue(std::make_pair(std::move(flow_file), std::move(content_buffer)));
   } else {
     logger_->log_warn("ListenHTTP buffer is full, '%s' request for '%s' uri was dropped", req_info->request_method, req_info->request_uri);
@@ -303,10 +309,26 @@ bool ListenHTTP::Handler::handlePost(CivetServer* /*server*/, struct mg_connecti
     return true;
   }
 
+  if (stream_request_body_ && isRequestBufferFull()) {
+    // refuse the request before receiving its body, so that it is not written to the content repository in vain
+    logger_->log_warn("ListenHTTP buffer is full, '%s' request for '%s' uri was dropped", req_info->request_method, req_info->request_uri);
+    sendHttp503(conn);
+    return true;
+  }
+
   // Always send 100 Continue, as allowed per standard to minimize client delay (https://www.w3.org/Protocols/rfc2616/rfc2616-sec8.html)
   mg_printf(conn, "HTTP/1.1 100 Continue\r\n\r\n");
 
-  enqueueRequest(conn, req_info, createContentBuffer(conn, req_info));
+  auto flow_file = std::make_shared<FlowFileRecord>();
+  if (!stream_request_body_) {
+    enqueueRequest(conn, req_info, std::move(flow_file), createContentBuffer(conn, req_info));
+    return true;
+  }
+  if (!writeContentToRepository(conn, req_info, *flow_file)) {
+    sendHttp500(conn);
+    return true;
+  }
+  enqueueRequest(conn, req_info, std::move(flow_file), nullptr);
   return true;
 }
 
@@ -337,7 +359,7 @@ bool ListenHTTP::Handler::handleGet(CivetServer* /*server*/, struct mg_connectio
     return true;
   }
 
-  enqueueRequest(conn, req_info, nullptr);
+  enqueueRequest(conn, req_info, std::make_shared<FlowFileRecord>(), nullptr);
   return true;
 }
 
@@ -429,8 +451,7 @@ void ListenHTTP::Handler::writeBody(mg_connection *conn, const mg_request_info *
   }
 }
 
-std::unique_ptr<io::BufferStream> ListenHTTP::Handler::createContentBuffer(struct mg_connection *conn, const struct mg_request_info *req_info) {
-  auto content_buffer = std::make_unique<io::BufferStream>();
+size_t ListenHTTP::Handler::readContent(struct mg_connection *conn, const struct mg_request_info *req_info, io::OutputStream& output) {
   size_t nlen = 0;
   int64_t tlen = req_info->content_length;
   uint8_t buf[16384];
@@ -451,14 +472,45 @@ std::unique_ptr<io::BufferStream> ListenHTTP::Handler::createContentBuffer(struc
     rlen = gsl::narrow<size_t>(mg_read_return);
 
     // Transfer buffer data to the output stream
-    content_buffer->write(&buf[0], rlen);
+    const auto write_result = output.write(&buf[0], rlen);
+    if (io::isError(write_result)) {
+      return write_result;
+    }
 
     nlen += rlen;
   }
 
+  return nlen;
+}
+
+std::unique_ptr<io::BufferStream> ListenHTTP::Handler::createContentBuffer(struct mg_connection *conn, const struct mg_request_info *req_info) {
+  auto content_buffer = std::make_unique<io::BufferStream>();
+  readContent(conn, req_info, *content_buffer);
   return content_buffer;
 }
 
+bool ListenHTTP::Handler::writeContentToRepository(struct mg_connection *conn, const struct mg_request_info *req_info, core::FlowFile& flow_file) const {
+  // the content is removed from the repository when the claim is released, unless the flow file gets committed
+  const auto content_repository = process_context_->getContentRepository();
+  const auto claim = std::make_shared<ResourceClaim>(content_repository);
+  const auto content_stream = content_repository->write(*claim);
+  if (!content_stream) {
+    logger_->log_error("Could not open %s to write the request body into", claim->getContentFullPath());
+    return false;
+  }
+  const auto size = readContent(conn, req_info, *content_stream);
+  content_stream->close();
+  if (io::isError(size)) {
+    logger_->log_error("Failed to write the body of the '%s' request for '%s' uri into %s", req_info->request_method, req_info->request_uri, claim->getContentFullPath());
+    return false;
+  }
+  flow_file.setSize(size);
+  flow_file.setOffset(0);
+  flow_file.setResourceClaim(claim);
+  logger_->log_debug("Streamed request body of %zu bytes into %s", size, claim->getContentFullPath());
+  return true;
+}
+
 bool ListenHTTP::isSecure() const {
   return (listeningPort.length() > 0) && *listeningPort.rbegin() == 's';
 }
@@ -112,7 +112,13 @@ class ListenHTTP : public core::Processor {
         .withPropertyType(core::StandardPropertyTypes::UNSIGNED_LONG_TYPE)
         .withDefaultValue(ListenHTTP::DEFAULT_BUFFER_SIZE_STR)
         .build();
-  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 10>{
+  EXTENSIONAPI static constexpr auto StreamRequestBody = core::PropertyDefinitionBuilder<>::createProperty("Stream Request Body")
+        .withDescription("If true, the body of POST requests is written into the content repository while it is received, using a fixed size buffer per connection, "
+            "instead of being held in memory until the processor is triggered. Requests are refused before their body is received if the buffer of requests is full.")
+        .withPropertyType(core::StandardPropertyTypes::BOOLEAN_TYPE)
+        .withDefaultValue("false")
+        .build();
+  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 11>{
       BasePath,
       Port,
       AuthorizedDNPattern,
@@ -122,7 +128,8 @@ class ListenHTTP : public core::Processor {
       SSLMinimumVersion,
       HeadersAsAttributesRegex,
       BatchSize,
-      BufferSize
+      BufferSize,
+      StreamRequestBody
   };
 
 
@@ -175,8 +182,11 @@ class ListenHTTP : public core::Processor {
     bool authRequest(mg_connection *conn, const mg_request_info *req_info) const;
     void setHeaderAttributes(const mg_request_info *req_info, const std::shared_ptr<core::FlowFile> &flow_file) const;
     void writeBody(mg_connection *conn, const mg_request_info *req_info, bool include_payload = true);
+    static size_t readContent(struct mg_connection *conn, const struct mg_request_info *req_info, io::OutputStream& output);
     static std::unique_ptr<io::BufferStream> createContentBuffer(struct mg_connection *conn, const struct mg_request_info *req_info);
-    void enqueueRequest(mg_connection *conn, const mg_request_info *req_info, std::unique_ptr<io::BufferStream>);
+    bool writeContentToRepository(struct mg_connection *conn, const struct mg_request_info *req_info, core::FlowFile& flow_file) const;
+    bool isRequestBufferFull() const;
+    void enqueueRequest(mg_connection *conn, const mg_request_info *req_info, std::shared_ptr<FlowFileRecord> flow_file, std::unique_ptr<io::BufferStream>);
 
     std::string base_uri_;
     utils::Regex auth_dn_regex_;
@@ -186,6 +196,7 @@ class ListenHTTP : public core::Processor {
     std::map<std::string, ResponseBody> response_uri_map_;
     std::mutex uri_map_mutex_;
     uint64_t buffer_size_;
+    bool stream_request_body_ = false;
     utils::ConcurrentQueue<FlowFileBufferPair> request_buffer_;
   };
 
@@ -423,6 +423,31 @@ TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTP Batch tests", "[batch]") {
   test_connect(requests, expected_processed_request_count);
 }
 
+TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTP POST with streamed request body", "[basic][stream]") {
+  plan->setProperty(listen_http, minifi::processors::ListenHTTP::StreamRequestBody, "true");
+  method = "POST";
+  std::size_t expected_processed_request_count = 0;
+  std::vector<HttpResponseExpectations> requests;
+
+  SECTION("Body larger than the read buffer") {
+    payload = std::string(100000, 'x');
+    requests.emplace_back(true, 200);
+    expected_processed_request_count = 1;
+  }
+
+  SECTION("Requests are refused when the buffer is full") {
+    payload = "Test payload";
+    batch_size_ = 5;
+    buffer_size_ = 2;
+    requests = {HttpResponseExpectations{true, 200}, HttpResponseExpectations{true, 200}, HttpResponseExpectations{true, 503}};
+    expected_processed_request_count = 2;
+  }
+
+  run_server();
+  test_connect(requests, expected_processed_request_count);
+  REQUIRE(LogTestController::getInstance().contains("Streamed request body of " + std::to_string(payload.size()) + " bytes"));
+}
+
 #ifdef OPENSSL_SUPPORT
 TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTPS without CA", "[basic][https]") {
   plan->setProperty(listen_http, minifi::processors::ListenHTTP::SSLCertificate, (minifi::utils::file::FileUtils::get_executable_dir() / "resources" / "server.pem").string());
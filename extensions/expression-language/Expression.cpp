@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <regex>
 #include <functional>
+#include <memory>
 #include <string>
 
 #include "rapidjson/reader.h"
@@ -775,16 +776,14 @@ Value expr_replace(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_replaceFirst(const std::vector<Value> &args) {
+Value expr_replaceFirst(const std::vector<Value> &args, const std::regex &find) {
   std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
   const std::string &replace = args[2].asString();
   return Value(std::regex_replace(result, find, replace, std::regex_constants::format_first_only));
 }
 
-Value expr_replaceAll(const std::vector<Value> &args) {
+Value expr_replaceAll(const std::vector<Value> &args, const std::regex &find) {
   std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
   const std::string &replace = args[2].asString();
   return Value(std::regex_replace(result, find, replace));
 }
@@ -799,21 +798,19 @@ Value expr_replaceNull(const std::vector<Value> &args) {
 
 Value expr_replaceEmpty(const std::vector<Value> &args) {
   std::string result = args[0].asString();
-  const std::regex find("^[ \n\r\t]*$");
+  static const std::regex find("^[ \n\r\t]*$");
   const std::string &replace = args[1].asString();
   return Value(std::regex_replace(result, find, replace));
 }
 
-Value expr_matches(const std::vector<Value> &args) {
+Value expr_matches(const std::vector<Value> &args, const utils::Regex &expr) {
   const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
 
   return Value(utils::regexMatch(subject, expr));
 }
 
-Value expr_find(const std::vector<Value> &args) {
+Value expr_find(const std::vector<Value> &args, const utils::Regex &expr) {
   const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
 
   return Value(utils::regexSearch(subject, expr));
 }
@@ -925,8 +922,8 @@ Value expr_random(const std::vector<Value>& /*args*/) {
   return Value(distribution(generator));
 }
 
-template<Value T(const std::vector<Value> &)>
-Expression make_dynamic_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+template<typename Function>
+Expression make_function_expression(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args, Function fn, bool deterministic) {
   if (args.size() < num_args) {
     std::stringstream message_ss;
     message_ss << "Expression language function " << function_name << " called with " << args.size() << " argument(s), but " << num_args << " are required";
@@ -941,20 +938,64 @@ Expression make_dynamic_function_incomplete(const std::string &function_name, co
     }
 
     return args[0].compose_multi([=](const std::vector<Value> &args) -> Value {
-      return T(args);
+      return fn(args);
     },
                                  multi_args);
-  } else {
-    return make_dynamic([=](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+  }
+
+  if (deterministic && std::none_of(args.begin(), args.end(), [](const Expression &arg) { return arg.is_dynamic(); })) {
+    // constant folding: the result is the same for every evaluation
+    try {
       std::vector<Value> evaluated_args;
       evaluated_args.reserve(args.size());
       for (const auto &arg : args) {
-        evaluated_args.emplace_back(arg(params));
+        evaluated_args.emplace_back(arg(Parameters{}));
       }
+      return Expression(fn(evaluated_args));
+    } catch (const std::exception&) {
+      // leave the error to be reported on evaluation
+    }
+  }
 
-      return T(evaluated_args);
-    });
+  return make_dynamic([=](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+    std::vector<Value> evaluated_args;
+    evaluated_args.reserve(args.size());
+    for (const auto &arg : args) {
+      evaluated_args.emplace_back(arg(params));
+    }
+
+    return fn(evaluated_args);
+  });
+}
+
+/**
+ * Whether the result of the function only depends on its arguments, so it can be evaluated at compile time for literal arguments.
+ */
+template<Value T(const std::vector<Value> &)>
+constexpr bool is_deterministic = true;
+
+template<Value T(const std::vector<Value> &)>
+Expression make_dynamic_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+  return make_function_expression(function_name, args, num_args, [](const std::vector<Value> &evaluated_args) { return T(evaluated_args); }, is_deterministic<T>);
+}
+
+/**
+ * Creates a function taking a regular expression as its second argument, which is compiled only once if it is a literal.
+ */
+template<typename RegexType, Value T(const std::vector<Value> &, const RegexType &)>
+Expression make_regex_function(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+  if (args.size() > 1 && !args[1].is_dynamic()) {
+    std::shared_ptr<const RegexType> pattern;
+    try {
+      pattern = std::make_shared<const RegexType>(args[1](Parameters{}).asString());
+    } catch (const std::exception&) {
+      // leave the error to be reported on evaluation
+    }
+    if (pattern) {
+      return make_function_expression(function_name, args, num_args, [pattern](const std::vector<Value> &evaluated_args) { return T(evaluated_args, *pattern); }, true);
+    }
   }
+  return make_function_expression(function_name, args, num_args, [](const std::vector<Value> &evaluated_args) { return T(evaluated_args, RegexType(evaluated_args[1].asString())); }, true);
 }
 
 Value expr_literal(const std::vector<Value> &args) {
@@ -1369,6 +1410,14 @@ Expression make_join(const std::string &function_name, const std::vector<Express
   });
 }
 
+template<> constexpr bool is_deterministic<expr_hostname> = false;
+template<> constexpr bool is_deterministic<resolve_user_id> = false;
+template<> constexpr bool is_deterministic<expr_ip> = false;
+template<> constexpr bool is_deterministic<expr_reverseDnsLookup> = false;
+template<> constexpr bool is_deterministic<expr_uuid> = false;
+template<> constexpr bool is_deterministic<expr_random> = false;
+template<> constexpr bool is_deterministic<expr_now> = false;
+
 Expression make_dynamic_function(const std::string &function_name, const std::vector<Expression> &args) {
   if (function_name == "hostname") {
     return make_dynamic_function_incomplete<expr_hostname>(function_name, args, 0);
@@ -1439,17 +1488,17 @@ Expression make_dynamic_function(const std::string &function_name, const std::ve
   } else if (function_name == "replace") {
     return make_dynamic_function_incomplete<expr_replace>(function_name, args, 2);
   } else if (function_name == "replaceFirst") {
-    return make_dynamic_function_incomplete<expr_replaceFirst>(function_name, args, 2);
+    return make_regex_function<std::regex, expr_replaceFirst>(function_name, args, 2);
   } else if (function_name == "replaceAll") {
-    return make_dynamic_function_incomplete<expr_replaceAll>(function_name, args, 2);
+    return make_regex_function<std::regex, expr_replaceAll>(function_name, args, 2);
   } else if (function_name == "replaceNull") {
     return make_dynamic_function_incomplete<expr_replaceNull>(function_name, args, 1);
   } else if (function_name == "replaceEmpty") {
     return make_dynamic_function_incomplete<expr_replaceEmpty>(function_name, args, 1);
   } else if (function_name == "matches") {
-    return make_dynamic_function_incomplete<expr_matches>(function_name, args, 1);
+    return make_regex_function<utils::Regex, expr_matches>(function_name, args, 1);
   } else if (function_name == "find") {
-    return make_dynamic_function_incomplete<expr_find>(function_name, args, 1);
+    return make_regex_function<utils::Regex, expr_find>(function_name, args, 1);
   } else if (function_name == "allMatchingAttributes") {
     return make_allMatchingAttributes(function_name, args);
   } else if (function_name == "anyMatchingAttribute") {
@@ -1547,48 +1596,39 @@ bool Expression::is_dynamic() const {
   return static_cast<bool>(val_fn_);
 }
 
+void Expression::append_concatenation_parts(std::vector<Expression> &parts) const {
+  if (concatenation_parts_ && !is_multi_) {
+    for (const auto &part : *concatenation_parts_) {
+      part.append_concatenation_parts(parts);
+    }
+  } else if (!is_dynamic() && !parts.empty() && !parts.back().is_dynamic()) {
+    parts.back() = make_static(parts.back().val_.asString().append(val_.asString()));
+  } else {
+    parts.push_back(*this);
+  }
+}
+
 Expression Expression::operator+(const Expression &other_expr) const {
-  if (is_dynamic() && other_expr.is_dynamic()) {
-    auto val_fn = val_fn_;
-    auto other_val_fn = other_expr.val_fn_;
-    auto sub_expr_generator = sub_expr_generator_;
-    auto other_sub_expr_generator = other_expr.sub_expr_generator_;
-    return make_dynamic([val_fn,
-    other_val_fn,
-    sub_expr_generator,
-    other_sub_expr_generator](const Parameters &params,
-        const std::vector<Expression>& /*sub_exprs*/) -> Value {
-      Value result = val_fn(params, sub_expr_generator(params));
-      return Value(result.asString().append(other_val_fn(params, other_sub_expr_generator(params)).asString()));
-    });
-  } else if (is_dynamic() && !other_expr.is_dynamic()) {
-    auto val_fn = val_fn_;
-    auto other_val = other_expr.val_;
-    auto sub_expr_generator = sub_expr_generator_;
-    return make_dynamic([val_fn,
-    other_val,
-    sub_expr_generator](const Parameters &params,
-        const std::vector<Expression>& /*sub_exprs*/) -> Value {
-      Value result = val_fn(params, sub_expr_generator(params));
-      return Value(result.asString().append(other_val.asString()));
-    });
-  } else if (!is_dynamic() && other_expr.is_dynamic()) {
-    auto val = val_;
-    auto other_val_fn = other_expr.val_fn_;
-    auto other_sub_expr_generator = other_expr.sub_expr_generator_;
-    return make_dynamic([val,
-    other_val_fn,
-    other_sub_expr_generator](const Parameters &params,
-        const std::vector<Expression>& /*sub_exprs*/) -> Value {
-      return Value(val.asString().append(other_val_fn(params, other_sub_expr_generator(params)).asString()));
-    });
-  } else if (!is_dynamic() && !other_expr.is_dynamic()) {
+  if (!is_dynamic() && !other_expr.is_dynamic()) {
     std::string result(val_.asString());
     result.append(other_expr.val_.asString());
     return make_static(result);
-  } else {
-    throw std::runtime_error("Invalid function composition");
   }
+
+  // keep the parts of chained concatenations in a flat list, instead of nesting a closure for each of them
+  std::vector<Expression> parts;
+  append_concatenation_parts(parts);
+  other_expr.append_concatenation_parts(parts);
+  auto shared_parts = std::make_shared<const std::vector<Expression>>(std::move(parts));
+  auto result = make_dynamic([shared_parts](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+    std::string concatenated;
+    for (const auto &part : *shared_parts) {
+      concatenated.append(part(params).asString());
+    }
+    return Value(std::move(concatenated));
+  });
+  result.concatenation_parts_ = std::move(shared_parts);
+  return result;
 }
 
 Value Expression::operator()(const Parameters &params) const {
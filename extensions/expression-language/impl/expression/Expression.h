@@ -118,11 +118,15 @@ class Expression {
   Expression make_aggregate(const std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)>& val_fn) const;
 
  protected:
+  void append_concatenation_parts(std::vector<Expression> &parts) const;
+
   Value val_;
   std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)> val_fn_;
   std::vector<Expression> fn_args_;
   std::function<std::vector<Expression>(const Parameters &params)> sub_expr_generator_;
-  bool is_multi_;
+  bool is_multi_ = false;
+  // the parts of a concatenation, evaluated one after the other
+  std::shared_ptr<const std::vector<Expression>> concatenation_parts_;
 };
 
 /**
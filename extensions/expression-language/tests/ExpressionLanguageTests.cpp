@@ -445,6 +445,67 @@ TEST_CASE("Replace All 3", "[expressionLanguageReplaceAll3]") {
   REQUIRE("a brand new filename.txt" == expr(expression::Parameters{ flow_file_a }).asString());
 }
 
+TEST_CASE("Replace All with a precompiled pattern", "[expressionLanguageReplaceAllPrecompiled]") {
+  auto expr = expression::compile("${attr:replaceAll('[0-9]+', 'N')}");
+
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+  flow_file_a->addAttribute("attr", "file-123.txt");
+  auto flow_file_b = std::make_shared<core::FlowFile>();
+  flow_file_b->addAttribute("attr", "4-5-6");
+  REQUIRE("file-N.txt" == expr(expression::Parameters{ flow_file_a }).asString());
+  REQUIRE("N-N-N" == expr(expression::Parameters{ flow_file_b }).asString());
+  REQUIRE("file-N.txt" == expr(expression::Parameters{ flow_file_a }).asString());
+}
+
+TEST_CASE("Replace All with a dynamic pattern", "[expressionLanguageReplaceAllDynamicPattern]") {
+  auto expr = expression::compile("${attr:replaceAll(${pattern}, 'X')}");
+
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+  flow_file_a->addAttribute("attr", "abc-123");
+  flow_file_a->addAttribute("pattern", "[a-z]");
+  auto flow_file_b = std::make_shared<core::FlowFile>();
+  flow_file_b->addAttribute("attr", "abc-123");
+  flow_file_b->addAttribute("pattern", "[0-9]");
+  REQUIRE("XXX-123" == expr(expression::Parameters{ flow_file_a }).asString());
+  REQUIRE("abc-XXX" == expr(expression::Parameters{ flow_file_b }).asString());
+}
+
+TEST_CASE("Invalid literal patterns are reported on evaluation", "[expressionLanguageInvalidLiteralPattern]") {
+  auto replace_expr = expression::compile("${attr:replaceAll('(', 'x')}");
+  auto matches_expr = expression::compile("${attr:matches('(')}");
+
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+  flow_file_a->addAttribute("attr", "abc");
+  REQUIRE_THROWS(replace_expr(expression::Parameters{ flow_file_a }));
+  REQUIRE_THROWS(matches_expr(expression::Parameters{ flow_file_a }));
+}
+
+TEST_CASE("Constant sub-expressions are folded", "[expressionLanguageConstantFolding]") {
+  auto expr = expression::compile("${literal('abc'):toUpper():append('-'):append(${literal(1):plus(2)})}");
+  REQUIRE_FALSE(expr.is_dynamic());
+  REQUIRE("ABC-3" == expr(expression::Parameters{}).asString());
+
+  auto mixed_expr = expression::compile("${attr:append(${literal('x'):toUpper()})}");
+  REQUIRE(mixed_expr.is_dynamic());
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+  flow_file_a->addAttribute("attr", "a");
+  REQUIRE("aX" == mixed_expr(expression::Parameters{ flow_file_a }).asString());
+
+  auto uuid_expr = expression::compile("${UUID()}");
+  REQUIRE(uuid_expr.is_dynamic());
+  REQUIRE(uuid_expr(expression::Parameters{}).asString() != uuid_expr(expression::Parameters{}).asString());
+}
+
+TEST_CASE("Concatenation of many parts", "[expressionLanguageConcatenation]") {
+  auto expr = expression::compile("<${a}|${b}|${literal('c'):toUpper()}|${a}${b}>");
+
+  auto flow_file_a = std::make_shared<core::FlowFile>();
+  flow_file_a->addAttribute("a", "1");
+  flow_file_a->addAttribute("b", "2");
+  REQUIRE("<1|2|C|12>" == expr(expression::Parameters{ flow_file_a }).asString());
+  REQUIRE("<||C|>" == expr(expression::Parameters{}).asString());
+}
+
 TEST_CASE("Replace Null", "[expressionLanguageReplaceNull]") {
   auto expr = expression::compile("${attr:replaceNull('abc')}");
 
@@ -310,23 +310,24 @@ void HTTPClient::setRequestHeader(std::string key, std::optional<std::string> va
 }
 
 namespace {
-struct CurlSListFreeAll {
-  void operator()(struct curl_slist* slist) const {
-    curl_slist_free_all(slist);
-  }
-};
-
-std::unique_ptr<struct curl_slist, CurlSListFreeAll> getCurlSList(const std::unordered_map<std::string, std::string>& request_headers) {
+curl_slist* getCurlSList(const std::unordered_map<std::string, std::string>& request_headers) {
   curl_slist* new_list = nullptr;
   for (const auto& [header_key, header_value] : request_headers)
     new_list = curl_slist_append(new_list, utils::StringUtils::join_pack(header_key, ": ", header_value).c_str());
 
-  return {new_list, {}};
+  return new_list;
 }
 }  // namespace
 
 
 bool HTTPClient::submit() {
+  if (!prepareSubmit()) {
+    return false;
+  }
+  return finishSubmit(curl_easy_perform(http_session_.get()));
+}
+
+bool HTTPClient::prepareSubmit() {
   if (url_.empty()) {
     logger_->log_error("Tried to submit to an empty url");
     return false;
@@ -348,11 +349,11 @@ bool HTTPClient::submit() {
     curl_easy_setopt(http_session_.get(), CURLOPT_NOPROGRESS, 1);
   }
 
-  auto headers = getCurlSList(request_headers_);
-  if (headers) {
-    curl_slist_append(headers.get(), "Expect:");
-    curl_easy_setopt(http_session_.get(), CURLOPT_HTTPHEADER, headers.get());
+  request_header_list_.reset(getCurlSList(request_headers_));
+  if (request_header_list_) {
+    curl_slist_append(request_header_list_.get(), "Expect:");
   }
+  curl_easy_setopt(http_session_.get(), CURLOPT_HTTPHEADER, request_header_list_.get());
 
   curl_easy_setopt(http_session_.get(), CURLOPT_URL, url_.c_str());
   logger_->log_debug("Submitting to %s", url_);
@@ -367,7 +368,11 @@ bool HTTPClient::submit() {
   if (form_ != nullptr) {
     curl_easy_setopt(http_session_.get(), CURLOPT_MIMEPOST, form_.get());
   }
-  res_ = curl_easy_perform(http_session_.get());
+  return true;
+}
+
+bool HTTPClient::finishSubmit(CURLcode result) {
+  res_ = result;
   if (read_callback_ == nullptr) {
     content_.close();
   }
@@ -526,6 +531,10 @@ void HTTPClient::CurlMimeFree::operator()(curl_mime* curl_mime) const {
   curl_mime_free(curl_mime);
 }
 
+void HTTPClient::CurlSListFreeAll::operator()(curl_slist* slist) const {
+  curl_slist_free_all(slist);
+}
+
 REGISTER_RESOURCE(HTTPClient, InternalResource);
 
 }  // namespace org::apache::nifi::minifi::extensions::curl
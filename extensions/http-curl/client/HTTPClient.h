@@ -64,6 +64,8 @@ struct HTTPResponseData {
   }
 };
 
+class HTTPMultiClient;
+
 class HTTPClient : public utils::BaseHTTPClient, public core::Connectable {
  public:
   HTTPClient();
@@ -190,8 +192,21 @@ class HTTPClient : public utils::BaseHTTPClient, public core::Connectable {
   static std::string replaceInvalidCharactersInHttpHeaderFieldName(std::string field_name);
 
  private:
+  friend class HTTPMultiClient;
+
   static int onProgress(void *client, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
 
+  /**
+   * Sets up the transfer of the request on the curl handle, which can then be performed either by curl_easy_perform or by a curl multi handle.
+   * @return false if the request cannot be submitted
+   */
+  bool prepareSubmit();
+  /**
+   * Collects the response after the transfer has been performed.
+   * @return whether the transfer succeeded
+   */
+  bool finishSubmit(CURLcode result);
+
   struct Progress{
     std::chrono::steady_clock::time_point last_transferred_;
     curl_off_t uploaded_data_{};
@@ -239,9 +254,12 @@ class HTTPClient : public utils::BaseHTTPClient, public core::Connectable {
 
   struct CurlEasyCleanup { void operator()(CURL* curl) const; };
   struct CurlMimeFree { void operator()(curl_mime* curl_mime) const; };
+  struct CurlSListFreeAll { void operator()(curl_slist* slist) const; };
 
   std::unique_ptr<CURL, CurlEasyCleanup> http_session_;
   std::unique_ptr<curl_mime, CurlMimeFree> form_;
+  // curl only keeps a pointer to the header list, it has to live until the transfer is finished
+  std::unique_ptr<curl_slist, CurlSListFreeAll> request_header_list_;
   std::unique_ptr<utils::HTTPReadCallback> read_callback_;
   std::unique_ptr<utils::HTTPUploadCallback> write_callback_;
   std::unique_ptr<utils::HTTPUploadCallback> form_callback_;
@@ -0,0 +1,117 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "HTTPMultiClient.h"
+
+#include <stdexcept>
+
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::extensions::curl {
+
+namespace {
+constexpr int MAX_WAIT_TIME_MS = 1000;
+}  // namespace
+
+HTTPMultiClient::HTTPMultiClient(size_t max_connections)
+    : multi_handle_(curl_multi_init()) {
+  if (!multi_handle_) {
+    throw std::runtime_error("Could not create curl multi handle");
+  }
+  curl_multi_setopt(multi_handle_.get(), CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));  // NOLINT(runtime/int) long due to libcurl API
+  curl_multi_setopt(multi_handle_.get(), CURLMOPT_MAXCONNECTS, gsl::narrow<long>(max_connections));  // NOLINT(runtime/int) long due to libcurl API
+}
+
+HTTPMultiClient::~HTTPMultiClient() {
+  removeAll();
+}
+
+void HTTPMultiClient::removeAll() {
+  for (const auto& [easy_handle, client] : pending_transfers_) {
+    curl_multi_remove_handle(multi_handle_.get(), easy_handle);
+  }
+  pending_transfers_.clear();
+}
+
+bool HTTPMultiClient::isHttp2Supported() {
+  static const bool http2_supported = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
+  return http2_supported;
+}
+
+bool HTTPMultiClient::add(HTTPClient& client) {
+  if (!client.prepareSubmit()) {
+    return false;
+  }
+  CURL* easy_handle = client.http_session_.get();
+  if (isHttp2Supported()) {
+    // HTTP/2 is only used for https, where it can be negotiated, plain http stays on HTTP/1.1
+    curl_easy_setopt(easy_handle, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));  // NOLINT(runtime/int) long due to libcurl API
+    // wait for an existing connection to the same host instead of opening a new one, so that the requests are multiplexed
+    curl_easy_setopt(easy_handle, CURLOPT_PIPEWAIT, 1L);
+  }
+  const auto result = curl_multi_add_handle(multi_handle_.get(), easy_handle);
+  if (result != CURLM_OK) {
+    logger_->log_error("Could not add request to %s to the multi handle: %s", client.getURL(), curl_multi_strerror(result));
+    return false;
+  }
+  pending_transfers_.emplace(easy_handle, &client);
+  return true;
+}
+
+void HTTPMultiClient::performAll(const std::function<void(HTTPClient&, bool)>& on_finished) {
+  const auto finish_transfer = [&](CURL* easy_handle, CURLcode result) {
+    const auto it = pending_transfers_.find(easy_handle);
+    if (it == pending_transfers_.end()) {
+      return;
+    }
+    HTTPClient& client = *it->second;
+    pending_transfers_.erase(it);
+    curl_multi_remove_handle(multi_handle_.get(), easy_handle);
+    on_finished(client, client.finishSubmit(result));
+  };
+  // if on_finished throws, the remaining requests must not be performed as part of the next batch
+  const auto remove_unfinished_transfers = gsl::finally([this] { removeAll(); });
+
+  int running_transfers = 0;
+  while (!pending_transfers_.empty()) {
+    auto multi_result = curl_multi_perform(multi_handle_.get(), &running_transfers);
+    if (multi_result == CURLM_OK) {
+      int remaining_messages = 0;
+      while (CURLMsg* message = curl_multi_info_read(multi_handle_.get(), &remaining_messages)) {
+        if (message->msg == CURLMSG_DONE) {
+          // the message is invalidated by removing its handle
+          finish_transfer(message->easy_handle, message->data.result);
+        }
+      }
+      if (running_transfers == 0 || pending_transfers_.empty()) {
+        continue;
+      }
+      multi_result = curl_multi_wait(multi_handle_.get(), nullptr, 0, MAX_WAIT_TIME_MS, nullptr);
+    }
+    if (multi_result != CURLM_OK) {
+      logger_->log_error("curl multi transfer failed: %s", curl_multi_strerror(multi_result));
+      while (!pending_transfers_.empty()) {
+        finish_transfer(pending_transfers_.begin()->first, CURLE_FAILED_INIT);
+      }
+    }
+  }
+}
+
+void HTTPMultiClient::CurlMultiCleanup::operator()(CURLM* multi_handle) const {
+  curl_multi_cleanup(multi_handle);
+}
+
+}  // namespace org::apache::nifi::minifi::extensions::curl
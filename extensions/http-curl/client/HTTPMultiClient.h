@@ -0,0 +1,66 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include "HTTPClient.h"
+
+namespace org::apache::nifi::minifi::extensions::curl {
+
+/**
+ * Performs the requests of several HTTPClients concurrently on a single thread, using the curl multi interface.
+ *
+ * The connections are kept in the connection cache of the multi handle between the calls to performAll, so consecutive
+ * batches of requests to the same host reuse them. If libcurl supports HTTP/2, requests to the same host are multiplexed
+ * on a single connection.
+ */
+class HTTPMultiClient {
+ public:
+  explicit HTTPMultiClient(size_t max_connections);
+
+  HTTPMultiClient(const HTTPMultiClient&) = delete;
+  HTTPMultiClient& operator=(const HTTPMultiClient&) = delete;
+
+  ~HTTPMultiClient();
+
+  /**
+   * Adds the request of the client to the next batch. The client has to outlive the call to performAll.
+   * @return false if the request cannot be submitted
+   */
+  bool add(HTTPClient& client);
+
+  /**
+   * Performs all added requests, and calls on_finished with the client and the result of the transfer as each of them finishes.
+   */
+  void performAll(const std::function<void(HTTPClient&, bool)>& on_finished);
+
+  static bool isHttp2Supported();
+
+ private:
+  void removeAll();
+
+  struct CurlMultiCleanup { void operator()(CURLM* multi_handle) const; };
+
+  std::unique_ptr<CURLM, CurlMultiCleanup> multi_handle_;
+  std::unordered_map<CURL*, HTTPClient*> pending_transfers_;
+  std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<HTTPMultiClient>::getLogger()};
+};
+
+}  // namespace org::apache::nifi::minifi::extensions::curl
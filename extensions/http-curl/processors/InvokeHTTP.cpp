@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -164,7 +165,29 @@ void InvokeHTTP::onSchedule(const std::shared_ptr<core::ProcessContext>& context
       return nullptr;
   };
 
-  client_queue_ = utils::ResourceQueue<extensions::curl::HTTPClient>::create(create_client, getMaxConcurrentTasks(), std::nullopt, logger_);
+  const auto max_concurrent_requests = context->getProperty<uint32_t>(MaxConcurrentRequests).value_or(1);
+  if (max_concurrent_requests == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Max Concurrent Requests must be at least 1");
+  }
+
+  client_queue_.reset();
+  concurrent_requests_queue_.reset();
+  if (max_concurrent_requests == 1) {
+    client_queue_ = utils::ResourceQueue<extensions::curl::HTTPClient>::create(create_client, getMaxConcurrentTasks(), std::nullopt, logger_);
+    return;
+  }
+
+  auto create_concurrent_requests = [create_client, max_concurrent_requests]() -> std::unique_ptr<ConcurrentRequests> {
+    auto requests = std::make_unique<ConcurrentRequests>(max_concurrent_requests);
+    for (uint32_t i = 0; i < max_concurrent_requests; ++i) {
+      auto client = create_client();
+      if (!client)
+        return nullptr;
+      requests->clients.push_back(std::move(client));
+    }
+    return requests;
+  };
+  concurrent_requests_queue_ = utils::ResourceQueue<ConcurrentRequests>::create(create_concurrent_requests, getMaxConcurrentTasks(), std::nullopt, logger_);
 }
 
 bool InvokeHTTP::shouldEmitFlowFile(minifi::extensions::curl::HTTPClient& client) {
@@ -206,7 +229,13 @@ bool InvokeHTTP::appendHeaders(const core::FlowFile& flow_file, /*std::invocable
 }
 
 void InvokeHTTP::onTrigger(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session) {
-  gsl_Expects(session && context && client_queue_);
+  gsl_Expects(session && context && (client_queue_ || concurrent_requests_queue_));
+
+  if (concurrent_requests_queue_) {
+    auto requests = concurrent_requests_queue_->getResource();
+    onTriggerWithConcurrentRequests(context, session, *requests);
+    return;
+  }
 
   auto client = client_queue_->getResource();
 
@@ -236,11 +265,66 @@ void InvokeHTTP::onTriggerWithClient(const std::shared_ptr<core::ProcessContext>
     client.setUploadCallback({});
   });
 
-  std::string transaction_id = utils::IdGenerator::getIdGenerator()->generate().to_string();
+  if (!prepareRequest(*session, flow_file, client)) {
+    return;
+  }
+
+  logger_->log_trace("InvokeHTTP -- curl performed");
+  processResponse(context, session, flow_file, client, client.submit());
+}
+
+void InvokeHTTP::onTriggerWithConcurrentRequests(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session,
+                                                 ConcurrentRequests& requests) {
+  gsl_Expects(!requests.clients.empty());
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  while (flow_files.size() < requests.clients.size()) {
+    auto flow_file = session->get();
+    if (!flow_file)
+      break;
+    flow_files.push_back(std::move(flow_file));
+  }
+
+  auto& first_client = *requests.clients.front();
+  if (flow_files.empty()) {
+    if (shouldEmitFlowFile(first_client)) {
+      logger_->log_debug("Exiting because method is %s and there is no flowfile available to execute it, yielding", first_client.getRequestMethod());
+      yield();
+      return;
+    }
+    logger_->log_debug("InvokeHTTP -- create flow file with  %s", first_client.getRequestMethod());
+    flow_files.push_back(session->create());
+  }
+
+  logger_->log_debug("onTrigger InvokeHTTP with %zu concurrent %s requests to %s", flow_files.size(), first_client.getRequestMethod(), first_client.getURL());
+
+  const auto remove_callbacks_from_clients_at_exit = gsl::finally([&requests] {
+    for (auto& client : requests.clients) {
+      client->setUploadCallback({});
+    }
+  });
 
+  std::unordered_map<const minifi::extensions::curl::HTTPClient*, std::shared_ptr<core::FlowFile>> flow_files_by_client;
+  for (size_t i = 0; i < flow_files.size(); ++i) {
+    auto& client = *requests.clients[i];
+    if (!prepareRequest(*session, flow_files[i], client)) {
+      continue;
+    }
+    if (!requests.multi_client.add(client)) {
+      processResponse(context, session, flow_files[i], client, false);
+      continue;
+    }
+    flow_files_by_client.emplace(&client, flow_files[i]);
+  }
+
+  requests.multi_client.performAll([&](minifi::extensions::curl::HTTPClient& client, bool submitted) {
+    processResponse(context, session, flow_files_by_client.at(&client), client, submitted);
+  });
+}
+
+bool InvokeHTTP::prepareRequest(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, minifi::extensions::curl::HTTPClient& client) {
   if (shouldEmitFlowFile(client)) {
     logger_->log_trace("InvokeHTTP -- reading flowfile");
-    const auto flow_file_reader_stream = session->getFlowFileContentStream(flow_file);
+    const auto flow_file_reader_stream = session.getFlowFileContentStream(flow_file);
     if (flow_file_reader_stream) {
       std::unique_ptr<utils::HTTPUploadCallback> callback_obj;
       if (send_message_body_) {
@@ -273,59 +357,64 @@ void InvokeHTTP::onTriggerWithClient(const std::shared_ptr<core::ProcessContext>
 
   const auto append_header = [&](const std::string& key, const std::string& value) { client.setRequestHeader(key, value); };
   if (!appendHeaders(*flow_file, append_header)) {
+    session.transfer(flow_file, RelFailure);
+    return false;
+  }
+  return true;
+}
+
+void InvokeHTTP::processResponse(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session,
+                                 const std::shared_ptr<core::FlowFile>& flow_file, minifi::extensions::curl::HTTPClient& client, bool submitted) {
+  if (!submitted) {
+    session->penalize(flow_file);
     session->transfer(flow_file, RelFailure);
     return;
   }
 
-  logger_->log_trace("InvokeHTTP -- curl performed");
-  if (client.submit()) {
-    logger_->log_trace("InvokeHTTP -- curl successful");
-
-    const std::vector<char>& response_body = client.getResponseBody();
-    const std::vector<std::string>& response_headers = client.getResponseHeaders();
-
-    int64_t http_code = client.getResponseCode();
-    const char* content_type = client.getContentType();
-    flow_file->addAttribute(std::string(STATUS_CODE), std::to_string(http_code));
-    if (!response_headers.empty()) { flow_file->addAttribute(std::string(STATUS_MESSAGE), response_headers.at(0)); }
-    flow_file->addAttribute(std::string(REQUEST_URL), client.getURL());
-    flow_file->addAttribute(std::string(TRANSACTION_ID), transaction_id);
-
-    bool is_success = ((http_code / 100) == 2);
-
-    logger_->log_debug("isSuccess: %d, response code %" PRId64, is_success, http_code);
-    std::shared_ptr<core::FlowFile> response_flow = nullptr;
-
-    if (is_success) {
-      if (!put_response_body_in_attribute_) {
-        if (flow_file != nullptr) {
-          response_flow = session->create(flow_file);
-        } else {
-          response_flow = session->create();
-        }
-
-        // if content type isn't returned we should return application/octet-stream
-        // as per RFC 2046 -- 4.5.1
-        response_flow->addAttribute(core::SpecialFlowAttribute::MIME_TYPE, content_type ? std::string(content_type) : DefaultContentType);
-        response_flow->addAttribute(std::string(STATUS_CODE), std::to_string(http_code));
-        if (!response_headers.empty()) { response_flow->addAttribute(std::string(STATUS_MESSAGE), response_headers.at(0)); }
-        response_flow->addAttribute(std::string(REQUEST_URL), client.getURL());
-        response_flow->addAttribute(std::string(TRANSACTION_ID), transaction_id);
-        io::BufferStream stream(gsl::make_span(response_body).as_span<const std::byte>());
-        // need an import from the data stream.
-        session->importFrom(stream, response_flow);
+  logger_->log_trace("InvokeHTTP -- curl successful");
+  std::string transaction_id = utils::IdGenerator::getIdGenerator()->generate().to_string();
+
+  const std::vector<char>& response_body = client.getResponseBody();
+  const std::vector<std::string>& response_headers = client.getResponseHeaders();
+
+  int64_t http_code = client.getResponseCode();
+  const char* content_type = client.getContentType();
+  flow_file->addAttribute(std::string(STATUS_CODE), std::to_string(http_code));
+  if (!response_headers.empty()) { flow_file->addAttribute(std::string(STATUS_MESSAGE), response_headers.at(0)); }
+  flow_file->addAttribute(std::string(REQUEST_URL), client.getURL());
+  flow_file->addAttribute(std::string(TRANSACTION_ID), transaction_id);
+
+  bool is_success = ((http_code / 100) == 2);
+
+  logger_->log_debug("isSuccess: %d, response code %" PRId64, is_success, http_code);
+  std::shared_ptr<core::FlowFile> response_flow = nullptr;
+
+  if (is_success) {
+    if (!put_response_body_in_attribute_) {
+      if (flow_file != nullptr) {
+        response_flow = session->create(flow_file);
       } else {
-        if (!response_body.empty()) {
-          std::string body_attribute_str{response_body.data(), response_body.size()};
-          flow_file->addAttribute(*put_response_body_in_attribute_, body_attribute_str);
-        }
+        response_flow = session->create();
+      }
+
+      // if content type isn't returned we should return application/octet-stream
+      // as per RFC 2046 -- 4.5.1
+      response_flow->addAttribute(core::SpecialFlowAttribute::MIME_TYPE, content_type ? std::string(content_type) : DefaultContentType);
+      response_flow->addAttribute(std::string(STATUS_CODE), std::to_string(http_code));
+      if (!response_headers.empty()) { response_flow->addAttribute(std::string(STATUS_MESSAGE), response_headers.at(0)); }
+      response_flow->addAttribute(std::string(REQUEST_URL), client.getURL());
+      response_flow->addAttribute(std::string(TRANSACTION_ID), transaction_id);
+      io::BufferStream stream(gsl::make_span(response_body).as_span<const std::byte>());
+      // need an import from the data stream.
+      session->importFrom(stream, response_flow);
+    } else {
+      if (!response_body.empty()) {
+        std::string body_attribute_str{response_body.data(), response_body.size()};
+        flow_file->addAttribute(*put_response_body_in_attribute_, body_attribute_str);
       }
     }
-    route(flow_file, response_flow, session, context, is_success, http_code);
-  } else {
-    session->penalize(flow_file);
-    session->transfer(flow_file, RelFailure);
   }
+  route(flow_file, response_flow, session, context, is_success, http_code);
 }
 
 void InvokeHTTP::route(const std::shared_ptr<core::FlowFile>& request, const std::shared_ptr<core::FlowFile>& response, const std::shared_ptr<core::ProcessSession>& session,
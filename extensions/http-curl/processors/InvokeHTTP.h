@@ -23,6 +23,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Core.h"
 #include "FlowFileRecord.h"
@@ -37,6 +38,7 @@
 #include "utils/Id.h"
 #include "utils/ResourceQueue.h"
 #include "../client/HTTPClient.h"
+#include "../client/HTTPMultiClient.h"
 #include "utils/Export.h"
 #include "utils/Enum.h"
 #include "utils/RegexUtils.h"
@@ -175,7 +177,16 @@ class InvokeHTTP : public core::Processor {
       .withAllowedValues(invoke_http::InvalidHTTPHeaderFieldHandlingOption::values)
       .build();
 
-  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 21>{
+  EXTENSIONAPI static constexpr auto MaxConcurrentRequests = core::PropertyDefinitionBuilder<>::createProperty("Max Concurrent Requests")
+      .withDescription("The maximum number of requests a single thread of the processor keeps in flight at the same time. "
+          "If greater than 1, up to this many FlowFiles are taken in every trigger, and their requests are performed concurrently, "
+          "reusing the connections to the server between triggers. Requests are multiplexed on HTTP/2 connections if the server and libcurl support it.")
+      .isRequired(true)
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("1")
+      .build();
+
+  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 22>{
         Method,
         URL,
         ConnectTimeout,
@@ -196,7 +207,8 @@ class InvokeHTTP : public core::Processor {
         PutResponseBodyInAttribute,
         AlwaysOutputResponse,
         PenalizeOnNoRetry,
-        InvalidHTTPHeaderFieldHandlingStrategy
+        InvalidHTTPHeaderFieldHandlingStrategy,
+        MaxConcurrentRequests
   };
 
 
@@ -253,10 +265,25 @@ class InvokeHTTP : public core::Processor {
   void onSchedule(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSessionFactory>& sessionFactory) override;
 
  private:
+  struct ConcurrentRequests {
+    explicit ConcurrentRequests(size_t max_requests) : multi_client(max_requests) {}
+
+    minifi::extensions::curl::HTTPMultiClient multi_client;
+    std::vector<std::unique_ptr<minifi::extensions::curl::HTTPClient>> clients;
+  };
+
   void route(const std::shared_ptr<core::FlowFile>& request, const std::shared_ptr<core::FlowFile>& response, const std::shared_ptr<core::ProcessSession>& session,
              const std::shared_ptr<core::ProcessContext>& context, bool is_success, int64_t status_code);
   static bool shouldEmitFlowFile(minifi::extensions::curl::HTTPClient& client);
   void onTriggerWithClient(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session, minifi::extensions::curl::HTTPClient& client);
+  void onTriggerWithConcurrentRequests(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session, ConcurrentRequests& requests);
+  /**
+   * Sets up the upload of the flow file and the request headers on the client.
+   * @return false if the flow file has been routed to failure
+   */
+  bool prepareRequest(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, minifi::extensions::curl::HTTPClient& client);
+  void processResponse(const std::shared_ptr<core::ProcessContext>& context, const std::shared_ptr<core::ProcessSession>& session, const std::shared_ptr<core::FlowFile>& flow_file,
+                       minifi::extensions::curl::HTTPClient& client, bool submitted);
   [[nodiscard]] bool appendHeaders(const core::FlowFile& flow_file, /*std::invocable<std::string, std::string>*/ auto append_header);
 
 
@@ -276,6 +303,7 @@ class InvokeHTTP : public core::Processor {
 
   std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<InvokeHTTP>::getLogger(uuid_)};
   std::shared_ptr<utils::ResourceQueue<extensions::curl::HTTPClient>> client_queue_;
+  std::shared_ptr<utils::ResourceQueue<ConcurrentRequests>> concurrent_requests_queue_;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -19,6 +19,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <set>
@@ -28,9 +30,26 @@ namespace org::apache::nifi::minifi::extensions::curl::testing {
 
 namespace details {
 
+class ConnectionIds {
+ public:
+  void add(const utils::SmallString<36>& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ids_.emplace(id);
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ids_.size();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::set<utils::SmallString<36>> ids_;
+};
+
 class NumberedMethodResponder : public CivetHandler {
  public:
-  explicit NumberedMethodResponder(std::set<utils::SmallString<36>>& connections) : connections_(connections) {}
+  explicit NumberedMethodResponder(ConnectionIds& connections) : connections_(connections) {}
 
   bool handleGet(CivetServer*, struct mg_connection* conn) override {
     sendNumberedMessage("GET", conn);
@@ -55,28 +74,28 @@ class NumberedMethodResponder : public CivetHandler {
  private:
   void sendNumberedMessage(std::string body, struct mg_connection* conn) {
     saveConnectionId(conn);
-    body.append(std::to_string(response_id_));
+    const uint64_t response_id = response_id_++;
+    body.append(std::to_string(response_id));
     mg_printf(conn, "HTTP/1.1 200 OK\r\n");
     mg_printf(conn, "Content-length: %lu\r\n", body.length());
-    mg_printf(conn, "Response-number: %" PRIu64 "\r\n", response_id_);
+    mg_printf(conn, "Response-number: %" PRIu64 "\r\n", response_id);
     mg_printf(conn, "\r\n");
     mg_printf(conn, body.data(), body.length());
-    ++response_id_;
   }
 
   void saveConnectionId(struct mg_connection* conn) {
     auto user_connection_data = reinterpret_cast<utils::SmallString<36>*>(mg_get_user_connection_data(conn));
     assert(user_connection_data);
-    connections_.emplace(*user_connection_data);
+    connections_.add(*user_connection_data);
   }
 
-  uint64_t response_id_ = 0;
-  std::set<utils::SmallString<36>>& connections_;
+  std::atomic<uint64_t> response_id_ = 0;
+  ConnectionIds& connections_;
 };
 
 class ReverseBodyPostHandler : public CivetHandler {
  public:
-  explicit ReverseBodyPostHandler(std::set<utils::SmallString<36>>& connections) : connections_(connections) {}
+  explicit ReverseBodyPostHandler(ConnectionIds& connections) : connections_(connections) {}
 
   bool handlePost(CivetServer* /*server*/, struct mg_connection* conn) override {
     saveConnectionId(conn);
@@ -97,10 +116,10 @@ class ReverseBodyPostHandler : public CivetHandler {
  private:
   void saveConnectionId(struct mg_connection* conn) {
     auto user_connection_data = reinterpret_cast<utils::SmallString<36>*>(mg_get_user_connection_data(conn));
-    connections_.emplace(*user_connection_data);
+    connections_.add(*user_connection_data);
   }
 
-  std::set<utils::SmallString<36>>& connections_;
+  ConnectionIds& connections_;
 };
 
 struct AddIdToUserConnectionData : public CivetCallbacks {
@@ -121,7 +140,8 @@ struct AddIdToUserConnectionData : public CivetCallbacks {
 
 class ConnectionCountingServer {
  public:
-  ConnectionCountingServer() {
+  explicit ConnectionCountingServer(size_t num_threads = 1)
+      : server_{getOptions(num_threads), &add_id_to_user_connection_data_} {
     server_.addHandler("/method", numbered_method_responder_);
     server_.addHandler("/reverse", reverse_body_post_handler_);
   }
@@ -135,15 +155,17 @@ class ConnectionCountingServer {
   }
 
  private:
-  static inline std::vector<std::string> options = {
+  static std::vector<std::string> getOptions(size_t num_threads) {
+    return {
       "enable_keep_alive", "yes",
       "keep_alive_timeout_ms", "15000",
-      "num_threads", "1",
+      "num_threads", std::to_string(num_threads),
       "listening_ports", "0"};
+  }
 
-  std::set<utils::SmallString<36>> connections_;
+  details::ConnectionIds connections_;
   details::AddIdToUserConnectionData add_id_to_user_connection_data_;
-  CivetServer server_{options, &add_id_to_user_connection_data_};
+  CivetServer server_;
   details::ReverseBodyPostHandler reverse_body_post_handler_{connections_};
   details::NumberedMethodResponder numbered_method_responder_{connections_};
 };
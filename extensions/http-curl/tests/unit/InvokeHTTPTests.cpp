@@ -514,4 +514,55 @@ TEST_CASE("Test Keepalive", "[InvokeHTTP]") {
   CHECK(1 == connection_counting_server.getConnectionCounter());
 }
 
+TEST_CASE("InvokeHTTP performs concurrent requests", "[InvokeHTTP]") {
+  using minifi::processors::InvokeHTTP;
+
+  auto invoke_http = std::make_shared<InvokeHTTP>("InvokeHTTP");
+  test::SingleProcessorTestController test_controller{invoke_http};
+
+  minifi::extensions::curl::testing::ConnectionCountingServer connection_counting_server{4};
+
+  invoke_http->setProperty(InvokeHTTP::Method, "POST");
+  invoke_http->setProperty(InvokeHTTP::URL, "http://localhost:" + connection_counting_server.getPort()  + "/reverse");
+  invoke_http->setProperty(InvokeHTTP::MaxConcurrentRequests, "4");
+
+  std::vector<InputFlowFileData> input_flow_files;
+  for (auto i = 0; i < 6; ++i) {
+    input_flow_files.push_back(InputFlowFileData{"data" + std::to_string(i)});
+  }
+  auto result = test_controller.trigger(std::move(input_flow_files));
+  CHECK(result.at(InvokeHTTP::RelFailure).empty());
+  CHECK(result.at(InvokeHTTP::RelNoRetry).empty());
+  CHECK(result.at(InvokeHTTP::RelRetry).empty());
+  CHECK(result.at(InvokeHTTP::Success).size() == 4);
+  REQUIRE(result.at(InvokeHTTP::RelResponse).size() == 4);
+
+  // the remaining flow files are processed in the next trigger, on the connections kept open from the previous one
+  const auto second_result = test_controller.trigger();
+  CHECK(second_result.at(InvokeHTTP::RelFailure).empty());
+  CHECK(second_result.at(InvokeHTTP::Success).size() == 2);
+  REQUIRE(second_result.at(InvokeHTTP::RelResponse).size() == 2);
+
+  std::set<std::string> response_bodies;
+  for (const auto& response : result.at(InvokeHTTP::RelResponse)) {
+    response_bodies.insert(test_controller.plan->getContent(response));
+  }
+  for (const auto& response : second_result.at(InvokeHTTP::RelResponse)) {
+    response_bodies.insert(test_controller.plan->getContent(response));
+  }
+  CHECK(response_bodies == std::set<std::string>{"0atad", "1atad", "2atad", "3atad", "4atad", "5atad"});
+  CHECK(connection_counting_server.getConnectionCounter() <= 4);
+}
+
+TEST_CASE("InvokeHTTP rejects zero Max Concurrent Requests", "[InvokeHTTP]") {
+  using minifi::processors::InvokeHTTP;
+
+  auto invoke_http = std::make_shared<InvokeHTTP>("InvokeHTTP");
+  test::SingleProcessorTestController test_controller{invoke_http};
+
+  invoke_http->setProperty(InvokeHTTP::URL, "http://localhost:8080/");
+  invoke_http->setProperty(InvokeHTTP::MaxConcurrentRequests, "0");
+  REQUIRE_THROWS_AS(test_controller.trigger(), minifi::Exception);
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -24,6 +24,7 @@
 #include <map>
 #include <deque>
 #include <utility>
+#include "utils/ProcessorConfigUtils.h"
 #include "utils/StringUtils.h"
 #include "core/ProcessContext.h"
 #include "core/ProcessSession.h"
@@ -78,6 +79,8 @@ void BinFiles::onSchedule(core::ProcessContext *context, core::ProcessSessionFac
   if (context->getProperty(BatchSize, batchSize_)) {
     logger_->log_debug("BinFiles: BatchSize [%" PRIu32 "]", batchSize_);
   }
+  bin_staging_ = bin_files::BinStaging::parse(utils::parsePropertyWithAllowableValuesOrThrow(*context, BinStaging.name, bin_files::BinStaging::values).c_str());
+  logger_->log_debug("BinFiles: BinStaging [%s]", bin_staging_.toString());
 }
 
 void BinFiles::preprocessFlowFile(core::ProcessContext* /*context*/, core::ProcessSession* /*session*/, const std::shared_ptr<core::FlowFile>& flow) {
@@ -242,8 +245,13 @@ void BinFiles::onTrigger(const std::shared_ptr<core::ProcessContext> &context, c
       context->yield();
       return;
     }
-    // assuming ownership over the incoming flowFile
-    session->transfer(flow, Self);
+    if (bin_staging_ == bin_files::BinStaging::IN_MEMORY) {
+      // the flowFile stays in the repository as part of the incoming connection until its bin is processed
+      session->detach(flow);
+    } else {
+      // assuming ownership over the incoming flowFile
+      session->transfer(flow, Self);
+    }
   }
 
   // migrate bin to ready bin
@@ -33,6 +33,7 @@
 #include "core/PropertyType.h"
 #include "core/RelationshipDefinition.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "utils/Enum.h"
 #include "utils/gsl.h"
 #include "utils/Id.h"
 #include "utils/Export.h"
@@ -40,6 +41,13 @@
 
 namespace org::apache::nifi::minifi::processors {
 
+namespace bin_files {
+SMART_ENUM(BinStaging,
+    (REPOSITORY, "Repository"),
+    (IN_MEMORY, "In Memory")
+)
+}  // namespace bin_files
+
 // Bin Class
 class Bin {
  public:
@@ -234,14 +242,23 @@ class BinFiles : public core::Processor {
       .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
       .withDefaultValue("1")
       .build();
-  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 7>{
+  EXTENSIONAPI static constexpr auto BinStaging = core::PropertyDefinitionBuilder<bin_files::BinStaging::length>::createProperty("Bin Staging")
+      .withDescription("Repository: every FlowFile added to a bin is persisted to the FlowFile Repository as owned by this processor. "
+          "In Memory: binned FlowFiles are only held in memory and keep the record they had in the incoming connection, so binning them needs no repository writes; "
+          "after a restart, the FlowFiles of bins which were not processed yet are received again from the incoming connection.")
+      .isRequired(true)
+      .withDefaultValue(toStringView(bin_files::BinStaging::REPOSITORY))
+      .withAllowedValues(bin_files::BinStaging::values)
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 8>{
       MinSize,
       MaxSize,
       MinEntries,
       MaxEntries,
       MaxBinCount,
       MaxBinAge,
-      BatchSize
+      BatchSize,
+      BinStaging
   };
 
 
@@ -304,6 +321,7 @@ class BinFiles : public core::Processor {
   std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<BinFiles>::getLogger(uuid_)};
   uint32_t batchSize_{1};
   uint32_t maxBinCount_{100};
+  bin_files::BinStaging bin_staging_ = bin_files::BinStaging::REPOSITORY;
   core::FlowFileStore file_store_;
 };
 
@@ -37,14 +37,18 @@ const std::map<std::string, io::CompressionFormat> CompressContent::compressionF
   {"application/bzip2", io::CompressionFormat::BZIP2},
   {"application/x-bzip2", io::CompressionFormat::BZIP2},
   {"application/x-lzma", io::CompressionFormat::LZMA},
-  {"application/x-xz", io::CompressionFormat::XZ_LZMA2}
+  {"application/x-xz", io::CompressionFormat::XZ_LZMA2},
+  {"application/zstd", io::CompressionFormat::ZSTD},
+  {"application/x-lz4-framed", io::CompressionFormat::LZ4}
 };
 
 const std::map<io::CompressionFormat, std::string> CompressContent::fileExtension_{
   {io::CompressionFormat::GZIP, ".gz"},
   {io::CompressionFormat::LZMA, ".lzma"},
   {io::CompressionFormat::BZIP2, ".bz2"},
-  {io::CompressionFormat::XZ_LZMA2, ".xz"}
+  {io::CompressionFormat::XZ_LZMA2, ".xz"},
+  {io::CompressionFormat::ZSTD, ".zst"},
+  {io::CompressionFormat::LZ4, ".lz4"}
 };
 
 void CompressContent::initialize() {
@@ -59,9 +63,11 @@ void CompressContent::onSchedule(core::ProcessContext *context, core::ProcessSes
   context->getProperty(UpdateFileName, updateFileName_);
   context->getProperty(EncapsulateInTar, encapsulateInTar_);
   context->getProperty(BatchSize, batchSize_);
+  context->getProperty(ZstdWorkerCount, zstdWorkerCount_);
+  context->getProperty(ZstdLongDistanceMatching, zstdLongDistanceMatching_);
 
-  logger_->log_info("Compress Content: Mode [%s] Format [%s] Level [%d] UpdateFileName [%d] EncapsulateInTar [%d]",
-      compressMode_.toString(), compressFormat_.toString(), compressLevel_, updateFileName_, encapsulateInTar_);
+  logger_->log_info("Compress Content: Mode [%s] Format [%s] Level [%d] UpdateFileName [%d] EncapsulateInTar [%d] ZstdWorkerCount [%" PRIu32 "] ZstdLongDistanceMatching [%d]",
+      compressMode_.toString(), compressFormat_.toString(), compressLevel_, updateFileName_, encapsulateInTar_, zstdWorkerCount_, zstdLongDistanceMatching_);
 }
 
 void CompressContent::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
@@ -106,8 +112,14 @@ void CompressContent::processFlowFile(const std::shared_ptr<core::FlowFile>& flo
   std::string mimeType = toMimeType(compressFormat);
 
   // Validate
-  if (!encapsulateInTar_ && compressFormat != io::CompressionFormat::GZIP) {
-    logger_->log_error("non-TAR encapsulated format only supports GZIP compression");
+  const bool isFilterStreamFormat = compressFormat == io::CompressionFormat::GZIP || compressFormat == io::CompressionFormat::ZSTD || compressFormat == io::CompressionFormat::LZ4;
+  if (!encapsulateInTar_ && !isFilterStreamFormat) {
+    logger_->log_error("non-TAR encapsulated format only supports GZIP, ZSTD and LZ4 compression");
+    session->transfer(flowFile, Failure);
+    return;
+  }
+  if (encapsulateInTar_ && (compressFormat == io::CompressionFormat::ZSTD || compressFormat == io::CompressionFormat::LZ4)) {
+    logger_->log_error("%s compression is only supported without TAR encapsulation", compressFormat.toString());
     session->transfer(flowFile, Failure);
     return;
   }
@@ -163,7 +175,7 @@ void CompressContent::processFlowFile(const std::shared_ptr<core::FlowFile>& flo
       });
     });
   } else {
-    CompressContent::GzipWriteCallback callback(compressMode_, compressLevel_, flowFile, session);
+    CompressContent::FilterStreamWriteCallback callback(compressMode_, compressFormat, compressLevel_, zstdWorkerCount_, zstdLongDistanceMatching_, flowFile, session);
     session->write(result, std::ref(callback));
     success = callback.success_;
   }
@@ -207,6 +219,8 @@ std::string CompressContent::toMimeType(io::CompressionFormat format) {
     case io::CompressionFormat::BZIP2: return "application/bzip2";
     case io::CompressionFormat::LZMA: return "application/x-lzma";
     case io::CompressionFormat::XZ_LZMA2: return "application/x-xz";
+    case io::CompressionFormat::ZSTD: return "application/zstd";
+    case io::CompressionFormat::LZ4: return "application/x-lz4-framed";
   }
   throw Exception(GENERAL_EXCEPTION, "Invalid compression format");
 }
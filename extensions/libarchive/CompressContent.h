@@ -37,7 +37,9 @@
 #include "core/PropertyDefinition.h"
 #include "core/PropertyDefinitionBuilder.h"
 #include "core/logging/LoggerConfiguration.h"
+#include "io/Lz4Stream.h"
 #include "io/ZlibStream.h"
+#include "io/ZstdStream.h"
 #include "utils/Enum.h"
 #include "utils/gsl.h"
 #include "utils/Export.h"
@@ -52,7 +54,7 @@ SMART_ENUM(CompressionMode,
   (Decompress, "decompress")
 )
 
-SMART_ENUM_EXTEND(ExtendedCompressionFormat, io::CompressionFormat, (GZIP, LZMA, XZ_LZMA2, BZIP2),
+SMART_ENUM_EXTEND(ExtendedCompressionFormat, io::CompressionFormat, (GZIP, LZMA, XZ_LZMA2, BZIP2, ZSTD, LZ4),
   (USE_MIME_TYPE, "use mime.type attribute")
 )
 }  // namespace compress_content
@@ -74,7 +76,8 @@ class CompressContent : public core::Processor {
       .withDefaultValue(toStringView(compress_content::CompressionMode::Compress))
       .build();
   EXTENSIONAPI static constexpr auto CompressLevel = core::PropertyDefinitionBuilder<>::createProperty("Compression Level")
-      .withDescription("The compression level to use; this is valid only when using GZIP compression.")
+      .withDescription("The compression level to use; this is valid only when using GZIP (0-9), zstd (negative levels for faster compression, up to 22) "
+          "or LZ4 (0-12, levels from 3 up use the high compression mode) compression.")
       .isRequired(false)
       .withPropertyType(core::StandardPropertyTypes::INTEGER_TYPE)
       .withDefaultValue("1")
@@ -105,13 +108,26 @@ class CompressContent : public core::Processor {
       .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
       .withDefaultValue("1")
       .build();
-  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 6>{
+  EXTENSIONAPI static constexpr auto ZstdWorkerCount = core::PropertyDefinitionBuilder<>::createProperty("Zstd Worker Count")
+      .withDescription("Number of threads compressing the content in parallel when using zstd compression. 0 compresses on the thread running the processor.")
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("0")
+      .build();
+  EXTENSIONAPI static constexpr auto ZstdLongDistanceMatching = core::PropertyDefinitionBuilder<>::createProperty("Zstd Long Distance Matching")
+      .withDescription("Enables long distance matching when using zstd compression, which improves the compression ratio of large content "
+          "with repetitions far apart, at the cost of more memory.")
+      .withPropertyType(core::StandardPropertyTypes::BOOLEAN_TYPE)
+      .withDefaultValue("false")
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 8>{
       CompressMode,
       CompressLevel,
       CompressFormat,
       UpdateFileName,
       EncapsulateInTar,
-      BatchSize
+      BatchSize,
+      ZstdWorkerCount,
+      ZstdLongDistanceMatching
   };
 
 
@@ -128,29 +144,54 @@ class CompressContent : public core::Processor {
 
   static const std::string TAR_EXT;
 
-  class GzipWriteCallback {
+  // Compresses or decompresses the content without TAR encapsulation, using the filter streams of libminifi
+  class FilterStreamWriteCallback {
    public:
-    GzipWriteCallback(compress_content::CompressionMode compress_mode, int compress_level, std::shared_ptr<core::FlowFile> flow, std::shared_ptr<core::ProcessSession> session)
+    FilterStreamWriteCallback(compress_content::CompressionMode compress_mode, io::CompressionFormat compress_format, int compress_level,
+        uint32_t zstd_worker_count, bool zstd_long_distance_matching, std::shared_ptr<core::FlowFile> flow, std::shared_ptr<core::ProcessSession> session)
       : compress_mode_(compress_mode)
+      , compress_format_(compress_format)
       , compress_level_(compress_level)
+      , zstd_worker_count_(zstd_worker_count)
+      , zstd_long_distance_matching_(zstd_long_distance_matching)
       , flow_(std::move(flow))
       , session_(std::move(session)) {
     }
 
     std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<CompressContent>::getLogger();
     compress_content::CompressionMode compress_mode_;
+    io::CompressionFormat compress_format_;
     int compress_level_;
+    uint32_t zstd_worker_count_;
+    bool zstd_long_distance_matching_;
     std::shared_ptr<core::FlowFile> flow_;
     std::shared_ptr<core::ProcessSession> session_;
     bool success_{false};
 
     int64_t operator()(const std::shared_ptr<io::OutputStream>& output_stream) {
-      std::shared_ptr<io::ZlibBaseStream> filterStream;
-      if (compress_mode_ == compress_content::CompressionMode::Compress) {
-        filterStream = std::make_shared<io::ZlibCompressStream>(gsl::make_not_null(output_stream.get()), io::ZlibCompressionFormat::GZIP, compress_level_);
-      } else {
-        filterStream = std::make_shared<io::ZlibDecompressStream>(gsl::make_not_null(output_stream.get()), io::ZlibCompressionFormat::GZIP);
+      const auto output = gsl::make_not_null(output_stream.get());
+      const bool compress = compress_mode_ == compress_content::CompressionMode::Compress;
+      if (compress_format_ == io::CompressionFormat::ZSTD) {
+        if (compress) {
+          return filter(io::ZstdCompressStream(output, compress_level_, zstd_worker_count_, zstd_long_distance_matching_));
+        }
+        return filter(io::ZstdDecompressStream(output));
       }
+      if (compress_format_ == io::CompressionFormat::LZ4) {
+        if (compress) {
+          return filter(io::Lz4CompressStream(output, compress_level_));
+        }
+        return filter(io::Lz4DecompressStream(output));
+      }
+      if (compress) {
+        return filter(io::ZlibCompressStream(output, io::ZlibCompressionFormat::GZIP, compress_level_));
+      }
+      return filter(io::ZlibDecompressStream(output, io::ZlibCompressionFormat::GZIP));
+    }
+
+   private:
+    template<typename FilterStream>
+    int64_t filter(FilterStream&& filterStream) {
       session_->read(flow_, [this, &filterStream](const std::shared_ptr<io::InputStream>& input_stream) -> int64_t {
         std::vector<std::byte> buffer(16 * 1024U);
         size_t read_size = 0;
@@ -161,18 +202,18 @@ class CompressContent : public core::Processor {
           } else if (ret == 0) {
             break;
           } else {
-            const auto writeret = filterStream->write(gsl::make_span(buffer).subspan(0, ret));
+            const auto writeret = filterStream.write(gsl::make_span(buffer).subspan(0, ret));
             if (io::isError(writeret) || gsl::narrow<size_t>(writeret) != ret) {
               return -1;
             }
             read_size += ret;
           }
         }
-        filterStream->close();
+        filterStream.close();
         return gsl::narrow<int64_t>(read_size);
       });
 
-      success_ = filterStream->isFinished();
+      success_ = filterStream.isFinished();
 
       return gsl::narrow<int64_t>(flow_->getSize());
     }
@@ -205,6 +246,8 @@ class CompressContent : public core::Processor {
   bool updateFileName_ = false;
   bool encapsulateInTar_ = false;
   uint32_t batchSize_{1};
+  uint32_t zstdWorkerCount_{0};
+  bool zstdLongDistanceMatching_ = false;
   static const std::map<std::string, io::CompressionFormat> compressionFormatMimeTypeMap_;
   static const std::map<io::CompressionFormat, std::string> fileExtension_;
 };
@@ -35,7 +35,9 @@ SMART_ENUM(CompressionFormat,
   (GZIP, "gzip"),
   (LZMA, "lzma"),
   (XZ_LZMA2, "xz-lzma2"),
-  (BZIP2, "bzip2")
+  (BZIP2, "bzip2"),
+  (ZSTD, "zstd"),
+  (LZ4, "lz4")
 )
 
 class WriteArchiveStreamImpl: public WriteArchiveStream {
@@ -19,11 +19,14 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <tuple>
 
 #include "core/ProcessSession.h"
 #include "core/PropertyType.h"
 #include "core/Resource.h"
 #include "FlowFileRecord.h"
+#include "io/OutputStream.h"
 #include "utils/ProcessorConfigUtils.h"
 #include "utils/gsl.h"
 
@@ -68,6 +71,19 @@ void ConsumeKafka::onSchedule(core::ProcessContext* context, core::ProcessSessio
   headers_to_add_as_attributes_ = utils::listFromCommaSeparatedProperty(*context, HeadersToAddAsAttributes.name);
   max_poll_records_ = gsl::narrow<std::size_t>(context->getProperty<uint64_t>(MaxPollRecords).value_or(core::StandardPropertyTypes::UNSIGNED_LONG_TYPE.parse(DEFAULT_MAX_POLL_RECORDS)));
 
+  max_bundle_message_count_ = gsl::narrow<std::size_t>(context->getProperty<uint64_t>(MaxBundleMessageCount)
+      .value_or(core::StandardPropertyTypes::UNSIGNED_LONG_TYPE.parse(DEFAULT_MAX_BUNDLE_MESSAGE_COUNT)));
+  if (max_bundle_message_count_ == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Max Bundle Message Count must be at least 1");
+  }
+  if (max_bundle_message_count_ > 1 && !message_demarcator_.empty()) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Bundling messages cannot be combined with splitting them using the Message Demarcator property");
+  }
+  if (auto max_bundle_size = context->getProperty<core::DataSizeValue>(MaxBundleSize)) {
+    max_bundle_size_ = max_bundle_size->getValue();
+  }
+  context->getProperty(BundleDemarcator, bundle_demarcator_);
+
   if (!utils::StringUtils::equalsIgnoreCase(KEY_ATTR_ENCODING_UTF_8, key_attribute_encoding_) && !utils::StringUtils::equalsIgnoreCase(KEY_ATTR_ENCODING_HEX, key_attribute_encoding_)) {
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Unsupported key attribute encoding: " + key_attribute_encoding_);
   }
@@ -317,12 +333,14 @@ std::vector<std::pair<std::string, std::string>> ConsumeKafka::get_flowfile_attr
   return attributes_from_headers;
 }
 
-void ConsumeKafka::add_kafka_attributes_to_flowfile(std::shared_ptr<FlowFileRecord>& flow_file, const rd_kafka_message_t& message) const {
-  // We do not currently support batching messages into a single flowfile
-  flow_file->setAttribute(KAFKA_COUNT_ATTR, "1");
-  const std::optional<std::string> message_key = utils::get_encoded_message_key(message, key_attr_encoding_attr_to_enum());
-  if (message_key) {
-    flow_file->setAttribute(KAFKA_MESSAGE_KEY_ATTR, message_key.value());
+void ConsumeKafka::add_kafka_attributes_to_flowfile(std::shared_ptr<FlowFileRecord>& flow_file, const rd_kafka_message_t& message, std::size_t message_count) const {
+  flow_file->setAttribute(KAFKA_COUNT_ATTR, std::to_string(message_count));
+  // the keys of the bundled messages may differ, so the key is only meaningful for a single message
+  if (message_count == 1) {
+    const std::optional<std::string> message_key = utils::get_encoded_message_key(message, key_attr_encoding_attr_to_enum());
+    if (message_key) {
+      flow_file->setAttribute(KAFKA_MESSAGE_KEY_ATTR, message_key.value());
+    }
   }
   flow_file->setAttribute(KAFKA_OFFSET_ATTR, std::to_string(message.offset));
   flow_file->setAttribute(KAFKA_PARTITION_ATTR, std::to_string(message.partition));
@@ -330,6 +348,9 @@ void ConsumeKafka::add_kafka_attributes_to_flowfile(std::shared_ptr<FlowFileReco
 }
 
 std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> ConsumeKafka::transform_pending_messages_into_flowfiles(core::ProcessSession& session) const {
+  if (max_bundle_message_count_ > 1) {
+    return bundle_pending_messages_into_flowfiles(session);
+  }
   std::vector<std::shared_ptr<FlowFileRecord>> flow_files_created;
   for (const auto& message : pending_messages_) {
     std::string message_content = extract_message(*message);
@@ -356,6 +377,91 @@ std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> ConsumeKafka::transf
   return { flow_files_created };
 }
 
+std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> ConsumeKafka::bundle_pending_messages_into_flowfiles(core::ProcessSession& session) const {
+  struct Bundle {
+    std::vector<const rd_kafka_message_t*> messages;
+    uint64_t size = 0;
+    std::vector<std::pair<std::string, std::string>> attributes_from_headers;
+  };
+  using BundleKey = std::tuple<std::string, int32_t, std::vector<std::pair<std::string, std::string>>>;
+
+  std::vector<Bundle> bundles;
+  // the last bundle of each topic, partition and header attributes, messages can only be added to this one
+  std::map<BundleKey, std::size_t> open_bundle_indices;
+  for (const auto& message : pending_messages_) {
+    if (RD_KAFKA_RESP_ERR_NO_ERROR != message->err) {
+      throw minifi::Exception(ExceptionType::PROCESSOR_EXCEPTION, "ConsumeKafka: received error message from broker: " + std::to_string(message->err) + " " + rd_kafka_err2str(message->err));
+    }
+    auto attributes_from_headers = get_flowfile_attributes_from_message_header(*message);
+    BundleKey key{rd_kafka_topic_name(message->rkt), message->partition, attributes_from_headers};
+    const uint64_t size_with_demarcator = message->len + bundle_demarcator_.size();
+    const auto open_bundle = open_bundle_indices.find(key);
+    if (open_bundle != open_bundle_indices.end()) {
+      auto& bundle = bundles[open_bundle->second];
+      if (bundle.messages.size() < max_bundle_message_count_ && bundle.size + size_with_demarcator <= max_bundle_size_) {
+        bundle.messages.push_back(message.get());
+        bundle.size += size_with_demarcator;
+        continue;
+      }
+    }
+    open_bundle_indices.insert_or_assign(std::move(key), bundles.size());
+    bundles.push_back(Bundle{.messages = {message.get()}, .size = message->len, .attributes_from_headers = std::move(attributes_from_headers)});
+  }
+
+  std::vector<std::shared_ptr<FlowFileRecord>> flow_files_created;
+  for (const auto& bundle : bundles) {
+    std::shared_ptr<FlowFileRecord> flow_file = std::static_pointer_cast<FlowFileRecord>(session.create());
+    if (flow_file == nullptr) {
+      logger_->log_error("Failed to create flowfile.");
+      // Either transform all flowfiles or none
+      return {};
+    }
+    // the payloads are written directly from the messages, each bundle is a single content claim
+    session.write(flow_file, [this, &bundle](const std::shared_ptr<io::OutputStream>& stream) -> int64_t {
+      uint64_t written = 0;
+      for (const auto* message : bundle.messages) {
+        if (written > 0 && !bundle_demarcator_.empty()) {
+          if (io::isError(stream->write(reinterpret_cast<const uint8_t*>(bundle_demarcator_.data()), bundle_demarcator_.size()))) {
+            return -1;
+          }
+          written += bundle_demarcator_.size();
+        }
+        if (message->len > 0) {
+          if (io::isError(stream->write(static_cast<const uint8_t*>(message->payload), message->len))) {
+            return -1;
+          }
+          written += message->len;
+        }
+      }
+      return gsl::narrow<int64_t>(written);
+    });
+    for (const auto& [attribute_key, attribute_value] : bundle.attributes_from_headers) {
+      flow_file->setAttribute(attribute_key, attribute_value);
+    }
+    add_kafka_attributes_to_flowfile(flow_file, *bundle.messages.front(), bundle.messages.size());
+    flow_files_created.emplace_back(std::move(flow_file));
+  }
+  return { flow_files_created };
+}
+
+void ConsumeKafka::commit_offsets_of_pending_messages() {
+  // The messages may come from several partitions, the position of each of them has to be committed
+  std::unique_ptr<rd_kafka_topic_partition_list_t, utils::rd_kafka_topic_partition_list_deleter> offsets{
+      rd_kafka_topic_partition_list_new(gsl::narrow<int>(pending_messages_.size())), utils::rd_kafka_topic_partition_list_deleter()};
+  for (const auto& message : pending_messages_) {
+    const char* topic_name = rd_kafka_topic_name(message->rkt);
+    rd_kafka_topic_partition_t* partition = rd_kafka_topic_partition_list_find(offsets.get(), topic_name, message->partition);
+    if (partition == nullptr) {
+      partition = rd_kafka_topic_partition_list_add(offsets.get(), topic_name, message->partition);
+    }
+    // The committed offset is the offset of the next message to be consumed
+    partition->offset = std::max(partition->offset, message->offset + 1);
+  }
+  const rd_kafka_resp_err_t commit_response = rd_kafka_commit(consumer_.get(), offsets.get(), /* async = */ 0);
+  if (RD_KAFKA_RESP_ERR_NO_ERROR != commit_response) {
+    logger_->log_error("Committing offset failed: %d: %s", commit_response, rd_kafka_err2str(commit_response));
+  }
+}
 
 void ConsumeKafka::process_pending_messages(core::ProcessSession& session) {
   std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> flow_files_created = transform_pending_messages_into_flowfiles(session);
@@ -365,11 +471,9 @@ void ConsumeKafka::process_pending_messages(core::ProcessSession& session) {
   for (const auto& flow_file : flow_files_created.value()) {
     session.transfer(flow_file, Success);
   }
+  // The offsets are only committed once the flowfiles are persisted, so that no message is lost if the session commit fails
   session.commit();
-  // Commit the offset from the latest message only
-  if (RD_KAFKA_RESP_ERR_NO_ERROR != rd_kafka_commit_message(consumer_.get(), pending_messages_.back().get(), /* async = */ 0)) {
-    logger_->log_error("Committing offset failed.");
-  }
+  commit_offsets_of_pending_messages();
   pending_messages_.clear();
 }
 
@@ -81,7 +81,7 @@ class ConsumeKafka : public KafkaProcessorBase {
   static constexpr std::string_view MSG_HEADER_COMMA_SEPARATED_MERGE = "Comma-separated Merge";
 
   // Flowfile attributes written
-  static constexpr std::string_view KAFKA_COUNT_ATTR = "kafka.count";  // Always 1 until we start supporting merging from batches
+  static constexpr std::string_view KAFKA_COUNT_ATTR = "kafka.count";  // The number of messages bundled into the flowfile
   static constexpr std::string_view KAFKA_MESSAGE_KEY_ATTR = "kafka.key";
   static constexpr std::string_view KAFKA_OFFSET_ATTR = "kafka.offset";
   static constexpr std::string_view KAFKA_PARTITION_ATTR = "kafka.partition";
@@ -89,6 +89,7 @@ class ConsumeKafka : public KafkaProcessorBase {
 
   static constexpr std::string_view DEFAULT_MAX_POLL_RECORDS = "10000";
   static constexpr std::string_view DEFAULT_MAX_POLL_TIME = "4 seconds";
+  static constexpr std::string_view DEFAULT_MAX_BUNDLE_MESSAGE_COUNT = "1";
 
   static constexpr const std::size_t METADATA_COMMUNICATIONS_TIMEOUT_MS{ 60000 };
 
@@ -190,7 +191,28 @@ class ConsumeKafka : public KafkaProcessorBase {
       .withPropertyType(core::StandardPropertyTypes::TIME_PERIOD_TYPE)
       .withDefaultValue("60 seconds")
       .build();
-  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(KafkaProcessorBase::Properties, std::array<core::PropertyReference, 14>{
+  EXTENSIONAPI static constexpr auto MaxBundleMessageCount = core::PropertyDefinitionBuilder<>::createProperty("Max Bundle Message Count")
+      .withDescription("The maximum number of Kafka messages written into a single FlowFile. Messages received in the same poll are bundled together "
+          "if they come from the same topic and partition and have the same header attributes. The FlowFile gets the offset of its first message, "
+          "and the 'kafka.key' attribute is only added to FlowFiles with a single message. If set to 1, every message results in its own FlowFile. "
+          "Bundling cannot be combined with the Message Demarcator property.")
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue(DEFAULT_MAX_BUNDLE_MESSAGE_COUNT)
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto MaxBundleSize = core::PropertyDefinitionBuilder<>::createProperty("Max Bundle Size")
+      .withDescription("The maximum size of the content of a FlowFile bundling multiple Kafka messages. A message larger than this is written into a FlowFile of its own. "
+          "Only used if Max Bundle Message Count is greater than 1.")
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("1 MB")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto BundleDemarcator = core::PropertyDefinitionBuilder<>::createProperty("Bundle Demarcator")
+      .withDescription("The string (interpreted as UTF-8) written between the Kafka messages bundled into the same FlowFile. If not set, the messages are concatenated. "
+          "Only used if Max Bundle Message Count is greater than 1.")
+      .supportsExpressionLanguage(true)
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(KafkaProcessorBase::Properties, std::array<core::PropertyReference, 17>{
       KafkaBrokers,
       TopicNames,
       TopicNameFormat,
@@ -204,7 +226,10 @@ class ConsumeKafka : public KafkaProcessorBase {
       DuplicateHeaderHandling,
       MaxPollRecords,
       MaxPollTime,
-      SessionTimeout
+      SessionTimeout,
+      MaxBundleMessageCount,
+      MaxBundleSize,
+      BundleDemarcator
   });
 
 
@@ -239,8 +264,10 @@ class ConsumeKafka : public KafkaProcessorBase {
   std::string resolve_duplicate_headers(const std::vector<std::string>& matching_headers) const;
   std::vector<std::string> get_matching_headers(const rd_kafka_message_t& message, const std::string& header_name) const;
   std::vector<std::pair<std::string, std::string>> get_flowfile_attributes_from_message_header(const rd_kafka_message_t& message) const;
-  void add_kafka_attributes_to_flowfile(std::shared_ptr<FlowFileRecord>& flow_file, const rd_kafka_message_t& message) const;
+  void add_kafka_attributes_to_flowfile(std::shared_ptr<FlowFileRecord>& flow_file, const rd_kafka_message_t& message, std::size_t message_count = 1) const;
   std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> transform_pending_messages_into_flowfiles(core::ProcessSession& session) const;
+  std::optional<std::vector<std::shared_ptr<FlowFileRecord>>> bundle_pending_messages_into_flowfiles(core::ProcessSession& session) const;
+  void commit_offsets_of_pending_messages();
   void process_pending_messages(core::ProcessSession& session);
 
   std::string kafka_brokers_;
@@ -257,6 +284,9 @@ class ConsumeKafka : public KafkaProcessorBase {
   std::size_t max_poll_records_{};
   std::chrono::milliseconds max_poll_time_milliseconds_{};
   std::chrono::milliseconds session_timeout_milliseconds_{};
+  std::size_t max_bundle_message_count_{1};
+  uint64_t max_bundle_size_{};
+  std::string bundle_demarcator_;
 
   std::unique_ptr<rd_kafka_t, utils::rd_kafka_consumer_deleter> consumer_;
   std::unique_ptr<rd_kafka_conf_t, utils::rd_kafka_conf_deleter> conf_;
@@ -22,6 +22,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <span>
 #include <type_traits>
 #include <vector>
 
@@ -196,11 +197,15 @@ class ReadCallback {
     return rd_kafka_headers_unique_ptr{ result };
   }
 
-  rd_kafka_resp_err_t produce(const size_t segment_num, std::vector<std::byte>& buffer, const size_t buflen) const {
+  /**
+   * Enqueues the payload without copying it. The payload has to stay valid until the delivery report, so payload_owner
+   * is kept alive by the delivery callback, and released when the message is delivered or failed to be enqueued.
+   */
+  rd_kafka_resp_err_t produce(const size_t segment_num, std::span<const std::byte> payload, std::shared_ptr<const void> payload_owner) const {
     const std::shared_ptr<PublishKafka::Messages> messages_ptr_copy = this->messages_;
     const auto flow_file_index_copy = this->flow_file_index_;
     const auto logger = logger_;
-    const auto produce_callback = [messages_ptr_copy, flow_file_index_copy, segment_num, logger](rd_kafka_t * /*rk*/, const rd_kafka_message_t *rkmessage) {
+    const auto produce_callback = [messages_ptr_copy, flow_file_index_copy, segment_num, logger, payload_owner = std::move(payload_owner)](rd_kafka_t * /*rk*/, const rd_kafka_message_t *rkmessage) {
       messages_ptr_copy->modifyResult(flow_file_index_copy, [segment_num, rkmessage, logger, flow_file_index_copy](FlowFileResult &flow_file) {
         auto &message = flow_file.messages.at(segment_num);
         message.err_code = rkmessage->err;
@@ -218,7 +223,9 @@ class ReadCallback {
     allocate_message_object(segment_num);
 
     const gsl::owner<rd_kafka_headers_t*> hdrs_copy = rd_kafka_headers_copy(hdrs.get());
-    const auto err = rd_kafka_producev(rk_, RD_KAFKA_V_RKT(rkt_), RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA), RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY), RD_KAFKA_V_VALUE(buffer.data(), buflen),
+    // no RD_KAFKA_MSG_F_COPY: librdkafka refers to the payload until the delivery report, without copying it
+    const auto err = rd_kafka_producev(rk_, RD_KAFKA_V_RKT(rkt_), RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA), RD_KAFKA_V_MSGFLAGS(0),
+        RD_KAFKA_V_VALUE(const_cast<std::byte*>(payload.data()), payload.size()),
         RD_KAFKA_V_HEADERS(hdrs_copy), RD_KAFKA_V_KEY(key_.c_str(), key_.size()), RD_KAFKA_V_OPAQUE(callback_ptr.get()), RD_KAFKA_V_END);
     if (err == RD_KAFKA_RESP_ERR_NO_ERROR) {
       // in case of failure, messageDeliveryCallback is not called and callback_ptr will delete the callback
@@ -232,6 +239,43 @@ class ReadCallback {
     return err;
   }
 
+  void start() {
+    read_size_ = 0;
+    status_ = 0;
+    called_ = true;
+
+    gsl_Expects(max_seg_size_ != 0 || (flow_size_ == 0 && "max_seg_size_ == 0 implies flow_size_ == 0"));
+    // ^^ therefore checking max_seg_size_ == 0 handles both division by zero and flow_size_ == 0 cases
+    const size_t reserved_msg_capacity = max_seg_size_ == 0 ? 1 : utils::intdiv_ceil(flow_size_, max_seg_size_);
+    messages_->modifyResult(flow_file_index_, [reserved_msg_capacity](FlowFileResult& flow_file) {
+      flow_file.messages.reserve(reserved_msg_capacity);
+    });
+  }
+
+  void produceEmptyMessage() {
+    const auto err = produce(0, {}, nullptr);
+    if (err != RD_KAFKA_RESP_ERR_NO_ERROR) {
+      status_ = -1;
+      error_ = rd_kafka_err2str(err);
+    }
+  }
+
+  bool produceSegment(const size_t segment_num, std::span<const std::byte> payload, std::shared_ptr<const void> payload_owner) {
+    const auto err = produce(segment_num, payload, std::move(payload_owner));
+    if (err) {
+      messages_->modifyResult(flow_file_index_, [segment_num, err](FlowFileResult& flow_file) {
+        auto& message = flow_file.messages.at(segment_num);
+        message.status = MessageStatus::Error;
+        message.err_code = err;
+      });
+      status_ = -1;
+      error_ = rd_kafka_err2str(err);
+      return false;
+    }
+    read_size_ += payload.size();
+    return true;
+  }
+
  public:
   ReadCallback(const uint64_t max_seg_size,
       std::string key,
@@ -259,53 +303,54 @@ class ReadCallback {
   ReadCallback& operator=(ReadCallback) = delete;
 
   int64_t operator()(const std::shared_ptr<io::InputStream>& stream) {
-    std::vector<std::byte> buffer;
-
-    buffer.resize(max_seg_size_);
-    read_size_ = 0;
-    status_ = 0;
-    called_ = true;
-
-    gsl_Expects(max_seg_size_ != 0 || (flow_size_ == 0 && "max_seg_size_ == 0 implies flow_size_ == 0"));
-    // ^^ therefore checking max_seg_size_ == 0 handles both division by zero and flow_size_ == 0 cases
-    const size_t reserved_msg_capacity = max_seg_size_ == 0 ? 1 : utils::intdiv_ceil(flow_size_, max_seg_size_);
-    messages_->modifyResult(flow_file_index_, [reserved_msg_capacity](FlowFileResult& flow_file) {
-      flow_file.messages.reserve(reserved_msg_capacity);
-    });
+    start();
 
     // If the flow file is empty, we still want to send the message, unless the user wants to fail_empty_flow_files_
     if (flow_size_ == 0 && !fail_empty_flow_files_) {
-      const auto err = produce(0, buffer, 0);
-      if (err != RD_KAFKA_RESP_ERR_NO_ERROR) {
-        status_ = -1;
-        error_ = rd_kafka_err2str(err);
-      }
+      produceEmptyMessage();
       return 0;
     }
 
     for (size_t segment_num = 0; read_size_ < flow_size_; ++segment_num) {
-      const auto readRet = stream->read(buffer);
+      // every segment gets its own buffer, as it is only released after its delivery report
+      auto buffer = std::make_shared<std::vector<std::byte>>(std::min(max_seg_size_, flow_size_ - read_size_));
+      const auto readRet = stream->read(*buffer);
       if (io::isError(readRet)) {
         status_ = -1;
         error_ = "Failed to read from stream";
-        return read_size_;
+        return gsl::narrow<int64_t>(read_size_);
       }
       if (readRet == 0) { break; }
 
-      const auto err = produce(segment_num, buffer, readRet);
-      if (err) {
-        messages_->modifyResult(flow_file_index_, [segment_num, err](FlowFileResult& flow_file) {
-          auto& message = flow_file.messages.at(segment_num);
-          message.status = MessageStatus::Error;
-          message.err_code = err;
-        });
-        status_ = -1;
-        error_ = rd_kafka_err2str(err);
-        return read_size_;
+      const std::span<const std::byte> payload{buffer->data(), readRet};
+      if (!produceSegment(segment_num, payload, std::move(buffer))) {
+        return gsl::narrow<int64_t>(read_size_);
+      }
+    }
+    return gsl::narrow<int64_t>(read_size_);
+  }
+
+  /**
+   * Produces the segments directly from a stream whose getBuffer() is a view of the whole content, e.g. a memory mapped content claim.
+   */
+  int64_t produceMapped(const std::shared_ptr<io::InputStream>& mapped_stream) {
+    start();
+
+    const auto content = mapped_stream->getBuffer();
+    if (content.empty()) {
+      if (!fail_empty_flow_files_) {
+        produceEmptyMessage();
+      }
+      return 0;
+    }
+
+    for (size_t segment_num = 0; read_size_ < content.size(); ++segment_num) {
+      const auto segment = content.subspan(read_size_, std::min<uint64_t>(max_seg_size_, content.size() - read_size_));
+      if (!produceSegment(segment_num, segment, mapped_stream)) {
+        break;
       }
-      read_size_ += readRet;
     }
-    return read_size_;
+    return gsl::narrow<int64_t>(read_size_);
   }
 
   const uint64_t flow_size_ = 0;
@@ -318,7 +363,7 @@ class ReadCallback {
   const size_t flow_file_index_;
   int status_ = 0;
   std::string error_;
-  uint32_t read_size_ = 0;
+  uint64_t read_size_ = 0;
   bool called_ = false;
   const bool fail_empty_flow_files_ = true;
   const std::shared_ptr<core::logging::Logger> logger_;
@@ -661,18 +706,10 @@ void PublishKafka::onTrigger(const std::shared_ptr<core::ProcessContext> &contex
   logger_->log_debug("PublishKafka onTrigger");
 
   // Collect FlowFiles to process
+  std::vector<std::shared_ptr<core::FlowFile>> flowFiles = session->get(batch_size_, target_batch_payload_size_);
   uint64_t actual_bytes = 0U;
-  std::vector<std::shared_ptr<core::FlowFile>> flowFiles;
-  for (uint32_t i = 0; i < batch_size_; i++) {
-    std::shared_ptr<core::FlowFile> flowFile = session->get();
-    if (flowFile == nullptr) {
-      break;
-    }
+  for (const auto& flowFile : flowFiles) {
     actual_bytes += flowFile->getSize();
-    flowFiles.emplace_back(std::move(flowFile));
-    if (target_batch_payload_size_ != 0U && actual_bytes >= target_batch_payload_size_) {
-      break;
-    }
   }
   if (flowFiles.empty()) {
     context->yield();
@@ -739,7 +776,12 @@ void PublishKafka::onTrigger(const std::shared_ptr<core::ProcessContext> &contex
 
     ReadCallback callback(max_flow_seg_size_, kafkaKey, thisTopic->getTopic(), conn_->getConnection(), *flowFile,
                           attributeNameRegex_, messages, flow_file_index, failEmptyFlowFiles, logger_);
-    session->read(flowFile, std::ref(callback));
+    // the mapped content is handed to librdkafka as it is, otherwise the segments are read into buffers which are passed without further copies
+    if (auto mapped_content_stream = session->getMappedFlowFileContentStream(flowFile)) {
+      callback.produceMapped(mapped_content_stream);
+    } else {
+      session->read(flowFile, std::ref(callback));
+    }
 
     if (!callback.called_) {
       // workaround: call callback since ProcessSession doesn't do so for empty flow files without resource claims
@@ -15,13 +15,92 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "TestBase.h"
 #include "Catch.h"
 #include "PublishKafka.h"
 #include "SingleProcessorTestController.h"
+#include "core/repository/FileSystemRepository.h"
+#include "core/repository/VolatileContentRepository.h"
+#include "rdkafka_mock.h"
+#include "rdkafka_utils.h"
+
+using namespace std::literals::chrono_literals;
 
 namespace org::apache::nifi::minifi::test {
 
+namespace {
+
+// in-process Kafka cluster of librdkafka, so that the messages can be published and read back without a broker
+class MockKafkaCluster {
+ public:
+  MockKafkaCluster() {
+    std::array<char, 512> errstr{};
+    host_.reset(rd_kafka_new(RD_KAFKA_PRODUCER, rd_kafka_conf_new(), errstr.data(), errstr.size()));
+    REQUIRE(host_);
+    cluster_ = rd_kafka_mock_cluster_new(host_.get(), 1);
+    REQUIRE(cluster_);
+  }
+
+  MockKafkaCluster(const MockKafkaCluster&) = delete;
+  MockKafkaCluster& operator=(const MockKafkaCluster&) = delete;
+
+  ~MockKafkaCluster() {
+    rd_kafka_mock_cluster_destroy(cluster_);
+  }
+
+  void createTopic(const std::string& topic) {
+    REQUIRE(rd_kafka_mock_topic_create(cluster_, topic.c_str(), 1, 1) == RD_KAFKA_RESP_ERR_NO_ERROR);
+  }
+
+  [[nodiscard]] std::string getBootstrapServers() const {
+    return rd_kafka_mock_cluster_bootstraps(cluster_);
+  }
+
+  // reads the payloads of the first expected_count messages of the topic
+  [[nodiscard]] std::vector<std::string> consume(const std::string& topic, size_t expected_count) const {
+    std::array<char, 512> errstr{};
+    std::unique_ptr<rd_kafka_conf_t, utils::rd_kafka_conf_deleter> conf{rd_kafka_conf_new()};
+    REQUIRE(rd_kafka_conf_set(conf.get(), "bootstrap.servers", getBootstrapServers().c_str(), errstr.data(), errstr.size()) == RD_KAFKA_CONF_OK);
+    REQUIRE(rd_kafka_conf_set(conf.get(), "group.id", "PublishKafkaTests", errstr.data(), errstr.size()) == RD_KAFKA_CONF_OK);
+    std::unique_ptr<rd_kafka_t, utils::rd_kafka_consumer_deleter> consumer{rd_kafka_new(RD_KAFKA_CONSUMER, conf.release(), errstr.data(), errstr.size())};
+    REQUIRE(consumer);
+    rd_kafka_poll_set_consumer(consumer.get());
+    std::unique_ptr<rd_kafka_topic_partition_list_t, utils::rd_kafka_topic_partition_list_deleter> partitions{rd_kafka_topic_partition_list_new(1)};
+    rd_kafka_topic_partition_list_add(partitions.get(), topic.c_str(), 0)->offset = RD_KAFKA_OFFSET_BEGINNING;
+    REQUIRE(rd_kafka_assign(consumer.get(), partitions.get()) == RD_KAFKA_RESP_ERR_NO_ERROR);
+
+    std::vector<std::string> payloads;
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (payloads.size() < expected_count && std::chrono::steady_clock::now() < deadline) {
+      std::unique_ptr<rd_kafka_message_t, utils::rd_kafka_message_deleter> message{rd_kafka_consumer_poll(consumer.get(), 100)};
+      if (message && message->err == RD_KAFKA_RESP_ERR_NO_ERROR) {
+        payloads.emplace_back(static_cast<const char*>(message->payload), message->len);
+      }
+    }
+    return payloads;
+  }
+
+ private:
+  std::unique_ptr<rd_kafka_t, utils::rd_kafka_producer_deleter> host_;
+  rd_kafka_mock_cluster_t* cluster_ = nullptr;
+};
+
+std::string createContent(size_t size) {
+  std::string content(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    content[i] = static_cast<char>('a' + (i * 7 + i / 26) % 26);
+  }
+  return content;
+}
+
+}  // namespace
+
 TEST_CASE("Scheduling should fail when batch size is larger than the max queue message count", "[testPublishKafka]") {
   LogTestController::getInstance().setTrace<TestPlan>();
   LogTestController::getInstance().setTrace<processors::PublishKafka>();
@@ -34,4 +113,67 @@ TEST_CASE("Scheduling should fail when batch size is larger than the max queue m
   REQUIRE_THROWS_WITH(test_controller.trigger(""), "Process Schedule Operation: Invalid configuration: Batch Size cannot be larger than Queue Max Message");
 }
 
+TEST_CASE("PublishKafka sends the content in segments of Max Flow Segment Size", "[testPublishKafka]") {
+  MockKafkaCluster kafka_cluster;
+  kafka_cluster.createTopic("test_topic");
+
+  std::shared_ptr<core::ContentRepository> content_repo;
+  SECTION("Segments read into buffers") {
+    content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  }
+  SECTION("Segments of the mapped content") {
+    content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  }
+
+  const auto publish_kafka = std::make_shared<processors::PublishKafka>("PublishKafka");
+  SingleProcessorTestController test_controller(publish_kafka, content_repo);
+  publish_kafka->setProperty(processors::PublishKafka::ClientName, "test_client");
+  publish_kafka->setProperty(processors::PublishKafka::SeedBrokers, kafka_cluster.getBootstrapServers());
+  publish_kafka->setProperty(processors::PublishKafka::Topic, "test_topic");
+  publish_kafka->setProperty(processors::PublishKafka::MaxFlowSegSize, "1000 B");
+  // the messages wait in the queue of librdkafka for a while, their payloads must stay valid after the processor has moved on
+  publish_kafka->setProperty(processors::PublishKafka::QueueBufferMaxTime, "200 millis");
+
+  const auto content = createContent(9500);
+  auto result = test_controller.trigger(content);
+  REQUIRE(result.at(processors::PublishKafka::Success).size() == 1);
+  CHECK(result.at(processors::PublishKafka::Failure).empty());
+
+  const auto payloads = kafka_cluster.consume("test_topic", 10);
+  REQUIRE(payloads.size() == 10);
+  std::string received_content;
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    CHECK(payloads[i].size() == (i < 9 ? 1000 : 500));
+    received_content += payloads[i];
+  }
+  CHECK(received_content == content);
+}
+
+TEST_CASE("PublishKafka keeps the payloads of several flow files until their delivery", "[testPublishKafka]") {
+  MockKafkaCluster kafka_cluster;
+  kafka_cluster.createTopic("test_topic");
+
+  const auto publish_kafka = std::make_shared<processors::PublishKafka>("PublishKafka");
+  SingleProcessorTestController test_controller(publish_kafka);
+  publish_kafka->setProperty(processors::PublishKafka::ClientName, "test_client");
+  publish_kafka->setProperty(processors::PublishKafka::SeedBrokers, kafka_cluster.getBootstrapServers());
+  publish_kafka->setProperty(processors::PublishKafka::Topic, "test_topic");
+  publish_kafka->setProperty(processors::PublishKafka::QueueBufferMaxTime, "200 millis");
+
+  // the buffer of every flow file is released by the delivery report, the later flow files must not reuse the memory of the earlier ones
+  std::vector<std::string> contents;
+  std::vector<InputFlowFileData> input_flow_files;
+  for (size_t i = 0; i < 5; ++i) {
+    contents.push_back(std::to_string(i) + createContent(2000 + i));
+  }
+  for (const auto& content : contents) {
+    input_flow_files.push_back({content});
+  }
+  auto result = test_controller.trigger(std::move(input_flow_files));
+  CHECK(result.at(processors::PublishKafka::Success).size() == contents.size());
+
+  const auto payloads = kafka_cluster.consume("test_topic", contents.size());
+  CHECK(payloads == contents);
+}
+
 }  // namespace org::apache::nifi::minifi::test
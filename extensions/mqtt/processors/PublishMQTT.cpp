@@ -232,7 +232,7 @@ void PublishMQTT::setMqtt5Properties(MQTTAsync_message& message, const std::stri
 }
 
 void PublishMQTT::addAttributesAsUserProperties(MQTTAsync_message& message, const std::shared_ptr<core::FlowFile>& flow_file) {
-  for (const auto& [key, value] : *flow_file->getAttributesPtr()) {
+  for (const auto& [key, value] : flow_file->getAttributeMap()) {
     MQTTProperty property;
     property.identifier = MQTTPROPERTY_CODE_USER_PROPERTY;
 
@@ -17,12 +17,14 @@
 
 #include <set>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 
 #include "ExecutePythonProcessor.h"
 #include "types/PyRelationship.h"
 #include "types/PyLogger.h"
 
+#include "utils/ProcessorConfigUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/file/FileUtils.h"
 #include "core/Resource.h"
@@ -56,7 +58,7 @@ void ExecutePythonProcessor::initialize() {
 }
 
 void ExecutePythonProcessor::initalizeThroughScriptEngine() {
-  appendPathForImportModules();
+  appendPathForImportModules(*python_script_engine_);
   python_script_engine_->eval(script_to_exec_);
   python_script_engine_->describe(this);
   python_script_engine_->onInitialize(this);
@@ -64,6 +66,12 @@ void ExecutePythonProcessor::initalizeThroughScriptEngine() {
 }
 
 void ExecutePythonProcessor::onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory>& /*sessionFactory*/) {
+  interpreter_mode_ = utils::parseEnumProperty<python::InterpreterMode>(*context, InterpreterMode);
+  if (interpreter_mode_ == python::InterpreterMode::SUBINTERPRETER && !SubInterpreter::isSupported()) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Interpreter Mode 'Subinterpreter' requires the python extension to be built with ENABLE_PYTHON_SUBINTERPRETERS against Python 3.12 or newer");
+  }
+
+  std::lock_guard<std::mutex> lock(script_mutex_);
   if (!processor_initialized_) {
     loadScript();
     python_script_engine_ = createScriptEngine();
@@ -75,27 +83,41 @@ void ExecutePythonProcessor::onSchedule(const std::shared_ptr<core::ProcessConte
     }
   }
 
-  gsl_Expects(python_script_engine_);
-  python_script_engine_->eval(script_to_exec_);
-  python_script_engine_->onSchedule(context);
-
   getProperty(ReloadOnScriptChange, reload_on_script_change_);
+
+  python_script_engine_queue_ = createScriptEngineQueue(context);
+  // create the first script context right away, so that errors in the script are reported when the processor is scheduled
+  std::ignore = python_script_engine_queue_->getResource();
 }
 
 void ExecutePythonProcessor::onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) {
-  reloadScriptIfUsingScriptFileProperty();
-  if (script_to_exec_.empty()) {
-    throw std::runtime_error("Neither Script Body nor Script File is available to execute");
+  std::shared_ptr<utils::ResourceQueue<PythonScriptEngine>> python_script_engine_queue;
+  {
+    std::lock_guard<std::mutex> lock(script_mutex_);
+    if (reloadScriptIfUsingScriptFileProperty()) {
+      python_script_engine_queue_ = createScriptEngineQueue(context);
+    }
+    if (script_to_exec_.empty()) {
+      throw std::runtime_error("Neither Script Body nor Script File is available to execute");
+    }
+    python_script_engine_queue = python_script_engine_queue_;
   }
 
-  python_script_engine_->onTrigger(context, session);
+  gsl_Expects(python_script_engine_queue);
+  auto python_script_engine = python_script_engine_queue->getResource();
+  python_script_engine->onTrigger(context, session);
+}
+
+void ExecutePythonProcessor::onUnSchedule() {
+  std::lock_guard<std::mutex> lock(script_mutex_);
+  python_script_engine_queue_.reset();
 }
 
-void ExecutePythonProcessor::appendPathForImportModules() {
+void ExecutePythonProcessor::appendPathForImportModules(PythonScriptEngine& python_script_engine) {
   std::string module_directory;
   getProperty(ModuleDirectory, module_directory);
   if (!module_directory.empty()) {
-    python_script_engine_->setModulePaths(utils::StringUtils::splitAndTrimRemovingEmpty(module_directory, ",") | ranges::to<std::vector<std::filesystem::path>>());
+    python_script_engine.setModulePaths(utils::StringUtils::splitAndTrimRemovingEmpty(module_directory, ",") | ranges::to<std::vector<std::filesystem::path>>());
   }
 }
 
@@ -129,17 +151,18 @@ void ExecutePythonProcessor::loadScript() {
   script_to_exec_ = script_body;
 }
 
-void ExecutePythonProcessor::reloadScriptIfUsingScriptFileProperty() {
+bool ExecutePythonProcessor::reloadScriptIfUsingScriptFileProperty() {
   if (script_file_path_.empty() || !reload_on_script_change_) {
-    return;
+    return false;
   }
   auto file_write_time = utils::file::last_write_time(script_file_path_);
-  if (file_write_time != last_script_write_time_) {
-    logger_->log_debug("Script file has changed since last time, reloading...");
-    loadScriptFromFile();
-    last_script_write_time_ = file_write_time;
-    python_script_engine_->eval(script_to_exec_);
+  if (file_write_time == last_script_write_time_) {
+    return false;
   }
+  logger_->log_debug("Script file has changed since last time, reloading...");
+  loadScriptFromFile();
+  last_script_write_time_ = file_write_time;
+  return true;
 }
 
 std::unique_ptr<PythonScriptEngine> ExecutePythonProcessor::createScriptEngine() {
@@ -151,6 +174,24 @@ std::unique_ptr<PythonScriptEngine> ExecutePythonProcessor::createScriptEngine()
   return engine;
 }
 
+std::shared_ptr<utils::ResourceQueue<PythonScriptEngine>> ExecutePythonProcessor::createScriptEngineQueue(const std::shared_ptr<core::ProcessContext>& context) {
+  // Every concurrent task gets its own script context, which is created on demand from the currently loaded script.
+  // The queue is owned by the processor, so it must not keep the process context alive.
+  auto create_engine = [this, script = script_to_exec_, interpreter_mode = interpreter_mode_, weak_context = std::weak_ptr(context)]() {
+    const auto process_context = weak_context.lock();
+    if (!process_context) {
+      throw std::runtime_error("Process context is no longer available to schedule the python script");
+    }
+    auto engine = std::make_unique<PythonScriptEngine>(interpreter_mode);
+    engine->initialize(Success, Failure, python_logger_);
+    appendPathForImportModules(*engine);
+    engine->eval(script);
+    engine->onSchedule(process_context);
+    return engine;
+  };
+  return utils::ResourceQueue<PythonScriptEngine>::create(create_engine, getMaxConcurrentTasks(), std::nullopt, logger_);
+}
+
 REGISTER_RESOURCE(ExecutePythonProcessor, Processor);
 
 }  // namespace org::apache::nifi::minifi::extensions::python::processors
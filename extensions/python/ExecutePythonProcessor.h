@@ -21,6 +21,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,7 +32,7 @@
 #include "core/PropertyDefinitionBuilder.h"
 #include "core/PropertyType.h"
 #include "core/RelationshipDefinition.h"
-#include "PythonScriptEngine.h"
+#include "utils/ResourceQueue.h"
 #include "PythonScriptEngine.h"
 
 #if defined(__GNUC__) || defined(__GNUG__)
@@ -71,11 +72,22 @@ class ExecutePythonProcessor : public core::Processor {
       .withPropertyType(core::StandardPropertyTypes::BOOLEAN_TYPE)
       .withDefaultValue("true")
       .build();
-  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 4>{
+  EXTENSIONAPI static constexpr auto InterpreterMode = core::PropertyDefinitionBuilder<python::InterpreterMode::length>::createProperty("Interpreter Mode")
+      .withDescription("Controls how the script contexts of the concurrent tasks are executed. "
+          "With 'Shared GIL' every script context runs in the main python interpreter, so the concurrent tasks are serialized on its global interpreter lock. "
+          "With 'Subinterpreter' every script context runs in its own isolated python subinterpreter with its own GIL, so the concurrent tasks can run in parallel. "
+          "Subinterpreters require the extension to be built with ENABLE_PYTHON_SUBINTERPRETERS against Python 3.12 or newer, and the modules imported by the script "
+          "must support them.")
+      .isRequired(true)
+      .withAllowedValues(python::InterpreterMode::values)
+      .withDefaultValue(toStringView(python::InterpreterMode::SHARED_GIL))
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 5>{
       ScriptFile,
       ScriptBody,
       ModuleDirectory,
-      ReloadOnScriptChange
+      ReloadOnScriptChange,
+      InterpreterMode
   };
 
 
@@ -86,12 +98,13 @@ class ExecutePythonProcessor : public core::Processor {
   EXTENSIONAPI static constexpr bool SupportsDynamicProperties = false;
   EXTENSIONAPI static constexpr bool SupportsDynamicRelationships = false;
   EXTENSIONAPI static constexpr core::annotation::Input InputRequirement = core::annotation::Input::INPUT_ALLOWED;
-  EXTENSIONAPI static constexpr bool IsSingleThreaded = true;
+  EXTENSIONAPI static constexpr bool IsSingleThreaded = false;
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_PROCESSORS
 
   void initialize() override;
   void onSchedule(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSessionFactory> &sessionFactory) override;
   void onTrigger(const std::shared_ptr<core::ProcessContext> &context, const std::shared_ptr<core::ProcessSession> &session) override;
+  void onUnSchedule() override;
 
   void setSupportsDynamicProperties() {
     python_dynamic_ = true;
@@ -133,15 +146,20 @@ class ExecutePythonProcessor : public core::Processor {
   std::optional<std::filesystem::file_time_type> last_script_write_time_;
   std::string script_file_path_;
   std::shared_ptr<core::logging::Logger> python_logger_;
+  // describes the processor, the flow files are processed by the script contexts of the engine queue
   std::unique_ptr<PythonScriptEngine> python_script_engine_;
+  python::InterpreterMode interpreter_mode_ = python::InterpreterMode::SHARED_GIL;
+  std::mutex script_mutex_;
+  std::shared_ptr<utils::ResourceQueue<PythonScriptEngine>> python_script_engine_queue_;
 
-  void appendPathForImportModules();
+  void appendPathForImportModules(PythonScriptEngine& python_script_engine);
   void loadScriptFromFile();
   void loadScript();
-  void reloadScriptIfUsingScriptFileProperty();
+  bool reloadScriptIfUsingScriptFileProperty();
   void initalizeThroughScriptEngine();
 
   std::unique_ptr<PythonScriptEngine> createScriptEngine();
+  std::shared_ptr<utils::ResourceQueue<PythonScriptEngine>> createScriptEngineQueue(const std::shared_ptr<core::ProcessContext>& context);
 };
 
 }  // namespace org::apache::nifi::minifi::extensions::python::processors
@@ -16,7 +16,10 @@
  */
 
 #include "PythonBindings.h"
+#include <map>
+#include <mutex>
 #include <utility>
+#include <vector>
 #include "types/PyLogger.h"
 #include "types/PyProcessSession.h"
 #include "types/PyProcessContext.h"
@@ -28,6 +31,58 @@
 #include "types/PyStateManager.h"
 
 namespace org::apache::nifi::minifi::extensions::python {
+
+namespace {
+using TypeObjectKey = std::pair<const void*, const PyType_Spec*>;
+
+std::mutex type_objects_mutex;
+
+std::map<TypeObjectKey, OwnedObject>& typeObjects() {
+  static std::map<TypeObjectKey, OwnedObject> type_objects;
+  return type_objects;
+}
+
+const void* currentInterpreter() {
+#ifdef MINIFI_PYTHON_SUBINTERPRETERS
+  return PyInterpreterState_Get();
+#else
+  // without subinterpreter support every type object belongs to the main interpreter
+  return nullptr;
+#endif
+}
+}  // namespace
+
+PyTypeObject* typeObjectFromSpec(PyType_Spec& spec) {
+  const TypeObjectKey key{currentInterpreter(), &spec};
+  {
+    std::lock_guard<std::mutex> lock(type_objects_mutex);
+    if (auto it = typeObjects().find(key); it != typeObjects().end()) {
+      return reinterpret_cast<PyTypeObject*>(it->second.get());
+    }
+  }
+  // Creating the type may run arbitrary python code (e.g. garbage collection), so it is done without holding the mutex
+  OwnedObject type_object{PyType_FromSpec(&spec)};
+  std::lock_guard<std::mutex> lock(type_objects_mutex);
+  const auto it = typeObjects().try_emplace(key, std::move(type_object)).first;
+  return reinterpret_cast<PyTypeObject*>(it->second.get());
+}
+
+void releaseTypeObjectsOfCurrentInterpreter() {
+  std::vector<OwnedObject> released_type_objects;
+  {
+    std::lock_guard<std::mutex> lock(type_objects_mutex);
+    auto& type_objects = typeObjects();
+    for (auto it = type_objects.begin(); it != type_objects.end();) {
+      if (it->first.first == currentInterpreter()) {
+        released_type_objects.push_back(std::move(it->second));
+        it = type_objects.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
 extern "C" {
 
 struct PyModuleDef minifi_module = {
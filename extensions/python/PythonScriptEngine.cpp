@@ -82,20 +82,110 @@ Interpreter::~Interpreter() {
   Py_Finalize();
 }
 
-PythonScriptEngine::PythonScriptEngine() {
+#ifdef MINIFI_PYTHON_SUBINTERPRETERS
+SubInterpreter::SubInterpreter() {
   Interpreter::getInterpreter();
 
   GlobalInterpreterLock lock;
+  PyThreadState* const main_thread_state = PyThreadState_Get();
+  const PyInterpreterConfig config{
+    .use_main_obmalloc = 0,
+    .allow_fork = 0,
+    .allow_exec = 0,
+    .allow_threads = 1,
+    .allow_daemon_threads = 0,
+    .check_multi_interp_extensions = 1,
+    .gil = PyInterpreterConfig_OWN_GIL
+  };
+  PyThreadState* thread_state = nullptr;
+  const PyStatus status = Py_NewInterpreterFromConfig(&thread_state, &config);
+  if (PyStatus_Exception(status)) {
+    throw PythonScriptException(fmt::format("Failed to create python subinterpreter: {}", status.err_msg ? status.err_msg : "unknown error"));
+  }
+  interpreter_state_ = PyThreadState_GetInterpreter(thread_state);
+
+  // The subinterpreter is entered with a new thread state on every use, so its initial thread state is not needed.
+  // This also releases the GIL of the subinterpreter, after which the main thread state can be restored.
+  PyThreadState_Clear(thread_state);
+  PyThreadState_DeleteCurrent();
+  PyEval_RestoreThread(main_thread_state);
+}
+
+SubInterpreter::~SubInterpreter() {
+  PyThreadState* thread_state = acquire();
+  releaseTypeObjectsOfCurrentInterpreter();
+  Py_EndInterpreter(thread_state);
+}
+
+bool SubInterpreter::isSupported() {
+  return true;
+}
+
+PyThreadState* SubInterpreter::acquire() {
+  PyThreadState* thread_state = PyThreadState_New(interpreter_state_);
+  PyEval_RestoreThread(thread_state);
+  return thread_state;
+}
+
+void SubInterpreter::release(PyThreadState* thread_state) {
+  PyThreadState_Clear(thread_state);
+  PyThreadState_DeleteCurrent();
+}
+#else
+SubInterpreter::SubInterpreter() {
+  throw PythonScriptException("Python subinterpreters are not supported by this build, the extension has to be built with ENABLE_PYTHON_SUBINTERPRETERS against Python 3.12 or newer");
+}
+
+SubInterpreter::~SubInterpreter() = default;
+
+bool SubInterpreter::isSupported() {
+  return false;
+}
+
+PyThreadState* SubInterpreter::acquire() {
+  return nullptr;
+}
+
+void SubInterpreter::release(PyThreadState*) {
+}
+#endif
+
+InterpreterLock::InterpreterLock(SubInterpreter* sub_interpreter)
+    : sub_interpreter_(sub_interpreter) {
+  if (sub_interpreter_) {
+    thread_state_ = sub_interpreter_->acquire();
+  } else {
+    global_interpreter_lock_.emplace();
+  }
+}
+
+InterpreterLock::~InterpreterLock() {
+  if (sub_interpreter_) {
+    sub_interpreter_->release(thread_state_);
+  }
+}
+
+PythonScriptEngine::PythonScriptEngine()
+    : PythonScriptEngine(InterpreterMode::SHARED_GIL) {
+}
+
+PythonScriptEngine::PythonScriptEngine(InterpreterMode interpreter_mode) {
+  Interpreter::getInterpreter();
+  if (interpreter_mode == InterpreterMode::SUBINTERPRETER) {
+    sub_interpreter_ = std::make_unique<SubInterpreter>();
+  }
+
+  InterpreterLock lock(sub_interpreter_.get());
   bindings_ = OwnedDict::create();
 }
 
 PythonScriptEngine::~PythonScriptEngine() {
-  GlobalInterpreterLock lock;
+  InterpreterLock lock(sub_interpreter_.get());
   bindings_.resetReference();
 }
 
 void PythonScriptEngine::eval(const std::string& script) {
-  GlobalInterpreterLock gil;
+  InterpreterLock lock(sub_interpreter_.get());
   try {
     evaluateModuleImports();
     evalInternal(script);
@@ -105,7 +195,7 @@ void PythonScriptEngine::eval(const std::string& script) {
 }
 
 void PythonScriptEngine::evalFile(const std::filesystem::path& file_name) {
-  GlobalInterpreterLock gil;
+  InterpreterLock lock(sub_interpreter_.get());
   try {
     evaluateModuleImports();
     std::ifstream file(file_name, std::ios::in);
@@ -22,6 +22,7 @@
 
 #include <mutex>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <exception>
 #include <string>
@@ -29,6 +30,7 @@
 
 #include "core/ProcessSession.h"
 #include "core/Processor.h"
+#include "utils/Enum.h"
 
 #include "PythonProcessor.h"
 #include "types/PyProcessSession.h"
@@ -53,6 +55,11 @@ class GlobalInterpreterLock {
   PyGILState_STATE gil_state_;
 };
 
+SMART_ENUM(InterpreterMode,
+  (SHARED_GIL, "Shared GIL"),
+  (SUBINTERPRETER, "Subinterpreter")
+)
+
 class Interpreter {
   Interpreter();
   ~Interpreter();
@@ -69,6 +76,53 @@ class Interpreter {
   PyThreadState* saved_thread_state_ = nullptr;
 };
 
+/**
+ * An isolated interpreter with its own GIL (PEP 684), so that scripts running in different subinterpreters
+ * can execute in parallel. Only available if the extension was built with MINIFI_PYTHON_SUBINTERPRETERS,
+ * i.e. against the full (non-limited) C API of Python 3.12 or newer.
+ */
+class SubInterpreter {
+ public:
+  SubInterpreter();
+  ~SubInterpreter();
+
+  SubInterpreter(const SubInterpreter& other) = delete;
+  SubInterpreter(SubInterpreter&& other) = delete;
+  SubInterpreter& operator=(const SubInterpreter& other) = delete;
+  SubInterpreter& operator=(SubInterpreter&& other) = delete;
+
+  static bool isSupported();
+
+  PyThreadState* acquire();
+  void release(PyThreadState* thread_state);
+
+ private:
+  PyInterpreterState* interpreter_state_ = nullptr;
+};
+
+/**
+ * Holds the GIL of the main interpreter, or the own GIL of the subinterpreter if one is given.
+ */
+#if defined(__GNUC__) || defined(__GNUG__)
+class __attribute__((visibility("default"))) InterpreterLock {
+#else
+class InterpreterLock {
+#endif
+ public:
+  explicit InterpreterLock(SubInterpreter* sub_interpreter);
+  ~InterpreterLock();
+
+  InterpreterLock(const InterpreterLock& other) = delete;
+  InterpreterLock(InterpreterLock&& other) = delete;
+  InterpreterLock& operator=(const InterpreterLock& other) = delete;
+  InterpreterLock& operator=(InterpreterLock&& other) = delete;
+
+ private:
+  SubInterpreter* sub_interpreter_;
+  PyThreadState* thread_state_ = nullptr;
+  std::optional<GlobalInterpreterLock> global_interpreter_lock_;
+};
+
 
 #if defined(__GNUC__) || defined(__GNUG__)
 class __attribute__((visibility("default"))) PythonScriptEngine {
@@ -77,6 +131,7 @@ class PythonScriptEngine {
 #endif
  public:
   PythonScriptEngine();
+  explicit PythonScriptEngine(InterpreterMode interpreter_mode);
   ~PythonScriptEngine();
 
   PythonScriptEngine(const PythonScriptEngine& other) = delete;
@@ -95,7 +150,7 @@ class PythonScriptEngine {
 
   template<typename... Args>
   void call(std::string_view fn_name, Args&& ...args) {
-    GlobalInterpreterLock gil_lock;
+    InterpreterLock interpreter_lock(sub_interpreter_.get());
     try {
       if (auto item = bindings_[fn_name]) {
         auto result = BorrowedCallable(*item)(std::forward<Args>(args)...);
@@ -110,7 +165,7 @@ class PythonScriptEngine {
 
   template<typename ... Args>
   void callRequiredFunction(const std::string& fn_name, Args&& ...args) {
-    GlobalInterpreterLock gil_lock;
+    InterpreterLock interpreter_lock(sub_interpreter_.get());
     if (auto item = bindings_[fn_name]) {
       auto result = BorrowedCallable(*item)(std::forward<Args>(args)...);
       if (!result) {
@@ -123,7 +178,7 @@ class PythonScriptEngine {
 
   template<object::convertible T>
   void bind(const std::string& name, const T& value) {
-    GlobalInterpreterLock gil_lock;
+    InterpreterLock interpreter_lock(sub_interpreter_.get());
     bindings_.put(name, value);
   }
 
@@ -136,6 +191,7 @@ class PythonScriptEngine {
   void evalInternal(std::string_view script);
 
   void evaluateModuleImports();
+  std::unique_ptr<SubInterpreter> sub_interpreter_;
   OwnedDict bindings_;
   std::vector<std::filesystem::path> module_paths_;
 };
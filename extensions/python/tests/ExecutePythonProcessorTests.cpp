@@ -16,14 +16,20 @@
  * limitations under the License.
  */
 #include <array>
+#include <latch>
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "TestBase.h"
 #include "Catch.h"
 
+#include "core/ProcessSessionFactory.h"
 #include "processors/GetFile.h"
 #include "ExecutePythonProcessor.h"
+#include "FlowFileRecord.h"
 #include "processors/LogAttribute.h"
 #include "processors/PutFile.h"
 #include "utils/file/FileUtils.h"
@@ -277,6 +283,71 @@ TEST_CASE_METHOD(SimplePythonFlowFileTransferTest, "Test the Reload On Script Ch
   }
 }
 
+TEST_CASE_METHOD(SimplePythonFlowFileTransferTest, "Scripts can run in subinterpreters", "[executePythonProcessorSubinterpreter]") {
+  const auto input_dir = testController_->createTempDirectory();
+  putFileToDir(input_dir, TEST_FILE_NAME, TEST_FILE_CONTENT);
+  addGetFileProcessorToPlan(input_dir);
+  auto execute_python_processor = addExecutePythonProcessorToPlan("passthrough_processor_transfering_to_success.py", "");
+  plan_->setProperty(execute_python_processor, minifi::extensions::python::processors::ExecutePythonProcessor::InterpreterMode, "Subinterpreter");
+  const auto output_dir = testController_->createTempDirectory();
+  addPutFileProcessorToPlan(core::Relationship("success", "description"), output_dir);
+
+  plan_->runNextProcessor();  // GetFile
+  if (!minifi::extensions::python::SubInterpreter::isSupported()) {
+    REQUIRE_THROWS_WITH(plan_->runNextProcessor(), Catch::Contains("ENABLE_PYTHON_SUBINTERPRETERS"));  // ExecutePythonProcessor
+    return;
+  }
+  REQUIRE_NOTHROW(plan_->runNextProcessor());  // ExecutePythonProcessor
+  plan_->runNextProcessor();  // PutFile
+
+  REQUIRE(getFileContent(output_dir / TEST_FILE_NAME) == TEST_FILE_CONTENT);
+}
+
+TEST_CASE_METHOD(SimplePythonFlowFileTransferTest, "Concurrent tasks get their own script context", "[executePythonProcessorConcurrentTasks]") {
+  constexpr size_t concurrent_task_count = 4;
+  auto execute_python_processor = plan_->addProcessor("ExecutePythonProcessor", "executePythonProcessor");
+  plan_->setProperty(execute_python_processor, minifi::extensions::python::processors::ExecutePythonProcessor::ScriptFile, getScriptFullPath("concurrent_processor.py").string());
+  SECTION("Shared GIL") {}
+  SECTION("Subinterpreter") {
+    if (!minifi::extensions::python::SubInterpreter::isSupported()) {
+      return;
+    }
+    plan_->setProperty(execute_python_processor, minifi::extensions::python::processors::ExecutePythonProcessor::InterpreterMode, "Subinterpreter");
+  }
+  execute_python_processor->setMaxConcurrentTasks(concurrent_task_count);
+  auto* input = plan_->addConnection(nullptr, core::Relationship{"success", "d"}, execute_python_processor);
+  auto* output = plan_->addConnection(execute_python_processor, core::Relationship{"success", "d"}, nullptr);
+
+  plan_->runNextProcessor();  // schedules ExecutePythonProcessor, there is no input yet
+  for (size_t i = 0; i < concurrent_task_count; ++i) {
+    input->put(std::make_shared<minifi::FlowFileRecord>());
+  }
+
+  const auto context = plan_->getCurrentContext();
+  const auto session_factory = std::make_shared<core::ProcessSessionFactory>(context);
+  std::latch tasks_ready{concurrent_task_count};
+  std::vector<std::thread> tasks;
+  for (size_t i = 0; i < concurrent_task_count; ++i) {
+    tasks.emplace_back([&] {
+      tasks_ready.arrive_and_wait();
+      execute_python_processor->onTrigger(context, session_factory);
+    });
+  }
+  for (auto& task : tasks) {
+    task.join();
+  }
+
+  // the script contexts are busy until their flow file is processed, so every task used a script context of its own
+  std::set<std::shared_ptr<core::FlowFile>> expired;
+  size_t output_count = 0;
+  while (auto flow_file = output->poll(expired)) {
+    CHECK(flow_file->getAttribute("processed_count") == "1");
+    ++output_count;
+  }
+  CHECK(output_count == concurrent_task_count);
+  CHECK(input->isEmpty());
+}
+
 TEST_CASE_METHOD(SimplePythonFlowFileTransferTest, "Test module load of processor", "[executePythonProcessorModuleLoad]") {
   const auto input_dir = testController_->createTempDirectory();
   putFileToDir(input_dir, TEST_FILE_NAME, TEST_FILE_CONTENT);
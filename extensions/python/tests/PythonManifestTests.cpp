@@ -93,7 +93,7 @@ TEST_CASE("Python processor's description is part of the manifest") {
     REQUIRE(MyPyProc);
 
     REQUIRE(getNode(MyPyProc->children, "inputRequirement").value == "INPUT_ALLOWED");
-    REQUIRE(getNode(MyPyProc->children, "isSingleThreaded").value == true);
+    REQUIRE(getNode(MyPyProc->children, "isSingleThreaded").value == false);
     REQUIRE(getNode(MyPyProc->children, "typeDescription").value == "An amazing processor");
     REQUIRE(getNode(MyPyProc->children, "supportsDynamicRelationships").value == false);
     REQUIRE(getNode(MyPyProc->children, "supportsDynamicProperties").value == false);
@@ -117,7 +117,7 @@ TEST_CASE("Python processor's description is part of the manifest") {
     REQUIRE(MyPyProc2);
 
     REQUIRE(getNode(MyPyProc2->children, "inputRequirement").value == "INPUT_ALLOWED");
-    REQUIRE(getNode(MyPyProc2->children, "isSingleThreaded").value == true);
+    REQUIRE(getNode(MyPyProc2->children, "isSingleThreaded").value == false);
     REQUIRE(getNode(MyPyProc2->children, "typeDescription").value == "Another amazing processor");
     REQUIRE(getNode(MyPyProc2->children, "supportsDynamicRelationships").value == false);
     REQUIRE(getNode(MyPyProc2->children, "supportsDynamicProperties").value == true);
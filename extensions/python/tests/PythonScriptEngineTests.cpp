@@ -16,6 +16,7 @@
  */
 
 #include <barrier>
+#include <mutex>
 #include "TestBase.h"
 #include "Catch.h"
 #include "Utils.h"
@@ -60,6 +61,52 @@ TEST_CASE("GilScopedAcquire should lock threads properly", "[pythonscriptenginee
   }
 }
 
+#ifdef MINIFI_PYTHON_SUBINTERPRETERS
+TEST_CASE("Subinterpreters have their own GIL", "[pythonscriptengineeval]") {
+  python::SubInterpreter first_interpreter;
+  python::SubInterpreter second_interpreter;
+
+  for (int i = 0; i < 10; ++i) {
+    DYNAMIC_SECTION("Iteration: " << i) {
+      std::mutex messages_mutex;
+      std::vector<std::string_view> messages;
+      const auto add_message = [&](std::string_view message) {
+        std::lock_guard<std::mutex> lock(messages_mutex);
+        messages.push_back(message);
+      };
+      std::barrier sync{2};
+      auto sleeping_thread = std::thread([&] {
+        using namespace std::literals::chrono_literals;
+        python::InterpreterLock interpreter_lock(&first_interpreter);
+        add_message("Before sleep");
+        std::ignore = sync.arrive();
+        std::this_thread::sleep_for(100ms);
+        add_message("First thread");
+      });
+      sync.arrive_and_wait();
+
+      auto non_sleeping_thread = std::thread([&] {
+        python::InterpreterLock interpreter_lock(&second_interpreter);
+        add_message("Second thread");
+      });
+      non_sleeping_thread.join();
+      sleeping_thread.join();
+      REQUIRE(messages == std::vector<std::string_view>{"Before sleep", "Second thread", "First thread"});
+    }
+  }
+}
+
+TEST_CASE("Modules are isolated between subinterpreters", "[pythonscriptengineeval]") {
+  python::PythonScriptEngine main_engine;
+  python::PythonScriptEngine first_engine(python::InterpreterMode::SUBINTERPRETER);
+  python::PythonScriptEngine second_engine(python::InterpreterMode::SUBINTERPRETER);
+
+  REQUIRE_NOTHROW(first_engine.eval("import sys\nsys.minifi_marker = 'first'"));
+  REQUIRE_NOTHROW(second_engine.eval("import sys\nif hasattr(sys, 'minifi_marker'):\n  raise RuntimeError('sys is shared')"));
+  REQUIRE_NOTHROW(main_engine.eval("import sys\nif hasattr(sys, 'minifi_marker'):\n  raise RuntimeError('sys is shared')"));
+}
+#endif
+
 TEST_CASE("PythonScriptEngine errors during call", "[luascriptenginecall]") {
   python::PythonScriptEngine engine;
   REQUIRE_NOTHROW(engine.eval(R"(
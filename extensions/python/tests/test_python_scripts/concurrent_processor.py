@@ -0,0 +1,35 @@
+#  Licensed to the Apache Software Foundation (ASF) under one or more
+#  contributor license agreements.  See the NOTICE file distributed with
+#  this work for additional information regarding copyright ownership.
+#  The ASF licenses this file to You under the Apache License, Version 2.0
+#  (the "License"); you may not use this file except in compliance with
+#  the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+import time
+
+
+def describe(processor):
+    processor.setDescription("Processor used for testing in ExecutePythonProcessorTests.cpp")
+
+
+# every script context has its own copy of the global state
+processed_count = 0
+
+
+def onTrigger(context, session):
+    global processed_count
+    flow_file = session.get()
+    if flow_file is not None:
+        processed_count = processed_count + 1
+        # sleeping releases the GIL, so the other concurrent tasks can run in the meantime
+        time.sleep(0.5)
+        flow_file.addAttribute("processed_count", str(processed_count))
+        session.transfer(flow_file, REL_SUCCESS)
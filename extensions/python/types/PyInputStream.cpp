@@ -83,8 +83,7 @@ PyObject* PyInputStream::read(PyInputStream* self, PyObject* args) {
 }
 
 PyTypeObject* PyInputStream::typeObject() {
-  static OwnedObject PyInputStreamType{PyType_FromSpec(&PyInputStreamTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyInputStreamType.get());
+  return typeObjectFromSpec(PyInputStreamTypeSpec);
 }
 
 }  // namespace org::apache::nifi::minifi::extensions::python
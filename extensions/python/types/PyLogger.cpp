@@ -135,8 +135,7 @@ PyObject* PyLogger::trace(PyLogger* self, PyObject* args) {
 }
 
 PyTypeObject* PyLogger::typeObject() {
-  static OwnedObject PyLoggerType{PyType_FromSpec(&PyLoggerTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyLoggerType.get());
+  return typeObjectFromSpec(PyLoggerTypeSpec);
 }
 }  // namespace org::apache::nifi::minifi::extensions::python
 }  // extern "C"
@@ -80,8 +80,7 @@ PyObject* PyOutputStream::write(PyOutputStream* self, PyObject* args) {
 }
 
 PyTypeObject* PyOutputStream::typeObject() {
-  static OwnedObject PyOutputStreamType{PyType_FromSpec(&PyOutputStreamTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyOutputStreamType.get());
+  return typeObjectFromSpec(PyOutputStreamTypeSpec);
 }
 
 }  // namespace org::apache::nifi::minifi::extensions::python
@@ -85,8 +85,7 @@ PyObject* PyProcessContext::getStateManager(PyProcessContext* self, PyObject*) {
 }
 
 PyTypeObject* PyProcessContext::typeObject() {
-  static OwnedObject PyProcessContextType{PyType_FromSpec(&PyProcessContextTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyProcessContextType.get());
+  return typeObjectFromSpec(PyProcessContextTypeSpec);
 }
 
 }  // namespace org::apache::nifi::minifi::extensions::python
@@ -257,8 +257,7 @@ PyObject* PyProcessSessionObject::transfer(PyProcessSessionObject* self, PyObjec
 }
 
 PyTypeObject* PyProcessSessionObject::typeObject() {
-  static OwnedObject PyProcessSessionObjectType{PyType_FromSpec(&PyProcessSessionObjectTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyProcessSessionObjectType.get());
+  return typeObjectFromSpec(PyProcessSessionObjectTypeSpec);
 }
 }  // extern "C"
 
@@ -119,8 +119,7 @@ PyObject* PyProcessor::addProperty(PyProcessor* self, PyObject* args) {
 }
 
 PyTypeObject* PyProcessor::typeObject() {
-  static OwnedObject PyProcessorType{PyType_FromSpec(&PyProcessorTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyProcessorType.get());
+  return typeObjectFromSpec(PyProcessorTypeSpec);
 }
 
 }  // namespace org::apache::nifi::minifi::extensions::python
@@ -64,8 +64,7 @@ PyObject* PyRelationship::getDescription(PyRelationship* self, PyObject*) {
 }
 
 PyTypeObject* PyRelationship::typeObject() {
-  static OwnedObject PyRelationshipType{PyType_FromSpec(&PyRelationshipTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyRelationshipType.get());
+  return typeObjectFromSpec(PyRelationshipTypeSpec);
 }
 
 }  // namespace org::apache::nifi::minifi::extensions::python
@@ -138,8 +138,7 @@ PyObject* PyScriptFlowFile::setAttribute(PyScriptFlowFile* self, PyObject* args)
 }
 
 PyTypeObject* PyScriptFlowFile::typeObject() {
-  static OwnedObject PyScriptFlowFileType{PyType_FromSpec(&PyScriptFlowFileTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyScriptFlowFileType.get());
+  return typeObjectFromSpec(PyScriptFlowFileTypeSpec);
 }
 }  // namespace org::apache::nifi::minifi::extensions::python
 }  // extern "C"
@@ -95,8 +95,7 @@ PyObject* PyStateManager::get(PyStateManager* self, PyObject*) {
 }
 
 PyTypeObject* PyStateManager::typeObject() {
-  static OwnedObject PyStateManagerType{PyType_FromSpec(&PyStateManagerTypeSpec)};
-  return reinterpret_cast<PyTypeObject*>(PyStateManagerType.get());
+  return typeObjectFromSpec(PyStateManagerTypeSpec);
 }
 
 }  // namespace org::apache::nifi::minifi::extensions::python
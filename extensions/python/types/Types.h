@@ -369,4 +369,15 @@ template<class T>
 void pythonAllocatedInstanceDealloc(T* self) {
   self->~T();
 }
+
+/**
+ * Returns the type object created from the spec for the interpreter of the calling thread.
+ * Interpreters with their own GIL can't share objects, so each of them gets its own type objects.
+ */
+PyTypeObject* typeObjectFromSpec(PyType_Spec& spec);
+
+/**
+ * Drops the type objects of the interpreter of the calling thread, has to be called before ending a subinterpreter.
+ */
+void releaseTypeObjectsOfCurrentInterpreter();
 }  // namespace org::apache::nifi::minifi::extensions::python
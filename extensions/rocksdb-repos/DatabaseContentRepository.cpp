@@ -180,6 +180,11 @@ std::shared_ptr<io::BaseStream> DatabaseContentRepository::read(const minifi::Re
   return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), false);
 }
 
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::readMapped(const minifi::ResourceClaim &claim) {
+  // RocksDbStream holds the pinned value, which it exposes through getBuffer()
+  return read(claim);
+}
+
 bool DatabaseContentRepository::exists(const minifi::ResourceClaim &streamId) {
   auto opendb = db_->open();
   if (!opendb) {
@@ -62,6 +62,7 @@ class DatabaseContentRepository : public core::ContentRepository {
   bool initialize(const std::shared_ptr<minifi::Configure> &configuration) override;
   std::shared_ptr<io::BaseStream> write(const minifi::ResourceClaim &claim, bool append = false) override;
   std::shared_ptr<io::BaseStream> read(const minifi::ResourceClaim &claim) override;
+  std::shared_ptr<io::BaseStream> readMapped(const minifi::ResourceClaim &claim) override;
 
   bool close(const minifi::ResourceClaim &claim) override {
     return remove(claim);
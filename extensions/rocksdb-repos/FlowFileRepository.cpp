@@ -16,11 +16,14 @@
  */
 #include "FlowFileRepository.h"
 
+#include <algorithm>
 #include <chrono>
+#include <future>
 #include <list>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -31,6 +34,8 @@
 #include "utils/gsl.h"
 #include "core/Resource.h"
 #include "utils/OptionalUtils.h"
+#include "utils/StringUtils.h"
+#include "core/Property.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -125,13 +130,82 @@ void FlowFileRepository::initialize_repository() {
     logger_->log_trace("Couldn't open database to load existing flow files");
     return;
   }
-  logger_->log_info("Reading existing flow files from database");
-
+  logger_->log_info("Reading existing flow files from database using %zu threads", recovery_thread_count_);
+
+  utils::ThreadPool<utils::TaskRescheduleInfo> recovery_thread_pool{gsl::narrow<int>(recovery_thread_count_), false, nullptr, "FlowFileRepositoryRecoveryThreadPool"};
+  recovery_thread_pool.start();
+
+  const auto recovery_start = std::chrono::steady_clock::now();
+  size_t read_count = 0;
+  size_t restored_count = 0;
+  // the flow files are read in chunks: the next chunk is read from the database while the previous one is deserialized,
+  // so at most two chunks are held in memory in addition to what the connections keep after swapping
+  std::shared_ptr<std::vector<RecoveredFlowFile>> previous_chunk;
+  std::vector<std::future<utils::TaskRescheduleInfo>> previous_chunk_slices;
   auto it = opendb->NewIterator(rocksdb::ReadOptions());
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    utils::Identifier container_id;
-    auto eventRead = FlowFileRecord::DeSerialize(gsl::make_span(it->value()).as_span<const std::byte>(), content_repo_, container_id);
-    std::string key = it->key().ToString();
+  it->SeekToFirst();
+  while (it->Valid() || previous_chunk) {
+    std::shared_ptr<std::vector<RecoveredFlowFile>> chunk;
+    std::vector<std::future<utils::TaskRescheduleInfo>> chunk_slices;
+    if (it->Valid()) {
+      chunk = std::make_shared<std::vector<RecoveredFlowFile>>();
+      chunk->reserve(RECOVERY_CHUNK_SIZE);
+      for (; it->Valid() && chunk->size() < RECOVERY_CHUNK_SIZE; it->Next()) {
+        chunk->push_back(RecoveredFlowFile{.key = it->key().ToString(), .value = it->value().ToString()});
+      }
+      chunk_slices = deserializeRecoveredFlowFiles(recovery_thread_pool, chunk);
+    }
+    if (previous_chunk) {
+      for (auto& slice : previous_chunk_slices) {
+        slice.wait();
+      }
+      read_count += previous_chunk->size();
+      restored_count += restoreRecoveredFlowFiles(*previous_chunk);
+      const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - recovery_start);
+      logger_->log_info("Flow file repository recovery progress: read %zu, restored %zu flow files in %" PRId64 " ms", read_count, restored_count, int64_t{elapsed.count()});
+    }
+    previous_chunk = std::move(chunk);
+    previous_chunk_slices = std::move(chunk_slices);
+  }
+  recovery_thread_pool.shutdown();
+  flush();
+  content_repo_->clearOrphans();
+}
+
+std::vector<std::future<utils::TaskRescheduleInfo>> FlowFileRepository::deserializeRecoveredFlowFiles(utils::ThreadPool<utils::TaskRescheduleInfo>& thread_pool,
+    const std::shared_ptr<std::vector<RecoveredFlowFile>>& chunk) const {
+  const size_t slice_count = std::max(size_t{1}, std::min(recovery_thread_count_, chunk->size()));
+  const size_t slice_size = (chunk->size() + slice_count - 1) / slice_count;
+  std::vector<std::future<utils::TaskRescheduleInfo>> slices;
+  for (size_t begin = 0; begin < chunk->size(); begin += slice_size) {
+    const size_t end = std::min(chunk->size(), begin + slice_size);
+    utils::Worker<utils::TaskRescheduleInfo> task{[this, chunk, begin, end] {
+        for (size_t i = begin; i < end; ++i) {
+          auto& recovered = (*chunk)[i];
+          try {
+            recovered.flow_file = FlowFileRecord::DeSerialize(gsl::make_span(recovered.value).as_span<const std::byte>(), content_repo_, recovered.container_id);
+          } catch (const std::exception& ex) {
+            logger_->log_error("Error while deserializing flow file %s: %s", recovered.key, ex.what());
+          }
+          // the serialized form is not needed anymore
+          std::string{}.swap(recovered.value);
+        }
+        return utils::TaskRescheduleInfo::Done();
+      },
+      "",  // doesn't matter that tasks alias by name, as we never actually query their status or stop a single task
+      std::make_unique<utils::ComplexMonitor>()};
+    std::future<utils::TaskRescheduleInfo> slice;
+    thread_pool.execute(std::move(task), slice);
+    slices.push_back(std::move(slice));
+  }
+  return slices;
+}
+
+size_t FlowFileRepository::restoreRecoveredFlowFiles(std::vector<RecoveredFlowFile>& chunk) {
+  size_t restored_count = 0;
+  for (auto& recovered : chunk) {
+    auto& eventRead = recovered.flow_file;
+    const auto& container_id = recovered.container_id;
     if (eventRead) {
       // on behalf of the just resurrected persisted instance
       auto claim = eventRead->getResourceClaim();
@@ -150,17 +224,18 @@ void FlowFileRepository::initialize_repository() {
         // we found the connection for the persistent flowFile
         // even if a processor immediately marks it for deletion, flush only happens after prune_stored_flowfiles
         search->second->restore(eventRead);
+        ++restored_count;
       } else {
         logger_->log_warn("Could not find connection for %s, path %s ", container_id.to_string(), eventRead->getContentFullPath());
-        keys_to_delete_.enqueue({.key = key, .content = eventRead->getResourceClaim()});
+        keys_to_delete_.enqueue({.key = recovered.key, .content = eventRead->getResourceClaim()});
       }
     } else {
       // failed to deserialize FlowFile, cannot clear claim
-      keys_to_delete_.enqueue({.key = key});
+      keys_to_delete_.enqueue({.key = recovered.key});
     }
+    eventRead.reset();
   }
-  flush();
-  content_repo_->clearOrphans();
+  return restored_count;
 }
 
 void FlowFileRepository::loadComponent(const std::shared_ptr<core::ContentRepository> &content_repo) {
@@ -180,6 +255,8 @@ bool FlowFileRepository::initialize(const std::shared_ptr<Configure> &configure)
   logger_->log_debug("NiFi FlowFile Repository Directory %s", directory_);
 
   setCompactionPeriod(configure);
+  setGroupCommitOptions(configure);
+  setRecoveryThreadCount(configure);
 
   const auto encrypted_env = createEncryptingEnv(utils::crypto::EncryptionManager{configure->getHome()}, DbEncryptionOptions{directory_, ENCRYPTION_KEY_NAME});
   logger_->log_info("Using %s FlowFileRepository", encrypted_env ? "encrypted" : "plaintext");
@@ -236,6 +313,88 @@ void FlowFileRepository::setCompactionPeriod(const std::shared_ptr<Configure> &c
   }
 }
 
+void FlowFileRepository::setGroupCommitOptions(const std::shared_ptr<Configure> &configure) {
+  if (auto group_commit_window_str = configure->get(Configure::nifi_flowfile_repository_rocksdb_group_commit_window)) {
+    if (auto group_commit_window = TimePeriodValue::fromString(group_commit_window_str.value())) {
+      group_commit_window_ = group_commit_window->getMilliseconds();
+      logger_->log_info("Using group commit window of %" PRId64 " ms", int64_t{group_commit_window_.count()});
+    } else {
+      logger_->log_error("Malformed property '%s', expected time period, group commit is disabled", Configure::nifi_flowfile_repository_rocksdb_group_commit_window);
+    }
+  }
+  if (auto sync_str = configure->get(Configure::nifi_flowfile_repository_rocksdb_sync)) {
+    if (auto sync = utils::StringUtils::toBool(sync_str.value())) {
+      write_options_.sync = sync.value();
+    } else {
+      logger_->log_error("Malformed property '%s', expected boolean, using default", Configure::nifi_flowfile_repository_rocksdb_sync);
+    }
+  }
+}
+
+void FlowFileRepository::setRecoveryThreadCount(const std::shared_ptr<Configure> &configure) {
+  recovery_thread_count_ = std::clamp(size_t{std::thread::hardware_concurrency()}, size_t{1}, MAX_DEFAULT_RECOVERY_THREAD_COUNT);
+  if (auto thread_count_str = configure->get(Configure::nifi_flowfile_repository_rocksdb_recovery_threads)) {
+    uint64_t thread_count = 0;
+    if (core::Property::StringToInt(thread_count_str.value(), thread_count) && thread_count > 0) {
+      recovery_thread_count_ = gsl::narrow<size_t>(thread_count);
+    } else {
+      logger_->log_error("Malformed property '%s', expected positive integer, using default", Configure::nifi_flowfile_repository_rocksdb_recovery_threads);
+    }
+  }
+}
+
+bool FlowFileRepository::MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) {
+  if (group_commit_window_.count() == 0) {
+    return RocksDbRepository::MultiPut(data);
+  }
+
+  PendingWrite pending_write{.data = &data};
+  std::unique_lock<std::mutex> lock(group_commit_mutex_);
+  pending_writes_.push_back(&pending_write);
+  group_commit_cv_.wait(lock, [&] { return pending_write.done || pending_writes_.front() == &pending_write; });
+  if (pending_write.done) {
+    // our write was committed by the leader of the group
+    return pending_write.success;
+  }
+
+  // we are the leader, give the concurrent sessions a chance to join the group
+  lock.unlock();
+  std::this_thread::sleep_for(group_commit_window_);
+  lock.lock();
+  const std::vector<PendingWrite*> group(pending_writes_.begin(), pending_writes_.end());
+  lock.unlock();
+
+  // writes arriving from now on wait for the next group, as we are still at the front of the queue
+  const bool success = writeGroup(group);
+
+  lock.lock();
+  for (auto* write : group) {
+    write->success = success;
+    write->done = true;
+    pending_writes_.pop_front();
+  }
+  group_commit_cv_.notify_all();
+  return success;
+}
+
+bool FlowFileRepository::writeGroup(const std::vector<PendingWrite*>& group) {
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  auto batch = opendb->createWriteBatch();
+  size_t item_count = 0;
+  for (const auto* write : group) {
+    if (!addToWriteBatch(batch, *write->data)) {
+      return false;
+    }
+    item_count += write->data->size();
+  }
+  logger_->log_debug("Writing %zu flow files of %zu sessions in a single batch", item_count, group.size());
+  auto operation = [this, &batch, &opendb]() { return opendb->Write(write_options_, &batch); };
+  return ExecuteWithRetry(operation);
+}
+
 bool FlowFileRepository::Delete(const std::string& key) {
   keys_to_delete_.enqueue({.key = key});
   return true;
@@ -21,6 +21,10 @@
 #include <string>
 #include <memory>
 #include <list>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <future>
 
 #include "utils/file/FileUtils.h"
 #include "rocksdb/options.h"
@@ -35,9 +39,11 @@
 #include "utils/crypto/EncryptionProvider.h"
 #include "SwapManager.h"
 #include "FlowFileLoader.h"
+#include "FlowFileRecord.h"
 #include "range/v3/algorithm/all_of.hpp"
 #include "utils/Literals.h"
 #include "utils/StoppableThread.h"
+#include "utils/ThreadPool.h"
 #include "RocksDbRepository.h"
 
 namespace org::apache::nifi::minifi::core::repository {
@@ -60,11 +66,21 @@ constexpr auto FLOWFILE_REPOSITORY_PURGE_PERIOD = std::chrono::seconds(2);
 class FlowFileRepository : public RocksDbRepository, public SwapManager {
   static constexpr std::chrono::milliseconds DEFAULT_COMPACTION_PERIOD = std::chrono::minutes{2};
 
+  static constexpr size_t RECOVERY_CHUNK_SIZE = 10000;
+  static constexpr size_t MAX_DEFAULT_RECOVERY_THREAD_COUNT = 8;
+
   struct ExpiredFlowFileInfo {
     std::string key;
     std::shared_ptr<ResourceClaim> content{};
   };
 
+  struct RecoveredFlowFile {
+    std::string key;
+    std::string value;
+    utils::Identifier container_id;
+    std::shared_ptr<FlowFileRecord> flow_file;
+  };
+
  public:
   static constexpr const char* ENCRYPTION_KEY_NAME = "nifi.flowfile.repository.encryption.key";
 
@@ -93,6 +109,7 @@ class FlowFileRepository : public RocksDbRepository, public SwapManager {
     return false;
   }
 
+  bool MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) override;
   bool Delete(const std::string& key) override;
   bool Delete(const std::shared_ptr<core::CoreComponent>& item) override;
 
@@ -105,11 +122,25 @@ class FlowFileRepository : public RocksDbRepository, public SwapManager {
   std::future<std::vector<std::shared_ptr<core::FlowFile>>> load(std::vector<SwappedFlowFile> flow_files) override;
 
  private:
+  struct PendingWrite {
+    const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>* data;
+    bool done = false;
+    bool success = false;
+  };
+
   void run() override;
   void initialize_repository();
+  void setRecoveryThreadCount(const std::shared_ptr<Configure> &configure);
+  // deserializes the flow files of the chunk on the thread pool, the returned futures become ready when their slice of the chunk is done
+  std::vector<std::future<utils::TaskRescheduleInfo>> deserializeRecoveredFlowFiles(utils::ThreadPool<utils::TaskRescheduleInfo>& thread_pool,
+      const std::shared_ptr<std::vector<RecoveredFlowFile>>& chunk) const;
+  // returns the number of flow files restored into a connection
+  size_t restoreRecoveredFlowFiles(std::vector<RecoveredFlowFile>& chunk);
 
   void runCompaction();
   void setCompactionPeriod(const std::shared_ptr<Configure> &configure);
+  void setGroupCommitOptions(const std::shared_ptr<Configure> &configure);
+  bool writeGroup(const std::vector<PendingWrite*>& group);
 
   void deserializeFlowFilesWithNoContentClaim(minifi::internal::OpenRocksDb& opendb, std::list<ExpiredFlowFileInfo>& flow_files);
 
@@ -120,6 +151,16 @@ class FlowFileRepository : public RocksDbRepository, public SwapManager {
 
   std::chrono::milliseconds compaction_period_;
   std::unique_ptr<utils::StoppableThread> compaction_thread_;
+
+  // number of threads deserializing the flow files read from the database on startup
+  size_t recovery_thread_count_{1};
+
+  // writes of concurrent MultiPut calls arriving within this window are merged into a single write batch
+  std::chrono::milliseconds group_commit_window_{0};
+  std::mutex group_commit_mutex_;
+  std::condition_variable group_commit_cv_;
+  // the first element is the leader of the group currently being assembled or written
+  std::deque<PendingWrite*> pending_writes_;
 };
 
 }  // namespace org::apache::nifi::minifi::core::repository
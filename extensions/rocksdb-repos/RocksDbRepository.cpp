@@ -52,7 +52,7 @@ bool RocksDbRepository::Put(const std::string& key, const uint8_t *buf, size_t b
     return false;
   }
   rocksdb::Slice value((const char *) buf, bufLen);
-  auto operation = [&key, &value, &opendb]() { return opendb->Put(rocksdb::WriteOptions(), key, value); };
+  auto operation = [this, &key, &value, &opendb]() { return opendb->Put(write_options_, key, value); };
   return ExecuteWithRetry(operation);
 }
 
@@ -62,6 +62,14 @@ bool RocksDbRepository::MultiPut(const std::vector<std::pair<std::string, std::u
     return false;
   }
   auto batch = opendb->createWriteBatch();
+  if (!addToWriteBatch(batch, data)) {
+    return false;
+  }
+  auto operation = [this, &batch, &opendb]() { return opendb->Write(write_options_, &batch); };
+  return ExecuteWithRetry(operation);
+}
+
+bool RocksDbRepository::addToWriteBatch(minifi::internal::WriteBatch& batch, const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) {
   for (const auto &item : data) {
     const auto buf = utils::as_span<const char>(item.second->getBuffer());
     rocksdb::Slice value(buf.data(), buf.size());
@@ -70,8 +78,7 @@ bool RocksDbRepository::MultiPut(const std::vector<std::pair<std::string, std::u
       return false;
     }
   }
-  auto operation = [&batch, &opendb]() { return opendb->Write(rocksdb::WriteOptions(), &batch); };
-  return ExecuteWithRetry(operation);
+  return true;
 }
 
 bool RocksDbRepository::Get(const std::string &key, std::string &value) {
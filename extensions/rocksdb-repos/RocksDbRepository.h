@@ -50,12 +50,14 @@ class RocksDbRepository : public ThreadedRepository {
 
  protected:
   bool ExecuteWithRetry(const std::function<rocksdb::Status()>& operation);
+  bool addToWriteBatch(minifi::internal::WriteBatch& batch, const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data);
 
   std::thread& getThread() override {
     return thread_;
   }
 
   std::unique_ptr<minifi::internal::RocksDatabase> db_;
+  rocksdb::WriteOptions write_options_;
   std::shared_ptr<logging::Logger> logger_;
   std::thread thread_;
 };
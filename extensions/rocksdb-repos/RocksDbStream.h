@@ -21,7 +21,9 @@
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <span>
 #include "database/RocksDatabase.h"
+#include "rocksdb/slice.h"
 #include "io/BaseStream.h"
 #include "core/logging/LoggerConfiguration.h"
 
@@ -63,6 +65,14 @@ class RocksDbStream : public io::BaseStream {
     return size_;
   }
 
+  /**
+   * Returns the value read when the stream was opened, pinned in the rocksdb block cache or memtable
+   * where possible, so it does not have to be copied.
+   */
+  std::span<const std::byte> getBuffer() const override {
+    return {reinterpret_cast<const std::byte*>(value_.data()), value_.size()};
+  }
+
   using BaseStream::write;
   using BaseStream::read;
 
@@ -89,7 +99,7 @@ class RocksDbStream : public io::BaseStream {
 
   size_t offset_;
 
-  std::string value_;
+  rocksdb::PinnableSlice value_;
 
   gsl::not_null<minifi::internal::RocksDatabase*> db_;
 
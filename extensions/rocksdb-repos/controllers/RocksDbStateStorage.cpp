@@ -174,6 +174,49 @@ bool RocksDbStateStorage::remove(const std::string& key) {
   return true;
 }
 
+bool RocksDbStateStorage::setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove) {
+  if (!db_) {
+    return false;
+  }
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  auto batch = opendb->createWriteBatch();
+  for (const auto& [key, value] : kvs_to_set) {
+    batch.Put(key, value);
+  }
+  for (const auto& key : keys_to_remove) {
+    batch.Delete(key);
+  }
+  rocksdb::Status status = opendb->Write(default_write_options, &batch);
+  if (!status.ok()) {
+    logger_->log_error("Failed to Write batch to RocksDB database at %s, error: %s", directory_.c_str(), status.getState());
+    return false;
+  }
+  return true;
+}
+
+bool RocksDbStateStorage::getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs) {
+  if (!db_) {
+    return false;
+  }
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  kvs.clear();
+  auto it = opendb->NewIterator(rocksdb::ReadOptions());
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+    kvs.emplace(it->key().ToString(), it->value().ToString());
+  }
+  if (!it->status().ok()) {
+    logger_->log_error("Encountered error when iterating through RocksDB database at %s, error: %s", directory_.c_str(), it->status().getState());
+    return false;
+  }
+  return true;
+}
+
 bool RocksDbStateStorage::clear() {
   if (!db_) {
     return false;
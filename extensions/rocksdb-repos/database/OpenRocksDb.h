@@ -52,6 +52,8 @@ class OpenRocksDb {
 
   rocksdb::Status Get(const rocksdb::ReadOptions& options, const rocksdb::Slice& key, std::string* value);
 
+  rocksdb::Status Get(const rocksdb::ReadOptions& options, const rocksdb::Slice& key, rocksdb::PinnableSlice* value);
+
   std::vector<rocksdb::Status> MultiGet(const rocksdb::ReadOptions& options, const std::vector<rocksdb::Slice>& keys, std::vector<std::string>* values);
 
   rocksdb::Status Write(const rocksdb::WriteOptions& options, internal::WriteBatch* updates);
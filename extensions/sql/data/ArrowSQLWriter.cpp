@@ -0,0 +1,483 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ArrowSQLWriter.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+#include "Exception.h"
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::sql {
+
+namespace {
+
+static_assert(std::endian::native == std::endian::little, "The Arrow IPC messages are written in the byte order of the host, which must be little endian");
+
+// Builds the flatbuffers of the Arrow IPC message metadata back to front, the same way as the flatbuffers library does,
+// so that every object is complete before the objects referring to it are added.
+class FlatBufferBuilder {
+ public:
+  // the distance of an object from the end of the buffer, which does not change as the buffer grows
+  using Offset = uint32_t;
+
+  template<typename T>
+  void push(T value) {
+    preAlign(sizeof(T), sizeof(T));
+    prepend(&value, sizeof(T));
+  }
+
+  Offset createString(std::string_view str) {
+    preAlign(str.size() + 1, sizeof(uint32_t));
+    const char terminator = 0;
+    prepend(&terminator, 1);
+    prepend(str.data(), str.size());
+    push(gsl::narrow<uint32_t>(str.size()));
+    return size();
+  }
+
+  // structs of two 64-bit integers, e.g. the FieldNode and Buffer structs of the Arrow schema
+  Offset createStructVector(const std::vector<std::array<int64_t, 2>>& elements) {
+    preAlign(elements.size() * sizeof(std::array<int64_t, 2>), sizeof(uint32_t));
+    preAlign(elements.size() * sizeof(std::array<int64_t, 2>), sizeof(int64_t));
+    for (auto it = elements.rbegin(); it != elements.rend(); ++it) {
+      prepend(it->data(), sizeof(std::array<int64_t, 2>));
+    }
+    push(gsl::narrow<uint32_t>(elements.size()));
+    return size();
+  }
+
+  Offset createTableVector(const std::vector<Offset>& tables) {
+    preAlign(tables.size() * sizeof(uint32_t), sizeof(uint32_t));
+    for (auto it = tables.rbegin(); it != tables.rend(); ++it) {
+      pushOffset(*it);
+    }
+    push(gsl::narrow<uint32_t>(tables.size()));
+    return size();
+  }
+
+  void startTable() {
+    fields_.clear();
+    table_start_ = size();
+  }
+
+  template<typename T>
+  void addField(uint16_t field_id, T value) {
+    push(value);
+    fields_.emplace_back(field_id, size());
+  }
+
+  void addOffsetField(uint16_t field_id, Offset offset) {
+    pushOffset(offset);
+    fields_.emplace_back(field_id, size());
+  }
+
+  Offset endTable() {
+    push(int32_t{0});  // the offset of the vtable, patched below
+    const Offset table = size();
+    uint16_t field_count = 0;
+    for (const auto& [field_id, field_offset] : fields_) {
+      field_count = std::max(field_count, gsl::narrow<uint16_t>(field_id + 1));
+    }
+    std::vector<uint16_t> vtable(field_count + 2);
+    vtable[0] = gsl::narrow<uint16_t>(vtable.size() * sizeof(uint16_t));
+    vtable[1] = gsl::narrow<uint16_t>(table - table_start_);
+    for (const auto& [field_id, field_offset] : fields_) {
+      vtable[field_id + 2] = gsl::narrow<uint16_t>(table - field_offset);
+    }
+    for (auto it = vtable.rbegin(); it != vtable.rend(); ++it) {
+      prepend(&*it, sizeof(uint16_t));
+    }
+    const auto vtable_distance = gsl::narrow<int32_t>(size() - table);
+    std::memcpy(buffer_.data() + (buffer_.size() - table), &vtable_distance, sizeof(vtable_distance));
+    return table;
+  }
+
+  std::span<const std::byte> finish(Offset root) {
+    preAlign(sizeof(uint32_t), MAX_ALIGNMENT);
+    pushOffset(root);
+    return buffer_;
+  }
+
+ private:
+  static constexpr size_t MAX_ALIGNMENT = sizeof(int64_t);
+
+  [[nodiscard]] Offset size() const {
+    return gsl::narrow<Offset>(buffer_.size());
+  }
+
+  void pushOffset(Offset offset) {
+    preAlign(sizeof(uint32_t), sizeof(uint32_t));
+    push(gsl::narrow<uint32_t>(size() + sizeof(uint32_t) - offset));
+  }
+
+  // pads the buffer so that it is aligned after adding length bytes
+  void preAlign(size_t length, size_t alignment) {
+    const size_t padding = (alignment - (buffer_.size() + length) % alignment) % alignment;
+    buffer_.insert(buffer_.begin(), padding, std::byte{0});
+  }
+
+  void prepend(const void* data, size_t length) {
+    const auto* bytes = static_cast<const std::byte*>(data);
+    buffer_.insert(buffer_.begin(), bytes, bytes + length);
+  }
+
+  std::vector<std::byte> buffer_;
+  std::vector<std::pair<uint16_t, Offset>> fields_;
+  Offset table_start_{0};
+};
+
+// identifiers of the Arrow IPC format, see Schema.fbs and Message.fbs of the Arrow project
+constexpr int16_t METADATA_VERSION_V5 = 4;
+constexpr uint8_t MESSAGE_HEADER_SCHEMA = 1;
+constexpr uint8_t MESSAGE_HEADER_RECORD_BATCH = 3;
+constexpr uint8_t TYPE_INT = 2;
+constexpr uint8_t TYPE_FLOATING_POINT = 3;
+constexpr uint8_t TYPE_UTF8 = 5;
+constexpr int16_t PRECISION_DOUBLE = 2;
+constexpr uint32_t CONTINUATION_MARKER = 0xFFFFFFFF;
+constexpr size_t BODY_ALIGNMENT = 8;
+
+size_t paddingOf(size_t length) {
+  return (BODY_ALIGNMENT - length % BODY_ALIGNMENT) % BODY_ALIGNMENT;
+}
+
+FlatBufferBuilder::Offset createMessage(FlatBufferBuilder& builder, uint8_t header_type, FlatBufferBuilder::Offset header, int64_t body_length) {
+  builder.startTable();
+  builder.addField<int64_t>(3, body_length);
+  builder.addOffsetField(2, header);
+  builder.addField<int16_t>(0, METADATA_VERSION_V5);
+  builder.addField<uint8_t>(1, header_type);
+  return builder.endTable();
+}
+
+template<typename T>
+std::string toString(T value) {
+  std::array<char, 64> buffer{};
+  const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  return std::string(buffer.data(), result.ptr);
+}
+
+}  // namespace
+
+void ArrowSQLWriter::Column::setType(ColumnType column_type) {
+  type = column_type;
+  // the values of the NULLs added before the type was known
+  if (column_type == ColumnType::UTF8) {
+    offsets.assign(length + 1, 0);
+  } else {
+    values.assign(length * (column_type == ColumnType::INT32 ? sizeof(int32_t) : sizeof(int64_t)), std::byte{0});
+  }
+}
+
+void ArrowSQLWriter::Column::appendValidity(bool valid) {
+  if (length % 8 == 0) {
+    validity.push_back(0);
+  }
+  if (valid) {
+    validity.back() |= static_cast<uint8_t>(1u << (length % 8));
+  } else {
+    ++null_count;
+  }
+  ++length;
+}
+
+void ArrowSQLWriter::Column::appendNull() {
+  if (type == ColumnType::UTF8) {
+    offsets.push_back(offsets.back());
+  } else if (type) {
+    values.resize(values.size() + (type == ColumnType::INT32 ? sizeof(int32_t) : sizeof(int64_t)));
+  }
+  appendValidity(false);
+}
+
+void ArrowSQLWriter::Column::appendValue(std::span<const std::byte> value) {
+  values.insert(values.end(), value.begin(), value.end());
+  appendValidity(true);
+}
+
+void ArrowSQLWriter::Column::appendString(std::string_view value) {
+  const auto* bytes = reinterpret_cast<const std::byte*>(value.data());
+  values.insert(values.end(), bytes, bytes + value.size());
+  offsets.push_back(gsl::narrow<int32_t>(values.size()));
+  appendValidity(true);
+}
+
+void ArrowSQLWriter::Column::clear() {
+  length = 0;
+  null_count = 0;
+  validity.clear();
+  values.clear();
+  offsets.clear();
+  if (type == ColumnType::UTF8) {
+    offsets.push_back(0);
+  }
+}
+
+ArrowSQLWriter::ArrowSQLWriter(ColumnFilter column_filter, size_t rows_per_record_batch)
+  : column_filter_(std::move(column_filter)),
+    rows_per_record_batch_(std::max(rows_per_record_batch, size_t{1})) {
+}
+
+void ArrowSQLWriter::setOutputStream(std::shared_ptr<io::OutputStream> output_stream) {
+  output_stream_ = std::move(output_stream);
+  bytes_written_ = 0;
+}
+
+void ArrowSQLWriter::beginProcessBatch() {
+  for (auto& column : columns_) {
+    column.clear();
+  }
+  buffered_rows_ = 0;
+  stream_started_ = false;
+}
+
+void ArrowSQLWriter::endProcessBatch() {
+  if (buffered_rows_ > 0) {
+    writeRecordBatch();
+  }
+  if (!stream_started_) {
+    return;
+  }
+  const std::array<uint32_t, 2> end_of_stream{CONTINUATION_MARKER, 0};
+  write(as_bytes(std::span(end_of_stream)));
+  stream_started_ = false;
+}
+
+void ArrowSQLWriter::beginProcessRow() {
+  current_column_ = 0;
+}
+
+void ArrowSQLWriter::endProcessRow() {
+  if (current_column_ != columns_.size()) {
+    throw Exception(PROCESSOR_EXCEPTION, "ArrowSQLWriter: the row has " + std::to_string(current_column_) + " columns instead of " + std::to_string(columns_.size()));
+  }
+  if (++buffered_rows_ == rows_per_record_batch_) {
+    writeRecordBatch();
+  }
+}
+
+void ArrowSQLWriter::finishProcessing() {}
+
+void ArrowSQLWriter::processColumnNames(const std::vector<std::string>& names) {
+  // the names are passed with the first row of every batch, the columns are kept from the first one
+  if (!columns_.empty()) {
+    return;
+  }
+  columns_.reserve(names.size());
+  for (const auto& name : names) {
+    auto& column = columns_.emplace_back();
+    column.name = name;
+    column.included = column_filter_(name);
+  }
+}
+
+void ArrowSQLWriter::processColumn(const std::string& name, const std::string& value) {
+  auto* column = nextColumn(name);
+  if (!column) {
+    return;
+  }
+  if (!column->type && !schema_fixed_) {
+    column->setType(ColumnType::UTF8);
+  }
+  if (column->type != ColumnType::UTF8) {
+    throw Exception(PROCESSOR_EXCEPTION, "ArrowSQLWriter: string value in the non-string column '" + name + "'");
+  }
+  column->appendString(value);
+}
+
+void ArrowSQLWriter::processColumn(const std::string& name, double value) {
+  processNumber(name, ColumnType::DOUBLE, value);
+}
+
+void ArrowSQLWriter::processColumn(const std::string& name, int value) {
+  processNumber(name, ColumnType::INT32, gsl::narrow<int32_t>(value));
+}
+
+void ArrowSQLWriter::processColumn(const std::string& name, long long value) {
+  processNumber(name, ColumnType::INT64, gsl::narrow<int64_t>(value));
+}
+
+void ArrowSQLWriter::processColumn(const std::string& name, unsigned long long value) {
+  processNumber(name, ColumnType::UINT64, gsl::narrow<uint64_t>(value));
+}
+
+void ArrowSQLWriter::processColumn(const std::string& name, const char* /*value*/) {
+  // the rowset processor passes the NULL values as C strings
+  if (auto* column = nextColumn(name)) {
+    column->appendNull();
+  }
+}
+
+template<typename T>
+void ArrowSQLWriter::processNumber(const std::string& name, ColumnType type, T value) {
+  auto* column = nextColumn(name);
+  if (!column) {
+    return;
+  }
+  if (!column->type && !schema_fixed_) {
+    column->setType(type);
+  }
+  if (column->type == type) {
+    column->appendValue(as_bytes(std::span(&value, 1)));
+  } else if (column->type == ColumnType::UTF8) {
+    column->appendString(toString(value));
+  } else if (column->type == ColumnType::INT64 && type == ColumnType::INT32) {
+    const auto widened_value = static_cast<int64_t>(value);
+    column->appendValue(as_bytes(std::span(&widened_value, 1)));
+  } else {
+    throw Exception(PROCESSOR_EXCEPTION, "ArrowSQLWriter: the type of the value does not match the type of the column '" + name + "'");
+  }
+}
+
+ArrowSQLWriter::Column* ArrowSQLWriter::nextColumn(const std::string& name) {
+  if (current_column_ >= columns_.size() || columns_[current_column_].name != name) {
+    throw Exception(PROCESSOR_EXCEPTION, "ArrowSQLWriter: unexpected column '" + name + "'");
+  }
+  auto& column = columns_[current_column_++];
+  return column.included ? &column : nullptr;
+}
+
+void ArrowSQLWriter::writeRecordBatch() {
+  if (!schema_fixed_) {
+    for (auto& column : columns_) {
+      if (!column.type) {
+        column.setType(ColumnType::UTF8);
+      }
+    }
+    schema_fixed_ = true;
+  }
+  if (!stream_started_) {
+    writeSchema();
+    stream_started_ = true;
+  }
+
+  std::vector<std::array<int64_t, 2>> nodes;
+  std::vector<std::array<int64_t, 2>> buffers;
+  std::vector<std::span<const std::byte>> body_buffers;
+  int64_t body_length = 0;
+  const auto add_buffer = [&](std::span<const std::byte> buffer) {
+    buffers.push_back({body_length, gsl::narrow<int64_t>(buffer.size())});
+    body_buffers.push_back(buffer);
+    body_length += gsl::narrow<int64_t>(buffer.size() + paddingOf(buffer.size()));
+  };
+  for (const auto& column : columns_) {
+    if (!column.included) {
+      continue;
+    }
+    nodes.push_back({gsl::narrow<int64_t>(column.length), gsl::narrow<int64_t>(column.null_count)});
+    // the validity bitmap can be omitted if there are no NULLs
+    add_buffer(column.null_count > 0 ? as_bytes(std::span(column.validity)) : std::span<const std::byte>{});
+    if (column.type == ColumnType::UTF8) {
+      add_buffer(as_bytes(std::span(column.offsets)));
+    }
+    add_buffer(column.values);
+  }
+
+  FlatBufferBuilder builder;
+  const auto buffers_offset = builder.createStructVector(buffers);
+  const auto nodes_offset = builder.createStructVector(nodes);
+  builder.startTable();
+  builder.addField<int64_t>(0, gsl::narrow<int64_t>(buffered_rows_));
+  builder.addOffsetField(1, nodes_offset);
+  builder.addOffsetField(2, buffers_offset);
+  const auto record_batch = builder.endTable();
+  writeMessage(builder.finish(createMessage(builder, MESSAGE_HEADER_RECORD_BATCH, record_batch, body_length)), body_buffers);
+
+  for (auto& column : columns_) {
+    column.clear();
+  }
+  buffered_rows_ = 0;
+}
+
+void ArrowSQLWriter::writeSchema() {
+  FlatBufferBuilder builder;
+  std::vector<FlatBufferBuilder::Offset> fields;
+  for (const auto& column : columns_) {
+    if (!column.included) {
+      continue;
+    }
+    const auto name = builder.createString(column.name);
+    const auto children = builder.createTableVector({});
+    uint8_t type_type = TYPE_UTF8;
+    builder.startTable();
+    switch (*column.type) {
+      case ColumnType::INT32:
+      case ColumnType::INT64:
+      case ColumnType::UINT64:
+        type_type = TYPE_INT;
+        builder.addField<int32_t>(0, column.type == ColumnType::INT32 ? 32 : 64);
+        builder.addField<uint8_t>(1, column.type != ColumnType::UINT64);
+        break;
+      case ColumnType::DOUBLE:
+        type_type = TYPE_FLOATING_POINT;
+        builder.addField<int16_t>(0, PRECISION_DOUBLE);
+        break;
+      case ColumnType::UTF8:
+        break;
+    }
+    const auto type = builder.endTable();
+
+    builder.startTable();
+    builder.addOffsetField(0, name);
+    builder.addOffsetField(3, type);
+    builder.addOffsetField(5, children);
+    builder.addField<uint8_t>(1, 1);  // nullable
+    builder.addField<uint8_t>(2, type_type);
+    fields.push_back(builder.endTable());
+  }
+  const auto fields_offset = builder.createTableVector(fields);
+  builder.startTable();
+  builder.addOffsetField(1, fields_offset);
+  const auto schema = builder.endTable();
+  writeMessage(builder.finish(createMessage(builder, MESSAGE_HEADER_SCHEMA, schema, 0)), {});
+}
+
+void ArrowSQLWriter::writeMessage(std::span<const std::byte> metadata, const std::vector<std::span<const std::byte>>& body_buffers) {
+  static constexpr std::array<std::byte, BODY_ALIGNMENT> padding{};
+  // the metadata is padded so that the body following it starts at an aligned position
+  const std::array<uint32_t, 2> prefix{CONTINUATION_MARKER, gsl::narrow<uint32_t>(metadata.size() + paddingOf(metadata.size()))};
+  write(as_bytes(std::span(prefix)));
+  write(metadata);
+  write(std::span(padding).first(paddingOf(metadata.size())));
+  for (const auto& buffer : body_buffers) {
+    write(buffer);
+    write(std::span(padding).first(paddingOf(buffer.size())));
+  }
+}
+
+void ArrowSQLWriter::write(std::span<const std::byte> data) {
+  if (data.empty()) {
+    return;
+  }
+  if (!output_stream_) {
+    throw Exception(PROCESSOR_EXCEPTION, "ArrowSQLWriter: no output stream to write the rows to");
+  }
+  const auto write_result = output_stream_->write(data);
+  if (io::isError(write_result)) {
+    throw Exception(FILE_OPERATION_EXCEPTION, "ArrowSQLWriter: failed to write the rows to the output stream");
+  }
+  bytes_written_ += write_result;
+}
+
+}  // namespace org::apache::nifi::minifi::sql
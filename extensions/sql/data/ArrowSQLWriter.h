@@ -0,0 +1,112 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SQLWriter.h"
+
+namespace org::apache::nifi::minifi::sql {
+
+// Writes the rows in the Apache Arrow IPC streaming format. The content written in every batch is a complete stream: the schema,
+// the rows in record batches of at most rows_per_record_batch rows and the end-of-stream marker.
+// The column types are taken from the first record batch of the result set, so that all batches share the same schema;
+// columns having only NULL values in the first record batch are written as strings.
+class ArrowSQLWriter : public SQLWriter {
+ public:
+  static constexpr size_t DEFAULT_ROWS_PER_RECORD_BATCH = 4096;
+
+  explicit ArrowSQLWriter(ColumnFilter column_filter = [] (const std::string&) {return true;}, size_t rows_per_record_batch = DEFAULT_ROWS_PER_RECORD_BATCH);
+
+  void setOutputStream(std::shared_ptr<io::OutputStream> output_stream) override;
+  [[nodiscard]] size_t getBytesWritten() const override {
+    return bytes_written_;
+  }
+
+ private:
+  enum class ColumnType {
+    INT32,
+    INT64,
+    UINT64,
+    DOUBLE,
+    UTF8
+  };
+
+  // the values of a column in the current record batch, in the memory layout of the Arrow arrays
+  struct Column {
+    std::string name;
+    bool included{true};
+    std::optional<ColumnType> type;
+    size_t length{0};
+    size_t null_count{0};
+    std::vector<uint8_t> validity;
+    std::vector<std::byte> values;
+    std::vector<int32_t> offsets;
+
+    void setType(ColumnType column_type);
+    void appendNull();
+    void appendValue(std::span<const std::byte> value);
+    void appendString(std::string_view value);
+    void clear();
+
+   private:
+    void appendValidity(bool valid);
+  };
+
+  void beginProcessBatch() override;
+  void endProcessBatch() override;
+  void beginProcessRow() override;
+  void endProcessRow() override;
+  void finishProcessing() override;
+  void processColumnNames(const std::vector<std::string>& names) override;
+  void processColumn(const std::string& name, const std::string& value) override;
+  void processColumn(const std::string& name, double value) override;
+  void processColumn(const std::string& name, int value) override;
+  void processColumn(const std::string& name, long long value) override;
+  void processColumn(const std::string& name, unsigned long long value) override;
+  void processColumn(const std::string& name, const char* value) override;
+
+  template<typename T>
+  void processNumber(const std::string& name, ColumnType type, T value);
+
+  Column* nextColumn(const std::string& name);
+  void writeRecordBatch();
+  void writeSchema();
+  void writeMessage(std::span<const std::byte> metadata, const std::vector<std::span<const std::byte>>& body_buffers);
+  void write(std::span<const std::byte> data);
+
+  ColumnFilter column_filter_;
+  size_t rows_per_record_batch_;
+  std::shared_ptr<io::OutputStream> output_stream_;
+  size_t bytes_written_{0};
+  std::vector<Column> columns_;
+  size_t current_column_{0};
+  size_t buffered_rows_{0};
+  bool schema_fixed_{false};
+  bool stream_started_{false};
+};
+
+}  // namespace org::apache::nifi::minifi::sql
@@ -16,10 +16,10 @@
  * limitations under the License.
  */
 
+#include <span>
+#include <utility>
+
 #include "JSONSQLWriter.h"
-#include "rapidjson/writer.h"
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/prettywriter.h"
 #include "Exception.h"
 
 namespace org {
@@ -28,78 +28,89 @@ namespace nifi {
 namespace minifi {
 namespace sql {
 
+void JSONSQLWriter::BufferedOutputStream::setOutputStream(std::shared_ptr<io::OutputStream> output_stream) {
+  buffer_.clear();
+  buffer_.reserve(BUFFER_SIZE);
+  bytes_written_ = 0;
+  output_stream_ = std::move(output_stream);
+}
+
+void JSONSQLWriter::BufferedOutputStream::Flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+  if (!output_stream_) {
+    throw Exception(PROCESSOR_EXCEPTION, "JSONSQLWriter: no output stream to write the rows to");
+  }
+  const auto write_result = output_stream_->write(as_bytes(std::span(buffer_)));
+  if (io::isError(write_result)) {
+    throw Exception(FILE_OPERATION_EXCEPTION, "JSONSQLWriter: failed to write the rows to the output stream");
+  }
+  bytes_written_ += write_result;
+  buffer_.clear();
+}
+
 JSONSQLWriter::JSONSQLWriter(bool pretty, ColumnFilter column_filter)
-  : pretty_(pretty), current_batch_(rapidjson::kArrayType), column_filter_(std::move(column_filter)) {
+  : pretty_(pretty), column_filter_(std::move(column_filter)) {
+}
+
+void JSONSQLWriter::setOutputStream(std::shared_ptr<io::OutputStream> output_stream) {
+  output_stream_.setOutputStream(std::move(output_stream));
 }
 
 void JSONSQLWriter::beginProcessRow() {
-  current_row_ = rapidjson::kObjectType;
+  // the array is only started with the first row, so that empty batches do not need an output stream
+  if (!batch_started_) {
+    write([] (auto& writer) { writer.StartArray(); });
+    batch_started_ = true;
+  }
+  write([] (auto& writer) { writer.StartObject(); });
 }
 
 void JSONSQLWriter::endProcessRow() {
-  current_batch_.PushBack(current_row_, current_batch_.GetAllocator());
+  write([] (auto& writer) { writer.EndObject(); });
 }
 
 void JSONSQLWriter::beginProcessBatch() {
-  current_batch_ = rapidjson::Document(rapidjson::kArrayType);
+  writer_.Reset(output_stream_);
+  pretty_writer_.Reset(output_stream_);
+  batch_started_ = false;
 }
 
-void JSONSQLWriter::endProcessBatch() {}
+void JSONSQLWriter::endProcessBatch() {
+  if (!batch_started_) {
+    return;
+  }
+  write([] (auto& writer) { writer.EndArray(); });
+  output_stream_.Flush();
+}
 
 void JSONSQLWriter::finishProcessing() {}
 
 void JSONSQLWriter::processColumnNames(const std::vector<std::string>& /*name*/) {}
 
 void JSONSQLWriter::processColumn(const std::string& name, const std::string& value) {
-  addToJSONRow(name, toJSONString(value));
+  writeColumn(name, [&] (auto& writer) { writer.String(value.c_str(), gsl::narrow<rapidjson::SizeType>(value.size())); });
 }
 
 void JSONSQLWriter::processColumn(const std::string& name, double value) {
-  addToJSONRow(name, rapidjson::Value(value));
+  writeColumn(name, [&] (auto& writer) { writer.Double(value); });
 }
 
 void JSONSQLWriter::processColumn(const std::string& name, int value) {
-  addToJSONRow(name, rapidjson::Value(value));
+  writeColumn(name, [&] (auto& writer) { writer.Int(value); });
 }
 
 void JSONSQLWriter::processColumn(const std::string& name, long long value) {
-  addToJSONRow(name, rapidjson::Value(gsl::narrow<int64_t>(value)));
+  writeColumn(name, [&] (auto& writer) { writer.Int64(gsl::narrow<int64_t>(value)); });
 }
 
 void JSONSQLWriter::processColumn(const std::string& name, unsigned long long value) {
-  addToJSONRow(name, rapidjson::Value(gsl::narrow<uint64_t>(value)));
+  writeColumn(name, [&] (auto& writer) { writer.Uint64(gsl::narrow<uint64_t>(value)); });
 }
 
 void JSONSQLWriter::processColumn(const std::string& name, const char* value) {
-  addToJSONRow(name, toJSONString(value));
-}
-
-void JSONSQLWriter::addToJSONRow(const std::string& column_name, rapidjson::Value&& json_value) {
-  if (!column_filter_(column_name)) {
-    return;
-  }
-  current_row_.AddMember(toJSONString(column_name), std::move(json_value), current_batch_.GetAllocator());
-}
-
-rapidjson::Value JSONSQLWriter::toJSONString(const std::string& s) {
-  rapidjson::Value jsonValue;
-  jsonValue.SetString(s.c_str(), s.size(), current_batch_.GetAllocator());
-
-  return jsonValue;
-}
-
-std::string JSONSQLWriter::toString() {
-  rapidjson::StringBuffer buffer;
-
-  if (pretty_) {
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-    current_batch_.Accept(writer);
-  } else {
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    current_batch_.Accept(writer);
-  }
-
-  return {buffer.GetString(), buffer.GetSize()};
+  writeColumn(name, [&] (auto& writer) { writer.String(value); });
 }
 
 }  // namespace sql
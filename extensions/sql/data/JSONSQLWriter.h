@@ -18,11 +18,16 @@
 
 #pragma once
 
-#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
-#include "rapidjson/document.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/prettywriter.h"
 
 #include "SQLWriter.h"
+#include "utils/gsl.h"
 
 namespace org {
 namespace apache {
@@ -32,13 +37,40 @@ namespace sql {
 
 class JSONSQLWriter: public SQLWriter {
  public:
-  using ColumnFilter = std::function<bool(const std::string&)>;
-
   explicit JSONSQLWriter(bool pretty, ColumnFilter column_filter = [] (const std::string&) {return true;});
 
-  std::string toString() override;
+  void setOutputStream(std::shared_ptr<io::OutputStream> output_stream) override;
+  [[nodiscard]] size_t getBytesWritten() const override {
+    return output_stream_.getBytesWritten();
+  }
 
 private:
+  // rapidjson output stream collecting the serialized rows in a small buffer, which is written to the flow file content when it fills up
+  class BufferedOutputStream {
+   public:
+    using Ch = char;
+    static constexpr size_t BUFFER_SIZE = 8192;
+
+    void setOutputStream(std::shared_ptr<io::OutputStream> output_stream);
+
+    void Put(Ch c) {
+      buffer_.push_back(c);
+      if (buffer_.size() >= BUFFER_SIZE) {
+        Flush();
+      }
+    }
+    void Flush();
+
+    [[nodiscard]] size_t getBytesWritten() const {
+      return bytes_written_;
+    }
+
+   private:
+    std::shared_ptr<io::OutputStream> output_stream_;
+    std::vector<Ch> buffer_;
+    size_t bytes_written_{0};
+  };
+
   void beginProcessBatch() override;
   void endProcessBatch() override;
   void beginProcessRow() override;
@@ -52,14 +84,32 @@ private:
   void processColumn(const std::string& name, unsigned long long value) override;
   void processColumn(const std::string& name, const char* value) override;
 
-  void addToJSONRow(const std::string& column_name, rapidjson::Value&& json_value);
+  template<typename WriteFunction>
+  void writeColumn(const std::string& column_name, WriteFunction write_value) {
+    if (!column_filter_(column_name)) {
+      return;
+    }
+    write([&] (auto& writer) {
+      writer.Key(column_name.c_str(), gsl::narrow<rapidjson::SizeType>(column_name.size()));
+      write_value(writer);
+    });
+  }
 
-  rapidjson::Value toJSONString(const std::string& s);
+  template<typename WriteFunction>
+  void write(WriteFunction write_function) {
+    if (pretty_) {
+      write_function(pretty_writer_);
+    } else {
+      write_function(writer_);
+    }
+  }
 
  private:
   bool pretty_;
-  rapidjson::Document current_batch_;
-  rapidjson::Value current_row_;
+  BufferedOutputStream output_stream_;
+  rapidjson::Writer<BufferedOutputStream> writer_{output_stream_};
+  rapidjson::PrettyWriter<BufferedOutputStream> pretty_writer_{output_stream_};
+  bool batch_started_{false};
   ColumnFilter column_filter_;
 };
 
@@ -69,4 +119,3 @@ private:
 } /* namespace apache */
 } /* namespace org */
 
-
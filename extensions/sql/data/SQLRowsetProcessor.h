@@ -35,6 +35,10 @@ class SQLRowsetProcessor {
 
   size_t process(size_t max);
 
+  bool isDone() const {
+    return rowset_->is_done();
+  }
+
  private:
    void addRow(const Row& row, size_t rowCount);
 
@@ -18,11 +18,14 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <soci/soci.h>
 
 #include "SQLRowSubscriber.h"
+#include "io/OutputStream.h"
 
 namespace org {
 namespace apache {
@@ -31,7 +34,12 @@ namespace minifi {
 namespace sql {
 
 struct SQLWriter: public SQLRowSubscriber {
-  virtual std::string toString() = 0;
+  // Decides whether a column of the result set is written.
+  using ColumnFilter = std::function<bool(const std::string&)>;
+
+  // The rows of the following batches are written to this stream as they are processed.
+  virtual void setOutputStream(std::shared_ptr<io::OutputStream> output_stream) = 0;
+  [[nodiscard]] virtual size_t getBytesWritten() const = 0;
 };
 
 
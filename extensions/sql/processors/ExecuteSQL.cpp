@@ -80,12 +80,12 @@ void ExecuteSQL::processOnTrigger(core::ProcessContext& context, core::ProcessSe
     return;
   }
 
-  sql::JSONSQLWriter json_writer{output_format_ == flow_file_source::OutputType::JSONPretty};
-  FlowFileGenerator flow_file_creator{session, json_writer};
-  sql::SQLRowsetProcessor sql_rowset_processor(std::move(row_set), {json_writer, flow_file_creator});
+  const auto sql_writer = createSQLWriter();
+  FlowFileGenerator flow_file_creator{session, *sql_writer};
+  sql::SQLRowsetProcessor sql_rowset_processor(std::move(row_set), {*sql_writer, flow_file_creator});
 
   // Process rowset.
-  while (size_t row_count = sql_rowset_processor.process(max_rows_)) {
+  while (size_t row_count = flow_file_creator.processNextBatch(sql_rowset_processor, max_rows_)) {
     auto new_file = flow_file_creator.getLastFlowFile();
     gsl_Expects(new_file);
     new_file->addAttribute(RESULT_ROW_COUNT, std::to_string(row_count));
@@ -17,19 +17,41 @@
 
 #include "FlowFileSource.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "data/ArrowSQLWriter.h"
+#include "data/JSONSQLWriter.h"
+#include "utils/gsl.h"
+
 namespace org::apache::nifi::minifi::processors {
 
-void FlowFileSource::FlowFileGenerator::endProcessBatch() {
-  if (current_batch_size_ == 0) {
-    // do not create flow files with no rows
-    return;
+std::unique_ptr<sql::SQLWriter> FlowFileSource::createSQLWriter(sql::SQLWriter::ColumnFilter column_filter) const {
+  if (output_format_ == flow_file_source::OutputType::ArrowIPC) {
+    return std::make_unique<sql::ArrowSQLWriter>(std::move(column_filter));
+  }
+  return std::make_unique<sql::JSONSQLWriter>(output_format_ == flow_file_source::OutputType::JSONPretty, std::move(column_filter));
+}
+
+size_t FlowFileSource::FlowFileGenerator::processNextBatch(sql::SQLRowsetProcessor& rowset_processor, size_t max_rows) {
+  if (rowset_processor.isDone()) {
+    // do not create flow files with no rows, processing the empty batch notifies the subscribers that all rows have been processed
+    return rowset_processor.process(max_rows);
   }
 
   auto new_flow = session_.create();
   new_flow->addAttribute(std::string{FRAGMENT_INDEX}, std::to_string(flow_files_.size()));
   new_flow->addAttribute(std::string{FRAGMENT_IDENTIFIER}, batch_id_.to_string());
-  session_.writeBuffer(new_flow, json_writer_.toString());
+  size_t row_count = 0;
+  session_.write(new_flow, [&](const std::shared_ptr<io::OutputStream>& output_stream) -> int64_t {
+    sql_writer_.setOutputStream(output_stream);
+    const auto reset_output_stream = gsl::finally([&] { sql_writer_.setOutputStream(nullptr); });
+    row_count = rowset_processor.process(max_rows);
+    return gsl::narrow<int64_t>(sql_writer_.getBytesWritten());
+  });
   flow_files_.push_back(std::move(new_flow));
+  return row_count;
 }
 
 void FlowFileSource::FlowFileGenerator::finishProcessing() {
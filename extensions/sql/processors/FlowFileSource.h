@@ -27,14 +27,15 @@
 #include "utils/Enum.h"
 #include "data/SQLRowsetProcessor.h"
 #include "ProcessSession.h"
-#include "data/JSONSQLWriter.h"
+#include "data/SQLWriter.h"
 
 namespace org::apache::nifi::minifi::processors {
 
 namespace flow_file_source {
 SMART_ENUM(OutputType,
   (JSON, "JSON"),
-  (JSONPretty, "JSON-Pretty")
+  (JSONPretty, "JSON-Pretty"),
+  (ArrowIPC, "Arrow-IPC")
 )
 }  // namespace flow_file_source
 
@@ -45,7 +46,8 @@ class FlowFileSource {
   EXTENSIONAPI static constexpr std::string_view FRAGMENT_INDEX = "fragment.index";
 
   EXTENSIONAPI static constexpr auto OutputFormat = core::PropertyDefinitionBuilder<flow_file_source::OutputType::length>::createProperty("Output Format")
-      .withDescription("Set the output format type.")
+      .withDescription("Set the output format type. Arrow-IPC writes the rows of every flow file as a stream in the Apache Arrow IPC streaming format, "
+          "the column types are taken from the first rows of the result set.")
       .isRequired(true)
       .supportsExpressionLanguage(true)
       .withDefaultValue(toStringView(flow_file_source::OutputType::JSONPretty))
@@ -63,23 +65,25 @@ class FlowFileSource {
   EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 2>{OutputFormat, MaxRowsPerFlowFile};
 
  protected:
+  std::unique_ptr<sql::SQLWriter> createSQLWriter(sql::SQLWriter::ColumnFilter column_filter = [] (const std::string&) {return true;}) const;
+
   class FlowFileGenerator : public sql::SQLRowSubscriber {
    public:
-    FlowFileGenerator(core::ProcessSession& session, sql::JSONSQLWriter& json_writer)
+    FlowFileGenerator(core::ProcessSession& session, sql::SQLWriter& sql_writer)
       : session_(session),
-        json_writer_(json_writer) {}
+        sql_writer_(sql_writer) {}
 
-    void beginProcessBatch() override {
-      current_batch_size_ = 0;
-    }
-    void endProcessBatch() override;
+    // Creates a flow file from the next at most max_rows rows (all of them if max_rows is 0), the rows are written to its content as they are processed.
+    // Returns the number of rows in the new flow file, 0 if there are no more rows.
+    size_t processNextBatch(sql::SQLRowsetProcessor& rowset_processor, size_t max_rows);
+
+    void beginProcessBatch() override {}
+    void endProcessBatch() override {}
 
     void finishProcessing() override;
 
     void beginProcessRow() override {}
-    void endProcessRow() override {
-      ++current_batch_size_;
-    }
+    void endProcessRow() override {}
     void processColumnNames(const std::vector<std::string>& /*names*/) override {}
     void processColumn(const std::string& /*name*/, const std::string& /*value*/) override {}
     void processColumn(const std::string& /*name*/, double /*value*/) override {}
@@ -101,9 +105,8 @@ class FlowFileSource {
 
    private:
     core::ProcessSession& session_;
-    sql::JSONSQLWriter& json_writer_;
+    sql::SQLWriter& sql_writer_;
     const utils::Identifier batch_id_{utils::IdGenerator::getIdGenerator()->generate()};
-    size_t current_batch_size_{0};
     std::vector<std::shared_ptr<core::FlowFile>> flow_files_;
   };
 
@@ -102,11 +102,11 @@ void QueryDatabaseTable::processOnTrigger(core::ProcessContext& /*context*/, cor
   auto column_filter = [&] (const std::string& column_name) {
     return return_columns_.empty() || return_columns_.contains(sql::SQLColumnIdentifier(column_name));
   };
-  sql::JSONSQLWriter json_writer{output_format_ == flow_file_source::OutputType::JSONPretty, column_filter};
-  FlowFileGenerator flow_file_creator{session, json_writer};
-  sql::SQLRowsetProcessor sql_rowset_processor(std::move(rowset), {json_writer, maxCollector, flow_file_creator});
+  const auto sql_writer = createSQLWriter(column_filter);
+  FlowFileGenerator flow_file_creator{session, *sql_writer};
+  sql::SQLRowsetProcessor sql_rowset_processor(std::move(rowset), {*sql_writer, maxCollector, flow_file_creator});
 
-  while (size_t row_count = sql_rowset_processor.process(max_rows_)) {
+  while (size_t row_count = flow_file_creator.processNextBatch(sql_rowset_processor, max_rows_)) {
     auto new_file = flow_file_creator.getLastFlowFile();
     gsl_Expects(new_file);
     new_file->addAttribute(RESULT_ROW_COUNT, std::to_string(row_count));
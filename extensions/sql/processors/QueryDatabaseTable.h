@@ -48,7 +48,7 @@ class QueryDatabaseTable: public SQLProcessor, public FlowFileSource {
 
   EXTENSIONAPI static constexpr const char* Description =
       "Fetches all rows of a table, whose values in the specified Maximum-value Columns are larger than the previously-seen maxima. "
-      "If that property is not provided, all rows are returned. The rows are grouped according to the value of Max Rows Per Flow File property and formatted as JSON.";
+      "If that property is not provided, all rows are returned. The rows are grouped according to the value of Max Rows Per Flow File property and formatted according to the Output Format property.";
 
   EXTENSIONAPI static constexpr auto TableName = core::PropertyDefinitionBuilder<>::createProperty("Table Name")
       .withDescription("The name of the database table to be queried.")
@@ -74,4 +74,24 @@ bool InMemoryKeyValueStorage::update(const std::string& key, const std::function
   return true;
 }
 
+bool InMemoryKeyValueStorage::setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove) {
+  for (const auto& [key, value] : kvs_to_set) {
+    map_[key] = value;
+  }
+  for (const auto& key : keys_to_remove) {
+    map_.erase(key);
+  }
+  return true;
+}
+
+bool InMemoryKeyValueStorage::getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs) {
+  kvs.clear();
+  for (const auto& [key, value] : map_) {
+    if (key.starts_with(prefix)) {
+      kvs.emplace(key, value);
+    }
+  }
+  return true;
+}
+
 }  // namespace org::apache::nifi::minifi::controllers
@@ -21,6 +21,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "core/logging/Logger.h"
 #include "core/logging/LoggerFactory.h"
@@ -38,6 +39,8 @@ class InMemoryKeyValueStorage {
   bool remove(const std::string& key);
   bool clear();
   bool update(const std::string& key, const std::function<bool(bool /*exists*/, std::string& /*value*/)>& update_func);
+  bool setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove);
+  bool getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs);
 
  private:
   std::unordered_map<std::string, std::string> map_;
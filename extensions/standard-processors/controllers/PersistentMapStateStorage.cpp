@@ -201,6 +201,23 @@ bool PersistentMapStateStorage::update(const std::string& key, const std::functi
   return res;
 }
 
+bool PersistentMapStateStorage::setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove) {
+  bool res = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    res = storage_.setAndRemove(kvs_to_set, keys_to_remove);
+  }
+  if (auto_persistor_.isAlwaysPersisting() && res) {
+    return persist();
+  }
+  return res;
+}
+
+bool PersistentMapStateStorage::getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return storage_.getWithPrefix(prefix, kvs);
+}
+
 bool PersistentMapStateStorage::persistNonVirtual() {
   std::lock_guard<std::mutex> lock(mutex_);
   std::ofstream ofs(file_);
@@ -21,6 +21,7 @@
 #include <mutex>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "controllers/keyvalue/AutoPersistor.h"
 #include "core/Core.h"
@@ -80,6 +81,8 @@ class PersistentMapStateStorage : public KeyValueStateStorage {
   bool remove(const std::string& key) override;
   bool clear() override;
   bool update(const std::string& key, const std::function<bool(bool /*exists*/, std::string& /*value*/)>& update_func) override;
+  bool setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove) override;
+  bool getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs) override;
 
   bool persist() override {
     return persistNonVirtual();
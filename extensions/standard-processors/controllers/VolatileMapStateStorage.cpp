@@ -64,6 +64,16 @@ bool VolatileMapStateStorage::update(const std::string& key, const std::function
   return storage_.update(key, update_func);
 }
 
+bool VolatileMapStateStorage::setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return storage_.setAndRemove(kvs_to_set, keys_to_remove);
+}
+
+bool VolatileMapStateStorage::getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return storage_.getWithPrefix(prefix, kvs);
+}
+
 REGISTER_RESOURCE_AS(VolatileMapStateStorage, ControllerService, ("UnorderedMapKeyValueStoreService", "VolatileMapStateStorage"));
 
 }  // namespace org::apache::nifi::minifi::controllers
@@ -21,40 +21,243 @@
 #ifdef OPENSSL_SUPPORT
 
 #include <algorithm>
-#include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "HashContent.h"
 #include "core/ProcessContext.h"
 #include "core/ProcessSession.h"
 #include "core/FlowFile.h"
 #include "core/Resource.h"
+#include "utils/gsl.h"
+#include "utils/Literals.h"
+#include "utils/ProcessorConfigUtils.h"
+#include "utils/StringUtils.h"
 
 #include "range/v3/view.hpp"
 
 namespace org::apache::nifi::minifi::processors {
 
+namespace {
+
+constexpr size_t READ_BUFFER_SIZE = 1_MiB;
+
+using Digest = std::vector<std::byte>;
+
+// Feeds the same data to the digest contexts of several algorithms, so that all checksums are computed in a single pass
+class MultiDigest {
+ public:
+  explicit MultiDigest(std::span<const EVP_MD* const> algorithms) {
+    contexts_.reserve(algorithms.size());
+    for (const auto* algorithm : algorithms) {
+      auto& context = contexts_.emplace_back(EVP_MD_CTX_new());
+      if (!context || EVP_DigestInit_ex(context.get(), algorithm, nullptr) != 1) {
+        throw Exception(PROCESSOR_EXCEPTION, "Failed to initialize the digest context");
+      }
+    }
+  }
+
+  void update(std::span<const std::byte> data) {
+    for (const auto& context : contexts_) {
+      EVP_DigestUpdate(context.get(), data.data(), data.size());
+    }
+  }
+
+  std::vector<Digest> finalize() {
+    std::vector<Digest> digests;
+    digests.reserve(contexts_.size());
+    for (const auto& context : contexts_) {
+      Digest digest(EVP_MAX_MD_SIZE);
+      unsigned int digest_length = 0;
+      EVP_DigestFinal_ex(context.get(), reinterpret_cast<unsigned char*>(digest.data()), &digest_length);
+      digest.resize(digest_length);
+      digests.push_back(std::move(digest));
+    }
+    return digests;
+  }
+
+ private:
+  struct EVPMDContextDeleter {
+    void operator()(EVP_MD_CTX* context) const { EVP_MD_CTX_free(context); }
+  };
+
+  std::vector<std::unique_ptr<EVP_MD_CTX, EVPMDContextDeleter>> contexts_;
+};
+
+// the root of the tree hash is the digest of the concatenated chunk digests, computed separately for each algorithm
+std::vector<Digest> combineChunkDigests(std::span<const EVP_MD* const> algorithms, const std::vector<std::vector<Digest>>& chunk_digests) {
+  std::vector<Digest> root_digests;
+  root_digests.reserve(algorithms.size());
+  for (size_t i = 0; i < algorithms.size(); ++i) {
+    MultiDigest root{std::span(algorithms).subspan(i, 1)};
+    for (const auto& digests_of_chunk : chunk_digests) {
+      root.update(digests_of_chunk[i]);
+    }
+    root_digests.push_back(std::move(root.finalize()[0]));
+  }
+  return root_digests;
+}
+
+std::vector<Digest> hashSequential(std::span<const EVP_MD* const> algorithms, std::span<const std::byte> content) {
+  MultiDigest digest{algorithms};
+  digest.update(content);
+  return digest.finalize();
+}
+
+// the chunks of the mapped content are hashed by the calling thread, helped by at most helper_count tasks of the shared thread pool
+std::vector<Digest> hashTree(std::span<const EVP_MD* const> algorithms, std::span<const std::byte> content, uint64_t chunk_size,
+    utils::ThreadPool<utils::TaskRescheduleInfo>* thread_pool, size_t helper_count) {
+  // the helper tasks may only get to run after the calling thread has returned, so they must not refer to its stack
+  struct TreeHashState {
+    std::vector<const EVP_MD*> algorithms;
+    std::span<const std::byte> content;
+    uint64_t chunk_size{};
+    size_t chunk_count{};
+    std::vector<std::vector<Digest>> chunk_digests;
+    std::atomic<size_t> next_chunk{0};
+    std::mutex mutex;
+    std::condition_variable chunk_finished;
+    size_t finished_chunks{0};
+    std::exception_ptr error;
+
+    void hashChunks() {
+      // content is only touched after claiming a chunk, which keeps the caller waiting in hashTree until the chunk is finished
+      for (size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) {
+        std::exception_ptr chunk_error;
+        try {
+          const size_t offset = chunk * chunk_size;
+          chunk_digests[chunk] = hashSequential(algorithms, content.subspan(offset, std::min<size_t>(chunk_size, content.size() - offset)));
+        } catch (...) {
+          chunk_error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (chunk_error && !error) {
+          error = chunk_error;
+        }
+        if (++finished_chunks == chunk_count) {
+          chunk_finished.notify_all();
+        }
+      }
+    }
+  };
+
+  auto state = std::make_shared<TreeHashState>();
+  state->algorithms.assign(algorithms.begin(), algorithms.end());
+  state->content = content;
+  state->chunk_size = chunk_size;
+  state->chunk_count = (content.size() + chunk_size - 1) / chunk_size;
+  state->chunk_digests.resize(state->chunk_count);
+
+  const size_t helpers_needed = thread_pool && state->chunk_count > 1 ? std::min(helper_count, state->chunk_count - 1) : 0;
+  for (size_t i = 0; i < helpers_needed; ++i) {
+    utils::Worker<utils::TaskRescheduleInfo> task{[state] {
+        state->hashChunks();
+        return utils::TaskRescheduleInfo::Done();
+      },
+      "",  // the helper tasks are never queried or stopped individually
+      std::make_unique<utils::ComplexMonitor>()};
+    std::future<utils::TaskRescheduleInfo> dummy_future;
+    thread_pool->execute(std::move(task), dummy_future);
+  }
+  state->hashChunks();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->chunk_finished.wait(lock, [&state] { return state->finished_chunks == state->chunk_count; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+  return combineChunkDigests(algorithms, state->chunk_digests);
+}
+
+// computes the same checksums as the mapped path, reading the stream in large blocks; tree chunks are hashed on the calling thread
+std::pair<std::vector<Digest>, int64_t> hashStream(std::span<const EVP_MD* const> algorithms, io::InputStream& stream, std::optional<uint64_t> tree_chunk_size) {
+  std::vector<std::byte> buffer(READ_BUFFER_SIZE);
+  std::vector<std::vector<Digest>> chunk_digests;
+  MultiDigest digest{algorithms};
+  uint64_t chunk_bytes = 0;
+  int64_t total_read = 0;
+  while (true) {
+    const size_t max_read = tree_chunk_size ? std::min<uint64_t>(buffer.size(), *tree_chunk_size - chunk_bytes) : buffer.size();
+    const size_t ret = stream.read(std::span(buffer).first(max_read));
+    if (ret == 0 || io::isError(ret)) {
+      break;
+    }
+    digest.update(std::span(buffer).first(ret));
+    total_read += gsl::narrow<int64_t>(ret);
+    chunk_bytes += ret;
+    if (tree_chunk_size && chunk_bytes == *tree_chunk_size) {
+      chunk_digests.push_back(std::exchange(digest, MultiDigest{algorithms}).finalize());
+      chunk_bytes = 0;
+    }
+  }
+  if (!tree_chunk_size) {
+    return {digest.finalize(), total_read};
+  }
+  if (chunk_bytes > 0) {
+    chunk_digests.push_back(digest.finalize());
+  }
+  return {combineChunkDigests(algorithms, chunk_digests), total_read};
+}
+
+}  // namespace
+
 void HashContent::initialize() {
   setSupportedProperties(Properties);
   setSupportedRelationships(Relationships);
 }
 
 void HashContent::onSchedule(core::ProcessContext *context, core::ProcessSessionFactory* /*sessionFactory*/) {
-  context->getProperty(HashAttribute, attrKey_);
+  std::string hash_attribute;
+  context->getProperty(HashAttribute, hash_attribute);
   context->getProperty(FailOnEmpty, failOnEmpty_);
+  hash_mode_ = hash_content::HashMode::parse(utils::parsePropertyWithAllowableValuesOrThrow(*context, HashMode.name, hash_content::HashMode::values).c_str());
+  tree_hash_chunk_size_ = context->getProperty<core::DataSizeValue>(TreeHashChunkSize)->getValue();
+  if (tree_hash_chunk_size_ == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Tree Hash Chunk Size must be greater than zero");
+  }
+  tree_hash_thread_count_ = context->getProperty<uint32_t>(TreeHashThreadCount).value_or(1);
+  if (tree_hash_thread_count_ == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Tree Hash Thread Count must be greater than zero");
+  }
+  if (hash_mode_ == hash_content::HashMode::TREE && tree_hash_thread_count_ > 1) {
+    tree_hash_thread_pool_ = std::make_unique<utils::ThreadPool<utils::TaskRescheduleInfo>>(
+        gsl::narrow<int>(tree_hash_thread_count_ - 1), false, nullptr, "HashContentTreeHashThreadPool");
+    tree_hash_thread_pool_->start();
+  }
 
-  {
-    std::string algo_name;
-    context->getProperty(HashAlgorithm, algo_name);
-    std::transform(algo_name.begin(), algo_name.end(), algo_name.begin(), ::toupper);
+  algorithms_.clear();
+  attribute_names_.clear();
+  std::string algorithm_list;
+  context->getProperty(HashAlgorithm, algorithm_list);
+  auto algo_names = utils::StringUtils::splitAndTrimRemovingEmpty(algorithm_list, ",");
+  for (auto& algo_name : algo_names) {
+    algo_name = utils::StringUtils::toUpper(algo_name);
     std::erase(algo_name, '-');
     if (!HashAlgos.contains(algo_name)) {
       const auto supported_algorithms = ranges::views::keys(HashAlgos) | ranges::views::join(std::string_view(", ")) | ranges::to<std::string>();
       throw Exception(PROCESS_SCHEDULE_EXCEPTION, algo_name + " is not supported, supported algorithms are: " + supported_algorithms);
     }
-    algorithm_ = HashAlgos.at(algo_name);
+    algorithms_.push_back(HashAlgos.at(algo_name)());
+    attribute_names_.push_back(algo_names.size() == 1 ? hash_attribute : hash_attribute + "." + algo_name);
+  }
+  if (algorithms_.empty()) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "At least one hash algorithm has to be specified");
+  }
+}
+
+void HashContent::onUnSchedule() {
+  if (tree_hash_thread_pool_) {
+    tree_hash_thread_pool_->shutdown();
+    tree_hash_thread_pool_.reset();
   }
 }
 
@@ -72,14 +275,27 @@ void HashContent::onTrigger(core::ProcessContext *, core::ProcessSession *sessio
     return;
   }
 
-  logger_->log_trace("attempting read");
-  session->read(flowFile, [&flowFile, this](const std::shared_ptr<io::InputStream>& stream) {
-    const auto& ret_val = algorithm_(stream);
-
-    flowFile->setAttribute(attrKey_, ret_val.first);
+  const auto set_checksums = [&flowFile, this](const std::vector<Digest>& digests, int64_t content_size) {
+    for (size_t i = 0; i < attribute_names_.size(); ++i) {
+      flowFile->setAttribute(attribute_names_[i], content_size > 0 ? utils::StringUtils::to_hex(digests[i], true /*uppercase*/) : "");
+    }
+  };
 
-    return ret_val.second;
-  });
+  logger_->log_trace("attempting read");
+  if (auto mapped_stream = session->getMappedFlowFileContentStream(flowFile)) {
+    const auto content = mapped_stream->getBuffer();
+    const auto digests = hash_mode_ == hash_content::HashMode::TREE
+        ? hashTree(algorithms_, content, tree_hash_chunk_size_, tree_hash_thread_pool_.get(), tree_hash_thread_count_ - 1)
+        : hashSequential(algorithms_, content);
+    set_checksums(digests, gsl::narrow<int64_t>(content.size()));
+  } else {
+    session->read(flowFile, [&set_checksums, this](const std::shared_ptr<io::InputStream>& stream) {
+      const auto tree_chunk_size = hash_mode_ == hash_content::HashMode::TREE ? std::make_optional(tree_hash_chunk_size_) : std::nullopt;
+      const auto [digests, total_read] = hashStream(algorithms_, *stream, tree_chunk_size);
+      set_checksums(digests, total_read);
+      return total_read;
+    });
+  }
   session->transfer(flowFile, Success);
 }
 
@@ -22,120 +22,37 @@
 #ifdef OPENSSL_SUPPORT
 
 #include <openssl/evp.h>
-#include <openssl/sha.h>
-#include <openssl/md5.h>
 
 #include <array>
 #include <cstdint>
-#include <iomanip>
 #include <map>
 #include <memory>
 #include <string>
-#include <sstream>
 #include <utility>
+#include <vector>
 
 #include "FlowFileRecord.h"
 #include "core/Processor.h"
 #include "core/PropertyDefinition.h"
 #include "core/PropertyDefinitionBuilder.h"
+#include "core/PropertyType.h"
 #include "core/RelationshipDefinition.h"
 #include "core/ProcessSession.h"
-#include "utils/StringUtils.h"
+#include "utils/Enum.h"
 #include "utils/Export.h"
-
-using HashReturnType = std::pair<std::string, int64_t>;
-
-// Without puttng this into its own namespace, the code would export already defined symbols.
-namespace { // NOLINT
-#define HASH_BUFFER_SIZE 16384
-
-  HashReturnType MD5Hash(const std::shared_ptr<org::apache::nifi::minifi::io::InputStream>& stream) {
-    HashReturnType ret_val;
-    ret_val.second = 0;
-    std::array<std::byte, HASH_BUFFER_SIZE> buffer{};
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
-    const auto guard = gsl::finally([&context]() {
-      EVP_MD_CTX_free(context);
-    });
-    EVP_DigestInit_ex(context, EVP_md5(), nullptr);
-
-    size_t ret = 0;
-    do {
-      ret = stream->read(buffer);
-      if (ret > 0) {
-        EVP_DigestUpdate(context, buffer.data(), ret);
-        ret_val.second += gsl::narrow<int64_t>(ret);
-      }
-    } while (ret > 0);
-
-    if (ret_val.second > 0) {
-      std::array<std::byte, MD5_DIGEST_LENGTH> digest{};
-      EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
-      ret_val.first = org::apache::nifi::minifi::utils::StringUtils::to_hex(digest, true /*uppercase*/);
-    }
-    return ret_val;
-  }
-
-  HashReturnType SHA1Hash(const std::shared_ptr<org::apache::nifi::minifi::io::InputStream>& stream) {
-    HashReturnType ret_val;
-    ret_val.second = 0;
-    std::array<std::byte, HASH_BUFFER_SIZE> buffer{};
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
-    const auto guard = gsl::finally([&context]() {
-      EVP_MD_CTX_free(context);
-    });
-    EVP_DigestInit_ex(context, EVP_sha1(), nullptr);
-
-    size_t ret = 0;
-    do {
-      ret = stream->read(buffer);
-      if (ret > 0) {
-        EVP_DigestUpdate(context, buffer.data(), ret);
-        ret_val.second += gsl::narrow<int64_t>(ret);
-      }
-    } while (ret > 0);
-
-    if (ret_val.second > 0) {
-      std::array<std::byte, SHA_DIGEST_LENGTH> digest{};
-      EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
-      ret_val.first = org::apache::nifi::minifi::utils::StringUtils::to_hex(digest, true /*uppercase*/);
-    }
-    return ret_val;
-  }
-
-  HashReturnType SHA256Hash(const std::shared_ptr<org::apache::nifi::minifi::io::InputStream>& stream) {
-    HashReturnType ret_val;
-    ret_val.second = 0;
-    std::array<std::byte, HASH_BUFFER_SIZE> buffer{};
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
-    const auto guard = gsl::finally([&context]() {
-      EVP_MD_CTX_free(context);
-    });
-    EVP_DigestInit_ex(context, EVP_sha256(), nullptr);
-
-    size_t ret;
-    do {
-      ret = stream->read(buffer);
-      if (ret > 0) {
-        EVP_DigestUpdate(context, buffer.data(), ret);
-        ret_val.second += gsl::narrow<int64_t>(ret);
-      }
-    } while (ret > 0);
-
-    if (ret_val.second > 0) {
-      std::array<std::byte, SHA256_DIGEST_LENGTH> digest{};
-      EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
-      ret_val.first = org::apache::nifi::minifi::utils::StringUtils::to_hex(digest, true /*uppercase*/);
-    }
-    return ret_val;
-  }
-}  // namespace
-
+#include "utils/ThreadPool.h"
 
 namespace org::apache::nifi::minifi::processors {
 
-static const std::map<std::string, const std::function<HashReturnType(const std::shared_ptr<io::InputStream>&)>> HashAlgos =
-  { {"MD5",  MD5Hash}, {"SHA1", SHA1Hash}, {"SHA256", SHA256Hash} };
+static const std::map<std::string, const EVP_MD* (*)()> HashAlgos =
+  { {"MD5",  EVP_md5}, {"SHA1", EVP_sha1}, {"SHA256", EVP_sha256} };
+
+namespace hash_content {
+SMART_ENUM(HashMode,
+    (SEQUENTIAL, "Sequential"),
+    (TREE, "Tree")
+)
+}  // namespace hash_content
 
 class HashContent : public core::Processor {
  public:
@@ -151,17 +68,41 @@ class HashContent : public core::Processor {
       .withDefaultValue("Checksum")
       .build();
   EXTENSIONAPI static constexpr auto HashAlgorithm = core::PropertyDefinitionBuilder<>::createProperty("Hash Algorithm")
-      .withDescription("Name of the algorithm used to generate checksum")
+      .withDescription("Name of the algorithm used to generate checksum. A comma-separated list of algorithms computes all of them in a single pass over the content, "
+          "in which case each checksum is stored in the Hash Attribute suffixed with the name of the algorithm, e.g. 'Checksum.SHA256'.")
       .withDefaultValue("SHA256")
       .build();
   EXTENSIONAPI static constexpr auto FailOnEmpty = core::PropertyDefinitionBuilder<>::createProperty("Fail on empty")
       .withDescription("Route to failure relationship in case of empty content")
       .withDefaultValue("false")
       .build();
-  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 3>{
+  EXTENSIONAPI static constexpr auto HashMode = core::PropertyDefinitionBuilder<hash_content::HashMode::length>::createProperty("Hash Mode")
+      .withDescription("Sequential computes the standard checksum of the content. Tree splits the content into chunks of 'Tree Hash Chunk Size', hashes the chunks on 'Tree Hash Thread Count' threads "
+          "and stores the checksum of the concatenated chunk checksums. Tree checksums differ from the standard ones, but they only depend on the content and the chunk size.")
+      .isRequired(true)
+      .withDefaultValue(toStringView(hash_content::HashMode::SEQUENTIAL))
+      .withAllowedValues(hash_content::HashMode::values)
+      .build();
+  EXTENSIONAPI static constexpr auto TreeHashChunkSize = core::PropertyDefinitionBuilder<>::createProperty("Tree Hash Chunk Size")
+      .withDescription("Size of the chunks hashed independently in Tree mode")
+      .isRequired(true)
+      .withPropertyType(core::StandardPropertyTypes::DATA_SIZE_TYPE)
+      .withDefaultValue("4 MB")
+      .build();
+  EXTENSIONAPI static constexpr auto TreeHashThreadCount = core::PropertyDefinitionBuilder<>::createProperty("Tree Hash Thread Count")
+      .withDescription("Number of threads hashing the chunks of a flow file in Tree mode, including the one running the processor. "
+          "The additional threads are shared by the concurrent tasks of the processor.")
+      .isRequired(true)
+      .withPropertyType(core::StandardPropertyTypes::UNSIGNED_INT_TYPE)
+      .withDefaultValue("1")
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 6>{
       HashAttribute,
       HashAlgorithm,
-      FailOnEmpty
+      FailOnEmpty,
+      HashMode,
+      TreeHashChunkSize,
+      TreeHashThreadCount
   };
 
 
@@ -178,13 +119,18 @@ class HashContent : public core::Processor {
 
   void onSchedule(core::ProcessContext *context, core::ProcessSessionFactory *sessionFactory) override;
   void onTrigger(core::ProcessContext *context, core::ProcessSession *session) override;
+  void onUnSchedule() override;
   void initialize() override;
 
  private:
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<HashContent>::getLogger(uuid_);
-  std::function<HashReturnType(const std::shared_ptr<io::InputStream>&)> algorithm_ = SHA256Hash;
-  std::string attrKey_;
+  std::vector<const EVP_MD*> algorithms_;
+  std::vector<std::string> attribute_names_;
   bool failOnEmpty_{};
+  hash_content::HashMode hash_mode_ = hash_content::HashMode::SEQUENTIAL;
+  uint64_t tree_hash_chunk_size_{};
+  uint32_t tree_hash_thread_count_{1};
+  std::unique_ptr<utils::ThreadPool<utils::TaskRescheduleInfo>> tree_hash_thread_pool_;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
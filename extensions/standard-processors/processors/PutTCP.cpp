@@ -16,6 +16,7 @@
  */
 #include "PutTCP.h"
 
+#include <algorithm>
 #include <utility>
 #include <tuple>
 
@@ -41,6 +42,8 @@ using org::apache::nifi::minifi::utils::net::asyncOperationWithTimeout;
 namespace org::apache::nifi::minifi::processors {
 
 constexpr size_t chunk_size = 1024;
+// mapped content is written directly without copying, so it can be sent in larger chunks
+constexpr size_t mapped_chunk_size = 64 * 1024;
 
 PutTCP::PutTCP(const std::string& name, const utils::Identifier& uuid)
     : Processor(name, uuid) {}
@@ -126,6 +129,10 @@ class ConnectionHandler : public ConnectionHandlerBase {
       const std::vector<std::byte>& delimiter,
       asio::io_context& io_context_) override;
 
+  asio::awaitable<std::error_code> sendBufferWithDelimiter(std::span<const std::byte> buffer_to_send,
+      const std::vector<std::byte>& delimiter,
+      asio::io_context& io_context_) override;
+
  private:
   [[nodiscard]] bool hasBeenUsedIn(std::chrono::milliseconds dur) const override {
     return last_used_ && *last_used_ >= (steady_clock::now() - dur);
@@ -142,6 +149,8 @@ class ConnectionHandler : public ConnectionHandlerBase {
 
   asio::awaitable<std::error_code> establishNewConnection(const tcp::resolver::results_type& endpoints, asio::io_context& io_context_);
   asio::awaitable<std::error_code> send(const std::shared_ptr<io::InputStream>& stream_to_send, const std::vector<std::byte>& delimiter);
+  asio::awaitable<std::error_code> send(std::span<const std::byte> buffer_to_send, const std::vector<std::byte>& delimiter);
+  asio::awaitable<std::error_code> sendDelimiter(const std::vector<std::byte>& delimiter);
 
   SocketType createNewSocket(asio::io_context& io_context_);
 
@@ -215,6 +224,15 @@ asio::awaitable<std::error_code> ConnectionHandler<SocketType>::sendStreamWithDe
   co_return co_await send(stream_to_send, delimiter);
 }
 
+template<class SocketType>
+asio::awaitable<std::error_code> ConnectionHandler<SocketType>::sendBufferWithDelimiter(std::span<const std::byte> buffer_to_send,
+    const std::vector<std::byte>& delimiter,
+    asio::io_context& io_context) {
+  if (auto connection_error = co_await setupUsableSocket(io_context))  // NOLINT
+    co_return connection_error;
+  co_return co_await send(buffer_to_send, delimiter);
+}
+
 template<class SocketType>
 asio::awaitable<std::error_code> ConnectionHandler<SocketType>::send(const std::shared_ptr<io::InputStream>& stream_to_send, const std::vector<std::byte>& delimiter) {
   gsl_Expects(hasUsableSocket());
@@ -231,6 +249,26 @@ asio::awaitable<std::error_code> ConnectionHandler<SocketType>::send(const std::
       co_return write_error;
     logger_->log_trace("Writing flowfile(%zu bytes) to socket succeeded", bytes_written);
   }
+  co_return co_await sendDelimiter(delimiter);
+}
+
+template<class SocketType>
+asio::awaitable<std::error_code> ConnectionHandler<SocketType>::send(std::span<const std::byte> buffer_to_send, const std::vector<std::byte>& delimiter) {
+  gsl_Expects(hasUsableSocket());
+
+  while (!buffer_to_send.empty()) {
+    const auto chunk = buffer_to_send.first(std::min(mapped_chunk_size, buffer_to_send.size()));
+    auto [write_error, bytes_written] = co_await asyncOperationWithTimeout(asio::async_write(*socket_, asio::buffer(chunk.data(), chunk.size()), use_nothrow_awaitable), timeout_duration_);
+    if (write_error)
+      co_return write_error;
+    logger_->log_trace("Writing flowfile(%zu bytes) to socket succeeded", bytes_written);
+    buffer_to_send = buffer_to_send.subspan(chunk.size());
+  }
+  co_return co_await sendDelimiter(delimiter);
+}
+
+template<class SocketType>
+asio::awaitable<std::error_code> ConnectionHandler<SocketType>::sendDelimiter(const std::vector<std::byte>& delimiter) {
   auto [delimiter_write_error, delimiter_bytes_written] = co_await asyncOperationWithTimeout(asio::async_write(*socket_, asio::buffer(delimiter), use_nothrow_awaitable), timeout_duration_);
   if (delimiter_write_error)
     co_return delimiter_write_error;
@@ -302,21 +340,43 @@ std::error_code PutTCP::sendFlowFileContent(std::shared_ptr<ConnectionHandlerBas
   return operation_error;
 }
 
+std::error_code PutTCP::sendFlowFileContent(std::shared_ptr<ConnectionHandlerBase>& connection_handler,
+    std::span<const std::byte> flow_file_content) {
+  std::error_code operation_error;
+  io_context_.restart();
+  asio::co_spawn(io_context_,
+      connection_handler->sendBufferWithDelimiter(flow_file_content, delimiter_, io_context_),
+      [&operation_error](const std::exception_ptr&, std::error_code error_code) {
+        operation_error = error_code;
+      });
+  io_context_.run();
+  return operation_error;
+}
+
 void PutTCP::processFlowFile(std::shared_ptr<ConnectionHandlerBase>& connection_handler,
     core::ProcessSession& session,
     const std::shared_ptr<core::FlowFile>& flow_file) {
-  auto flow_file_content_stream = session.getFlowFileContentStream(flow_file);
+  // send the content straight from memory if the content repository can map it, otherwise stream it in chunks
+  auto mapped_content_stream = session.getMappedFlowFileContentStream(flow_file);
+  auto flow_file_content_stream = mapped_content_stream ? mapped_content_stream : session.getFlowFileContentStream(flow_file);
   if (!flow_file_content_stream) {
     session.transfer(flow_file, Failure);
     return;
   }
 
-  std::error_code operation_error = sendFlowFileContent(connection_handler, flow_file_content_stream);
+  const auto send_content = [&] {
+    if (mapped_content_stream) {
+      return sendFlowFileContent(connection_handler, mapped_content_stream->getBuffer());
+    }
+    return sendFlowFileContent(connection_handler, flow_file_content_stream);
+  };
+
+  std::error_code operation_error = send_content();
 
   if (operation_error && connection_handler->hasBeenUsed()) {
     logger_->log_warn("%s with reused connection, retrying...", operation_error.message());
     connection_handler->reset();
-    operation_error = sendFlowFileContent(connection_handler, flow_file_content_stream);
+    operation_error = send_content();
   }
 
   if (operation_error) {
@@ -19,6 +19,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -52,6 +53,9 @@ class ConnectionHandlerBase {
   [[nodiscard]] virtual asio::awaitable<std::error_code> sendStreamWithDelimiter(const std::shared_ptr<io::InputStream>& stream_to_send,
       const std::vector<std::byte>& delimiter,
       asio::io_context& io_context) = 0;
+  [[nodiscard]] virtual asio::awaitable<std::error_code> sendBufferWithDelimiter(std::span<const std::byte> buffer_to_send,
+      const std::vector<std::byte>& delimiter,
+      asio::io_context& io_context) = 0;
 };
 
 class PutTCP final : public core::Processor {
@@ -153,6 +157,8 @@ EXTENSIONAPI static constexpr auto MaxSizeOfSocketSendBuffer = core::PropertyDef
 
   std::error_code sendFlowFileContent(std::shared_ptr<ConnectionHandlerBase>& connection_handler,
       const std::shared_ptr<io::InputStream>& flow_file_content_stream);
+  std::error_code sendFlowFileContent(std::shared_ptr<ConnectionHandlerBase>& connection_handler,
+      std::span<const std::byte> flow_file_content);
 
   std::vector<std::byte> delimiter_;
   asio::io_context io_context_;
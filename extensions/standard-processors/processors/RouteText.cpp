@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <map>
+#include <optional>
+#include <span>
 #include <vector>
 #include <utility>
 
@@ -32,6 +34,7 @@
 #include "range/v3/view/join.hpp"
 #include "utils/ProcessorConfigUtils.h"
 #include "utils/OptionalUtils.h"
+#include "utils/RegexSet.h"
 #include "utils/Searcher.h"
 
 namespace org::apache::nifi::minifi::processors {
@@ -59,19 +62,10 @@ class RouteText::ReadCallback {
   using Fn = std::function<void(Segment)>;
 
  public:
-  ReadCallback(route_text::Segmentation segmentation, size_t file_size, Fn&& fn)
-    : segmentation_(segmentation), file_size_(file_size), fn_(std::move(fn)) {}
-
-  int64_t operator()(const std::shared_ptr<io::InputStream>& stream) const {
-    std::vector<std::byte> buffer;
-    buffer.resize(file_size_);
-    size_t ret = stream->read(buffer);
-    if (io::isError(ret)) {
-      return -1;
-    }
-    if (ret != file_size_) {
-      throw Exception(PROCESS_SESSION_EXCEPTION, "Couldn't read whole flowfile content");
-    }
+  ReadCallback(route_text::Segmentation segmentation, Fn&& fn)
+    : segmentation_(segmentation), fn_(std::move(fn)) {}
+
+  int64_t operator()(std::span<const std::byte> buffer) const {
     std::string_view content{reinterpret_cast<const char*>(buffer.data()), buffer.size()};
     switch (segmentation_.value()) {
       case route_text::Segmentation::FULL_TEXT: {
@@ -104,7 +98,6 @@ class RouteText::ReadCallback {
 
  private:
   route_text::Segmentation segmentation_;
-  size_t file_size_;
   Fn fn_;
 };
 
@@ -136,25 +129,28 @@ class RouteText::MatchingContext {
   };
 
  public:
-  MatchingContext(core::ProcessContext& process_context, std::shared_ptr<core::FlowFile> flow_file, route_text::CasePolicy case_policy)
+  MatchingContext(core::ProcessContext& process_context, std::shared_ptr<core::FlowFile> flow_file, route_text::CasePolicy case_policy,
+                  const std::map<std::string, core::Property>& dynamic_properties)
     : process_context_(process_context),
       flow_file_(std::move(flow_file)),
-      case_policy_(case_policy) {}
-
-  const utils::Regex& getRegexProperty(const core::Property& prop) {
-    auto it = regex_values_.find(prop.getName());
-    if (it != regex_values_.end()) {
-      return it->second;
-    }
-    std::string value;
-    if (!process_context_.getDynamicProperty(prop, value, flow_file_)) {
-      throw Exception(PROCESSOR_EXCEPTION, "Missing dynamic property: '" + prop.getName() + "'");
+      case_policy_(case_policy),
+      dynamic_properties_(dynamic_properties) {}
+
+  bool matchesRegex(std::string_view segment, const core::Property& prop, utils::RegexSet::MatchMode mode) {
+    if (!regex_set_) {
+      // the patterns of all properties are matched in a single pass, the results are reused for the other properties
+      std::vector<std::string> patterns;
+      for (const auto& [property_name, dynamic_property] : dynamic_properties_) {
+        regex_indices_.emplace(property_name, patterns.size());
+        patterns.push_back(getStringProperty(dynamic_property));
+      }
+      regex_set_.emplace(patterns, mode, case_policy_ == route_text::CasePolicy::IGNORE_CASE);
     }
-    std::vector<utils::Regex::Mode> flags;
-    if (case_policy_ == route_text::CasePolicy::IGNORE_CASE) {
-      flags.push_back(utils::Regex::Mode::ICASE);
+    if (!regex_matches_ || segment.data() != matched_segment_.data() || segment.size() != matched_segment_.size()) {
+      regex_matches_ = &regex_set_->match(segment);
+      matched_segment_ = segment;
     }
-    return (regex_values_[prop.getName()] = utils::Regex(value, flags));
+    return (*regex_matches_)[regex_indices_.at(prop.getName())];
   }
 
   const std::string& getStringProperty(const core::Property& prop) {
@@ -187,9 +183,15 @@ class RouteText::MatchingContext {
   core::ProcessContext& process_context_;
   std::shared_ptr<core::FlowFile> flow_file_;
   route_text::CasePolicy case_policy_;
+  const std::map<std::string, core::Property>& dynamic_properties_;
 
   std::map<std::string, std::string> string_values_;
-  std::map<std::string, utils::Regex> regex_values_;
+
+  std::optional<utils::RegexSet> regex_set_;
+  std::map<std::string, size_t> regex_indices_;
+  // the segment the results belong to, segments point into the content so they are identified by their location
+  std::string_view matched_segment_;
+  const std::vector<bool>* regex_matches_ = nullptr;
 
   struct OwningSearcher {
     OwningSearcher(std::string str, route_text::CasePolicy case_policy)
@@ -227,9 +229,9 @@ void RouteText::onTrigger(core::ProcessContext *context, core::ProcessSession *s
 
   std::map<Route, std::string> flow_file_contents;
 
-  MatchingContext matching_context(*context, flow_file, case_policy_);
+  MatchingContext matching_context(*context, flow_file, case_policy_, dynamic_properties_);
 
-  ReadCallback callback(segmentation_, flow_file->getSize(), [&] (Segment segment) {
+  ReadCallback callback(segmentation_, [&] (Segment segment) {
     std::string_view original_value = segment.value_;
     std::string_view preprocessed_value = preprocess(segment.value_);
 
@@ -278,7 +280,8 @@ void RouteText::onTrigger(core::ProcessContext *context, core::ProcessSession *s
     }
     throw Exception(PROCESSOR_EXCEPTION, "Unknown routing strategy");
   });
-  session->read(flow_file, std::move(callback));
+  // the segments point directly into the content, which is mapped into memory if the content repository supports it
+  session->readMapped(flow_file, std::move(callback));
 
   for (const auto& [route, content] : flow_file_contents) {
     auto new_flow_file = session->create(flow_file);
@@ -339,12 +342,10 @@ bool RouteText::matchSegment(MatchingContext& context, const Segment& segment, c
       return utils::StringUtils::equals(segment.value_, context.getStringProperty(prop), case_policy_ == route_text::CasePolicy::CASE_SENSITIVE);
     }
     case route_text::Matching::CONTAINS_REGEX: {
-      std::string segment_str = std::string(segment.value_);
-      return utils::regexSearch(segment_str, context.getRegexProperty(prop));
+      return context.matchesRegex(segment.value_, prop, utils::RegexSet::MatchMode::PARTIAL);
     }
     case route_text::Matching::MATCHES_REGEX: {
-      std::string segment_str = std::string(segment.value_);
-      return utils::regexMatch(segment_str, context.getRegexProperty(prop));
+      return context.matchesRegex(segment.value_, prop, utils::RegexSet::MatchMode::FULL);
     }
   }
   throw Exception(PROCESSOR_EXCEPTION, "Unknown matching strategy");
@@ -177,5 +177,51 @@ TEST_CASE("Invalid hash algorithm throws in onSchedule", "[HashContent]") {
   REQUIRE_THROWS_WITH(controller.plan->scheduleProcessor(hash_content), "Process Schedule Operation: MYALGO is not supported, supported algorithms are: MD5, SHA1, SHA256");
 }
 
+TEST_CASE("Several hash algorithms are computed in a single pass", "[HashContent]") {
+  auto hash_content = std::make_shared<HashContent>("HashContent");
+  minifi::test::SingleProcessorTestController controller{hash_content};
+  hash_content->setProperty(HashContent::HashAlgorithm, "md5, SHA-256");
+
+  auto result = controller.trigger("Test text\n");
+  REQUIRE(result.at(HashContent::Success).size() == 1);
+  const auto& flow_file = result.at(HashContent::Success)[0];
+  CHECK(flow_file->getAttribute("Checksum.MD5") == MD5_CHECKSUM);
+  CHECK(flow_file->getAttribute("Checksum.SHA256") == SHA256_CHECKSUM);
+  CHECK_FALSE(flow_file->getAttribute("Checksum"));
+}
+
+TEST_CASE("Tree hash mode hashes the concatenated chunk checksums", "[HashContent]") {
+  auto hash_content = std::make_shared<HashContent>("HashContent");
+  minifi::test::SingleProcessorTestController controller{hash_content};
+  hash_content->setProperty(HashContent::HashMode, "Tree");
+
+  SECTION("Content split into several chunks") {
+    hash_content->setProperty(HashContent::TreeHashChunkSize, "4 B");
+    auto result = controller.trigger("Test text\n");
+    REQUIRE(result.at(HashContent::Success).size() == 1);
+    CHECK(result.at(HashContent::Success)[0]->getAttribute("Checksum") == "62F77BD4B5E123FA0B3BC3815EAC98E601C9BD8603147B25C724D13766C4DA01");
+  }
+  SECTION("Chunks hashed by several threads give the same checksum") {
+    hash_content->setProperty(HashContent::TreeHashChunkSize, "4 B");
+    hash_content->setProperty(HashContent::TreeHashThreadCount, "3");
+    auto result = controller.trigger("Test text\n");
+    REQUIRE(result.at(HashContent::Success).size() == 1);
+    CHECK(result.at(HashContent::Success)[0]->getAttribute("Checksum") == "62F77BD4B5E123FA0B3BC3815EAC98E601C9BD8603147B25C724D13766C4DA01");
+  }
+  SECTION("Content fitting in a single chunk") {
+    auto result = controller.trigger("Test text\n");
+    REQUIRE(result.at(HashContent::Success).size() == 1);
+    CHECK(result.at(HashContent::Success)[0]->getAttribute("Checksum") == "028782568DF9C65B6933C618484477BC643758E8948D9BFFF5B9032E9E4B6E86");
+  }
+}
+
+TEST_CASE("Tree Hash Thread Count must be greater than zero", "[HashContent]") {
+  auto hash_content = std::make_shared<HashContent>("HashContent");
+  minifi::test::SingleProcessorTestController controller{hash_content};
+  hash_content->setProperty(HashContent::HashMode, "Tree");
+  hash_content->setProperty(HashContent::TreeHashThreadCount, "0");
+  REQUIRE_THROWS_WITH(controller.plan->scheduleProcessor(hash_content), "Process Schedule Operation: Tree Hash Thread Count must be greater than zero");
+}
+
 }  // namespace org::apache::nifi::minifi::processors::test
 #endif  // OPENSSL_SUPPORT
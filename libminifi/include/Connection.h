@@ -35,6 +35,7 @@
 #include "core/FlowFile.h"
 #include "core/Repository.h"
 #include "utils/FlowFileQueue.h"
+#include "concurrentqueue.h"
 
 namespace org::apache::nifi::minifi {
 
@@ -139,13 +140,26 @@ class Connection : public core::Connectable {
     return drop_empty_;
   }
 
+  /**
+   * When enabled, flow files that are ready for processing on arrival bypass the ordered
+   * queue and go through a lock-free queue, which is FIFO only per producer thread. Only
+   * penalized flow files are kept in the (mutex protected) penalty ordered queue.
+   * Has no effect while swapping is enabled.
+   */
+  void setConcurrentQueue(bool enable) {
+    concurrent_queue_ = enable;
+  }
+
+  bool isConcurrentQueue() const {
+    return concurrent_queue_;
+  }
+
   bool isEmpty() const;
 
   bool backpressureThresholdReached() const;
 
   uint64_t getQueueSize() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
+    return ready_queue_size_ + queue_size_;
   }
 
   uint64_t getQueueDataSize() {
@@ -158,14 +172,20 @@ class Connection : public core::Connectable {
 
   std::shared_ptr<core::FlowFile> poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords);
 
+  /**
+   * Dequeues up to max_count flow files under a single lock acquisition.
+   * @param max_count maximum number of flow files to return
+   * @param max_bytes stop polling once the total size of the returned flow files reaches this value, 0 means unlimited
+   * @param expired_flow_records expired flow files encountered while polling are appended here
+   * @return the polled flow files, in queue order
+   */
+  std::vector<std::shared_ptr<core::FlowFile>> pollBatch(size_t max_count, uint64_t max_bytes, std::vector<std::shared_ptr<core::FlowFile>>& expired_flow_records);
+
   void drain(bool delete_permanently);
 
   void yield() override {}
 
-  bool isWorkAvailable() override {
-    const std::lock_guard<std::mutex> lock{mutex_};
-    return queue_.isWorkAvailable();
-  }
+  bool isWorkAvailable() override;
 
   bool isRunning() const override {
     return true;
@@ -184,10 +204,21 @@ class Connection : public core::Connectable {
   std::shared_ptr<core::ContentRepository> content_repo_;
 
  private:
+  bool useReadyQueue(const core::FlowFile& flow_file) const;
+  void enqueue(const std::shared_ptr<core::FlowFile>& flow_file);
+  std::shared_ptr<core::FlowFile> dequeue(std::unique_lock<std::mutex>& lock);
+  bool isExpired(const core::FlowFile& flow_file, std::chrono::system_clock::time_point now) const;
+
   bool drop_empty_ = false;
+  std::atomic<bool> concurrent_queue_ = false;
   mutable std::mutex mutex_;
   std::atomic<uint64_t> queued_data_size_ = 0;
   utils::FlowFileQueue queue_;
+  // mirrors queue_.size(), updated under mutex_, so that the size can be queried without locking
+  std::atomic<uint64_t> queue_size_ = 0;
+  // flow files that were ready for processing when they were enqueued, only used with concurrent_queue_
+  moodycamel::ConcurrentQueue<std::shared_ptr<core::FlowFile>> ready_queue_;
+  std::atomic<uint64_t> ready_queue_size_ = 0;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<Connection>::getLogger();
 };
 }  // namespace org::apache::nifi::minifi
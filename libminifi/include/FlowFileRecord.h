@@ -53,6 +53,10 @@ class FlowFileRecord : public core::FlowFile {
  public:
   FlowFileRecord();
 
+  /**
+   * Writes the record in the compact format: varint lengths and timestamps, binary uuids, well-known attribute keys
+   * as indices and the content path relative to the content repository. DeSerialize reads the legacy format as well.
+   */
   bool Serialize(io::OutputStream &outStream);
 
   //! Serialize and Persistent to the repository
@@ -75,6 +79,9 @@ class FlowFileRecord : public core::FlowFile {
   static std::atomic<uint64_t> local_flow_seq_number_;
 
  private:
+  static std::shared_ptr<FlowFileRecord> DeSerializeLegacy(io::InputStream &stream, const std::shared_ptr<core::ContentRepository> &content_repo, utils::Identifier &container);
+  static std::shared_ptr<FlowFileRecord> DeSerializeCompact(io::InputStream &stream, const std::shared_ptr<core::ContentRepository> &content_repo, utils::Identifier &container);
+
   static std::shared_ptr<core::logging::Logger> logger_;
 };
 
@@ -27,6 +27,7 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <optional>
 #include "core/Core.h"
 #include "core/StreamManager.h"
 #include "properties/Configure.h"
@@ -78,6 +79,12 @@ class ResourceClaim {
     return _contentFullPath;
   }
 
+  /**
+   * Returns the content path relative to the storage path of the claim manager,
+   * or nullopt if the content is not stored under it.
+   */
+  std::optional<Path> getContentId() const;
+
   bool exists() {
     if (claim_manager_ == nullptr) {
       return false;
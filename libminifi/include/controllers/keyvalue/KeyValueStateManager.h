@@ -50,8 +50,12 @@ class KeyValueStateManager final : public core::StateManager {
     CLEAR
   };
 
+  bool commitStateToSet();
+  bool commitClear();
+
   gsl::not_null<KeyValueStateStorage*> storage_;
   std::optional<core::StateManager::State> state_;
+  bool has_serialized_state_ = false;  // the whole state is stored in one entry, as written by earlier versions
   bool transaction_in_progress_;
   ChangeType change_type_;
   core::StateManager::State state_to_set_;
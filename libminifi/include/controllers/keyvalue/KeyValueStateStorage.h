@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/controller/ControllerService.h"
 #include "core/Core.h"
@@ -39,6 +40,13 @@ class KeyValueStateStorage : public core::StateStorage, public core::controller:
   static core::StateManager::State deserialize(const std::string& serialized);
   static std::string serialize(const core::StateManager::State& kvs);
 
+  /**
+   * The state of a component is stored as one entry per state key under "<component uuid>/<state key>",
+   * so that a commit only has to write the keys that changed. The entry under "<component uuid>" marks that the
+   * component has a state, it can also contain the whole serialized state as written by earlier versions.
+   */
+  static std::string getStateEntryKey(const utils::Identifier& component_id, const std::string& state_key);
+
   std::unique_ptr<core::StateManager> getStateManager(const utils::Identifier& uuid) override;
   std::unordered_map<utils::Identifier, core::StateManager::State> getAllStates() override;
 
@@ -61,9 +69,19 @@ class KeyValueStateStorage : public core::StateStorage, public core::controller:
   virtual bool update(const std::string& key, const std::function<bool(bool /*exists*/, std::string& /*value*/)>& update_func) = 0;
   virtual bool persist() = 0;
 
- private:
-  bool getAll(std::unordered_map<utils::Identifier, std::string>& kvs);
+  /**
+   * Sets and removes the given keys as a single atomic change.
+   * The default implementation is not atomic, it applies the changes one by one.
+   */
+  virtual bool setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove);
 
+  /**
+   * Gets the key-value pairs whose key starts with the given prefix.
+   * The default implementation filters all key-value pairs.
+   */
+  virtual bool getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs);
+
+ private:
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<KeyValueStateStorage>::getLogger();
 };
 
@@ -45,6 +45,8 @@ class BufferedContentSession : public ContentSession {
 
   std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) override;
 
+  std::shared_ptr<io::BaseStream> readMapped(const std::shared_ptr<ResourceClaim>& resource_id) override;
+
   void commit() override;
 
   void rollback() override;
@@ -50,6 +50,14 @@ class ContentRepository : public core::CoreComponent, public StreamManager<minif
   void incrementStreamCount(const minifi::ResourceClaim &streamId) override;
   StreamState decrementStreamCount(const minifi::ResourceClaim &streamId) override;
 
+  /**
+   * Returns a read-only stream of the content of claim, whose getBuffer() is a view of the whole content
+   * that does not have to be copied (e.g. the file is mapped into memory), nullptr if the repository cannot provide one.
+   */
+  virtual std::shared_ptr<io::BaseStream> readMapped(const minifi::ResourceClaim& /*claim*/) {
+    return nullptr;
+  }
+
   virtual void clearOrphans() = 0;
 
   virtual void start() {}
@@ -34,6 +34,14 @@ class ContentSession {
 
   virtual std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) = 0;
 
+  /**
+   * Like read, but the getBuffer() of the returned stream is a view of the whole content,
+   * returns nullptr if the content cannot be accessed without copying.
+   */
+  virtual std::shared_ptr<io::BaseStream> readMapped(const std::shared_ptr<ResourceClaim>& /*resource_id*/) {
+    return nullptr;
+  }
+
   virtual void commit() = 0;
 
   virtual void rollback() = 0;
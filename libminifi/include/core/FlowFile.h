@@ -32,6 +32,7 @@
 #include "Connectable.h"
 #include "WeakReference.h"
 #include "utils/FlatMap.h"
+#include "utils/CopyOnWrite.h"
 #include "utils/Export.h"
 
 namespace org {
@@ -161,7 +162,7 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    * setAttribute, if attribute already there, update it, else, add it
    */
   bool setAttribute(std::string_view key, std::string value) {
-    return attributes_.insert_or_assign(std::string{key}, std::move(value)).second;
+    return attributes_.getMutable().insert_or_assign(std::string{key}, std::move(value)).second;
   }
 
   /**
@@ -169,15 +170,42 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
    * @return attributes.
    */
   [[nodiscard]] std::map<std::string, std::string> getAttributes() const {
-    return {attributes_.begin(), attributes_.end()};
+    return {attributes_.get().begin(), attributes_.get().end()};
   }
 
   /**
-   * Returns the map of attributes
+   * Returns the map of attributes without copying it
+   * @return attributes.
+   */
+  [[nodiscard]] const AttributeMap& getAttributeMap() const {
+    return attributes_.get();
+  }
+
+  /**
+   * Returns a snapshot of the attributes, sharing the storage with this flow file
+   * until either of them is modified
+   * @return attributes.
+   */
+  [[nodiscard]] std::shared_ptr<const AttributeMap> shareAttributes() const {
+    return attributes_.share();
+  }
+
+  /**
+   * Replaces the attributes with the ones of the other flow file, sharing
+   * the storage with it until either of them is modified
+   */
+  void copyAttributesFrom(const FlowFile& other) {
+    attributes_ = other.attributes_;
+  }
+
+  /**
+   * Returns the map of attributes. As the returned pointer allows modification
+   * at any time, the attributes of this flow file will not be shared with copies anymore,
+   * prefer getAttributeMap() for read-only access.
    * @return attributes.
    */
   AttributeMap *getAttributesPtr() {
-    return &attributes_;
+    return attributes_.leak();
   }
 
   /**
@@ -274,8 +302,8 @@ class FlowFile : public CoreComponent, public ReferenceContainer {
   uint64_t offset_;
   // Penalty expiration
   std::chrono::steady_clock::time_point to_be_processed_after_;
-  // Attributes key/values pairs for the flow record
-  AttributeMap attributes_;
+  // Attributes key/values pairs for the flow record, shared with snapshots and copies until modified
+  utils::CopyOnWrite<AttributeMap> attributes_;
   // Pointer to the associated content resource claim
   std::shared_ptr<ResourceClaim> claim_;
   // Pointers to stashed content resource claims
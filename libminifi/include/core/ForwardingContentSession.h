@@ -44,6 +44,8 @@ class ForwardingContentSession : public ContentSession {
 
   std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) override;
 
+  std::shared_ptr<io::BaseStream> readMapped(const std::shared_ptr<ResourceClaim>& resource_id) override;
+
   void commit() override;
 
   void rollback() override;
@@ -17,7 +17,9 @@
  */
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -76,6 +78,12 @@ class ProcessSession : public ReferenceContainer {
 
   // Get the FlowFile from the highest priority queue
   virtual std::shared_ptr<core::FlowFile> get();
+  /**
+   * Get up to max_count FlowFiles from the incoming connections, draining each connection in a single batch.
+   * @param max_count maximum number of FlowFiles to return
+   * @param max_bytes stop once the total size of the returned FlowFiles reaches this value, 0 means unlimited
+   */
+  std::vector<std::shared_ptr<core::FlowFile>> get(size_t max_count, uint64_t max_bytes = 0);
   // Create a new UUID FlowFile with no content resource claim and inherit all attributes from parent
   std::shared_ptr<core::FlowFile> create(const std::shared_ptr<core::FlowFile> &parent = {});
   // Add a FlowFile to the session
@@ -92,12 +100,20 @@ class ProcessSession : public ReferenceContainer {
   void removeAttribute(const std::shared_ptr<core::FlowFile>& flow, const std::string& key);
   // Remove Flow File
   void remove(const std::shared_ptr<core::FlowFile> &flow);
+  // Take a flow file provided by this session out of it without routing it. Its repository record is left in the state it had
+  // in the incoming connection, so the caller has to hold on to it and route it in a later session, or it is received again after a restart
+  void detach(const std::shared_ptr<core::FlowFile> &flow);
   // Access the contents of the flow file as an input stream; returns null if the flow file has no content claim
   std::shared_ptr<io::InputStream> getFlowFileContentStream(const std::shared_ptr<core::FlowFile>& flow_file);
   // Execute the given read callback against the content
   int64_t read(const std::shared_ptr<core::FlowFile> &flow, const io::InputStreamCallback& callback);
   // Read content into buffer
   detail::ReadBufferResult readBuffer(const std::shared_ptr<core::FlowFile>& flow);
+  // Access the contents of the flow file as an input stream, whose getBuffer() is a view of the content; returns null
+  // if the content repository cannot provide the content without copying it
+  std::shared_ptr<io::InputStream> getMappedFlowFileContentStream(const std::shared_ptr<core::FlowFile>& flow_file);
+  // Execute the given callback against a view of the content, which is only read into memory if it cannot be mapped
+  int64_t readMapped(const std::shared_ptr<core::FlowFile>& flow, const std::function<int64_t(std::span<const std::byte>)>& callback);
   // Execute the given write callback against the content
   void write(const std::shared_ptr<core::FlowFile> &flow, const io::OutputStreamCallback& callback);
   // Read and write the flow file at the same time (eg. for processing it line by line)
@@ -204,8 +220,14 @@ class ProcessSession : public ReferenceContainer {
   void ensureNonNullResourceClaim(
       const std::map<Connectable*, std::vector<std::shared_ptr<core::FlowFile>>>& transactionMap);
 
+  void expireFlowFiles(const std::vector<std::shared_ptr<core::FlowFile>>& expired_flow_files);
+  // registers a flow file polled from an incoming connection with the session
+  void addPolledFlowFile(const std::shared_ptr<core::FlowFile>& flow_file, const std::shared_ptr<state::FlowIdentifier>& flow_version);
+
   // Clone the flow file during transfer to multiple connections for a relationship
   std::shared_ptr<core::FlowFile> cloneDuringTransfer(const std::shared_ptr<core::FlowFile> &parent);
+  // Shares the attributes of the parent with its child or clone, except for the special ones
+  void copyAttributesFromParent(core::FlowFile& record, const core::FlowFile& parent) const;
   // ProcessContext
   std::shared_ptr<ProcessContext> process_context_;
   // Logger
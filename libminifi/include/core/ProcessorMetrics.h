@@ -19,12 +19,14 @@
 #include <string>
 #include <chrono>
 #include <atomic>
+#include <memory>
 #include <unordered_map>
-#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #include "core/state/nodes/MetricsBase.h"
 #include "core/state/PublishedMetricProvider.h"
+#include "utils/AtomicHistogram.h"
 
 namespace org::apache::nifi::minifi::core {
 
@@ -47,11 +49,13 @@ class ProcessorMetrics : public state::response::ResponseNode {
   void increaseRelationshipTransferCount(const std::string& relationship, size_t count = 1);
   std::chrono::milliseconds getAverageOnTriggerRuntime() const;
   std::chrono::milliseconds getLastOnTriggerRuntime() const;
-  void addLastOnTriggerRuntime(std::chrono::milliseconds runtime);
+  std::chrono::microseconds getOnTriggerRuntimePercentile(double fraction) const;
+  void addLastOnTriggerRuntime(std::chrono::microseconds runtime);
 
   std::chrono::milliseconds getAverageSessionCommitRuntime() const;
   std::chrono::milliseconds getLastSessionCommitRuntime() const;
-  void addLastSessionCommitRuntime(std::chrono::milliseconds runtime);
+  std::chrono::microseconds getSessionCommitRuntimePercentile(double fraction) const;
+  void addLastSessionCommitRuntime(std::chrono::microseconds runtime);
 
   std::atomic<size_t> iterations{0};
   std::atomic<size_t> transferred_flow_files{0};
@@ -62,29 +66,31 @@ class ProcessorMetrics : public state::response::ResponseNode {
   requires Summable<ValueType> && DividableByInteger<ValueType>
   class Averager {
    public:
-    explicit Averager(uint32_t sample_size) : SAMPLE_SIZE_(sample_size), next_average_index_(SAMPLE_SIZE_) {
-      values_.reserve(SAMPLE_SIZE_);
-    }
+    explicit Averager(uint32_t sample_size) : SAMPLE_SIZE_(sample_size), values_(std::make_unique<std::atomic<ValueType>[]>(SAMPLE_SIZE_)) {}
 
     ValueType getAverage() const;
     ValueType getLastValue() const;
     void addValue(ValueType runtime);
 
    private:
+    // lock-free ring buffer of the last SAMPLE_SIZE_ values, a reader may see a slot before the value claiming it is stored
     const uint32_t SAMPLE_SIZE_;
-    mutable std::mutex average_value_mutex_;
-    uint32_t next_average_index_;
-    std::vector<ValueType> values_;
+    std::atomic<uint64_t> value_count_{0};
+    std::unique_ptr<std::atomic<ValueType>[]> values_;
   };
 
   [[nodiscard]] std::unordered_map<std::string, std::string> getCommonLabels() const;
   static const uint8_t STORED_ON_TRIGGER_RUNTIME_COUNT = 10;
 
-  std::mutex transferred_relationships_mutex_;
-  std::unordered_map<std::string, size_t> transferred_relationships_;
+  // the unique lock is only taken when a relationship is transferred to for the first time
+  mutable std::shared_mutex transferred_relationships_mutex_;
+  std::unordered_map<std::string, std::atomic<size_t>> transferred_relationships_;
   const Processor& source_processor_;
   Averager<std::chrono::milliseconds> on_trigger_runtime_averager_;
   Averager<std::chrono::milliseconds> session_commit_runtime_averager_;
+  // in microseconds
+  utils::AtomicHistogram on_trigger_runtime_histogram_;
+  utils::AtomicHistogram session_commit_runtime_histogram_;
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -48,6 +48,7 @@ struct FlowSchema {
   Keys destination_name;
   Keys flowfile_expiration;
   Keys drop_empty;
+  Keys concurrent_queue;
   Keys source_relationship;
   Keys source_relationship_list;
 
@@ -53,6 +53,7 @@ class StructuredConnectionParser {
   [[nodiscard]] utils::Identifier getDestinationUUID() const;
   [[nodiscard]] std::chrono::milliseconds getFlowFileExpiration() const;
   [[nodiscard]] bool getDropEmpty() const;
+  [[nodiscard]] bool getConcurrentQueue() const;
 
  private:
   void addNewRelationshipToConnection(std::string_view relationship_name, minifi::Connection& connection) const;
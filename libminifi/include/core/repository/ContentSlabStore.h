@@ -0,0 +1,114 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/logging/Logger.h"
+
+namespace org::apache::nifi::minifi::core::repository {
+
+/**
+ * Packs the content of many small resource claims into large append-only segment files.
+ *
+ * Every segment "<id>.slab" has an accompanying "<id>.idx" file, listing the key, offset and length
+ * of each entry appended to the segment, so the locations can be restored on startup without
+ * reading the content itself. Only the newest segment is written to; once it grows over the
+ * configured size a new one is started. A segment is deleted when it is no longer written to
+ * and all of its entries have been removed.
+ */
+class ContentSlabStore {
+ public:
+  ContentSlabStore(std::filesystem::path directory, uint64_t max_segment_size);
+
+  ContentSlabStore(const ContentSlabStore&) = delete;
+  ContentSlabStore& operator=(const ContentSlabStore&) = delete;
+
+  /**
+   * Restores the entry locations from the index files of the existing segments.
+   */
+  bool initialize();
+
+  /**
+   * Appends the content of key to the active segment, replacing its previous content if there was one.
+   */
+  bool append(const std::string& key, std::span<const std::byte> data);
+
+  std::optional<std::vector<std::byte>> read(const std::string& key) const;
+
+  bool contains(const std::string& key) const;
+
+  /**
+   * Removes key, deleting its segment if it was the last live entry in it.
+   * @return true if the key was present
+   */
+  bool remove(const std::string& key);
+
+  std::vector<std::string> getKeys() const;
+
+  size_t getEntryCount() const;
+
+  const std::filesystem::path& getDirectory() const {
+    return directory_;
+  }
+
+ private:
+  struct Location {
+    uint64_t segment_id;
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  struct Segment {
+    uint64_t size = 0;
+    size_t live_entries = 0;
+  };
+
+  std::filesystem::path getSegmentPath(uint64_t segment_id) const;
+  std::filesystem::path getIndexPath(uint64_t segment_id) const;
+  bool loadIndex(uint64_t segment_id);
+  bool openActiveSegment(uint64_t segment_id);
+  bool rollOver();
+  void releaseEntry(const Location& location);
+  void deleteSegment(uint64_t segment_id);
+
+  const std::filesystem::path directory_;
+  const uint64_t max_segment_size_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Location> entries_;
+  std::map<uint64_t, Segment> segments_;
+  uint64_t active_segment_id_ = 0;
+  std::ofstream active_segment_;
+  std::ofstream active_index_;
+
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::core::repository
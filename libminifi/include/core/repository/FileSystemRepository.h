@@ -24,14 +24,23 @@
 #include <algorithm>
 
 #include "../ContentRepository.h"
+#include "ContentSlabStore.h"
 #include "properties/Configure.h"
 #include "core/logging/LoggerFactory.h"
 #include "utils/file/FileUtils.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
+/**
+ * Stores every resource claim in a separate file, optionally spread over a fixed number of subdirectories.
+ * In slab mode the content of small claims is packed into large segment files instead (see ContentSlabStore),
+ * claims growing over the configured size are still stored in separate files.
+ */
 class FileSystemRepository : public core::ContentRepository {
  public:
+  static constexpr const char* SLAB_DIRECTORY_NAME = "slabs";
+  static constexpr uint64_t DEFAULT_SLAB_SEGMENT_SIZE = 16 * 1024 * 1024;
+
   explicit FileSystemRepository(std::string name = getClassName<FileSystemRepository>())
     : core::ContentRepository(std::move(name)),
       logger_(logging::LoggerFactory<FileSystemRepository>::getLogger()) {
@@ -43,6 +52,7 @@ class FileSystemRepository : public core::ContentRepository {
   bool exists(const minifi::ResourceClaim& streamId) override;
   std::shared_ptr<io::BaseStream> write(const minifi::ResourceClaim& claim, bool append = false) override;
   std::shared_ptr<io::BaseStream> read(const minifi::ResourceClaim& claim) override;
+  std::shared_ptr<io::BaseStream> readMapped(const minifi::ResourceClaim& claim) override;
 
   bool close(const minifi::ResourceClaim& claim) override {
     return remove(claim);
@@ -56,18 +66,23 @@ class FileSystemRepository : public core::ContentRepository {
     return utils::file::path_size(directory_);
   }
 
-  uint64_t getRepositoryEntryCount() const override {
-    auto dir_it = std::filesystem::recursive_directory_iterator(directory_, std::filesystem::directory_options::skip_permission_denied);
-    return std::count_if(
-      std::filesystem::begin(dir_it),
-      std::filesystem::end(dir_it),
-      [](auto& entry) { return entry.is_regular_file(); });
-  }
+  uint64_t getRepositoryEntryCount() const override;
 
  protected:
   bool removeKey(const std::string& content_path) override;
 
  private:
+  class SlabWriteStream;
+
+  /**
+   * Returns the location of the file storing the content of content_path, taking the directory fan-out into account.
+   */
+  std::filesystem::path getFilePath(const std::string& content_path) const;
+  bool removeFile(const std::filesystem::path& path);
+
+  uint32_t directory_fan_out_ = 0;
+  uint64_t slab_max_claim_size_ = 0;
+  std::shared_ptr<ContentSlabStore> slab_store_;
   std::shared_ptr<logging::Logger> logger_;
 };
 
@@ -62,6 +62,13 @@ class InputStream : public virtual Stream {
    **/
   size_t read(utils::Identifier& value);
 
+  /**
+   * Read a variable length integer written by OutputStream::writeVarInt. Use isError (Stream.h) to check for errors.
+   * @param value reference to the output
+   * @return resulting read size or STREAM_ERROR on error
+   **/
+  size_t readVarInt(uint64_t& value);
+
   /**
    * Reads sizeof(Integral) bytes from the stream. Use isError (Stream.h) to check for errors.
    * @param value reference in which will set the result
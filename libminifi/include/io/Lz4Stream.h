@@ -0,0 +1,106 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <lz4frame.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "OutputStream.h"
+#include "core/logging/Logger.h"
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * Compresses the data written to it into an LZ4 frame, and writes the compressed data to the underlying stream.
+ * The frame is completed by close().
+ */
+class Lz4CompressStream : public OutputStream {
+ public:
+  // levels below 3 use the fast LZ4 compressor, higher ones (up to 12) the high compression one
+  explicit Lz4CompressStream(gsl::not_null<OutputStream*> output, int level = 0);
+
+  Lz4CompressStream(const Lz4CompressStream&) = delete;
+  Lz4CompressStream& operator=(const Lz4CompressStream&) = delete;
+  Lz4CompressStream(Lz4CompressStream&& other) = delete;
+  Lz4CompressStream& operator=(Lz4CompressStream&& other) = delete;
+
+  ~Lz4CompressStream() override = default;
+
+  using OutputStream::write;
+  size_t write(const uint8_t* value, size_t size) override;
+
+  void close() override;
+
+  bool isFinished() const { return finished_; }
+
+ private:
+  bool begin();
+  bool writeOutput(size_t result, const char* operation);
+
+  struct ContextDeleter {
+    void operator()(LZ4F_cctx* context) const { LZ4F_freeCompressionContext(context); }
+  };
+
+  std::unique_ptr<LZ4F_cctx, ContextDeleter> context_;
+  LZ4F_preferences_t preferences_{};
+  std::vector<std::byte> output_buffer_;
+  gsl::not_null<OutputStream*> output_;
+  bool started_ = false;
+  bool errored_ = false;
+  bool finished_ = false;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+/**
+ * Decompresses the LZ4 frames written to it, and writes the decompressed data to the underlying stream.
+ */
+class Lz4DecompressStream : public OutputStream {
+ public:
+  explicit Lz4DecompressStream(gsl::not_null<OutputStream*> output);
+
+  Lz4DecompressStream(const Lz4DecompressStream&) = delete;
+  Lz4DecompressStream& operator=(const Lz4DecompressStream&) = delete;
+  Lz4DecompressStream(Lz4DecompressStream&& other) = delete;
+  Lz4DecompressStream& operator=(Lz4DecompressStream&& other) = delete;
+
+  ~Lz4DecompressStream() override = default;
+
+  using OutputStream::write;
+  size_t write(const uint8_t* value, size_t size) override;
+
+  // true if the data written so far ends with a complete frame
+  bool isFinished() const { return !errored_ && frame_complete_; }
+
+ private:
+  struct ContextDeleter {
+    void operator()(LZ4F_dctx* context) const { LZ4F_freeDecompressionContext(context); }
+  };
+
+  std::unique_ptr<LZ4F_dctx, ContextDeleter> context_;
+  std::vector<std::byte> output_buffer_;
+  gsl::not_null<OutputStream*> output_;
+  bool errored_ = false;
+  bool frame_complete_ = false;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::io
@@ -0,0 +1,79 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#include "BaseStream.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * Read-only stream over a file mapped into memory. getBuffer() returns a view of the whole file,
+ * which stays valid until the stream is closed or destroyed.
+ */
+class MemoryMappedFileStream : public io::BaseStream {
+ public:
+  /**
+   * Maps the file at path, returns nullptr if the file cannot be mapped.
+   */
+  static std::shared_ptr<MemoryMappedFileStream> map(const std::filesystem::path& path);
+
+  MemoryMappedFileStream(const MemoryMappedFileStream&) = delete;
+  MemoryMappedFileStream& operator=(const MemoryMappedFileStream&) = delete;
+
+  ~MemoryMappedFileStream() override {
+    close();
+  }
+
+  void close() final;
+
+  void seek(size_t offset) override;
+
+  [[nodiscard]] size_t tell() const override {
+    return offset_;
+  }
+
+  [[nodiscard]] size_t size() const override {
+    return length_;
+  }
+
+  [[nodiscard]] std::span<const std::byte> getBuffer() const override {
+    return {data_, length_};
+  }
+
+  using BaseStream::read;
+  using BaseStream::write;
+
+  size_t read(std::span<std::byte> buf) override;
+
+  size_t write(const uint8_t* /*value*/, size_t /*size*/) override {
+    return STREAM_ERROR;
+  }
+
+ private:
+  MemoryMappedFileStream(const std::byte* data, size_t length) : data_(data), length_(length) {}
+
+  const std::byte* data_;
+  size_t length_;
+  size_t offset_ = 0;
+};
+
+}  // namespace org::apache::nifi::minifi::io
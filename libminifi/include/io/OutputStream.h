@@ -93,6 +93,13 @@ class OutputStream : public virtual Stream {
    **/
   size_t write(const char* str, bool widen = false);
 
+  /**
+   * writes value as a variable length integer, using 7 bits of each byte and the highest bit to mark continuation
+   * @param value to write
+   * @return resulting write size
+   **/
+  size_t writeVarInt(uint64_t value);
+
   template<size_t N>
   size_t write(const utils::SmallString<N>& str, bool widen = false) {
     return write(str.c_str(), widen);
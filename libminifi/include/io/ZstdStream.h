@@ -0,0 +1,107 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <zstd.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "OutputStream.h"
+#include "core/logging/Logger.h"
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * Compresses the data written to it into zstd frames, and writes the compressed data to the underlying stream.
+ * The frame is completed by close().
+ */
+class ZstdCompressStream : public OutputStream {
+ public:
+  /**
+   * @param level zstd compression level, negative levels trade compression ratio for speed
+   * @param worker_count number of background threads compressing the data; 0 compresses on the writing thread
+   * @param long_distance_matching finds matches far back in the input, which improves the ratio of large inputs with distant repetitions
+   */
+  explicit ZstdCompressStream(gsl::not_null<OutputStream*> output, int level = ZSTD_CLEVEL_DEFAULT, uint32_t worker_count = 0, bool long_distance_matching = false);
+
+  ZstdCompressStream(const ZstdCompressStream&) = delete;
+  ZstdCompressStream& operator=(const ZstdCompressStream&) = delete;
+  ZstdCompressStream(ZstdCompressStream&& other) = delete;
+  ZstdCompressStream& operator=(ZstdCompressStream&& other) = delete;
+
+  ~ZstdCompressStream() override = default;
+
+  using OutputStream::write;
+  size_t write(const uint8_t* value, size_t size) override;
+
+  void close() override;
+
+  bool isFinished() const { return finished_; }
+
+ private:
+  size_t compress(const uint8_t* value, size_t size, ZSTD_EndDirective mode);
+
+  struct ContextDeleter {
+    void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+  };
+
+  std::unique_ptr<ZSTD_CCtx, ContextDeleter> context_;
+  std::vector<std::byte> output_buffer_;
+  gsl::not_null<OutputStream*> output_;
+  bool errored_ = false;
+  bool finished_ = false;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+/**
+ * Decompresses the zstd frames written to it, and writes the decompressed data to the underlying stream.
+ */
+class ZstdDecompressStream : public OutputStream {
+ public:
+  explicit ZstdDecompressStream(gsl::not_null<OutputStream*> output);
+
+  ZstdDecompressStream(const ZstdDecompressStream&) = delete;
+  ZstdDecompressStream& operator=(const ZstdDecompressStream&) = delete;
+  ZstdDecompressStream(ZstdDecompressStream&& other) = delete;
+  ZstdDecompressStream& operator=(ZstdDecompressStream&& other) = delete;
+
+  ~ZstdDecompressStream() override = default;
+
+  using OutputStream::write;
+  size_t write(const uint8_t* value, size_t size) override;
+
+  // true if the data written so far ends with a complete frame
+  bool isFinished() const { return !errored_ && frame_complete_; }
+
+ private:
+  struct ContextDeleter {
+    void operator()(ZSTD_DCtx* context) const { ZSTD_freeDCtx(context); }
+  };
+
+  std::unique_ptr<ZSTD_DCtx, ContextDeleter> context_;
+  std::vector<std::byte> output_buffer_;
+  gsl::not_null<OutputStream*> output_;
+  bool errored_ = false;
+  bool frame_complete_ = false;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
+}  // namespace org::apache::nifi::minifi::io
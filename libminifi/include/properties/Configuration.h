@@ -45,6 +45,7 @@ class Configuration : public Properties {
   static constexpr const char *nifi_flow_engine_threads = "nifi.flow.engine.threads";
   static constexpr const char *nifi_flow_engine_alert_period = "nifi.flow.engine.alert.period";
   static constexpr const char *nifi_flow_engine_event_driven_time_slice = "nifi.flow.engine.event.driven.time.slice";
+  static constexpr const char *nifi_flow_engine_work_stealing = "nifi.flow.engine.work.stealing";
   static constexpr const char *nifi_administrative_yield_duration = "nifi.administrative.yield.duration";
   static constexpr const char *nifi_bored_yield_duration = "nifi.bored.yield.duration";
   static constexpr const char *nifi_graceful_shutdown_seconds = "nifi.flowcontroller.graceful.shutdown.period";
@@ -74,6 +75,12 @@ class Configuration : public Properties {
   // these are internal properties related to the rocksdb backend
   static constexpr const char *nifi_flowfile_repository_rocksdb_compaction_period = "nifi.flowfile.repository.rocksdb.compaction.period";
   static constexpr const char *nifi_dbcontent_repository_rocksdb_compaction_period = "nifi.database.content.repository.rocksdb.compaction.period";
+  static constexpr const char *nifi_flowfile_repository_rocksdb_group_commit_window = "nifi.flowfile.repository.rocksdb.group.commit.window";
+  static constexpr const char *nifi_flowfile_repository_rocksdb_sync = "nifi.flowfile.repository.rocksdb.sync";
+  static constexpr const char *nifi_flowfile_repository_rocksdb_recovery_threads = "nifi.flowfile.repository.rocksdb.recovery.threads";
+  static constexpr const char *nifi_filesystem_content_repository_directory_fan_out = "nifi.filesystem.content.repository.directory.fan.out";
+  static constexpr const char *nifi_filesystem_content_repository_slab_max_claim_size = "nifi.filesystem.content.repository.slab.max.claim.size";
+  static constexpr const char *nifi_filesystem_content_repository_slab_segment_size = "nifi.filesystem.content.repository.slab.segment.size";
 
   static constexpr const char *nifi_remote_input_secure = "nifi.remote.input.secure";
   static constexpr const char *nifi_security_need_ClientAuth = "nifi.security.need.ClientAuth";
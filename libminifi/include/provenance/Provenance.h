@@ -167,7 +167,10 @@ class ProvenanceEventRecord : public core::SerializableComponent {
   }
 
   std::map<std::string, std::string> getAttributes() const {
-    return _attributes;
+    if (!_attributes) {
+      return {};
+    }
+    return {_attributes->begin(), _attributes->end()};
   }
 
   uint64_t getFileSize() const {
@@ -322,7 +325,7 @@ class ProvenanceEventRecord : public core::SerializableComponent {
     _lineageStartDate = flow->getlineageStartDate();
     _lineageIdentifiers = flow->getlineageIdentifiers();
     flow_uuid_ = flow->getUUID();
-    _attributes = flow->getAttributes();
+    _attributes = flow->shareAttributes();
     _size = flow->getSize();
     _offset = flow->getOffset();
     if (flow->getConnection())
@@ -352,7 +355,8 @@ class ProvenanceEventRecord : public core::SerializableComponent {
   utils::Identifier flow_uuid_;
   uint64_t _offset;
   std::string _contentFullPath;
-  std::map<std::string, std::string> _attributes;
+  // shares storage with the flow file's attributes at the time of the event
+  std::shared_ptr<const core::FlowFile::AttributeMap> _attributes;
   // UUID string for all parents
   std::vector<utils::Identifier> _lineageIdentifiers;
   std::string _transitUri;
@@ -0,0 +1,126 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Histogram of non-negative integer values with a bounded relative error, similar to HdrHistogram.
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly, larger ones in log-linear buckets: every power of two range is
+ * split into 2^SUB_BUCKET_BITS equal sub-buckets, so the relative error of the reported percentiles is below 2^-SUB_BUCKET_BITS.
+ * Values of MAX_VALUE_BITS bits or more are counted in the last bucket.
+ *
+ * Recording is lock-free and wait-free: it only increments atomic counters, the buckets are only summed when a snapshot is taken.
+ * The snapshot is not atomic with respect to concurrent recordings, which is fine for metrics.
+ */
+class AtomicHistogram {
+ public:
+  static constexpr size_t SUB_BUCKET_BITS = 5;
+  static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+  static constexpr size_t MAX_VALUE_BITS = 36;
+  static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+  class Snapshot {
+   public:
+    [[nodiscard]] uint64_t count() const { return count_; }
+    [[nodiscard]] uint64_t max() const { return max_; }
+    [[nodiscard]] double mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+    /**
+     * Returns the smallest value that is greater than or equal to the given fraction (between 0 and 1) of the recorded values,
+     * up to the precision of the buckets. Returns 0 if there are no recorded values.
+     */
+    [[nodiscard]] uint64_t percentile(double fraction) const {
+      if (count_ == 0) {
+        return 0;
+      }
+      const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(count_))));
+      uint64_t seen = 0;
+      for (size_t index = 0; index < BUCKET_COUNT; ++index) {
+        seen += buckets_[index];
+        if (seen >= rank) {
+          return std::min(bucketUpperBound(index), max_);
+        }
+      }
+      return max_;
+    }
+
+   private:
+    friend class AtomicHistogram;
+
+    std::array<uint64_t, BUCKET_COUNT> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+  };
+
+  void record(uint64_t value) {
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+  }
+
+  [[nodiscard]] Snapshot getSnapshot() const {
+    Snapshot snapshot;
+    for (size_t index = 0; index < BUCKET_COUNT; ++index) {
+      snapshot.buckets_[index] = buckets_[index].load(std::memory_order_relaxed);
+      snapshot.count_ += snapshot.buckets_[index];
+    }
+    snapshot.sum_ = sum_.load(std::memory_order_relaxed);
+    snapshot.max_ = max_.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+  static size_t bucketIndex(uint64_t value) {
+    const size_t highest_bit = std::bit_width(value);
+    if (highest_bit <= SUB_BUCKET_BITS) {
+      return value;
+    }
+    if (highest_bit > MAX_VALUE_BITS) {
+      return BUCKET_COUNT - 1;
+    }
+    const size_t shift = highest_bit - SUB_BUCKET_BITS - 1;
+    // the top bit is implied by the range, the next SUB_BUCKET_BITS bits select the sub-bucket
+    return ((shift + 1) << SUB_BUCKET_BITS) + ((value >> shift) - SUB_BUCKET_COUNT);
+  }
+
+  static uint64_t bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+      return index;
+    }
+    const size_t shift = (index >> SUB_BUCKET_BITS) - 1;
+    const uint64_t sub_bucket = index & (SUB_BUCKET_COUNT - 1);
+    return ((SUB_BUCKET_COUNT + sub_bucket + 1) << shift) - 1;
+  }
+
+ private:
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+}  // namespace org::apache::nifi::minifi::utils
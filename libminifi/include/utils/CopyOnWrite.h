@@ -0,0 +1,104 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Value wrapper whose copies share the same underlying storage until one of them is modified.
+ *
+ * Not thread-safe: the same instance must not be copied and modified concurrently, but different
+ * instances sharing the same storage can be used from different threads.
+ */
+template<typename T>
+class CopyOnWrite {
+ public:
+  CopyOnWrite() : value_(std::make_shared<T>()) {}
+
+  explicit CopyOnWrite(T value) : value_(std::make_shared<T>(std::move(value))) {}
+
+  CopyOnWrite(const CopyOnWrite& other)
+      : value_(other.shareable_ ? other.value_ : std::make_shared<T>(*other.value_)) {}
+
+  // the moved-from instance is left holding a default constructed value, so that it stays usable
+  CopyOnWrite(CopyOnWrite&& other)
+      : value_(std::exchange(other.value_, std::make_shared<T>())),
+        shareable_(std::exchange(other.shareable_, true)) {}
+
+  CopyOnWrite& operator=(const CopyOnWrite& other) {
+    if (this != &other) {
+      value_ = other.shareable_ ? other.value_ : std::make_shared<T>(*other.value_);
+      shareable_ = true;
+    }
+    return *this;
+  }
+
+  CopyOnWrite& operator=(CopyOnWrite&& other) {
+    if (this != &other) {
+      value_ = std::exchange(other.value_, std::make_shared<T>());
+      shareable_ = std::exchange(other.shareable_, true);
+    }
+    return *this;
+  }
+
+  const T& get() const {
+    return *value_;
+  }
+
+  /**
+   * Returns a modifiable reference, copying the underlying value first if it is shared with other instances.
+   * The reference is invalidated by the next copy of this instance.
+   */
+  T& getMutable() {
+    if (value_.use_count() > 1) {
+      value_ = std::make_shared<T>(*value_);
+    }
+    return *value_;
+  }
+
+  /**
+   * Like getMutable, but the returned pointer stays valid for the lifetime of this instance,
+   * so the storage will not be shared with later copies anymore.
+   */
+  T* leak() {
+    T* result = &getMutable();
+    shareable_ = false;
+    return result;
+  }
+
+  /**
+   * Returns a snapshot of the current value, which is not affected by later modifications of this instance.
+   */
+  std::shared_ptr<const T> share() const {
+    return shareable_ ? value_ : std::make_shared<T>(*value_);
+  }
+
+  bool isShared() const {
+    return value_.use_count() > 1;
+  }
+
+ private:
+  std::shared_ptr<T> value_;
+  bool shareable_ = true;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -226,6 +226,10 @@ class FlatMap{
     return end();
   }
 
+  bool contains(const K& key) const {
+    return find(key) != end();
+  }
+
   iterator begin() noexcept {
     return iterator{data_.begin()};
   }
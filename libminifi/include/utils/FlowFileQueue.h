@@ -51,6 +51,7 @@ class FlowFileQueue {
   void setMinSize(size_t min_size);
   void setTargetSize(size_t target_size);
   void setMaxSize(size_t max_size);
+  bool isSwappingEnabled() const;
   void clear();
 
  private:
@@ -70,6 +70,10 @@ class Identifier {
 
   bool isNil() const;
 
+  const Data& getData() const {
+    return data_;
+  }
+
   // Numerous places query the string representation
   // just to then forward the temporary to build logs,
   // streams, or others. Dynamically allocating in these
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <chrono>
 #include <deque>
+#include <iterator>
 #include <mutex>
 #include <condition_variable>
 #include <utility>
@@ -95,6 +96,13 @@ class ConcurrentQueue {
     queue_.emplace_back(std::forward<Args>(args)...);
   }
 
+  // Moves all the elements of items to the end of the queue at once
+  template <typename Container>
+  void enqueueAll(Container&& items) {
+    std::lock_guard<std::mutex> guard(mtx_);
+    std::move(items.begin(), items.end(), std::back_inserter(queue_));
+  }
+
  private:
   ConcurrentQueue(ConcurrentQueue&& other, std::lock_guard<std::mutex>&)
     : queue_(std::move(other.queue_)) {}
@@ -169,6 +177,17 @@ class ConditionConcurrentQueue : private ConcurrentQueue<T> {
     }
   }
 
+  template <typename Container>
+  void enqueueAll(Container&& items) {
+    const size_t count = items.size();
+    ConcurrentQueue<T>::enqueueAll(std::forward<Container>(items));
+    if (running_) {
+      for (size_t i = 0; i < count; ++i) {
+        cv_.notify_one();
+      }
+    }
+  }
+
   bool dequeueWait(T& out) {
     std::unique_lock<std::mutex> lck(this->mtx_);
     cv_.wait(lck, [this, &lck]{ return !running_ || !this->emptyImpl(lck); });  // Only wake up if there is something to return or stopped
@@ -0,0 +1,124 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "utils/RegexUtils.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Matches a set of regular expressions against an input in a single pass.
+ *
+ * The patterns are compiled into one NFA, which is turned into a DFA lazily while matching, so the matching time is
+ * linear in the length of the input regardless of the number of patterns. Patterns using syntax the automaton does not
+ * support (back references, lookarounds, word boundaries, anchors within groups, or syntax whose meaning differs between
+ * the regex implementations used by utils::Regex) are matched one by one using utils::Regex, so the results are the same
+ * as those of regexMatch and regexSearch.
+ *
+ * Not thread-safe: the DFA is extended while matching.
+ */
+class RegexSet {
+ public:
+  enum class MatchMode {
+    FULL,     // the whole input has to match, as in regexMatch
+    PARTIAL   // some part of the input has to match, as in regexSearch
+  };
+
+  /**
+   * @throws Exception(REGEX_EXCEPTION) if one of the patterns is not a valid regular expression
+   */
+  RegexSet(const std::vector<std::string>& patterns, MatchMode mode, bool ignore_case = false);
+
+  /**
+   * Returns whether each pattern matches the input, in the order of the patterns.
+   * The returned reference is valid until the next call.
+   */
+  const std::vector<bool>& match(std::string_view input);
+
+  [[nodiscard]] size_t size() const {
+    return matches_.size();
+  }
+
+  /**
+   * Returns whether the pattern at index is matched by the automaton instead of utils::Regex.
+   */
+  [[nodiscard]] bool isAutomatonBacked(size_t index) const;
+
+ private:
+  static constexpr size_t MAX_NFA_STATES = 10000;
+  static constexpr size_t MAX_DFA_STATES = 1024;
+
+  struct NfaState {
+    enum class Kind { CHARACTER, SPLIT, MATCH };
+    Kind kind;
+    std::bitset<256> characters;
+    std::vector<int32_t> next;
+    size_t pattern_index = 0;
+    bool anchored_end = false;
+  };
+
+  struct DfaState {
+    std::vector<int32_t> nfa_states;
+    std::vector<size_t> accepts_anywhere;
+    std::vector<size_t> accepts_at_end;
+    bool dead = false;
+    std::array<int32_t, 256> next;
+  };
+
+  struct Node;
+  class Parser;
+
+  void compilePattern(const std::string& pattern, size_t pattern_index, bool ignore_case);
+  int32_t compileNode(const Node& node, int32_t next);
+  int32_t addState(NfaState state);
+
+  void addClosure(int32_t nfa_state, std::vector<int32_t>& states);
+  int32_t getDfaState(std::vector<int32_t> nfa_states);
+  int32_t computeTransition(int32_t dfa_state, unsigned char ch);
+  void accept(const std::vector<size_t>& pattern_indices, size_t& match_count);
+
+  MatchMode mode_;
+  std::vector<NfaState> nfa_;
+  std::vector<int32_t> anchored_starts_;
+  std::vector<int32_t> unanchored_starts_;
+  std::vector<int32_t> restart_closure_;
+  std::vector<int32_t> closure_stack_;
+  std::vector<uint64_t> visited_;
+  uint64_t visit_generation_ = 0;
+
+  std::vector<DfaState> dfa_;
+  std::map<std::vector<int32_t>, int32_t> dfa_index_;
+  int32_t initial_dfa_state_ = -1;
+
+  std::vector<bool> automaton_backed_;
+  size_t automaton_pattern_count_ = 0;
+  std::vector<std::pair<size_t, Regex>> fallback_regexes_;
+  std::vector<bool> matches_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
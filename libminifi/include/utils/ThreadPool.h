@@ -25,7 +25,6 @@
 #include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -36,6 +35,7 @@
 #include "BackTrace.h"
 #include "MinifiConcurrentQueue.h"
 #include "Monitors.h"
+#include "TimerWheel.h"
 #include "core/expect.h"
 #include "controllers/ThreadManagementService.h"
 #include "core/controller/ControllerService.h"
@@ -45,6 +45,18 @@ namespace org::apache::nifi::minifi::utils {
 
 using TaskId = std::string;
 
+/**
+ * State shared by all the scheduled instances of a task, so that the workers
+ * can keep track of them without taking the thread pool's locks.
+ */
+struct TaskRunState {
+  std::atomic<bool> enabled{true};
+  std::atomic<uint32_t> running_count{0};
+};
+
+template<typename T>
+class ThreadPool;
+
 /**
  * Worker task
  * purpose: Provides a wrapper for the functor
@@ -118,14 +130,10 @@ class Worker {
   std::function<T()> task;
   std::unique_ptr<AfterExecute<T>> run_determinant_;
   std::shared_ptr<std::promise<T>> promise;
-};
 
-template<typename T>
-class DelayedTaskComparator {
- public:
-  bool operator()(Worker<T> &a, Worker<T> &b) {
-    return a.getNextExecutionTime() > b.getNextExecutionTime();
-  }
+ private:
+  friend class ThreadPool<T>;
+  std::shared_ptr<TaskRunState> run_state_;
 };
 
 template<typename T>
@@ -201,10 +209,10 @@ class ThreadPool {
    */
   bool isTaskRunning(const TaskId &identifier) {
     std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-    const auto iter = task_status_.find(identifier);
-    if (iter == task_status_.end())
+    const auto iter = task_states_.find(identifier);
+    if (iter == task_states_.end())
       return false;
-    return iter->second;
+    return iter->second->enabled.load();
   }
 
   bool isRunning() const {
@@ -252,6 +260,26 @@ class ThreadPool {
       start();
   }
 
+  /**
+   * Switches between a single queue shared by all the workers and per-worker queues, where
+   * the workers reschedule their tasks to their own queue and steal from the others when it is empty.
+   * The thread pool is restarted if it is running.
+   */
+  void setWorkStealing(bool work_stealing) {
+    std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
+    bool was_running = running_;
+    if (was_running) {
+      shutdown();
+    }
+    work_stealing_ = work_stealing;
+    if (was_running)
+      start();
+  }
+
+  bool isWorkStealing() const {
+    return work_stealing_;
+  }
+
   void setControllerServiceProvider(core::controller::ControllerServiceProvider* controller_service_provider) {
     std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
     bool was_running = running_;
@@ -278,6 +306,10 @@ class ThreadPool {
    */
   void drain() {
     worker_queue_.stop();
+    {
+      std::lock_guard<std::mutex> idle_lock(idle_mutex_);
+      work_available_.notify_all();
+    }
     while (current_workers_ > 0) {
       // The sleeping workers were waken up and stopped, but we have to wait
       // the ones that actually worked on something when the queue was stopped.
@@ -311,21 +343,32 @@ class ThreadPool {
   ConcurrentQueue<std::shared_ptr<WorkerThread>> deceased_thread_queue_;
 // worker queue of worker objects
   ConditionConcurrentQueue<Worker<T>> worker_queue_;
-  std::priority_queue<Worker<T>, std::vector<Worker<T>>, DelayedTaskComparator<T>> delayed_worker_queue_;
-// mutex to  protect task status and delayed queue
+// mutex to protect task status
   std::mutex worker_queue_mutex_;
+// delayed tasks by their next execution time, owned by the delayed scheduler thread
+  TimerWheel<TaskId, Worker<T>> delayed_tasks_;
+  std::mutex delayed_tasks_mutex_;
+// the time until which the delayed scheduler thread sleeps
+  std::chrono::steady_clock::time_point delayed_scheduler_wake_up_ = std::chrono::steady_clock::time_point::max();
 // notification for new delayed tasks that's before the current ones
   std::condition_variable delayed_task_available_;
-// map to identify if a task should be
-  std::map<TaskId, bool> task_status_;
+// run state of the scheduled tasks by ID
+  std::unordered_map<TaskId, std::shared_ptr<TaskRunState>> task_states_;
 // manager mutex
   std::recursive_mutex manager_mutex_;
   // thread pool name
   std::string name_;
-  // count of running tasks by ID
-  std::unordered_map<TaskId, uint32_t> running_task_count_by_id_;
-  // variable to signal task running completion
+  // mutex and variable to signal task running completion to stopTasks, only notified for stopped tasks
+  std::mutex task_run_complete_mutex_;
   std::condition_variable task_run_complete_;
+  // per-worker queues in work-stealing mode, worker_queue_ only receives the newly executed and the delayed tasks
+  bool work_stealing_ = false;
+  std::vector<std::unique_ptr<ConcurrentQueue<Worker<T>>>> worker_queues_;
+  size_t next_home_queue_index_ = 0;
+  // idle workers of the work-stealing mode wait here, so that they are only notified when there is someone to wake up
+  std::mutex idle_mutex_;
+  std::condition_variable work_available_;
+  std::atomic<int> idle_workers_{0};
 
   std::shared_ptr<core::logging::Logger> logger_;
 
@@ -334,11 +377,31 @@ class ThreadPool {
    */
   void manageWorkers();
 
+  std::thread createWorkerThread(const std::shared_ptr<WorkerThread>& worker_thread);
+
+  bool shouldRetire(const std::shared_ptr<WorkerThread>& thread);
+
   /**
    * Runs worker tasks
    */
   void run_tasks(const std::shared_ptr<WorkerThread>& thread);
 
+  void run_tasks_work_stealing(const std::shared_ptr<WorkerThread>& thread, size_t home_queue_index);
+
+  bool takeTask(size_t home_queue_index, Worker<T>& task, uint32_t& take_count);
+
+  bool hasQueuedTask() const;
+
+  void waitForTask();
+
+  void wakeIdleWorkers(size_t count);
+
+  bool tryStartRun(const Worker<T>& task);
+
+  void finishRun(const Worker<T>& task);
+
+  void scheduleDelayed(Worker<T>&& task);
+
   void manage_delayed_queue();
 };
 
@@ -0,0 +1,271 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Hierarchical timer wheel: keeps values until their deadline has passed.
+ *
+ * Level 0 has a slot for each of the next 64 ticks, every further level covers 64 slots of the level below it.
+ * Timers are placed on the lowest level whose range covers their deadline, and are moved to the lower levels as
+ * their deadline gets closer, so scheduling and cancelling are O(1), independently of the number of timers.
+ * Timers further in the future than the range of the wheel are parked on the last level until they fit.
+ *
+ * Every timer has a key, and all timers with the same key can be cancelled at once.
+ * Not thread-safe, the owner is expected to guard it.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class TimerWheel {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  static constexpr size_t SLOT_BITS = 6;
+  static constexpr size_t SLOT_COUNT = size_t{1} << SLOT_BITS;
+  static constexpr size_t LEVEL_COUNT = 6;
+
+  explicit TimerWheel(clock::duration tick = std::chrono::milliseconds(1), clock::time_point origin = clock::now())
+      : tick_(tick),
+        origin_(origin) {
+  }
+
+  void schedule(clock::time_point deadline, Key key, Value value) {
+    const uint64_t timer_id = next_timer_id_++;
+    auto& timer = timers_.emplace(timer_id, Timer{toTicks(deadline), std::move(key), std::move(value)}).first->second;
+    timer_ids_by_key_[timer.key].push_back(timer_id);
+    place(timer_id, timer.expiry_tick);
+  }
+
+  /**
+   * Removes every timer scheduled with the given key.
+   * @return the number of removed timers
+   */
+  size_t cancel(const Key& key) {
+    auto it = timer_ids_by_key_.find(key);
+    if (it == timer_ids_by_key_.end()) {
+      return 0;
+    }
+    // the ids left behind in the slots are skipped when the slot is processed
+    for (auto timer_id : it->second) {
+      timers_.erase(timer_id);
+    }
+    const size_t cancelled = it->second.size();
+    timer_ids_by_key_.erase(it);
+    return cancelled;
+  }
+
+  /**
+   * Advances the wheel to now, and passes the value of every expired timer to on_expired in the order of their expiry.
+   */
+  template<typename Callback>
+  void advance(clock::time_point now, Callback&& on_expired) {
+    // toTicks rounds up, the ticks up to the current time have to be processed inclusively
+    const uint64_t target_tick = toTicksFloor(now);
+    if (timers_.empty()) {
+      clearSlots();
+      current_tick_ = std::max(current_tick_, target_tick + 1);
+      return;
+    }
+    for (auto timer_id : std::exchange(overdue_, {})) {
+      expire(timer_id, on_expired);
+    }
+    while (current_tick_ <= target_tick) {
+      if (target_tick - current_tick_ >= SLOT_COUNT) {
+        // skip the ticks with nothing to do when catching up after a long time
+        const auto next_tick = nextBusyTick();
+        if (!next_tick || *next_tick > target_tick) {
+          current_tick_ = target_tick + 1;
+          break;
+        }
+        current_tick_ = std::max(current_tick_, *next_tick);
+      }
+      const auto index = slotIndex(0, current_tick_);
+      if (index == 0) {
+        for (size_t level = 1; level < LEVEL_COUNT; ++level) {
+          const auto level_index = slotIndex(level, current_tick_);
+          cascade(level, level_index);
+          if (level_index != 0) {
+            break;
+          }
+        }
+      }
+      ++current_tick_;
+      for (auto timer_id : std::exchange(slots_[0][index], {})) {
+        expire(timer_id, on_expired);
+      }
+      if (timers_.empty()) {
+        current_tick_ = std::max(current_tick_, target_tick + 1);
+        break;
+      }
+    }
+  }
+
+  /**
+   * Returns the time until which advance is guaranteed not to expire any timer, or nullopt if there are no timers.
+   * It might be earlier than the first deadline, when timers have to be moved between the levels.
+   */
+  std::optional<clock::time_point> nextWakeUp() const {
+    if (timers_.empty()) {
+      return std::nullopt;
+    }
+    if (!overdue_.empty()) {
+      // overdue timers can only exist once the current tick has been processed
+      return fromTicks(current_tick_ - 1);
+    }
+    const auto next_tick = nextBusyTick();
+    return next_tick ? std::optional{fromTicks(*next_tick)} : std::nullopt;
+  }
+
+  bool empty() const {
+    return timers_.empty();
+  }
+
+  size_t size() const {
+    return timers_.size();
+  }
+
+  void clear() {
+    timers_.clear();
+    timer_ids_by_key_.clear();
+    overdue_.clear();
+    clearSlots();
+  }
+
+ private:
+  struct Timer {
+    uint64_t expiry_tick;
+    Key key;
+    Value value;
+  };
+
+  static size_t slotIndex(size_t level, uint64_t tick) {
+    return (tick >> (level * SLOT_BITS)) & (SLOT_COUNT - 1);
+  }
+
+  uint64_t toTicksFloor(clock::time_point time_point) const {
+    if (time_point <= origin_) {
+      return 0;
+    }
+    return static_cast<uint64_t>((time_point - origin_) / tick_);
+  }
+
+  uint64_t toTicks(clock::time_point time_point) const {
+    if (time_point <= origin_) {
+      return 0;
+    }
+    const auto elapsed = time_point - origin_;
+    return static_cast<uint64_t>((elapsed + tick_ - clock::duration(1)) / tick_);
+  }
+
+  clock::time_point fromTicks(uint64_t tick) const {
+    return origin_ + tick_ * static_cast<clock::rep>(tick);
+  }
+
+  /**
+   * Returns the first tick to be processed which either expires timers or moves them to a lower level.
+   */
+  std::optional<uint64_t> nextBusyTick() const {
+    std::optional<uint64_t> next_tick;
+    for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+      const size_t shift = level * SLOT_BITS;
+      // the slots of the higher levels are processed when the lower bits of the tick are all zero
+      const uint64_t first_tick = ((current_tick_ + (uint64_t{1} << shift) - 1) >> shift) << shift;
+      for (uint64_t offset = 0; offset < SLOT_COUNT; ++offset) {
+        const uint64_t tick = first_tick + (offset << shift);
+        if (next_tick && tick >= *next_tick) {
+          break;
+        }
+        if (!slots_[level][slotIndex(level, tick)].empty()) {
+          next_tick = tick;
+          break;
+        }
+      }
+    }
+    return next_tick;
+  }
+
+  void place(uint64_t timer_id, uint64_t expiry_tick) {
+    if (expiry_tick < current_tick_) {
+      overdue_.push_back(timer_id);
+      return;
+    }
+    const uint64_t delta = expiry_tick - current_tick_;
+    for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+      if (delta < (uint64_t{1} << ((level + 1) * SLOT_BITS))) {
+        slots_[level][slotIndex(level, expiry_tick)].push_back(timer_id);
+        return;
+      }
+    }
+    // beyond the range of the wheel: park it in the furthest slot, it is placed again when that slot is cascaded
+    const uint64_t furthest_tick = current_tick_ + (uint64_t{1} << (LEVEL_COUNT * SLOT_BITS)) - 1;
+    slots_[LEVEL_COUNT - 1][slotIndex(LEVEL_COUNT - 1, furthest_tick)].push_back(timer_id);
+  }
+
+  void cascade(size_t level, size_t index) {
+    for (auto timer_id : std::exchange(slots_[level][index], {})) {
+      if (auto it = timers_.find(timer_id); it != timers_.end()) {
+        place(timer_id, it->second.expiry_tick);
+      }
+    }
+  }
+
+  template<typename Callback>
+  void expire(uint64_t timer_id, Callback& on_expired) {
+    auto it = timers_.find(timer_id);
+    if (it == timers_.end()) {
+      return;  // cancelled
+    }
+    auto& ids_of_key = timer_ids_by_key_[it->second.key];
+    ids_of_key.erase(std::find(ids_of_key.begin(), ids_of_key.end(), timer_id));
+    if (ids_of_key.empty()) {
+      timer_ids_by_key_.erase(it->second.key);
+    }
+    Value value = std::move(it->second.value);
+    timers_.erase(it);
+    on_expired(std::move(value));
+  }
+
+  void clearSlots() {
+    for (auto& level : slots_) {
+      for (auto& slot : level) {
+        slot.clear();
+      }
+    }
+  }
+
+  const clock::duration tick_;
+  const clock::time_point origin_;
+  // the next tick to be processed
+  uint64_t current_tick_ = 0;
+  uint64_t next_timer_id_ = 0;
+  std::array<std::array<std::vector<uint64_t>, SLOT_COUNT>, LEVEL_COUNT> slots_;
+  std::vector<uint64_t> overdue_;
+  std::unordered_map<uint64_t, Timer> timers_;
+  std::unordered_map<Key, std::vector<uint64_t>, Hash> timer_ids_by_key_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -29,6 +29,7 @@ const std::unordered_map<std::string_view, gsl::not_null<const core::PropertyVal
   {Configuration::nifi_flow_engine_threads, gsl::make_not_null(&core::StandardPropertyTypes::UNSIGNED_INT_TYPE)},
   {Configuration::nifi_flow_engine_alert_period, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
   {Configuration::nifi_flow_engine_event_driven_time_slice, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
+  {Configuration::nifi_flow_engine_work_stealing, gsl::make_not_null(&core::StandardPropertyTypes::BOOLEAN_TYPE)},
   {Configuration::nifi_administrative_yield_duration, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
   {Configuration::nifi_bored_yield_duration, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
   {Configuration::nifi_graceful_shutdown_seconds, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
@@ -56,6 +57,12 @@ const std::unordered_map<std::string_view, gsl::not_null<const core::PropertyVal
   {Configuration::nifi_dbcontent_repository_directory_default, gsl::make_not_null(&core::StandardPropertyTypes::VALID_TYPE)},
   {Configuration::nifi_flowfile_repository_rocksdb_compaction_period, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
   {Configuration::nifi_dbcontent_repository_rocksdb_compaction_period, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
+  {Configuration::nifi_flowfile_repository_rocksdb_group_commit_window, gsl::make_not_null(&core::StandardPropertyTypes::TIME_PERIOD_TYPE)},
+  {Configuration::nifi_flowfile_repository_rocksdb_sync, gsl::make_not_null(&core::StandardPropertyTypes::BOOLEAN_TYPE)},
+  {Configuration::nifi_flowfile_repository_rocksdb_recovery_threads, gsl::make_not_null(&core::StandardPropertyTypes::UNSIGNED_INT_TYPE)},
+  {Configuration::nifi_filesystem_content_repository_directory_fan_out, gsl::make_not_null(&core::StandardPropertyTypes::UNSIGNED_INT_TYPE)},
+  {Configuration::nifi_filesystem_content_repository_slab_max_claim_size, gsl::make_not_null(&core::StandardPropertyTypes::DATA_SIZE_TYPE)},
+  {Configuration::nifi_filesystem_content_repository_slab_segment_size, gsl::make_not_null(&core::StandardPropertyTypes::DATA_SIZE_TYPE)},
   {Configuration::nifi_remote_input_secure, gsl::make_not_null(&core::StandardPropertyTypes::BOOLEAN_TYPE)},
   {Configuration::nifi_security_need_ClientAuth, gsl::make_not_null(&core::StandardPropertyTypes::BOOLEAN_TYPE)},
   {Configuration::nifi_sensitive_props_additional_keys, gsl::make_not_null(&core::StandardPropertyTypes::VALID_TYPE)},
@@ -18,6 +18,7 @@
  * limitations under the License.
  */
 #include "Connection.h"
+#include <cinttypes>
 #include <vector>
 #include <memory>
 #include <string>
@@ -75,17 +76,25 @@ Connection::Connection(std::shared_ptr<core::Repository> flow_repository, std::s
 }
 
 bool Connection::isEmpty() const {
-  std::lock_guard<std::mutex> lock(mutex_);
+  return ready_queue_size_ == 0 && queue_size_ == 0;
+}
 
-  return queue_.empty();
+bool Connection::isWorkAvailable() {
+  if (ready_queue_size_ > 0) {
+    return true;
+  }
+  if (queue_size_ == 0) {
+    return false;
+  }
+  const std::lock_guard<std::mutex> lock{mutex_};
+  return queue_.isWorkAvailable();
 }
 
 bool Connection::backpressureThresholdReached() const {
-  std::lock_guard<std::mutex> lock(mutex_);
   auto backpressure_threshold_count = backpressure_threshold_count_.load();
   auto backpressure_threshold_data_size = backpressure_threshold_data_size_.load();
 
-  if (backpressure_threshold_count != 0 && queue_.size() >= backpressure_threshold_count)
+  if (backpressure_threshold_count != 0 && getQueueSize() >= backpressure_threshold_count)
     return true;
 
   if (backpressure_threshold_data_size != 0 && queued_data_size_ >= backpressure_threshold_data_size)
@@ -94,20 +103,60 @@ bool Connection::backpressureThresholdReached() const {
   return false;
 }
 
+bool Connection::useReadyQueue(const core::FlowFile& flow_file) const {
+  // penalized flow files stay in queue_, as they must be ordered by their penalty expiration, and swapping depends on that ordered queue_;
+  // the lock-free queue only keeps the flow files of the same producer thread in FIFO order, not across producers
+  return concurrent_queue_ && !flow_file.isPenalized() && !queue_.isSwappingEnabled();
+}
+
+void Connection::enqueue(const std::shared_ptr<core::FlowFile>& flow_file) {
+  queued_data_size_ += flow_file->getSize();
+  if (useReadyQueue(*flow_file)) {
+    // the size is raised first, so that a consumer taking the flow file right away never decrements it below zero
+    ++ready_queue_size_;
+    ready_queue_.enqueue(flow_file);
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(flow_file);
+    queue_size_ = queue_.size();
+  }
+  logger_->log_debug("Enqueue flow file UUID %s to connection %s", flow_file->getUUIDStr(), name_);
+}
+
+std::shared_ptr<core::FlowFile> Connection::dequeue(std::unique_lock<std::mutex>& lock) {
+  // penalized flow files whose penalty has already expired have been waiting longer than the ready ones
+  if (queue_size_ != 0) {
+    if (!lock.owns_lock()) {
+      lock.lock();
+    }
+    if (queue_.isWorkAvailable()) {
+      std::optional<std::shared_ptr<core::FlowFile>> opt_item = queue_.tryPop();
+      queue_size_ = queue_.size();
+      if (opt_item) {
+        return std::move(opt_item.value());
+      }
+    }
+  }
+  std::shared_ptr<core::FlowFile> item;
+  if (ready_queue_.try_dequeue(item)) {
+    --ready_queue_size_;
+    return item;
+  }
+  return nullptr;
+}
+
+bool Connection::isExpired(const core::FlowFile& flow_file, std::chrono::system_clock::time_point now) const {
+  const auto expired_duration = expired_duration_.load();
+  return expired_duration > 0ms && now > (flow_file.getEntryDate() + expired_duration);
+}
+
 void Connection::put(const std::shared_ptr<core::FlowFile>& flow) {
   if (drop_empty_ && flow->getSize() == 0) {
     logger_->log_info("Dropping empty flow file: %s", flow->getUUIDStr());
     return;
   }
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    queue_.push(flow);
-
-    queued_data_size_ += flow->getSize();
 
-    logger_->log_debug("Enqueue flow file UUID %s to connection %s", flow->getUUIDStr(), name_);
-  }
+  enqueue(flow);
 
   // Notify receiving processor that work may be available
   if (dest_connectable_) {
@@ -118,7 +167,7 @@ void Connection::put(const std::shared_ptr<core::FlowFile>& flow) {
 
 void Connection::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
   {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
 
     for (auto &ff : flows) {
       if (drop_empty_ && ff->getSize() == 0) {
@@ -126,8 +175,18 @@ void Connection::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
         continue;
       }
 
-      queue_.push(ff);
       queued_data_size_ += ff->getSize();
+      if (useReadyQueue(*ff)) {
+        ++ready_queue_size_;
+        ready_queue_.enqueue(ff);
+      } else {
+        // only lock once for the whole batch
+        if (!lock.owns_lock()) {
+          lock.lock();
+        }
+        queue_.push(ff);
+        queue_size_ = queue_.size();
+      }
 
       logger_->log_debug("Enqueue flow file UUID %s to connection %s", ff->getUUIDStr(), name_);
     }
@@ -140,57 +199,85 @@ void Connection::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
 }
 
 std::shared_ptr<core::FlowFile> Connection::poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+  while (std::shared_ptr<core::FlowFile> item = dequeue(lock)) {
+    queued_data_size_ -= item->getSize();
+
+    if (isExpired(*item, std::chrono::system_clock::now())) {
+      // Flow record expired
+      expiredFlowRecords.insert(item);
+      logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
+      continue;
+    }
+    item->setConnection(this);
+    logger_->log_debug("Dequeue flow file UUID %s from connection %s", item->getUUIDStr(), name_);
+    return item;
+  }
 
-  while (queue_.isWorkAvailable()) {
-    std::optional<std::shared_ptr<core::FlowFile>> opt_item = queue_.tryPop();
-    if (!opt_item) {
-      return nullptr;
+  return nullptr;
+}
+
+std::vector<std::shared_ptr<core::FlowFile>> Connection::pollBatch(size_t max_count, uint64_t max_bytes, std::vector<std::shared_ptr<core::FlowFile>>& expired_flow_records) {
+  std::vector<std::shared_ptr<core::FlowFile>> result;
+  uint64_t total_size = 0;
+  const auto now = std::chrono::system_clock::now();
+  std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+  while (result.size() < max_count && (max_bytes == 0 || total_size < max_bytes)) {
+    std::shared_ptr<core::FlowFile> item = dequeue(lock);
+    if (!item) {
+      break;
     }
-    std::shared_ptr<core::FlowFile> item = std::move(opt_item.value());
     queued_data_size_ -= item->getSize();
 
-    if (expired_duration_.load() > 0ms) {
-      // We need to check for flow expiration
-      if (std::chrono::system_clock::now() > (item->getEntryDate() + expired_duration_.load())) {
-        // Flow record expired
-        expiredFlowRecords.insert(item);
-        logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
-      } else {
-        item->setConnection(this);
-        logger_->log_debug("Dequeue flow file UUID %s from connection %s", item->getUUIDStr(), name_);
-        return item;
-      }
-    } else {
-      item->setConnection(this);
-      logger_->log_debug("Dequeue flow file UUID %s from connection %s", item->getUUIDStr(), name_);
-      return item;
+    if (isExpired(*item, now)) {
+      logger_->log_debug("Delete flow file UUID %s from connection %s, because it expired", item->getUUIDStr(), name_);
+      expired_flow_records.push_back(std::move(item));
+      continue;
     }
+    item->setConnection(this);
+    total_size += item->getSize();
+    result.push_back(std::move(item));
   }
 
-  return nullptr;
+  logger_->log_debug("Dequeued %zu flow files (%" PRIu64 " bytes) from connection %s", result.size(), total_size, name_);
+  return result;
 }
 
 void Connection::drain(bool delete_permanently) {
   std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::shared_ptr<core::FlowFile>> ready_items;
+  {
+    std::shared_ptr<core::FlowFile> item;
+    while (ready_queue_.try_dequeue(item)) {
+      ready_items.push_back(std::move(item));
+    }
+    // the producers might have raised the size for flow files not yet in the queue, so only the removed ones are subtracted
+    ready_queue_size_ -= ready_items.size();
+  }
+  const auto delete_from_repository = [this] (const std::shared_ptr<core::FlowFile>& item) {
+    if (item->isStored() && flow_repository_->Delete(item->getUUIDStr())) {
+      item->setStoredToRepository(false);
+      auto claim = item->getResourceClaim();
+      if (claim) claim->decreaseFlowFileRecordOwnedCount();
+    }
+  };
   if (!delete_permanently) {
     // simply discard in-memory flow files
     queue_.clear();
   } else {
+    for (const auto& item : ready_items) {
+      delete_from_repository(item);
+    }
     while (!queue_.empty()) {
       auto opt_item = queue_.tryPop(std::chrono::milliseconds{100});
       if (!opt_item) {
         continue;
       }
-      auto& item = opt_item.value();
-      if (item->isStored() && flow_repository_->Delete(item->getUUIDStr())) {
-        item->setStoredToRepository(false);
-        auto claim = item->getResourceClaim();
-        if (claim) claim->decreaseFlowFileRecordOwnedCount();
-      }
+      delete_from_repository(opt_item.value());
     }
   }
 
+  queue_size_ = 0;
   queued_data_size_ = 0;
   logger_->log_debug("Drain connection %s", name_);
 }
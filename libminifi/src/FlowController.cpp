@@ -37,6 +37,8 @@
 #include "core/Connectable.h"
 #include "utils/file/PathUtils.h"
 #include "utils/file/FileSystem.h"
+#include "utils/OptionalUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/BaseHTTPClient.h"
 #include "io/NetworkPrioritizer.h"
 #include "io/FileStream.h"
@@ -279,6 +281,8 @@ void FlowController::load(bool reload) {
   if (!thread_pool_.isRunning() || reload) {
     thread_pool_.shutdown();
     thread_pool_.setMaxConcurrentTasks(configuration_->getInt(Configure::nifi_flow_engine_threads, 5));
+    thread_pool_.setWorkStealing((configuration_->get(Configure::nifi_flow_engine_work_stealing)
+        | utils::flatMap(utils::StringUtils::toBool)).value_or(false));
     thread_pool_.setControllerServiceProvider(this);
     thread_pool_.start();
   }
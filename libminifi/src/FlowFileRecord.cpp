@@ -17,13 +17,19 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <array>
 #include <ctime>
 #include <cstdio>
 #include <vector>
 #include <queue>
+#include <limits>
 #include <map>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <iostream>
 #include <fstream>
 #include <cinttypes>
@@ -35,6 +41,47 @@
 
 namespace org::apache::nifi::minifi {
 
+namespace {
+
+// a legacy record starts with the most significant byte of its event time in milliseconds, which is always zero
+constexpr uint8_t COMPACT_FORMAT_VERSION = 2;
+
+enum class ClaimEncoding : uint8_t {
+  FullPath = 0,
+  // relative to the storage path of the content repository
+  ContentId = 1
+};
+
+// serialized as their index + 1, so existing entries must never be changed or reordered, only appended to
+constexpr std::array<std::string_view, 31> WELL_KNOWN_ATTRIBUTE_KEYS{
+  "path", "absolute.path", "filename", "uuid", "priority", "mime.type", "discard.reason", "alternate.identifier", "flow.id",
+  "file.size", "file.owner", "file.group", "file.permissions", "file.lastModifiedTime", "invokehttp.status.code", "invokehttp.status.message",
+  "fragment.identifier", "fragment.index", "fragment.count", "segment.original.filename",
+  "segment.identifier", "segment.index", "segment.count", "merge.count", "merge.bin.age",
+  "source.hostname", "source.endpoint", "kafka.key", "kafka.topic", "kafka.partition", "kafka.offset"
+};
+
+std::optional<uint64_t> findWellKnownAttributeKey(std::string_view key) {
+  static const auto indices = [] {
+    std::unordered_map<std::string_view, uint64_t> result;
+    for (size_t i = 0; i < WELL_KNOWN_ATTRIBUTE_KEYS.size(); ++i) {
+      result.emplace(WELL_KNOWN_ATTRIBUTE_KEYS[i], i);
+    }
+    return result;
+  }();
+  const auto it = indices.find(key);
+  if (it == indices.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+uint64_t toMillis(std::chrono::system_clock::time_point time_point) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count());
+}
+
+}  // namespace
+
 std::shared_ptr<core::logging::Logger> FlowFileRecord::logger_ = core::logging::LoggerFactory<FlowFileRecord>::getLogger();
 std::atomic<uint64_t> FlowFileRecord::local_flow_seq_number_(0);
 
@@ -67,86 +114,55 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(const std::string& k
 }
 
 bool FlowFileRecord::Serialize(io::OutputStream &outStream) {
-  {
-    uint64_t event_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(event_time_.time_since_epoch()).count();
-    const auto ret = outStream.write(event_time_ms);
-    if (ret != 8) {
-      return false;
-    }
-  }
-  {
-    uint64_t entry_date_ms = std::chrono::duration_cast<std::chrono::milliseconds>(entry_date_.time_since_epoch()).count();
-    const auto ret = outStream.write(entry_date_ms);
-    if (ret != 8) {
-      return false;
-    }
-  }
-  {
-    uint64_t lineage_start_date_ms = std::chrono::duration_cast<std::chrono::milliseconds>(lineage_start_date_.time_since_epoch()).count();
-    const auto ret = outStream.write(lineage_start_date_ms);
-    if (ret != 8) {
-      return false;
-    }
+  const auto write_varint = [&outStream](uint64_t value) {
+    return !io::isError(outStream.writeVarInt(value));
+  };
+  const auto write_string = [&outStream, &write_varint](std::string_view str) {
+    return write_varint(str.size()) && (str.empty() || outStream.write(reinterpret_cast<const uint8_t*>(str.data()), str.size()) == str.size());
+  };
+  const auto write_identifier = [&outStream](const utils::Identifier& id) {
+    return outStream.write(id.getData().data(), id.getData().size()) == id.getData().size();
+  };
+
+  if (outStream.write(COMPACT_FORMAT_VERSION) != 1) {
+    return false;
   }
-  {
-    const auto ret = outStream.write(uuid_);
-    if (ret == 0 || io::isError(ret)) {
-      return false;
-    }
+  if (!write_varint(toMillis(event_time_)) || !write_varint(toMillis(entry_date_)) || !write_varint(toMillis(lineage_start_date_))) {
+    return false;
   }
   utils::Identifier containerId;
   if (connection_) {
     containerId = connection_->getUUID();
   }
-  {
-    const auto ret = outStream.write(containerId);
-    if (ret == 0 || io::isError(ret)) {
-      return false;
-    }
-  }
-  // write flow attributes
-  {
-    const auto numAttributes = gsl::narrow<uint32_t>(attributes_.size());
-    const auto ret = outStream.write(numAttributes);
-    if (ret != 4) {
-      return false;
-    }
+  if (!write_identifier(uuid_) || !write_identifier(containerId)) {
+    return false;
   }
 
-  for (auto& itAttribute : attributes_) {
-    {
-      const auto ret = outStream.write(itAttribute.first, true);
-      if (ret == 0 || io::isError(ret)) {
-        return false;
-      }
-    }
-    {
-      const auto ret = outStream.write(itAttribute.second, true);
-      if (ret == 0 || io::isError(ret)) {
-        return false;
-      }
-    }
+  const auto& attributes = attributes_.get();
+  if (!write_varint(attributes.size())) {
+    return false;
   }
-
-  {
-    const auto ret = outStream.write(getContentFullPath());
-    if (ret == 0 || io::isError(ret)) {
+  for (const auto& [key, value] : attributes) {
+    const auto key_index = findWellKnownAttributeKey(key);
+    if (!write_varint(key_index ? *key_index + 1 : 0)) {
       return false;
     }
-  }
-  {
-    const auto ret = outStream.write(size_);
-    if (ret != 8) {
+    if (!key_index && !write_string(key)) {
+      return false;
+    }
+    if (!write_string(value)) {
       return false;
     }
   }
-  {
-    const auto ret = outStream.write(offset_);
-    if (ret != 8) {
+
+  if (auto content_id = claim_ ? claim_->getContentId() : std::nullopt) {
+    if (outStream.write(static_cast<uint8_t>(ClaimEncoding::ContentId)) != 1 || !write_string(*content_id)) {
       return false;
     }
+  } else if (outStream.write(static_cast<uint8_t>(ClaimEncoding::FullPath)) != 1 || !write_string(getContentFullPath())) {
+    return false;
   }
-  return true;
+  return write_varint(size_) && write_varint(offset_);
 }
 
 bool FlowFileRecord::Persist(const std::shared_ptr<core::Repository>& flowRepository) {
@@ -174,14 +190,129 @@ bool FlowFileRecord::Persist(const std::shared_ptr<core::Repository>& flowReposi
 }
 
 std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inStream, const std::shared_ptr<core::ContentRepository>& content_repo, utils::Identifier& container) {
+  uint8_t format_version = 0;
+  if (inStream.read(format_version) != 1) {
+    return {};
+  }
+  if (format_version == COMPACT_FORMAT_VERSION) {
+    return DeSerializeCompact(inStream, content_repo, container);
+  }
+  if (format_version != 0) {
+    logger_->log_error("Unknown flow file record format version %" PRIu8, format_version);
+    return {};
+  }
+  return DeSerializeLegacy(inStream, content_repo, container);
+}
+
+std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerializeCompact(io::InputStream& inStream, const std::shared_ptr<core::ContentRepository>& content_repo, utils::Identifier& container) {
+  const auto read_varint = [&inStream](auto& value) {
+    uint64_t varint = 0;
+    if (io::isError(inStream.readVarInt(varint))) {
+      return false;
+    }
+    value = varint;
+    return true;
+  };
+  const auto read_string = [&inStream, &read_varint](std::string& str) {
+    uint64_t length = 0;
+    // the legacy format could not store longer strings either
+    if (!read_varint(length) || length > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    str.resize(gsl::narrow<size_t>(length));
+    return str.empty() || inStream.read(as_writable_bytes(std::span(str))) == str.size();
+  };
+  const auto read_identifier = [&inStream](utils::Identifier& id) {
+    utils::Identifier::Data data{};
+    if (inStream.read(as_writable_bytes(std::span(data))) != data.size()) {
+      return false;
+    }
+    id = utils::Identifier(data);
+    return true;
+  };
+  const auto read_time = [&read_varint](std::chrono::system_clock::time_point& time_point) {
+    uint64_t millis = 0;
+    if (!read_varint(millis)) {
+      return false;
+    }
+    time_point = std::chrono::system_clock::time_point() + std::chrono::milliseconds(millis);
+    return true;
+  };
+
+  auto file = std::make_shared<FlowFileRecord>();
+  if (!read_time(file->event_time_) || !read_time(file->entry_date_) || !read_time(file->lineage_start_date_)) {
+    return {};
+  }
+  if (!read_identifier(file->uuid_) || !read_identifier(container)) {
+    return {};
+  }
+
+  uint64_t attribute_count = 0;
+  if (!read_varint(attribute_count)) {
+    return {};
+  }
+  auto& attributes = file->attributes_.getMutable();
+  for (uint64_t i = 0; i < attribute_count; ++i) {
+    uint64_t key_ref = 0;
+    if (!read_varint(key_ref)) {
+      return {};
+    }
+    std::string key;
+    if (key_ref == 0) {
+      if (!read_string(key)) {
+        return {};
+      }
+    } else if (key_ref <= WELL_KNOWN_ATTRIBUTE_KEYS.size()) {
+      key = WELL_KNOWN_ATTRIBUTE_KEYS[key_ref - 1];
+    } else {
+      logger_->log_error("Unknown attribute key index %" PRIu64 " in flow file record %s", key_ref, file->getUUIDStr());
+      return {};
+    }
+    std::string value;
+    if (!read_string(value)) {
+      return {};
+    }
+    attributes[std::move(key)] = std::move(value);
+  }
+
+  uint8_t claim_encoding = 0;
+  std::string content_path;
+  if (inStream.read(claim_encoding) != 1 || !read_string(content_path)) {
+    return {};
+  }
+  if (claim_encoding == static_cast<uint8_t>(ClaimEncoding::ContentId)) {
+    if (!content_repo) {
+      logger_->log_error("Cannot resolve the content of flow file record %s without a content repository", file->getUUIDStr());
+      return {};
+    }
+    content_path = content_repo->getStoragePath() + "/" + content_path;
+  } else if (claim_encoding != static_cast<uint8_t>(ClaimEncoding::FullPath)) {
+    logger_->log_error("Unknown content claim encoding %" PRIu8 " in flow file record %s", claim_encoding, file->getUUIDStr());
+    return {};
+  }
+
+  if (!read_varint(file->size_) || !read_varint(file->offset_)) {
+    return {};
+  }
+
+  file->claim_ = std::make_shared<ResourceClaim>(content_path, content_repo);
+
+  return file;
+}
+
+std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerializeLegacy(io::InputStream& inStream, const std::shared_ptr<core::ContentRepository>& content_repo, utils::Identifier& container) {
   auto file = std::make_shared<FlowFileRecord>();
 
   {
-    uint64_t event_time_in_ms;
-    const auto ret = inStream.read(event_time_in_ms);
-    if (ret != 8) {
+    // the most significant byte of the event time has already been consumed as the format version
+    std::array<std::byte, sizeof(uint64_t) - 1> buffer{};
+    if (inStream.read(buffer) != buffer.size()) {
       return {};
     }
+    uint64_t event_time_in_ms = 0;
+    for (auto byte : buffer) {
+      event_time_in_ms = (event_time_in_ms << 8) | static_cast<uint64_t>(byte);
+    }
     file->event_time_ = std::chrono::system_clock::time_point() + std::chrono::milliseconds(event_time_in_ms);
   }
 
@@ -226,6 +357,7 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inS
     }
   }
 
+  auto& attributes = file->attributes_.getMutable();
   for (uint32_t i = 0; i < numAttributes; i++) {
     std::string key;
     {
@@ -241,7 +373,7 @@ std::shared_ptr<FlowFileRecord> FlowFileRecord::DeSerialize(io::InputStream& inS
         return {};
       }
     }
-    file->attributes_[key] = value;
+    attributes[key] = value;
   }
 
   std::string content_full_path;
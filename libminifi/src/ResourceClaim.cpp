@@ -19,6 +19,7 @@
  */
 #include "ResourceClaim.h"
 #include <map>
+#include <optional>
 #include <queue>
 #include <string>
 #include <vector>
@@ -63,4 +64,16 @@ ResourceClaim::~ResourceClaim() {
   if (claim_manager_) decreaseFlowFileRecordOwnedCount();
 }
 
+std::optional<ResourceClaim::Path> ResourceClaim::getContentId() const {
+  if (!claim_manager_) {
+    return std::nullopt;
+  }
+  const auto storage_path = claim_manager_->getStoragePath();
+  if (storage_path.empty() || _contentFullPath.size() <= storage_path.size() + 1
+      || !_contentFullPath.starts_with(storage_path) || _contentFullPath[storage_path.size()] != '/') {
+    return std::nullopt;
+  }
+  return _contentFullPath.substr(storage_path.size() + 1);
+}
+
 }  // namespace org::apache::nifi::minifi
@@ -16,6 +16,10 @@
  */
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "controllers/keyvalue/KeyValueStateManager.h"
 #include "controllers/keyvalue/KeyValueStateStorage.h"
@@ -32,6 +36,18 @@ KeyValueStateManager::KeyValueStateManager(
   std::string serialized;
   if (storage_->get(id_.to_string(), serialized)) {
     state_ = KeyValueStateStorage::deserialize(serialized);
+    has_serialized_state_ = !state_->empty();
+  }
+
+  const auto entry_key_prefix = KeyValueStateStorage::getStateEntryKey(id_, "");
+  std::unordered_map<std::string, std::string> state_entries;
+  if (storage_->getWithPrefix(entry_key_prefix, state_entries) && !state_entries.empty()) {
+    if (!state_) {
+      state_.emplace();
+    }
+    for (auto& [entry_key, value] : state_entries) {
+      state_->insert_or_assign(entry_key.substr(entry_key_prefix.size()), std::move(value));
+    }
   }
 }
 
@@ -108,21 +124,9 @@ bool KeyValueStateManager::commit() {
 
   // actually make the pending changes
   if (change_type_ == ChangeType::SET) {
-    if (storage_->set(id_.to_string(), KeyValueStateStorage::serialize(state_to_set_))) {
-      state_ = state_to_set_;
-    } else {
-      success = false;
-    }
+    success = commitStateToSet();
   } else if (change_type_ == ChangeType::CLEAR) {
-    if (state_ && storage_->remove(id_.to_string())) {
-      state_.reset();
-    } else {
-      success = false;
-    }
-  }
-
-  if (success && change_type_ != ChangeType::NONE) {
-    success = persist();
+    success = commitClear();
   }
 
   change_type_ = ChangeType::NONE;
@@ -131,6 +135,63 @@ bool KeyValueStateManager::commit() {
   return success;
 }
 
+bool KeyValueStateManager::commitStateToSet() {
+  std::unordered_map<std::string, std::string> kvs_to_set;
+  std::vector<std::string> keys_to_remove;
+
+  // only the changed keys are written, unless the state has to be migrated from the whole serialized state
+  const bool write_all_keys = !state_ || has_serialized_state_;
+  if (write_all_keys) {
+    kvs_to_set.emplace(id_.to_string(), KeyValueStateStorage::serialize({}));
+  }
+  for (const auto& [key, value] : state_to_set_) {
+    if (write_all_keys) {
+      kvs_to_set.emplace(KeyValueStateStorage::getStateEntryKey(id_, key), value);
+      continue;
+    }
+    const auto committed_value = state_->find(key);
+    if (committed_value == state_->end() || committed_value->second != value) {
+      kvs_to_set.emplace(KeyValueStateStorage::getStateEntryKey(id_, key), value);
+    }
+  }
+  if (state_) {
+    for (const auto& [key, value] : *state_) {
+      if (!state_to_set_.contains(key)) {
+        keys_to_remove.push_back(KeyValueStateStorage::getStateEntryKey(id_, key));
+      }
+    }
+  }
+
+  if (kvs_to_set.empty() && keys_to_remove.empty()) {
+    return true;
+  }
+  if (!storage_->setAndRemove(kvs_to_set, keys_to_remove)) {
+    return false;
+  }
+  state_ = std::move(state_to_set_);
+  has_serialized_state_ = false;
+  return persist();
+}
+
+bool KeyValueStateManager::commitClear() {
+  if (!state_) {
+    return false;
+  }
+
+  std::vector<std::string> keys_to_remove{id_.to_string()};
+  if (!has_serialized_state_) {
+    for (const auto& [key, value] : *state_) {
+      keys_to_remove.push_back(KeyValueStateStorage::getStateEntryKey(id_, key));
+    }
+  }
+  if (!storage_->setAndRemove({}, keys_to_remove)) {
+    return false;
+  }
+  state_.reset();
+  has_serialized_state_ = false;
+  return persist();
+}
+
 bool KeyValueStateManager::rollback() {
   if (!transaction_in_progress_) {
     return false;
@@ -16,6 +16,7 @@
  */
 
 #include <memory>
+#include <utility>
 
 #include "Exception.h"
 #include "controllers/keyvalue/KeyValueStateManager.h"
@@ -62,6 +63,15 @@ core::StateManager::State KeyValueStateStorage::deserialize(const std::string& s
   return retState;
 }
 
+namespace {
+constexpr char STATE_ENTRY_KEY_SEPARATOR = '/';
+constexpr size_t UUID_STRING_LENGTH = 36;
+}  // namespace
+
+std::string KeyValueStateStorage::getStateEntryKey(const utils::Identifier& component_id, const std::string& state_key) {
+  return component_id.to_string() + STATE_ENTRY_KEY_SEPARATOR + state_key;
+}
+
 KeyValueStateStorage::KeyValueStateStorage(const std::string& name, const utils::Identifier& uuid)
   : ControllerService(name, uuid) {
 }
@@ -71,31 +81,57 @@ std::unique_ptr<core::StateManager> KeyValueStateStorage::getStateManager(const
 }
 
 std::unordered_map<utils::Identifier, core::StateManager::State> KeyValueStateStorage::getAllStates() {
-  std::unordered_map<utils::Identifier, std::string> all_serialized;
-  if (!getAll(all_serialized)) {
+  std::unordered_map<std::string, std::string> all_entries;
+  if (!get(all_entries)) {
     return {};
   }
 
-  std::unordered_map<utils::Identifier, core::StateManager::State> all_deserialized;
-  for (const auto& serialized : all_serialized) {
-    all_deserialized.emplace(serialized.first, deserialize(serialized.second));
+  std::unordered_map<utils::Identifier, core::StateManager::State> all_states;
+  std::vector<std::pair<utils::Identifier, std::pair<std::string, std::string>>> state_entries;
+  for (const auto& [key, value] : all_entries) {
+    if (key.size() > UUID_STRING_LENGTH && key[UUID_STRING_LENGTH] == STATE_ENTRY_KEY_SEPARATOR) {
+      if (const auto component_id = utils::Identifier::parse(key.substr(0, UUID_STRING_LENGTH))) {
+        state_entries.emplace_back(*component_id, std::make_pair(key.substr(UUID_STRING_LENGTH + 1), value));
+        continue;
+      }
+    } else if (const auto component_id = utils::Identifier::parse(key)) {
+      auto& state = all_states[*component_id];
+      state.merge(deserialize(value));
+      continue;
+    }
+    logger_->log_error("Found non-UUID key \"%s\" in storage implementation", key);
+  }
+  // the entries of the individual keys take precedence over the whole serialized state written by earlier versions
+  for (auto& [component_id, state_entry] : state_entries) {
+    all_states[component_id].insert_or_assign(std::move(state_entry.first), std::move(state_entry.second));
   }
 
-  return all_deserialized;
+  return all_states;
+}
+
+bool KeyValueStateStorage::setAndRemove(const std::unordered_map<std::string, std::string>& kvs_to_set, const std::vector<std::string>& keys_to_remove) {
+  for (const auto& [key, value] : kvs_to_set) {
+    if (!set(key, value)) {
+      return false;
+    }
+  }
+  for (const auto& key : keys_to_remove) {
+    if (!remove(key)) {
+      return false;
+    }
+  }
+  return true;
 }
 
-bool KeyValueStateStorage::getAll(std::unordered_map<utils::Identifier, std::string>& kvs) {
-  std::unordered_map<std::string, std::string> states;
-  if (!get(states)) {
+bool KeyValueStateStorage::getWithPrefix(const std::string& prefix, std::unordered_map<std::string, std::string>& kvs) {
+  std::unordered_map<std::string, std::string> all_kvs;
+  if (!get(all_kvs)) {
     return false;
   }
   kvs.clear();
-  for (const auto& state : states) {
-    const auto optional_uuid = utils::Identifier::parse(state.first);
-    if (optional_uuid) {
-      kvs[optional_uuid.value()] = state.second;
-    } else {
-      logger_->log_error("Found non-UUID key \"%s\" in storage implementation", state.first);
+  for (auto& [key, value] : all_kvs) {
+    if (key.starts_with(prefix)) {
+      kvs.emplace(key, std::move(value));
     }
   }
   return true;
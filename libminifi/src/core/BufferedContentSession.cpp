@@ -61,6 +61,13 @@ std::shared_ptr<io::BaseStream> BufferedContentSession::read(const std::shared_p
   return repository_->read(*resource_id);
 }
 
+std::shared_ptr<io::BaseStream> BufferedContentSession::readMapped(const std::shared_ptr<ResourceClaim>& resource_id) {
+  if (managed_resources_.contains(resource_id) || extended_resources_.contains(resource_id)) {
+    throw Exception(REPOSITORY_EXCEPTION, "Can only read non-modified resource");
+  }
+  return repository_->readMapped(*resource_id);
+}
+
 void BufferedContentSession::commit() {
   for (const auto& resource : managed_resources_) {
     auto outStream = repository_->write(*resource.first);
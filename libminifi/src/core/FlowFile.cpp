@@ -155,8 +155,9 @@ bool FlowFile::getAttribute(const std::string& key, std::string& value) const {
 }
 
 std::optional<std::string> FlowFile::getAttribute(const std::string& key) const {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  const auto& attributes = attributes_.get();
+  auto it = attributes.find(key);
+  if (it != attributes.end()) {
     return it->second;
   }
   return std::nullopt;
@@ -172,9 +173,13 @@ uint64_t FlowFile::getOffset() const {
 }
 
 bool FlowFile::removeAttribute(const std::string key) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
-    attributes_.erase(it);
+  if (!attributes_.get().contains(key)) {
+    return false;
+  }
+  auto& attributes = attributes_.getMutable();
+  auto it = attributes.find(key);
+  if (it != attributes.end()) {
+    attributes.erase(it);
     return true;
   } else {
     return false;
@@ -182,8 +187,12 @@ bool FlowFile::removeAttribute(const std::string key) {
 }
 
 bool FlowFile::updateAttribute(const std::string key, const std::string value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  if (!attributes_.get().contains(key)) {
+    return false;
+  }
+  auto& attributes = attributes_.getMutable();
+  auto it = attributes.find(key);
+  if (it != attributes.end()) {
     it->second = value;
     return true;
   } else {
@@ -192,12 +201,11 @@ bool FlowFile::updateAttribute(const std::string key, const std::string value) {
 }
 
 bool FlowFile::addAttribute(const std::string& key, const std::string& value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  if (attributes_.get().contains(key)) {
     // attribute already there in the map
     return false;
   } else {
-    attributes_[key] = value;
+    attributes_.getMutable()[key] = value;
     return true;
   }
 }
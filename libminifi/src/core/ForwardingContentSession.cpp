@@ -50,6 +50,10 @@ std::shared_ptr<io::BaseStream> ForwardingContentSession::read(const std::shared
   return repository_->read(*resource_id);
 }
 
+std::shared_ptr<io::BaseStream> ForwardingContentSession::readMapped(const std::shared_ptr<ResourceClaim>& resource_id) {
+  return repository_->readMapped(*resource_id);
+}
+
 void ForwardingContentSession::commit() {
   created_claims_.clear();
 }
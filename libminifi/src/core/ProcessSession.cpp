@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "core/ProcessSessionReadCallback.h"
+#include "io/BufferStream.h"
 #include "io/StreamSlice.h"
 #include "utils/gsl.h"
 
@@ -92,25 +93,32 @@ void ProcessSession::add(const std::shared_ptr<core::FlowFile> &record) {
   record->setDeleted(false);
 }
 
-std::shared_ptr<core::FlowFile> ProcessSession::create(const std::shared_ptr<core::FlowFile> &parent) {
-  auto record = std::make_shared<FlowFileRecord>();
+void ProcessSession::copyAttributesFromParent(core::FlowFile& record, const core::FlowFile& parent) const {
+  // the attributes are shared with the parent until either of them is modified,
+  // removing the special attributes only copies them if the parent has any of these
+  record.copyAttributesFrom(parent);
+  record.removeAttribute(SpecialFlowAttribute::ALTERNATE_IDENTIFIER);
+  record.removeAttribute(SpecialFlowAttribute::DISCARD_REASON);
+  record.removeAttribute(SpecialFlowAttribute::UUID);
+  // the flow id of the parent takes precedence
   auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
-  if (flow_version != nullptr) {
-    record->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
+  if (flow_version != nullptr && !record.getAttributeMap().contains(SpecialFlowAttribute::FLOW_ID)) {
+    record.setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
   }
+}
 
+std::shared_ptr<core::FlowFile> ProcessSession::create(const std::shared_ptr<core::FlowFile> &parent) {
+  auto record = std::make_shared<FlowFileRecord>();
   if (parent) {
-    // Copy attributes
-    for (const auto& attribute : parent->getAttributes()) {
-      if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER || attribute.first == SpecialFlowAttribute::DISCARD_REASON || attribute.first == SpecialFlowAttribute::UUID) {
-        // Do not copy special attributes from parent
-        continue;
-      }
-      record->setAttribute(attribute.first, attribute.second);
-    }
+    copyAttributesFromParent(*record, *parent);
     record->setLineageStartDate(parent->getlineageStartDate());
     record->setLineageIdentifiers(parent->getlineageIdentifiers());
     parent->getlineageIdentifiers().push_back(parent->getUUID());
+  } else {
+    auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
+    if (flow_version != nullptr) {
+      record->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
+    }
   }
 
   utils::Identifier uuid = record->getUUID();
@@ -142,22 +150,9 @@ std::shared_ptr<core::FlowFile> ProcessSession::clone(const std::shared_ptr<core
 std::shared_ptr<core::FlowFile> ProcessSession::cloneDuringTransfer(const std::shared_ptr<core::FlowFile> &parent) {
   auto record = std::make_shared<FlowFileRecord>();
 
-  auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
-  if (flow_version != nullptr) {
-    record->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
-  }
   this->cloned_flowfiles_.push_back(record);
   logger_->log_debug("Clone FlowFile with UUID %s during transfer", record->getUUIDStr());
-  // Copy attributes
-  for (const auto& attribute : parent->getAttributes()) {
-    if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER
-        || attribute.first == SpecialFlowAttribute::DISCARD_REASON
-        || attribute.first == SpecialFlowAttribute::UUID) {
-      // Do not copy special attributes from parent
-      continue;
-    }
-    record->setAttribute(attribute.first, attribute.second);
-  }
+  copyAttributesFromParent(*record, *parent);
   record->setLineageStartDate(parent->getlineageStartDate());
   record->setLineageIdentifiers(parent->getlineageIdentifiers());
   record->getlineageIdentifiers().push_back(parent->getUUID());
@@ -202,6 +197,15 @@ void ProcessSession::remove(const std::shared_ptr<core::FlowFile> &flow) {
   provenance_report_->drop(flow, reason);
 }
 
+void ProcessSession::detach(const std::shared_ptr<core::FlowFile> &flow) {
+  const auto uuid = flow->getUUID();
+  if (updated_flowfiles_.erase(uuid) == 0) {
+    throw Exception(ExceptionType::PROCESSOR_EXCEPTION, "Only flow files provided by this session can be detached");
+  }
+  updated_relationships_.erase(uuid);
+  logger_->log_trace("Detached flow file with UUID: %s", flow->getUUIDStr());
+}
+
 void ProcessSession::putAttribute(const std::shared_ptr<core::FlowFile>& flow, const std::string& key, const std::string& value) {
   flow->setAttribute(key, value);
   std::stringstream details;
@@ -430,6 +434,42 @@ detail::ReadBufferResult ProcessSession::readBuffer(const std::shared_ptr<core::
   return result;
 }
 
+std::shared_ptr<io::InputStream> ProcessSession::getMappedFlowFileContentStream(const std::shared_ptr<core::FlowFile>& flow_file) {
+  if (flow_file->getResourceClaim() == nullptr) {
+    if (flow_file->getSize() == 0) {
+      return std::make_shared<io::BufferStream>();
+    }
+    throw Exception(FILE_OPERATION_EXCEPTION, "No Content Claim existed for read");
+  }
+
+  std::shared_ptr<io::InputStream> stream = content_session_->readMapped(flow_file->getResourceClaim());
+  if (nullptr == stream) {
+    return nullptr;
+  }
+  return std::make_shared<io::StreamSlice>(stream, flow_file->getOffset(), flow_file->getSize());
+}
+
+int64_t ProcessSession::readMapped(const std::shared_ptr<core::FlowFile>& flow, const std::function<int64_t(std::span<const std::byte>)>& callback) {
+  if (auto mapped_stream = getMappedFlowFileContentStream(flow)) {
+    auto ret = callback(mapped_stream->getBuffer());
+    if (ret < 0) {
+      throw Exception(FILE_OPERATION_EXCEPTION, "Failed to process flowfile content");
+    }
+    return ret;
+  }
+
+  logger_->log_trace("Content of %s cannot be mapped, reading it into memory", flow->getUUIDStr());
+  return read(flow, [&](const std::shared_ptr<io::InputStream>& input_stream) {
+    std::vector<std::byte> buffer(input_stream->size());
+    const auto read_status = input_stream->read(buffer);
+    if (read_status != buffer.size()) {
+      logger_->log_error("readMapped: %zu bytes were requested from the stream but %zu bytes were read. Rolling back.", buffer.size(), read_status);
+      throw Exception(PROCESSOR_EXCEPTION, "Failed to read the entire FlowFile.");
+    }
+    return callback(buffer);
+  });
+}
+
 void ProcessSession::importFrom(io::InputStream&& stream, const std::shared_ptr<core::FlowFile> &flow) {
   importFrom(stream, flow);
 }
@@ -1090,29 +1130,10 @@ std::shared_ptr<core::FlowFile> ProcessSession::get() {
     std::set<std::shared_ptr<core::FlowFile> > expired;
     std::shared_ptr<core::FlowFile> ret = current->poll(expired);
     if (!expired.empty()) {
-      // Remove expired flow record
-      for (const auto& record : expired) {
-        std::stringstream details;
-        details << process_context_->getProcessorNode()->getName() << " expire flow record " << record->getUUIDStr();
-        provenance_report_->expire(record, details.str());
-        // there is no rolling back expired FlowFiles
-        if (record->isStored() && process_context_->getFlowFileRepository()->Delete(record->getUUIDStr())) {
-          record->setStoredToRepository(false);
-        }
-      }
+      expireFlowFiles({expired.begin(), expired.end()});
     }
     if (ret) {
-      // add the flow record to the current process session update map
-      ret->setDeleted(false);
-      std::shared_ptr<FlowFile> snapshot = std::make_shared<FlowFileRecord>();
-      *snapshot = *ret;
-      logger_->log_debug("Create Snapshot FlowFile with UUID %s", snapshot->getUUIDStr());
-      utils::Identifier uuid = ret->getUUID();
-      updated_flowfiles_[uuid] = {ret, snapshot};
-      auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
-      if (flow_version != nullptr) {
-        ret->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
-      }
+      addPolledFlowFile(ret, process_context_->getProcessorNode()->getFlowIdentifier());
       return ret;
     }
     current = dynamic_cast<Connection*>(process_context_->getProcessorNode()->pickIncomingConnection());
@@ -1121,6 +1142,69 @@ std::shared_ptr<core::FlowFile> ProcessSession::get() {
   return nullptr;
 }
 
+std::vector<std::shared_ptr<core::FlowFile>> ProcessSession::get(size_t max_count, uint64_t max_bytes) {
+  std::vector<std::shared_ptr<core::FlowFile>> result;
+  const auto first = process_context_->getProcessorNode()->pickIncomingConnection();
+
+  if (first == nullptr) {
+    logger_->log_trace("Get is null for %s", process_context_->getProcessorNode()->getName());
+    return result;
+  }
+
+  auto current = dynamic_cast<Connection*>(first);
+  if (!current) {
+    logger_->log_error("The incoming connection [%s] of the processor [%s] \"%s\" is not actually a Connection.",
+                       first->getUUIDStr(), process_context_->getProcessorNode()->getUUIDStr(), process_context_->getProcessorNode()->getName());
+    return result;
+  }
+
+  const auto flow_version = process_context_->getProcessorNode()->getFlowIdentifier();
+  uint64_t total_size = 0;
+  std::vector<std::shared_ptr<core::FlowFile>> expired;
+  do {
+    auto batch = current->pollBatch(max_count - result.size(), max_bytes == 0 ? 0 : max_bytes - total_size, expired);
+    result.reserve(result.size() + batch.size());
+    for (auto& flow_file : batch) {
+      addPolledFlowFile(flow_file, flow_version);
+      total_size += flow_file->getSize();
+      result.push_back(std::move(flow_file));
+    }
+    if (result.size() >= max_count || (max_bytes != 0 && total_size >= max_bytes)) {
+      break;
+    }
+    current = dynamic_cast<Connection*>(process_context_->getProcessorNode()->pickIncomingConnection());
+  } while (current != nullptr && current != first);
+
+  if (!expired.empty()) {
+    expireFlowFiles(expired);
+  }
+  return result;
+}
+
+void ProcessSession::expireFlowFiles(const std::vector<std::shared_ptr<core::FlowFile>>& expired_flow_files) {
+  const auto& processor_name = process_context_->getProcessorNode()->getName();
+  const auto flow_file_repo = process_context_->getFlowFileRepository();
+  for (const auto& record : expired_flow_files) {
+    provenance_report_->expire(record, processor_name + " expire flow record " + record->getUUIDStr());
+    // there is no rolling back expired FlowFiles
+    if (record->isStored() && flow_file_repo->Delete(record->getUUIDStr())) {
+      record->setStoredToRepository(false);
+    }
+  }
+}
+
+void ProcessSession::addPolledFlowFile(const std::shared_ptr<core::FlowFile>& flow_file, const std::shared_ptr<state::FlowIdentifier>& flow_version) {
+  // add the flow record to the current process session update map
+  flow_file->setDeleted(false);
+  std::shared_ptr<FlowFile> snapshot = std::make_shared<FlowFileRecord>();
+  *snapshot = *flow_file;
+  logger_->log_debug("Create Snapshot FlowFile with UUID %s", snapshot->getUUIDStr());
+  updated_flowfiles_[flow_file->getUUID()] = {flow_file, snapshot};
+  if (flow_version != nullptr) {
+    flow_file->setAttribute(SpecialFlowAttribute::FLOW_ID, flow_version->getFlowId());
+  }
+}
+
 void ProcessSession::flushContent() {
   content_session_->commit();
 }
@@ -16,14 +16,32 @@
  */
 #include "core/ProcessorMetrics.h"
 
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <string_view>
+
 #include "core/Processor.h"
 #include "utils/gsl.h"
-#include "range/v3/numeric/accumulate.hpp"
+#include "utils/StringUtils.h"
 
 using namespace std::literals::chrono_literals;
 
 namespace org::apache::nifi::minifi::core {
 
+namespace {
+struct RuntimePercentile {
+  std::string_view name;
+  double fraction;
+};
+
+constexpr std::array<RuntimePercentile, 3> RUNTIME_PERCENTILES{{{"p50", 0.5}, {"p99", 0.99}, {"p999", 0.999}}};
+
+double toMilliseconds(std::chrono::microseconds duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+}  // namespace
+
 ProcessorMetrics::ProcessorMetrics(const Processor& source_processor)
     : source_processor_(source_processor),
       on_trigger_runtime_averager_(STORED_ON_TRIGGER_RUNTIME_COUNT),
@@ -54,13 +72,19 @@ std::vector<state::response::SerializedResponseNode> ProcessorMetrics::serialize
     }
   };
 
+  for (const auto& percentile : RUNTIME_PERCENTILES) {
+    const auto suffix = utils::StringUtils::toUpper(std::string{percentile.name});
+    root_node.children.push_back({.name = "OnTriggerRunTime" + suffix, .value = toMilliseconds(getOnTriggerRuntimePercentile(percentile.fraction))});
+    root_node.children.push_back({.name = "SessionCommitRunTime" + suffix, .value = toMilliseconds(getSessionCommitRuntimePercentile(percentile.fraction))});
+  }
+
   {
-    std::lock_guard<std::mutex> lock(transferred_relationships_mutex_);
+    std::shared_lock lock(transferred_relationships_mutex_);
     for (const auto& [relationship, count] : transferred_relationships_) {
       gsl_Expects(!relationship.empty());
       state::response::SerializedResponseNode transferred_to_relationship_node;
       transferred_to_relationship_node.name = std::string("TransferredTo").append(1, toupper(relationship[0])).append(relationship.substr(1));
-      transferred_to_relationship_node.value = static_cast<uint32_t>(count);
+      transferred_to_relationship_node.value = static_cast<uint32_t>(count.load());
 
       root_node.children.push_back(transferred_to_relationship_node);
     }
@@ -82,10 +106,17 @@ std::vector<state::PublishedMetric> ProcessorMetrics::calculateMetrics() {
     {"transferred_bytes", static_cast<double>(transferred_bytes.load()), getCommonLabels()}
   };
 
+  for (const auto& percentile : RUNTIME_PERCENTILES) {
+    metrics.push_back({utils::StringUtils::join_pack("onTrigger_runtime_", percentile.name, "_milliseconds"),
+        toMilliseconds(getOnTriggerRuntimePercentile(percentile.fraction)), getCommonLabels()});
+    metrics.push_back({utils::StringUtils::join_pack("session_commit_runtime_", percentile.name, "_milliseconds"),
+        toMilliseconds(getSessionCommitRuntimePercentile(percentile.fraction)), getCommonLabels()});
+  }
+
   {
-    std::lock_guard<std::mutex> lock(transferred_relationships_mutex_);
+    std::shared_lock lock(transferred_relationships_mutex_);
     for (const auto& [relationship, count] : transferred_relationships_) {
-      metrics.push_back({"transferred_to_" + relationship, static_cast<double>(count),
+      metrics.push_back({"transferred_to_" + relationship, static_cast<double>(count.load()),
         {{"metric_class", getName()}, {"processor_name", source_processor_.getName()}, {"processor_uuid", source_processor_.getUUIDStr()}}});
     }
   }
@@ -94,16 +125,28 @@ std::vector<state::PublishedMetric> ProcessorMetrics::calculateMetrics() {
 }
 
 void ProcessorMetrics::increaseRelationshipTransferCount(const std::string& relationship, size_t count) {
-  std::lock_guard<std::mutex> lock(transferred_relationships_mutex_);
-  transferred_relationships_[relationship] += count;
+  {
+    std::shared_lock lock(transferred_relationships_mutex_);
+    if (auto it = transferred_relationships_.find(relationship); it != transferred_relationships_.end()) {
+      it->second.fetch_add(count, std::memory_order_relaxed);
+      return;
+    }
+  }
+  std::lock_guard lock(transferred_relationships_mutex_);
+  transferred_relationships_.try_emplace(relationship, 0).first->second.fetch_add(count, std::memory_order_relaxed);
 }
 
 std::chrono::milliseconds ProcessorMetrics::getAverageOnTriggerRuntime() const {
   return on_trigger_runtime_averager_.getAverage();
 }
 
-void ProcessorMetrics::addLastOnTriggerRuntime(std::chrono::milliseconds runtime) {
-  on_trigger_runtime_averager_.addValue(runtime);
+void ProcessorMetrics::addLastOnTriggerRuntime(std::chrono::microseconds runtime) {
+  on_trigger_runtime_averager_.addValue(std::chrono::duration_cast<std::chrono::milliseconds>(runtime));
+  on_trigger_runtime_histogram_.record(gsl::narrow<uint64_t>(std::max(runtime.count(), std::chrono::microseconds::rep{0})));
+}
+
+std::chrono::microseconds ProcessorMetrics::getOnTriggerRuntimePercentile(double fraction) const {
+  return std::chrono::microseconds(gsl::narrow<std::chrono::microseconds::rep>(on_trigger_runtime_histogram_.getSnapshot().percentile(fraction)));
 }
 
 std::chrono::milliseconds ProcessorMetrics::getLastOnTriggerRuntime() const {
@@ -114,8 +157,13 @@ std::chrono::milliseconds ProcessorMetrics::getAverageSessionCommitRuntime() con
   return session_commit_runtime_averager_.getAverage();
 }
 
-void ProcessorMetrics::addLastSessionCommitRuntime(std::chrono::milliseconds runtime) {
-  session_commit_runtime_averager_.addValue(runtime);
+void ProcessorMetrics::addLastSessionCommitRuntime(std::chrono::microseconds runtime) {
+  session_commit_runtime_averager_.addValue(std::chrono::duration_cast<std::chrono::milliseconds>(runtime));
+  session_commit_runtime_histogram_.record(gsl::narrow<uint64_t>(std::max(runtime.count(), std::chrono::microseconds::rep{0})));
+}
+
+std::chrono::microseconds ProcessorMetrics::getSessionCommitRuntimePercentile(double fraction) const {
+  return std::chrono::microseconds(gsl::narrow<std::chrono::microseconds::rep>(session_commit_runtime_histogram_.getSnapshot().percentile(fraction)));
 }
 
 std::chrono::milliseconds ProcessorMetrics::getLastSessionCommitRuntime() const {
@@ -125,39 +173,32 @@ std::chrono::milliseconds ProcessorMetrics::getLastSessionCommitRuntime() const
 template<typename ValueType>
 requires Summable<ValueType> && DividableByInteger<ValueType>
 ValueType ProcessorMetrics::Averager<ValueType>::getAverage() const {
-  std::lock_guard<std::mutex> lock(average_value_mutex_);
-  if (values_.empty()) {
+  const auto value_count = gsl::narrow<uint32_t>(std::min<uint64_t>(value_count_.load(), SAMPLE_SIZE_));
+  if (value_count == 0) {
     return {};
   }
-  return ranges::accumulate(values_, ValueType{}) / values_.size();
+  ValueType sum{};
+  for (uint32_t index = 0; index < value_count; ++index) {
+    sum = sum + values_[index].load(std::memory_order_relaxed);
+  }
+  return sum / value_count;
 }
 
 template<typename ValueType>
 requires Summable<ValueType> && DividableByInteger<ValueType>
 void ProcessorMetrics::Averager<ValueType>::addValue(ValueType runtime) {
-  std::lock_guard<std::mutex> lock(average_value_mutex_);
-  if (values_.size() < SAMPLE_SIZE_) {
-    values_.push_back(runtime);
-  } else {
-    if (next_average_index_ >= values_.size()) {
-      next_average_index_ = 0;
-    }
-    values_[next_average_index_] = runtime;
-    ++next_average_index_;
-  }
+  const auto index = value_count_.fetch_add(1) % SAMPLE_SIZE_;
+  values_[index].store(runtime, std::memory_order_relaxed);
 }
 
 template<typename ValueType>
 requires Summable<ValueType> && DividableByInteger<ValueType>
 ValueType ProcessorMetrics::Averager<ValueType>::getLastValue() const {
-  std::lock_guard<std::mutex> lock(average_value_mutex_);
-  if (values_.empty()) {
+  const auto value_count = value_count_.load();
+  if (value_count == 0) {
     return {};
-  } else if (values_.size() < SAMPLE_SIZE_) {
-    return values_[values_.size() - 1];
-  } else {
-    return values_[next_average_index_ - 1];
   }
+  return values_[(value_count - 1) % SAMPLE_SIZE_].load(std::memory_order_relaxed);
 }
 
 }  // namespace org::apache::nifi::minifi::core
@@ -44,6 +44,7 @@ FlowSchema FlowSchema::getDefault() {
       .destination_name = {"destination name"},
       .flowfile_expiration = {"flowfile expiration"},
       .drop_empty = {"drop empty"},
+      .concurrent_queue = {"concurrent queue"},
       .source_relationship = {"source relationship name"},
       .source_relationship_list = {"source relationship names"},
 
@@ -105,6 +106,7 @@ FlowSchema FlowSchema::getNiFiFlowJson() {
       .flowfile_expiration = {"flowFileExpiration"},
       // contrary to nifi we support dropEmpty in flow json as well
       .drop_empty = {"dropEmpty"},
+      .concurrent_queue = {},
       .source_relationship = {},
       .source_relationship_list = {"selectedRelationships"},
 
@@ -566,6 +566,7 @@ void StructuredConfiguration::parseConnection(const Node& connection_node_seq, c
     connection->setDestinationUUID(connectionParser.getDestinationUUID());
     connection->setFlowExpirationDuration(connectionParser.getFlowFileExpiration());
     connection->setDropEmptyFlowFiles(connectionParser.getDropEmpty());
+    connection->setConcurrentQueue(connectionParser.getConcurrentQueue());
 
     parent->addConnection(std::move(connection));
   }
@@ -202,4 +202,12 @@ bool StructuredConnectionParser::getDropEmpty() const {
   return false;
 }
 
+bool StructuredConnectionParser::getConcurrentQueue() const {
+  const flow::Node concurrent_queue_node = connectionNode_[schema_.concurrent_queue];
+  if (concurrent_queue_node) {
+    return utils::StringUtils::toBool(concurrent_queue_node.getString().value()).value_or(false);
+  }
+  return false;
+}
+
 }  // namespace org::apache::nifi::minifi::core::flow
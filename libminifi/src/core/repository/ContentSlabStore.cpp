@@ -0,0 +1,266 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/repository/ContentSlabStore.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/logging/LoggerFactory.h"
+#include "utils/gsl.h"
+#include "utils/file/FileUtils.h"
+
+namespace org::apache::nifi::minifi::core::repository {
+
+namespace {
+constexpr const char* SEGMENT_EXTENSION = ".slab";
+constexpr const char* INDEX_EXTENSION = ".idx";
+
+template<typename T>
+bool readValue(std::istream& stream, T& value) {
+  return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template<typename T>
+void writeValue(std::ostream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}  // namespace
+
+ContentSlabStore::ContentSlabStore(std::filesystem::path directory, uint64_t max_segment_size)
+    : directory_(std::move(directory)),
+      max_segment_size_(max_segment_size),
+      logger_(logging::LoggerFactory<ContentSlabStore>::getLogger()) {
+}
+
+bool ContentSlabStore::initialize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (utils::file::create_dir(directory_) != 0) {
+    logger_->log_error("Could not create slab directory %s", directory_.string());
+    return false;
+  }
+
+  std::vector<uint64_t> segment_ids;
+  for (const auto& entry : std::filesystem::directory_iterator(directory_, std::filesystem::directory_options::skip_permission_denied)) {
+    if (entry.path().extension() != SEGMENT_EXTENSION) {
+      continue;
+    }
+    try {
+      segment_ids.push_back(std::stoull(entry.path().stem().string()));
+    } catch (const std::exception&) {
+      logger_->log_warn("Ignoring unexpected file %s in slab directory", entry.path().string());
+    }
+  }
+  // load the segments in the order they were written, so that rewritten entries override the earlier ones
+  std::sort(segment_ids.begin(), segment_ids.end());
+  for (auto segment_id : segment_ids) {
+    if (!loadIndex(segment_id)) {
+      return false;
+    }
+  }
+  for (auto it = segments_.begin(); it != segments_.end();) {
+    if (it->second.live_entries == 0) {
+      deleteSegment((it++)->first);
+    } else {
+      ++it;
+    }
+  }
+  logger_->log_debug("Restored %zu entries in %zu slab segments", entries_.size(), segments_.size());
+
+  // never append to a segment that might have been left incomplete
+  return openActiveSegment(segment_ids.empty() ? 0 : segment_ids.back() + 1);
+}
+
+bool ContentSlabStore::loadIndex(uint64_t segment_id) {
+  auto& segment = segments_[segment_id];
+  std::error_code ec;
+  segment.size = std::filesystem::file_size(getSegmentPath(segment_id), ec);
+  if (ec) {
+    logger_->log_error("Could not get the size of slab segment %s: %s", getSegmentPath(segment_id).string(), ec.message());
+    return false;
+  }
+
+  std::ifstream index(getIndexPath(segment_id), std::ios::binary);
+  while (index) {
+    uint32_t key_length = 0;
+    Location location{.segment_id = segment_id};
+    if (!readValue(index, key_length)) {
+      break;
+    }
+    std::string key(key_length, '\0');
+    if (!index.read(key.data(), gsl::narrow<std::streamsize>(key_length)) || !readValue(index, location.offset) || !readValue(index, location.length)) {
+      logger_->log_warn("Ignoring truncated record at the end of slab index %s", getIndexPath(segment_id).string());
+      break;
+    }
+    if (location.offset + location.length > segment.size) {
+      logger_->log_warn("Ignoring entry %s pointing past the end of slab segment %s", key, getSegmentPath(segment_id).string());
+      continue;
+    }
+    auto [it, inserted] = entries_.try_emplace(key, location);
+    if (!inserted) {
+      // empty segments are only deleted after all indices have been loaded
+      --segments_[it->second.segment_id].live_entries;
+      it->second = location;
+    }
+    ++segment.live_entries;
+  }
+  return true;
+}
+
+bool ContentSlabStore::openActiveSegment(uint64_t segment_id) {
+  active_segment_.close();
+  active_index_.close();
+  active_segment_id_ = segment_id;
+  segments_[segment_id] = Segment{};
+  active_segment_.open(getSegmentPath(segment_id), std::ios::binary | std::ios::out | std::ios::trunc);
+  active_index_.open(getIndexPath(segment_id), std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!active_segment_ || !active_index_) {
+    logger_->log_error("Could not open slab segment %s for writing", getSegmentPath(segment_id).string());
+    return false;
+  }
+  logger_->log_debug("Opened slab segment %s", getSegmentPath(segment_id).string());
+  return true;
+}
+
+bool ContentSlabStore::append(const std::string& key, std::span<const std::byte> data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& active = segments_[active_segment_id_];
+  if (active.size > 0 && active.size + data.size() > max_segment_size_ && !rollOver()) {
+    return false;
+  }
+
+  auto& segment = segments_[active_segment_id_];
+  const Location location{.segment_id = active_segment_id_, .offset = segment.size, .length = data.size()};
+  active_segment_.write(reinterpret_cast<const char*>(data.data()), gsl::narrow<std::streamsize>(data.size()));
+  // the content has to reach the segment before the index refers to it
+  active_segment_.flush();
+  writeValue(active_index_, gsl::narrow<uint32_t>(key.size()));
+  active_index_.write(key.data(), gsl::narrow<std::streamsize>(key.size()));
+  writeValue(active_index_, location.offset);
+  writeValue(active_index_, location.length);
+  active_index_.flush();
+  if (!active_segment_ || !active_index_) {
+    logger_->log_error("Failed to append %s to slab segment %s", key, getSegmentPath(active_segment_id_).string());
+    // do not reuse a segment with a partial write at its end
+    rollOver();
+    return false;
+  }
+  segment.size += data.size();
+  ++segment.live_entries;
+
+  auto [it, inserted] = entries_.try_emplace(key, location);
+  if (!inserted) {
+    releaseEntry(it->second);
+    it->second = location;
+  }
+  return true;
+}
+
+bool ContentSlabStore::rollOver() {
+  const auto sealed_segment_id = active_segment_id_;
+  const bool success = openActiveSegment(sealed_segment_id + 1);
+  if (segments_[sealed_segment_id].live_entries == 0) {
+    deleteSegment(sealed_segment_id);
+  }
+  return success;
+}
+
+std::optional<std::vector<std::byte>> ContentSlabStore::read(const std::string& key) const {
+  Location location{};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return std::nullopt;
+    }
+    location = it->second;
+  }
+  // the segment cannot be deleted while the key refers to it, as the key is only removed once nobody owns the claim
+  std::ifstream segment(getSegmentPath(location.segment_id), std::ios::binary);
+  std::vector<std::byte> data(location.length);
+  if (!segment.seekg(gsl::narrow<std::streamoff>(location.offset)) || !segment.read(reinterpret_cast<char*>(data.data()), gsl::narrow<std::streamsize>(data.size()))) {
+    logger_->log_error("Failed to read %s from slab segment %s", key, getSegmentPath(location.segment_id).string());
+    return std::nullopt;
+  }
+  return data;
+}
+
+bool ContentSlabStore::contains(const std::string& key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.contains(key);
+}
+
+bool ContentSlabStore::remove(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  releaseEntry(it->second);
+  entries_.erase(it);
+  return true;
+}
+
+std::vector<std::string> ContentSlabStore::getKeys() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> keys;
+  keys.reserve(entries_.size());
+  for (const auto& [key, location] : entries_) {
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+size_t ContentSlabStore::getEntryCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+std::filesystem::path ContentSlabStore::getSegmentPath(uint64_t segment_id) const {
+  return directory_ / (std::to_string(segment_id) + SEGMENT_EXTENSION);
+}
+
+std::filesystem::path ContentSlabStore::getIndexPath(uint64_t segment_id) const {
+  return directory_ / (std::to_string(segment_id) + INDEX_EXTENSION);
+}
+
+void ContentSlabStore::releaseEntry(const Location& location) {
+  auto it = segments_.find(location.segment_id);
+  gsl_Expects(it != segments_.end() && it->second.live_entries > 0);
+  if (--it->second.live_entries == 0 && location.segment_id != active_segment_id_) {
+    deleteSegment(location.segment_id);
+  }
+}
+
+void ContentSlabStore::deleteSegment(uint64_t segment_id) {
+  logger_->log_debug("Deleting slab segment %s", getSegmentPath(segment_id).string());
+  segments_.erase(segment_id);
+  std::error_code ec;
+  std::filesystem::remove(getIndexPath(segment_id), ec);
+  if (ec) {
+    logger_->log_error("Could not delete slab index %s: %s", getIndexPath(segment_id).string(), ec.message());
+  }
+  std::filesystem::remove(getSegmentPath(segment_id), ec);
+  if (ec) {
+    logger_->log_error("Could not delete slab segment %s: %s", getSegmentPath(segment_id).string(), ec.message());
+  }
+}
+
+}  // namespace org::apache::nifi::minifi::core::repository
@@ -17,15 +17,108 @@
  */
 
 #include "core/repository/FileSystemRepository.h"
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
 #include <memory>
 #include <string>
 #include <filesystem>
+#include <utility>
+#include <vector>
+#include "io/BufferStream.h"
 #include "io/FileStream.h"
+#include "io/MemoryMappedFileStream.h"
 #include "utils/file/FileUtils.h"
 #include "core/ForwardingContentSession.h"
+#include "core/Property.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
+namespace {
+// the bucket of a file must not depend on the standard library implementation, so std::hash cannot be used
+uint32_t fnv1aHash(std::string_view str) {
+  uint32_t hash = 2166136261u;
+  for (char c : str) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+}  // namespace
+
+/**
+ * Buffers the content in memory and appends it to the slab store when closed. Once the content
+ * grows over the maximum slab claim size, it is written to a separate file instead.
+ */
+class FileSystemRepository::SlabWriteStream : public io::BaseStream {
+ public:
+  SlabWriteStream(std::shared_ptr<ContentSlabStore> slab_store, std::string content_path, std::filesystem::path file_path,
+      uint64_t max_claim_size, std::vector<std::byte> initial_content)
+      : slab_store_(std::move(slab_store)),
+        content_path_(std::move(content_path)),
+        file_path_(std::move(file_path)),
+        max_claim_size_(max_claim_size),
+        buffer_(std::move(initial_content)) {
+  }
+
+  ~SlabWriteStream() override {
+    close();
+  }
+
+  using BaseStream::read;
+  using BaseStream::write;
+
+  size_t read(std::span<std::byte> /*buffer*/) override {
+    return io::STREAM_ERROR;
+  }
+
+  size_t write(const uint8_t* value, size_t size) override {
+    if (closed_) {
+      return io::STREAM_ERROR;
+    }
+    if (!file_stream_ && buffer_.size() + size > max_claim_size_) {
+      file_stream_ = std::make_unique<io::FileStream>(file_path_);
+      if (!buffer_.empty() && io::isError(file_stream_->write(buffer_))) {
+        return io::STREAM_ERROR;
+      }
+      std::vector<std::byte>{}.swap(buffer_);
+      // the claim lives in its own file from now on
+      slab_store_->remove(content_path_);
+    }
+    if (file_stream_) {
+      return file_stream_->write(value, size);
+    }
+    const auto* bytes = reinterpret_cast<const std::byte*>(value);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+    return size;
+  }
+
+  [[nodiscard]] size_t size() const override {
+    return file_stream_ ? file_stream_->size() : buffer_.size();
+  }
+
+  void close() override {
+    if (std::exchange(closed_, true)) {
+      return;
+    }
+    if (file_stream_) {
+      file_stream_->close();
+    } else if (!slab_store_->append(content_path_, buffer_)) {
+      // fall back to a separate file, so that the content is not lost
+      io::FileStream(file_path_).write(buffer_);
+    }
+  }
+
+ private:
+  std::shared_ptr<ContentSlabStore> slab_store_;
+  std::string content_path_;
+  std::filesystem::path file_path_;
+  uint64_t max_claim_size_;
+  std::vector<std::byte> buffer_;
+  std::unique_ptr<io::FileStream> file_stream_;
+  bool closed_ = false;
+};
+
 bool FileSystemRepository::initialize(const std::shared_ptr<minifi::Configure>& configuration) {
   std::string directory_str;
   if (configuration->get(Configure::nifi_dbcontent_repository_directory_default, directory_str) && !directory_str.empty()) {
@@ -34,37 +127,117 @@ bool FileSystemRepository::initialize(const std::shared_ptr<minifi::Configure>&
     directory_ = configuration->getHome().string();
   }
   utils::file::create_dir(directory_);
+
+  if (auto fan_out_str = configuration->get(Configure::nifi_filesystem_content_repository_directory_fan_out)) {
+    if (!core::Property::StringToInt(*fan_out_str, directory_fan_out_)) {
+      logger_->log_error("Malformed property '%s', expected non-negative integer", Configure::nifi_filesystem_content_repository_directory_fan_out);
+      return false;
+    }
+  }
+  for (uint32_t bucket = 0; bucket < directory_fan_out_; ++bucket) {
+    utils::file::create_dir(std::filesystem::path(directory_) / std::to_string(bucket));
+  }
+
+  if (auto max_claim_size_str = configuration->get(Configure::nifi_filesystem_content_repository_slab_max_claim_size)) {
+    if (!core::Property::StringToInt(*max_claim_size_str, slab_max_claim_size_)) {
+      logger_->log_error("Malformed property '%s', expected data size", Configure::nifi_filesystem_content_repository_slab_max_claim_size);
+      return false;
+    }
+  }
+  if (slab_max_claim_size_ > 0) {
+    uint64_t segment_size = DEFAULT_SLAB_SEGMENT_SIZE;
+    if (auto segment_size_str = configuration->get(Configure::nifi_filesystem_content_repository_slab_segment_size)) {
+      if (!core::Property::StringToInt(*segment_size_str, segment_size)) {
+        logger_->log_error("Malformed property '%s', expected data size", Configure::nifi_filesystem_content_repository_slab_segment_size);
+        return false;
+      }
+    }
+    logger_->log_info("Packing claims up to %" PRIu64 " bytes into slab segments of %" PRIu64 " bytes", slab_max_claim_size_, segment_size);
+    slab_store_ = std::make_shared<ContentSlabStore>(std::filesystem::path(directory_) / SLAB_DIRECTORY_NAME, segment_size);
+    if (!slab_store_->initialize()) {
+      return false;
+    }
+  }
   return true;
 }
 
+std::filesystem::path FileSystemRepository::getFilePath(const std::string& content_path) const {
+  if (directory_fan_out_ == 0) {
+    return content_path;
+  }
+  std::filesystem::path path(content_path);
+  const auto bucket = fnv1aHash(path.filename().string()) % directory_fan_out_;
+  return path.parent_path() / std::to_string(bucket) / path.filename();
+}
+
 std::shared_ptr<io::BaseStream> FileSystemRepository::write(const minifi::ResourceClaim& claim, bool append) {
-  return std::make_shared<io::FileStream>(claim.getContentFullPath(), append);
+  const auto& content_path = claim.getContentFullPath();
+  auto file_path = getFilePath(content_path);
+  if (!slab_store_) {
+    return std::make_shared<io::FileStream>(file_path, append);
+  }
+
+  std::vector<std::byte> initial_content;
+  if (append) {
+    if (auto content = slab_store_->read(content_path)) {
+      initial_content = std::move(*content);
+    } else if (utils::file::exists(file_path)) {
+      // already too large to be packed
+      return std::make_shared<io::FileStream>(file_path, true);
+    }
+  }
+  return std::make_shared<SlabWriteStream>(slab_store_, content_path, std::move(file_path), slab_max_claim_size_, std::move(initial_content));
 }
 
 bool FileSystemRepository::exists(const minifi::ResourceClaim& streamId) {
-  std::ifstream file(streamId.getContentFullPath());
+  if (slab_store_ && slab_store_->contains(streamId.getContentFullPath())) {
+    return true;
+  }
+  std::ifstream file(getFilePath(streamId.getContentFullPath()));
   return file.good();
 }
 
 std::shared_ptr<io::BaseStream> FileSystemRepository::read(const minifi::ResourceClaim& claim) {
-  return std::make_shared<io::FileStream>(claim.getContentFullPath(), 0, false);
+  if (slab_store_) {
+    if (auto content = slab_store_->read(claim.getContentFullPath())) {
+      return std::make_shared<io::BufferStream>(*content);
+    }
+  }
+  return std::make_shared<io::FileStream>(getFilePath(claim.getContentFullPath()), 0, false);
+}
+
+std::shared_ptr<io::BaseStream> FileSystemRepository::readMapped(const minifi::ResourceClaim& claim) {
+  if (slab_store_) {
+    // packed claims are small, copying them out of their segment is cheaper than mapping it
+    if (auto content = slab_store_->read(claim.getContentFullPath())) {
+      return std::make_shared<io::BufferStream>(*content);
+    }
+  }
+  return io::MemoryMappedFileStream::map(getFilePath(claim.getContentFullPath()));
 }
 
 bool FileSystemRepository::removeKey(const std::string& content_path) {
   logger_->log_debug("Deleting resource %s", content_path);
+  if (slab_store_ && slab_store_->remove(content_path)) {
+    return true;
+  }
+  return removeFile(getFilePath(content_path));
+}
+
+bool FileSystemRepository::removeFile(const std::filesystem::path& path) {
   std::error_code ec;
-  auto result = std::filesystem::exists(content_path, ec);
+  auto result = std::filesystem::exists(path, ec);
   if (ec) {
-    logger_->log_error("Deleting %s from content repository failed with the following error: %s", content_path, ec.message());
+    logger_->log_error("Deleting %s from content repository failed with the following error: %s", path.string(), ec.message());
     return false;
   }
   if (!result) {
-    logger_->log_debug("Content path %s does not exist, no need to delete it", content_path);
+    logger_->log_debug("Content path %s does not exist, no need to delete it", path.string());
     return true;
   }
   ec.clear();
-  if (!std::filesystem::remove(content_path, ec)) {
-    logger_->log_error("Deleting %s from content repository failed with the following error: %s", content_path, ec.message());
+  if (!std::filesystem::remove(path, ec)) {
+    logger_->log_error("Deleting %s from content repository failed with the following error: %s", path.string(), ec.message());
     return false;
   }
   return true;
@@ -75,27 +248,66 @@ std::shared_ptr<ContentSession> FileSystemRepository::createSession() {
 }
 
 void FileSystemRepository::clearOrphans() {
-  utils::file::list_dir(directory_, [&] (auto& /*dir*/, auto& filename) {
-    auto path = directory_ +  "/" + filename.string();
-    bool is_orphan = false;
-    {
-      std::lock_guard<std::mutex> lock(count_map_mutex_);
-      auto it = count_map_.find(path);
-      is_orphan = it == count_map_.end() || it->second == 0;
-    }
-    if (is_orphan) {
-      logger_->log_debug("Deleting orphan resource %s", path);
-      std::error_code ec;
-      if (!std::filesystem::remove(path, ec)) {
-        {
-          std::lock_guard<std::mutex> lock(purge_list_mutex_);
-          purge_list_.push_back(path);
+  const auto is_orphan = [&] (const std::string& content_path) {
+    std::lock_guard<std::mutex> lock(count_map_mutex_);
+    auto it = count_map_.find(content_path);
+    return it == count_map_.end() || it->second == 0;
+  };
+
+  if (slab_store_) {
+    for (const auto& content_path : slab_store_->getKeys()) {
+      if (is_orphan(content_path)) {
+        logger_->log_debug("Deleting orphan resource %s", content_path);
+        slab_store_->remove(content_path);
+      }
+    }
+  }
+
+  utils::file::list_dir(directory_, [&] (auto& dir, auto& filename) {
+    auto path = dir / filename;
+    auto content_path = directory_ +  "/" + filename.string();
+    if (!is_orphan(content_path)) {
+      // the fan-out might have been changed since the file was written
+      auto file_path = getFilePath(content_path);
+      if (file_path != path) {
+        logger_->log_debug("Moving resource %s to %s", path.string(), file_path.string());
+        std::error_code ec;
+        std::filesystem::rename(path, file_path, ec);
+        if (ec) {
+          logger_->log_error("Moving %s to %s failed with the following error: %s", path.string(), file_path.string(), ec.message());
         }
-        logger_->log_error("Deleting %s from content repository failed with the following error: %s", path, ec.message());
       }
+      return true;
+    }
+    logger_->log_debug("Deleting orphan resource %s", path.string());
+    std::error_code ec;
+    if (!std::filesystem::remove(path, ec)) {
+      {
+        std::lock_guard<std::mutex> lock(purge_list_mutex_);
+        purge_list_.push_back(content_path);
+      }
+      logger_->log_error("Deleting %s from content repository failed with the following error: %s", path.string(), ec.message());
     }
     return true;
-  }, logger_, false);
+  }, logger_, [] (const std::filesystem::path& dir) {
+    // only descend into the fan-out buckets, which might be left over from a different fan-out setting
+    const auto name = dir.filename().string();
+    return !name.empty() && std::all_of(name.begin(), name.end(), [] (char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+  });
+}
+
+uint64_t FileSystemRepository::getRepositoryEntryCount() const {
+  const auto slab_directory = std::filesystem::path(directory_) / SLAB_DIRECTORY_NAME;
+  uint64_t count = slab_store_ ? slab_store_->getEntryCount() : 0;
+  auto dir_it = std::filesystem::recursive_directory_iterator(directory_, std::filesystem::directory_options::skip_permission_denied);
+  for (auto it = std::filesystem::begin(dir_it); it != std::filesystem::end(dir_it); ++it) {
+    if (it->is_directory() && it->path() == slab_directory) {
+      it.disable_recursion_pending();
+    } else if (it->is_regular_file()) {
+      ++count;
+    }
+  }
+  return count;
 }
 
 }  // namespace org::apache::nifi::minifi::core::repository
@@ -37,6 +37,22 @@ size_t InputStream::read(bool &value) {
   return 1;
 }
 
+size_t InputStream::readVarInt(uint64_t& value) {
+  constexpr size_t max_length = 10;
+  value = 0;
+  for (size_t length = 1; length <= max_length; ++length) {
+    uint8_t byte = 0;
+    if (read(byte) != 1) {
+      return STREAM_ERROR;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << (7 * (length - 1));
+    if ((byte & 0x80) == 0) {
+      return length;
+    }
+  }
+  return STREAM_ERROR;
+}
+
 size_t InputStream::read(utils::Identifier &value) {
   std::string uuidStr;
   const auto ret = read(uuidStr);
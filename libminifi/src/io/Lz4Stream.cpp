@@ -0,0 +1,142 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io/Lz4Stream.h"
+
+#include <algorithm>
+
+#include "Exception.h"
+#include "core/logging/LoggerConfiguration.h"
+
+namespace org::apache::nifi::minifi::io {
+
+namespace {
+// LZ4F_compressUpdate needs an output buffer large enough for the worst case, so the input is fed to it in blocks of this size
+constexpr size_t LZ4_INPUT_BLOCK_SIZE = 64 * 1024;
+constexpr size_t LZ4_OUTPUT_BUFFER_SIZE = 64 * 1024;
+}  // namespace
+
+Lz4CompressStream::Lz4CompressStream(gsl::not_null<OutputStream*> output, int level)
+    : output_{output},
+      logger_{core::logging::LoggerFactory<Lz4CompressStream>::getLogger()} {
+  LZ4F_cctx* context = nullptr;
+  const size_t result = LZ4F_createCompressionContext(&context, LZ4F_VERSION);
+  context_.reset(context);
+  if (LZ4F_isError(result)) {
+    logger_->log_error("Failed to create LZ4 compression context: %s", LZ4F_getErrorName(result));
+    throw Exception(ExceptionType::GENERAL_EXCEPTION, "Failed to create LZ4 compression context");
+  }
+  preferences_.compressionLevel = level;
+  preferences_.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+  output_buffer_.resize(std::max(LZ4F_compressBound(LZ4_INPUT_BLOCK_SIZE, &preferences_), size_t{LZ4F_HEADER_SIZE_MAX}));
+}
+
+bool Lz4CompressStream::writeOutput(size_t result, const char* operation) {
+  if (LZ4F_isError(result)) {
+    logger_->log_error("%s failed: %s", operation, LZ4F_getErrorName(result));
+    errored_ = true;
+    return false;
+  }
+  if (result > 0 && output_->write(gsl::make_span(output_buffer_).subspan(0, result)) != result) {
+    logger_->log_error("Failed to write to underlying stream");
+    errored_ = true;
+    return false;
+  }
+  return true;
+}
+
+bool Lz4CompressStream::begin() {
+  if (!started_) {
+    started_ = true;
+    return writeOutput(LZ4F_compressBegin(context_.get(), output_buffer_.data(), output_buffer_.size(), &preferences_), "LZ4F_compressBegin");
+  }
+  return true;
+}
+
+size_t Lz4CompressStream::write(const uint8_t* value, size_t size) {
+  if (errored_ || finished_) {
+    logger_->log_error("write called on a %s Lz4CompressStream", errored_ ? "failed" : "closed");
+    return STREAM_ERROR;
+  }
+  if (!begin()) {
+    return STREAM_ERROR;
+  }
+  for (size_t offset = 0; offset < size; offset += LZ4_INPUT_BLOCK_SIZE) {
+    const size_t block_size = std::min(LZ4_INPUT_BLOCK_SIZE, size - offset);
+    if (!writeOutput(LZ4F_compressUpdate(context_.get(), output_buffer_.data(), output_buffer_.size(), value + offset, block_size, nullptr), "LZ4F_compressUpdate")) {
+      return STREAM_ERROR;
+    }
+  }
+  return size;
+}
+
+void Lz4CompressStream::close() {
+  if (errored_ || finished_ || !begin()) {
+    return;
+  }
+  if (writeOutput(LZ4F_compressEnd(context_.get(), output_buffer_.data(), output_buffer_.size(), nullptr), "LZ4F_compressEnd")) {
+    finished_ = true;
+  }
+}
+
+Lz4DecompressStream::Lz4DecompressStream(gsl::not_null<OutputStream*> output)
+    : output_buffer_(LZ4_OUTPUT_BUFFER_SIZE),
+      output_{output},
+      logger_{core::logging::LoggerFactory<Lz4DecompressStream>::getLogger()} {
+  LZ4F_dctx* context = nullptr;
+  const size_t result = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+  context_.reset(context);
+  if (LZ4F_isError(result)) {
+    logger_->log_error("Failed to create LZ4 decompression context: %s", LZ4F_getErrorName(result));
+    throw Exception(ExceptionType::GENERAL_EXCEPTION, "Failed to create LZ4 decompression context");
+  }
+}
+
+size_t Lz4DecompressStream::write(const uint8_t* value, size_t size) {
+  if (errored_) {
+    logger_->log_error("write called on a failed Lz4DecompressStream");
+    return STREAM_ERROR;
+  }
+
+  size_t offset = 0;
+  bool output_buffer_full = false;
+  // a full output buffer means that LZ4 may still hold decompressed data, even if all input has been consumed
+  while (offset < size || output_buffer_full) {
+    size_t output_size = output_buffer_.size();
+    size_t input_size = size - offset;
+    const size_t result = LZ4F_decompress(context_.get(), output_buffer_.data(), &output_size, value + offset, &input_size, nullptr);
+    if (LZ4F_isError(result)) {
+      logger_->log_error("LZ4 decompression failed: %s", LZ4F_getErrorName(result));
+      errored_ = true;
+      return STREAM_ERROR;
+    }
+    if (output_size > 0 && output_->write(gsl::make_span(output_buffer_).subspan(0, output_size)) != output_size) {
+      logger_->log_error("Failed to write to underlying stream");
+      errored_ = true;
+      return STREAM_ERROR;
+    }
+    offset += input_size;
+    // LZ4F_decompress returns 0 once a frame is fully decoded
+    frame_complete_ = result == 0;
+    output_buffer_full = output_size == output_buffer_.size();
+  }
+
+  return size;
+}
+
+}  // namespace org::apache::nifi::minifi::io
@@ -0,0 +1,104 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "io/MemoryMappedFileStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "utils/gsl.h"
+
+namespace org::apache::nifi::minifi::io {
+
+std::shared_ptr<MemoryMappedFileStream> MemoryMappedFileStream::map(const std::filesystem::path& path) {
+  std::error_code ec;
+  const auto length = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return nullptr;
+  }
+  if (length == 0) {
+    // empty files cannot be mapped
+    return std::shared_ptr<MemoryMappedFileStream>(new MemoryMappedFileStream(nullptr, 0));
+  }
+#ifdef WIN32
+  HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  // the view keeps the mapping alive
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (data == nullptr) {
+    return nullptr;
+  }
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  void* data = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping keeps the file open
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+#endif
+  return std::shared_ptr<MemoryMappedFileStream>(new MemoryMappedFileStream(static_cast<const std::byte*>(data), gsl::narrow<size_t>(length)));
+}
+
+void MemoryMappedFileStream::close() {
+  if (data_ == nullptr) {
+    return;
+  }
+#ifdef WIN32
+  UnmapViewOfFile(data_);
+#else
+  ::munmap(const_cast<std::byte*>(data_), length_);
+#endif
+  data_ = nullptr;
+  length_ = 0;
+  offset_ = 0;
+}
+
+void MemoryMappedFileStream::seek(size_t offset) {
+  offset_ = std::min(offset, length_);
+}
+
+size_t MemoryMappedFileStream::read(std::span<std::byte> buf) {
+  const auto amount_to_read = std::min(buf.size(), length_ - offset_);
+  if (amount_to_read > 0) {
+    std::memcpy(buf.data(), data_ + offset_, amount_to_read);
+  }
+  offset_ += amount_to_read;
+  return amount_to_read;
+}
+
+}  // namespace org::apache::nifi::minifi::io
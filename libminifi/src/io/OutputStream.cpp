@@ -21,6 +21,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <array>
 #include "io/OutputStream.h"
 #include "utils/gsl.h"
 
@@ -46,6 +47,20 @@ size_t OutputStream::write(const utils::Identifier &value) {
   return write(value.to_string());
 }
 
+size_t OutputStream::writeVarInt(uint64_t value) {
+  std::array<uint8_t, 10> buffer{};
+  size_t length = 0;
+  do {
+    buffer[length] = gsl::narrow_cast<uint8_t>(value & 0x7F);
+    value >>= 7;
+    if (value != 0) {
+      buffer[length] |= 0x80;
+    }
+    ++length;
+  } while (value != 0);
+  return write(buffer.data(), length);
+}
+
 size_t OutputStream::write(const std::string& str, bool widen) {
   return write_str(str.c_str(), gsl::narrow<uint32_t>(str.length()), widen);
 }
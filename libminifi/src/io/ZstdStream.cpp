@@ -0,0 +1,126 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io/ZstdStream.h"
+#include "Exception.h"
+#include "core/logging/LoggerConfiguration.h"
+
+namespace org::apache::nifi::minifi::io {
+
+ZstdCompressStream::ZstdCompressStream(gsl::not_null<OutputStream*> output, int level, uint32_t worker_count, bool long_distance_matching)
+    : context_(ZSTD_createCCtx()),
+      output_buffer_(ZSTD_CStreamOutSize()),
+      output_{output},
+      logger_{core::logging::LoggerFactory<ZstdCompressStream>::getLogger()} {
+  if (!context_) {
+    throw Exception(ExceptionType::GENERAL_EXCEPTION, "Failed to create zstd compression context");
+  }
+  const auto set_parameter = [this](ZSTD_cParameter parameter, int value, const char* name) {
+    const size_t result = ZSTD_CCtx_setParameter(context_.get(), parameter, value);
+    if (ZSTD_isError(result)) {
+      logger_->log_error("Failed to set zstd %s to %d: %s", name, value, ZSTD_getErrorName(result));
+      throw Exception(ExceptionType::GENERAL_EXCEPTION, std::string("Invalid zstd ") + name);
+    }
+  };
+  set_parameter(ZSTD_c_compressionLevel, level, "compression level");
+  if (long_distance_matching) {
+    set_parameter(ZSTD_c_enableLongDistanceMatching, 1, "long distance matching");
+  }
+  if (worker_count > 0 && ZSTD_isError(ZSTD_CCtx_setParameter(context_.get(), ZSTD_c_nbWorkers, gsl::narrow<int>(worker_count)))) {
+    logger_->log_warn("zstd was built without multithreading support, compressing on the calling thread");
+  }
+}
+
+size_t ZstdCompressStream::write(const uint8_t* value, size_t size) {
+  return compress(value, size, ZSTD_e_continue);
+}
+
+void ZstdCompressStream::close() {
+  if (!errored_ && !finished_ && compress(nullptr, 0U, ZSTD_e_end) == 0) {
+    finished_ = true;
+  }
+}
+
+size_t ZstdCompressStream::compress(const uint8_t* value, size_t size, ZSTD_EndDirective mode) {
+  if (errored_ || finished_) {
+    logger_->log_error("write called on a %s ZstdCompressStream", errored_ ? "failed" : "closed");
+    return STREAM_ERROR;
+  }
+
+  ZSTD_inBuffer input{value, size, 0};
+  bool done = false;
+  while (!done) {
+    ZSTD_outBuffer output{output_buffer_.data(), output_buffer_.size(), 0};
+    const size_t remaining = ZSTD_compressStream2(context_.get(), &output, &input, mode);
+    if (ZSTD_isError(remaining)) {
+      logger_->log_error("zstd compression failed: %s", ZSTD_getErrorName(remaining));
+      errored_ = true;
+      return STREAM_ERROR;
+    }
+    if (output.pos > 0 && output_->write(gsl::make_span(output_buffer_).subspan(0, output.pos)) != output.pos) {
+      logger_->log_error("Failed to write to underlying stream");
+      errored_ = true;
+      return STREAM_ERROR;
+    }
+    // the input is consumed once it has all been passed to zstd, but the frame is only complete once nothing is left to flush
+    done = mode == ZSTD_e_end ? remaining == 0 : input.pos == input.size;
+  }
+
+  return size;
+}
+
+ZstdDecompressStream::ZstdDecompressStream(gsl::not_null<OutputStream*> output)
+    : context_(ZSTD_createDCtx()),
+      output_buffer_(ZSTD_DStreamOutSize()),
+      output_{output},
+      logger_{core::logging::LoggerFactory<ZstdDecompressStream>::getLogger()} {
+  if (!context_) {
+    throw Exception(ExceptionType::GENERAL_EXCEPTION, "Failed to create zstd decompression context");
+  }
+}
+
+size_t ZstdDecompressStream::write(const uint8_t* value, size_t size) {
+  if (errored_) {
+    logger_->log_error("write called on a failed ZstdDecompressStream");
+    return STREAM_ERROR;
+  }
+
+  ZSTD_inBuffer input{value, size, 0};
+  bool output_buffer_full = false;
+  // a full output buffer means that zstd may still hold decompressed data, even if all input has been consumed
+  while (input.pos < input.size || output_buffer_full) {
+    ZSTD_outBuffer output{output_buffer_.data(), output_buffer_.size(), 0};
+    const size_t result = ZSTD_decompressStream(context_.get(), &output, &input);
+    if (ZSTD_isError(result)) {
+      logger_->log_error("zstd decompression failed: %s", ZSTD_getErrorName(result));
+      errored_ = true;
+      return STREAM_ERROR;
+    }
+    if (output.pos > 0 && output_->write(gsl::make_span(output_buffer_).subspan(0, output.pos)) != output.pos) {
+      logger_->log_error("Failed to write to underlying stream");
+      errored_ = true;
+      return STREAM_ERROR;
+    }
+    frame_complete_ = result == 0;
+    output_buffer_full = output.pos == output.size;
+  }
+
+  return size;
+}
+
+}  // namespace org::apache::nifi::minifi::io
@@ -146,13 +146,14 @@ bool ProvenanceEventRecord::serialize(io::OutputStream& output_stream) {
   }
   // write flow attributes
   {
-    const auto numAttributes = gsl::narrow<uint32_t>(this->_attributes.size());
+    const auto numAttributes = gsl::narrow<uint32_t>(_attributes ? _attributes->size() : 0);
     const auto ret = output_stream.write(numAttributes);
     if (ret != 4) {
       return false;
     }
   }
-  for (const auto& itAttribute : _attributes) {
+  static const core::FlowFile::AttributeMap no_attributes;
+  for (const auto& itAttribute : _attributes ? *_attributes : no_attributes) {
     {
       const auto ret = output_stream.write(itAttribute.first);
       if (ret == 0 || io::isError(ret)) {
@@ -331,6 +332,7 @@ bool ProvenanceEventRecord::deserialize(io::InputStream &input_stream) {
     }
   }
 
+  core::FlowFile::AttributeMap attributes;
   for (uint32_t i = 0; i < numAttributes; i++) {
     std::string key;
     {
@@ -346,8 +348,9 @@ bool ProvenanceEventRecord::deserialize(io::InputStream &input_stream) {
         return false;
       }
     }
-    this->_attributes[key] = value;
+    attributes[key] = value;
   }
+  _attributes = std::make_shared<const core::FlowFile::AttributeMap>(std::move(attributes));
 
   {
     const auto ret = input_stream.read(this->_contentFullPath);
@@ -209,6 +209,10 @@ void FlowFileQueue::setMaxSize(size_t max_size) {
   max_size_ = max_size;
 }
 
+bool FlowFileQueue::isSwappingEnabled() const {
+  return swap_manager_ && max_size_ != 0 && target_size_ != 0;
+}
+
 size_t FlowFileQueue::shouldSwapOutCount() const {
   if (!swap_manager_) {
     return 0;
@@ -87,10 +87,10 @@ void ListingStateManager::storeState(const ListingState &latest_listing_state) {
   std::unordered_map<std::string, std::string> state;
   state[LATEST_LISTED_OBJECT_TIMESTAMP] = std::to_string(latest_listing_state.getListedKeyTimeStampInMilliseconds());
 
-  uint64_t id = 0;
+  // the state keys are derived from the listed keys, so keys listed in an earlier run keep their state key
+  // and only the newly listed keys have to be written by the state manager
   for (const auto& key : latest_listing_state.listed_keys) {
-    state[LATEST_LISTED_OBJECT_PREFIX + std::to_string(id)] = key;
-    ++id;
+    state[LATEST_LISTED_OBJECT_PREFIX + key] = key;
   }
 
   logger_->log_debug("Stored new listed timestamp %s", state[LATEST_LISTED_OBJECT_TIMESTAMP]);
@@ -0,0 +1,646 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/RegexSet.h"
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+
+namespace org::apache::nifi::minifi::utils {
+
+namespace {
+
+// thrown while compiling a pattern which has to be matched by utils::Regex instead of the automaton
+struct UnsupportedPattern {};
+
+#ifdef NO_MORE_REGFREEE
+// utils::Regex uses std::regex with the ECMAScript grammar
+constexpr bool ECMASCRIPT_SYNTAX = true;
+#else
+// utils::Regex uses regcomp with POSIX extended regular expressions
+constexpr bool ECMASCRIPT_SYNTAX = false;
+#endif
+
+constexpr size_t MAX_REPETITION_COUNT = 1000;
+
+template<typename Predicate>
+std::bitset<256> charactersWhere(Predicate predicate) {
+  std::bitset<256> result;
+  for (size_t ch = 0; ch < 256; ++ch) {
+    result[ch] = predicate(static_cast<unsigned char>(ch));
+  }
+  return result;
+}
+
+std::bitset<256> literal(char ch) {
+  std::bitset<256> result;
+  result.set(static_cast<unsigned char>(ch));
+  return result;
+}
+
+std::bitset<256> digitCharacters() {
+  return charactersWhere([](unsigned char ch) { return std::isdigit(ch) != 0; });
+}
+
+std::bitset<256> wordCharacters() {
+  return charactersWhere([](unsigned char ch) { return std::isalnum(ch) != 0 || ch == '_'; });
+}
+
+std::bitset<256> spaceCharacters() {
+  return charactersWhere([](unsigned char ch) { return std::isspace(ch) != 0; });
+}
+
+std::bitset<256> anyCharacter() {
+  std::bitset<256> result;
+  result.set();
+  if constexpr (ECMASCRIPT_SYNTAX) {
+    result.reset('\n');
+    result.reset('\r');
+  }
+  return result;
+}
+
+void foldCase(std::bitset<256>& characters) {
+  for (unsigned char lower = 'a'; lower <= 'z'; ++lower) {
+    const auto upper = static_cast<unsigned char>(std::toupper(lower));
+    if (characters[lower] || characters[upper]) {
+      characters.set(lower);
+      characters.set(upper);
+    }
+  }
+}
+
+}  // namespace
+
+struct RegexSet::Node {
+  enum class Type { CHARACTERS, SEQUENCE, ALTERNATION, REPETITION };
+
+  Type type;
+  std::bitset<256> characters;
+  std::vector<Node> children;
+  size_t min = 0;
+  std::optional<size_t> max;
+};
+
+/**
+ * Parses the subset of the regular expression syntax which has the same meaning for utils::Regex on every platform,
+ * throws UnsupportedPattern on anything else.
+ * Anchors are only supported at the beginning and the end of the top level alternatives.
+ */
+class RegexSet::Parser {
+ public:
+  struct Alternative {
+    Node sequence;
+    bool anchored_begin = false;
+    bool anchored_end = false;
+  };
+
+  Parser(std::string_view pattern, bool ignore_case)
+      : pattern_(pattern),
+        ignore_case_(ignore_case) {
+  }
+
+  std::vector<Alternative> parse() {
+    std::vector<Alternative> alternatives;
+    while (true) {
+      Alternative alternative;
+      alternative.anchored_begin = consume('^');
+      alternative.sequence = parseSequence();
+      alternative.anchored_end = consume('$');
+      if (alternative.sequence.children.empty() && !alternative.anchored_begin && !alternative.anchored_end) {
+        throw UnsupportedPattern{};
+      }
+      alternatives.push_back(std::move(alternative));
+      if (atEnd()) {
+        return alternatives;
+      }
+      // anything else is an anchor in the middle of the pattern or an unbalanced parenthesis
+      if (!consume('|')) {
+        throw UnsupportedPattern{};
+      }
+    }
+  }
+
+ private:
+  [[nodiscard]] bool atEnd() const {
+    return position_ >= pattern_.size();
+  }
+
+  [[nodiscard]] bool lookingAt(std::string_view prefix) const {
+    return pattern_.substr(position_).starts_with(prefix);
+  }
+
+  bool consume(std::string_view prefix) {
+    if (!lookingAt(prefix)) {
+      return false;
+    }
+    position_ += prefix.size();
+    return true;
+  }
+
+  bool consume(char ch) {
+    return consume(std::string_view(&ch, 1));
+  }
+
+  char next() {
+    if (atEnd()) {
+      throw UnsupportedPattern{};
+    }
+    return pattern_[position_++];
+  }
+
+  [[nodiscard]] bool atQuantifier() const {
+    return !atEnd() && std::string_view("*+?{").find(pattern_[position_]) != std::string_view::npos;
+  }
+
+  Node characters(std::bitset<256> characters) const {
+    if (ignore_case_) {
+      foldCase(characters);
+    }
+    return Node{.type = Node::Type::CHARACTERS, .characters = characters};
+  }
+
+  Node parseSequence() {
+    Node sequence{.type = Node::Type::SEQUENCE};
+    while (!atEnd() && !lookingAt("|") && !lookingAt(")") && !lookingAt("$")) {
+      sequence.children.push_back(parseQuantifiers(parseAtom()));
+    }
+    return sequence;
+  }
+
+  Node parseAlternation() {
+    Node alternation{.type = Node::Type::ALTERNATION};
+    do {
+      auto sequence = parseSequence();
+      if (sequence.children.empty()) {
+        throw UnsupportedPattern{};
+      }
+      alternation.children.push_back(std::move(sequence));
+    } while (consume('|'));
+    return alternation;
+  }
+
+  Node parseAtom() {
+    const char ch = next();
+    switch (ch) {
+      case '(': {
+        if (lookingAt("?") && !(ECMASCRIPT_SYNTAX && consume("?:"))) {
+          throw UnsupportedPattern{};
+        }
+        auto group = parseAlternation();
+        if (!consume(')')) {
+          throw UnsupportedPattern{};
+        }
+        return group;
+      }
+      case '[':
+        return characters(parseBracketExpression());
+      case '.':
+        return characters(anyCharacter());
+      case '\\':
+        return characters(parseEscape());
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+      case '}':
+      case ']':
+      case '^':
+        throw UnsupportedPattern{};
+      default:
+        return characters(literal(ch));
+    }
+  }
+
+  Node parseQuantifiers(Node atom) {
+    if (!atQuantifier()) {
+      return atom;
+    }
+    auto [min, max] = parseQuantifier();
+    if (consume('?')) {
+      // lazy in ECMAScript, which matches the same inputs, but it makes the repetition optional in POSIX
+      if constexpr (!ECMASCRIPT_SYNTAX) {
+        min = 0;
+      }
+    }
+    if (atQuantifier()) {
+      throw UnsupportedPattern{};
+    }
+    Node repetition{.type = Node::Type::REPETITION, .min = min, .max = max};
+    repetition.children.push_back(std::move(atom));
+    return repetition;
+  }
+
+  std::pair<size_t, std::optional<size_t>> parseQuantifier() {
+    switch (next()) {
+      case '*':
+        return {0, std::nullopt};
+      case '+':
+        return {1, std::nullopt};
+      case '?':
+        return {0, 1};
+      default:
+        break;
+    }
+    const size_t min = parseRepetitionCount();
+    if (consume('}')) {
+      return {min, min};
+    }
+    if (!consume(',')) {
+      throw UnsupportedPattern{};
+    }
+    if (consume('}')) {
+      return {min, std::nullopt};
+    }
+    const size_t max = parseRepetitionCount();
+    if (!consume('}') || max < min) {
+      throw UnsupportedPattern{};
+    }
+    return {min, max};
+  }
+
+  size_t parseRepetitionCount() {
+    size_t count = 0;
+    size_t digits = 0;
+    while (!atEnd() && std::isdigit(static_cast<unsigned char>(pattern_[position_]))) {
+      count = count * 10 + static_cast<size_t>(pattern_[position_++] - '0');
+      if (++digits > 4 || count > MAX_REPETITION_COUNT) {
+        throw UnsupportedPattern{};
+      }
+    }
+    if (digits == 0) {
+      throw UnsupportedPattern{};
+    }
+    return count;
+  }
+
+  std::bitset<256> parseEscape() {
+    const char ch = next();
+    switch (ch) {
+      case 'w': return wordCharacters();
+      case 'W': return ~wordCharacters();
+      case 's': return spaceCharacters();
+      case 'S': return ~spaceCharacters();
+      default: break;
+    }
+    if constexpr (ECMASCRIPT_SYNTAX) {
+      // regcomp treats these as the escaped letter itself
+      switch (ch) {
+        case 'd': return digitCharacters();
+        case 'D': return ~digitCharacters();
+        case 't': return literal('\t');
+        case 'n': return literal('\n');
+        case 'r': return literal('\r');
+        case 'f': return literal('\f');
+        case 'v': return literal('\v');
+        default: break;
+      }
+    }
+    if (std::string_view(".[]{}()\\*+?^$|/").find(ch) != std::string_view::npos) {
+      return literal(ch);
+    }
+    throw UnsupportedPattern{};
+  }
+
+  std::bitset<256> parseBracketExpression() {
+    std::bitset<256> result;
+    const bool negated = consume('^');
+    // a leading ']' is a literal in POSIX, but it closes an empty class in ECMAScript
+    if (atEnd() || lookingAt("]")) {
+      throw UnsupportedPattern{};
+    }
+    while (!consume(']')) {
+      if (consume("[:")) {
+        result |= parseCharacterClass();
+        continue;
+      }
+      if (lookingAt("[=") || lookingAt("[.")) {
+        throw UnsupportedPattern{};
+      }
+      const auto first = parseBracketCharacter(result);
+      if (!first) {
+        if (lookingAt("-") && !lookingAt("-]")) {
+          throw UnsupportedPattern{};
+        }
+        continue;
+      }
+      if (lookingAt("-") && !lookingAt("-]")) {
+        ++position_;
+        const auto last = parseBracketCharacter(result);
+        if (!last || static_cast<unsigned char>(*last) < static_cast<unsigned char>(*first) || (lookingAt("-") && !lookingAt("-]"))) {
+          throw UnsupportedPattern{};
+        }
+        for (auto ch = static_cast<size_t>(static_cast<unsigned char>(*first)); ch <= static_cast<unsigned char>(*last); ++ch) {
+          result.set(ch);
+        }
+      } else {
+        result.set(static_cast<unsigned char>(*first));
+      }
+    }
+    if (ignore_case_) {
+      foldCase(result);
+    }
+    if (negated) {
+      result.flip();
+    }
+    return result;
+  }
+
+  /**
+   * Returns the next character of a bracket expression, or adds the characters of a class escape to result and returns nullopt.
+   */
+  std::optional<char> parseBracketCharacter(std::bitset<256>& result) {
+    const char ch = next();
+    if (ch == '[') {
+      throw UnsupportedPattern{};
+    }
+    // a backslash is an ordinary character in POSIX bracket expressions
+    if (ch != '\\' || !ECMASCRIPT_SYNTAX) {
+      return ch;
+    }
+    const auto escaped = parseEscape();
+    if (escaped.count() != 1) {
+      result |= escaped;
+      return std::nullopt;
+    }
+    for (size_t escaped_ch = 0; escaped_ch < 256; ++escaped_ch) {
+      if (escaped[escaped_ch]) {
+        return static_cast<char>(escaped_ch);
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::bitset<256> parseCharacterClass() {
+    const auto end = pattern_.find(":]", position_);
+    if (end == std::string_view::npos) {
+      throw UnsupportedPattern{};
+    }
+    const auto name = pattern_.substr(position_, end - position_);
+    position_ = end + 2;
+    if (name == "alpha") return charactersWhere([](unsigned char ch) { return std::isalpha(ch) != 0; });
+    if (name == "digit") return digitCharacters();
+    if (name == "alnum") return charactersWhere([](unsigned char ch) { return std::isalnum(ch) != 0; });
+    if (name == "space") return spaceCharacters();
+    if (name == "blank") return charactersWhere([](unsigned char ch) { return ch == ' ' || ch == '\t'; });
+    if (name == "punct") return charactersWhere([](unsigned char ch) { return std::ispunct(ch) != 0; });
+    if (name == "xdigit") return charactersWhere([](unsigned char ch) { return std::isxdigit(ch) != 0; });
+    if (name == "print") return charactersWhere([](unsigned char ch) { return std::isprint(ch) != 0; });
+    if (name == "graph") return charactersWhere([](unsigned char ch) { return std::isgraph(ch) != 0; });
+    if (name == "cntrl") return charactersWhere([](unsigned char ch) { return std::iscntrl(ch) != 0; });
+    // the case-insensitive meaning of these differs between the implementations
+    if (name == "upper" && !ignore_case_) return charactersWhere([](unsigned char ch) { return std::isupper(ch) != 0; });
+    if (name == "lower" && !ignore_case_) return charactersWhere([](unsigned char ch) { return std::islower(ch) != 0; });
+    throw UnsupportedPattern{};
+  }
+
+  std::string_view pattern_;
+  bool ignore_case_;
+  size_t position_ = 0;
+};
+
+RegexSet::RegexSet(const std::vector<std::string>& patterns, MatchMode mode, bool ignore_case)
+    : mode_(mode),
+      automaton_backed_(patterns.size(), false),
+      matches_(patterns.size(), false) {
+  for (size_t index = 0; index < patterns.size(); ++index) {
+    try {
+      compilePattern(patterns[index], index, ignore_case);
+      automaton_backed_[index] = true;
+      ++automaton_pattern_count_;
+    } catch (const UnsupportedPattern&) {
+      std::vector<Regex::Mode> flags;
+      if (ignore_case) {
+        flags.push_back(Regex::Mode::ICASE);
+      }
+      fallback_regexes_.emplace_back(index, Regex(patterns[index], flags));
+    }
+  }
+
+  visited_.resize(nfa_.size(), 0);
+  ++visit_generation_;
+  for (auto start : unanchored_starts_) {
+    addClosure(start, restart_closure_);
+  }
+  std::sort(restart_closure_.begin(), restart_closure_.end());
+}
+
+void RegexSet::compilePattern(const std::string& pattern, size_t pattern_index, bool ignore_case) {
+  const size_t nfa_size = nfa_.size();
+  const size_t anchored_start_count = anchored_starts_.size();
+  const size_t unanchored_start_count = unanchored_starts_.size();
+  try {
+    std::vector<Parser::Alternative> alternatives;
+    if (mode_ == MatchMode::FULL && !ECMASCRIPT_SYNTAX) {
+      // regexMatch uses the pattern surrounded by anchors in this case
+      alternatives = Parser('^' + pattern + '$', ignore_case).parse();
+    } else {
+      alternatives = Parser(pattern, ignore_case).parse();
+      if (mode_ == MatchMode::FULL) {
+        for (auto& alternative : alternatives) {
+          alternative.anchored_begin = true;
+          alternative.anchored_end = true;
+        }
+      }
+    }
+    for (const auto& alternative : alternatives) {
+      const auto match = addState(NfaState{.kind = NfaState::Kind::MATCH, .pattern_index = pattern_index, .anchored_end = alternative.anchored_end});
+      const auto start = compileNode(alternative.sequence, match);
+      (alternative.anchored_begin ? anchored_starts_ : unanchored_starts_).push_back(start);
+    }
+  } catch (const UnsupportedPattern&) {
+    nfa_.resize(nfa_size);
+    anchored_starts_.resize(anchored_start_count);
+    unanchored_starts_.resize(unanchored_start_count);
+    throw;
+  }
+}
+
+int32_t RegexSet::compileNode(const Node& node, int32_t next) {
+  switch (node.type) {
+    case Node::Type::CHARACTERS:
+      return addState(NfaState{.kind = NfaState::Kind::CHARACTER, .characters = node.characters, .next = {next}});
+    case Node::Type::SEQUENCE:
+      for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+        next = compileNode(*it, next);
+      }
+      return next;
+    case Node::Type::ALTERNATION: {
+      NfaState split{.kind = NfaState::Kind::SPLIT};
+      for (const auto& child : node.children) {
+        split.next.push_back(compileNode(child, next));
+      }
+      return addState(std::move(split));
+    }
+    case Node::Type::REPETITION: {
+      const auto& child = node.children.front();
+      int32_t entry = next;
+      if (!node.max) {
+        const auto loop = addState(NfaState{.kind = NfaState::Kind::SPLIT});
+        const auto body = compileNode(child, loop);
+        nfa_[loop].next = {body, next};
+        entry = loop;
+      } else {
+        for (size_t optional_count = node.min; optional_count < *node.max; ++optional_count) {
+          const auto body = compileNode(child, entry);
+          entry = addState(NfaState{.kind = NfaState::Kind::SPLIT, .next = {body, next}});
+        }
+      }
+      for (size_t required_count = 0; required_count < node.min; ++required_count) {
+        entry = compileNode(child, entry);
+      }
+      return entry;
+    }
+  }
+  throw UnsupportedPattern{};
+}
+
+int32_t RegexSet::addState(NfaState state) {
+  if (nfa_.size() >= MAX_NFA_STATES) {
+    throw UnsupportedPattern{};
+  }
+  nfa_.push_back(std::move(state));
+  return static_cast<int32_t>(nfa_.size() - 1);
+}
+
+void RegexSet::addClosure(int32_t nfa_state, std::vector<int32_t>& states) {
+  closure_stack_.push_back(nfa_state);
+  while (!closure_stack_.empty()) {
+    const auto current = closure_stack_.back();
+    closure_stack_.pop_back();
+    if (visited_[current] == visit_generation_) {
+      continue;
+    }
+    visited_[current] = visit_generation_;
+    const auto& state = nfa_[current];
+    if (state.kind == NfaState::Kind::SPLIT) {
+      closure_stack_.insert(closure_stack_.end(), state.next.begin(), state.next.end());
+    } else {
+      states.push_back(current);
+    }
+  }
+}
+
+int32_t RegexSet::getDfaState(std::vector<int32_t> nfa_states) {
+  const auto [it, inserted] = dfa_index_.try_emplace(nfa_states, static_cast<int32_t>(dfa_.size()));
+  if (!inserted) {
+    return it->second;
+  }
+  DfaState state;
+  state.next.fill(-1);
+  state.dead = true;
+  for (auto nfa_state : nfa_states) {
+    const auto& nfa_state_ref = nfa_[nfa_state];
+    if (nfa_state_ref.kind == NfaState::Kind::MATCH) {
+      (nfa_state_ref.anchored_end ? state.accepts_at_end : state.accepts_anywhere).push_back(nfa_state_ref.pattern_index);
+    } else {
+      state.dead = false;
+    }
+  }
+  state.nfa_states = std::move(nfa_states);
+  dfa_.push_back(std::move(state));
+  return it->second;
+}
+
+int32_t RegexSet::computeTransition(int32_t dfa_state, unsigned char ch) {
+  std::vector<int32_t> nfa_states;
+  ++visit_generation_;
+  for (auto nfa_state : dfa_[dfa_state].nfa_states) {
+    const auto& state = nfa_[nfa_state];
+    if (state.kind == NfaState::Kind::CHARACTER && state.characters[ch]) {
+      addClosure(state.next.front(), nfa_states);
+    }
+  }
+  // the unanchored patterns can start matching at any position
+  for (auto nfa_state : restart_closure_) {
+    if (visited_[nfa_state] != visit_generation_) {
+      visited_[nfa_state] = visit_generation_;
+      nfa_states.push_back(nfa_state);
+    }
+  }
+  std::sort(nfa_states.begin(), nfa_states.end());
+
+  if (dfa_.size() >= MAX_DFA_STATES && !dfa_index_.contains(nfa_states)) {
+    // start over instead of growing without bounds, the states are computed again when they are needed
+    dfa_.clear();
+    dfa_index_.clear();
+    initial_dfa_state_ = -1;
+    return getDfaState(std::move(nfa_states));
+  }
+  const auto next = getDfaState(std::move(nfa_states));
+  dfa_[dfa_state].next[ch] = next;
+  return next;
+}
+
+void RegexSet::accept(const std::vector<size_t>& pattern_indices, size_t& match_count) {
+  for (auto pattern_index : pattern_indices) {
+    if (!matches_[pattern_index]) {
+      matches_[pattern_index] = true;
+      ++match_count;
+    }
+  }
+}
+
+const std::vector<bool>& RegexSet::match(std::string_view input) {
+#ifndef NO_MORE_REGFREEE
+  // regexec stops at the first null character
+  input = input.substr(0, input.find('\0'));
+#endif
+  std::fill(matches_.begin(), matches_.end(), false);
+
+  if (automaton_pattern_count_ > 0) {
+    if (initial_dfa_state_ < 0) {
+      std::vector<int32_t> nfa_states;
+      ++visit_generation_;
+      for (auto start : anchored_starts_) {
+        addClosure(start, nfa_states);
+      }
+      for (auto start : unanchored_starts_) {
+        addClosure(start, nfa_states);
+      }
+      std::sort(nfa_states.begin(), nfa_states.end());
+      initial_dfa_state_ = getDfaState(std::move(nfa_states));
+    }
+
+    size_t match_count = 0;
+    int32_t current = initial_dfa_state_;
+    accept(dfa_[current].accepts_anywhere, match_count);
+    size_t position = 0;
+    for (; position < input.size() && match_count < automaton_pattern_count_ && !dfa_[current].dead; ++position) {
+      const auto ch = static_cast<unsigned char>(input[position]);
+      const auto next = dfa_[current].next[ch];
+      current = next >= 0 ? next : computeTransition(current, ch);
+      accept(dfa_[current].accepts_anywhere, match_count);
+    }
+    if (position == input.size()) {
+      accept(dfa_[current].accepts_at_end, match_count);
+    }
+  }
+
+  for (const auto& [index, regex] : fallback_regexes_) {
+    matches_[index] = mode_ == MatchMode::FULL ? regexMatch(input, regex) : regexSearch(input, regex);
+  }
+  return matches_;
+}
+
+bool RegexSet::isAutomatonBacked(size_t index) const {
+  return automaton_backed_.at(index);
+}
+
+}  // namespace org::apache::nifi::minifi::utils
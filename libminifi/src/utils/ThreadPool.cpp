@@ -36,59 +36,80 @@ ThreadPool<T>::ThreadPool(int max_worker_threads, bool daemon_threads, core::con
   thread_manager_ = nullptr;
 }
 
+template<typename T>
+bool ThreadPool<T>::shouldRetire(const std::shared_ptr<WorkerThread>& thread) {
+  if (UNLIKELY(thread_reduction_count_ > 0)) {
+    if (--thread_reduction_count_ >= 0) {
+      deceased_thread_queue_.enqueue(thread);
+      thread->is_running_ = false;
+      return true;
+    } else {
+      thread_reduction_count_++;
+    }
+  }
+  return false;
+}
+
+template<typename T>
+bool ThreadPool<T>::tryStartRun(const Worker<T>& task) {
+  auto& state = *task.run_state_;
+  // the count is raised before checking the flag, so either stopTasks waits for this run, or the run sees that the task was stopped
+  ++state.running_count;
+  if (!state.enabled) {
+    finishRun(task);
+    return false;
+  }
+  return true;
+}
+
+template<typename T>
+void ThreadPool<T>::finishRun(const Worker<T>& task) {
+  auto& state = *task.run_state_;
+  if (--state.running_count == 0 && !state.enabled) {
+    std::lock_guard<std::mutex> lock(task_run_complete_mutex_);
+    task_run_complete_.notify_all();
+  }
+}
+
+template<typename T>
+void ThreadPool<T>::scheduleDelayed(Worker<T>&& task) {
+  std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
+  const auto next_execution_time = task.getNextExecutionTime();
+  auto identifier = task.getIdentifier();
+  delayed_tasks_.schedule(next_execution_time, std::move(identifier), std::move(task));
+  if (next_execution_time < delayed_scheduler_wake_up_) {
+    delayed_scheduler_wake_up_ = next_execution_time;
+    delayed_task_available_.notify_one();
+  }
+}
+
 template<typename T>
 void ThreadPool<T>::run_tasks(const std::shared_ptr<WorkerThread>& thread) {
   thread->is_running_ = true;
   while (running_.load()) {
-    if (UNLIKELY(thread_reduction_count_ > 0)) {
-      if (--thread_reduction_count_ >= 0) {
-        deceased_thread_queue_.enqueue(thread);
-        thread->is_running_ = false;
-        break;
-      } else {
-        thread_reduction_count_++;
-      }
+    if (shouldRetire(thread)) {
+      break;
     }
 
     Worker<T> task;
     if (worker_queue_.dequeueWait(task)) {
-      {
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        if (!task_status_[task.getIdentifier()]) {
-          continue;
-        } else if (!worker_queue_.isRunning()) {
-          worker_queue_.enqueue(std::move(task));
-          continue;
-        }
-        ++running_task_count_by_id_[task.getIdentifier()];
+      if (!worker_queue_.isRunning()) {
+        worker_queue_.enqueue(std::move(task));
+        continue;
       }
-      const bool taskRunResult = task.run();
-      {
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        auto& count = running_task_count_by_id_[task.getIdentifier()];
-        if (count == 1) {
-          running_task_count_by_id_.erase(task.getIdentifier());
-        } else {
-          --count;
-        }
+      if (!tryStartRun(task)) {
+        continue;
       }
-      task_run_complete_.notify_all();
-      if (taskRunResult) {
+      const bool taskRunResult = task.run();
+      finishRun(task);
+      if (taskRunResult && task.run_state_->enabled) {
         if (task.getNextExecutionTime() <= std::chrono::steady_clock::now()) {
           // it can be rescheduled again as soon as there is a worker available
           worker_queue_.enqueue(std::move(task));
           continue;
         }
         // Task will be put to the delayed queue as next exec time is in the future
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        bool need_to_notify =
-            delayed_worker_queue_.empty() ||
-                task.getNextExecutionTime() < delayed_worker_queue_.top().getNextExecutionTime();
-
-        delayed_worker_queue_.push(std::move(task));
-        if (need_to_notify) {
-          delayed_task_available_.notify_all();
-        }
+        scheduleDelayed(std::move(task));
       }
     } else {
       // The threadpool is running, but the ConcurrentQueue is stopped -> shouldn't happen during normal conditions
@@ -101,23 +122,119 @@ void ThreadPool<T>::run_tasks(const std::shared_ptr<WorkerThread>& thread) {
   current_workers_--;
 }
 
+template<typename T>
+void ThreadPool<T>::run_tasks_work_stealing(const std::shared_ptr<WorkerThread>& thread, size_t home_queue_index) {
+  thread->is_running_ = true;
+  auto& home_queue = *worker_queues_[home_queue_index];
+  uint32_t take_count = 0;
+  while (running_.load()) {
+    if (shouldRetire(thread)) {
+      // the tasks this worker rescheduled to its own queue are handed over, as the idle workers might not be woken up for them
+      size_t handed_over_count = 0;
+      Worker<T> queued_task;
+      while (home_queue.tryDequeue(queued_task)) {
+        worker_queue_.enqueue(std::move(queued_task));
+        ++handed_over_count;
+      }
+      if (handed_over_count > 0) {
+        wakeIdleWorkers(handed_over_count);
+      }
+      break;
+    }
+
+    Worker<T> task;
+    if (!worker_queue_.isRunning() || !takeTask(home_queue_index, task, take_count)) {
+      waitForTask();
+      continue;
+    }
+    if (!tryStartRun(task)) {
+      continue;
+    }
+    const bool taskRunResult = task.run();
+    finishRun(task);
+    if (taskRunResult && task.run_state_->enabled) {
+      if (task.getNextExecutionTime() <= std::chrono::steady_clock::now()) {
+        // keep the task on this worker, the idle ones only need to be woken up if there is more work than this worker can take
+        home_queue.enqueue(std::move(task));
+        if (home_queue.size() > 1) {
+          wakeIdleWorkers(1);
+        }
+        continue;
+      }
+      scheduleDelayed(std::move(task));
+    }
+  }
+  current_workers_--;
+}
+
+template<typename T>
+bool ThreadPool<T>::takeTask(size_t home_queue_index, Worker<T>& task, uint32_t& take_count) {
+  // check the shared queue first every now and then, so that the new tasks are not starved by the rescheduled ones
+  if (++take_count % 16 == 0 && worker_queue_.tryDequeue(task)) {
+    return true;
+  }
+  if (worker_queues_[home_queue_index]->tryDequeue(task) || worker_queue_.tryDequeue(task)) {
+    return true;
+  }
+  for (size_t offset = 1; offset < worker_queues_.size(); ++offset) {
+    if (worker_queues_[(home_queue_index + offset) % worker_queues_.size()]->tryDequeue(task)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template<typename T>
+bool ThreadPool<T>::hasQueuedTask() const {
+  return !worker_queue_.empty() || std::any_of(worker_queues_.begin(), worker_queues_.end(), [](const auto& queue) { return !queue->empty(); });
+}
+
+template<typename T>
+void ThreadPool<T>::waitForTask() {
+  std::unique_lock<std::mutex> lock(idle_mutex_);
+  // the counter is raised before checking the queues, so the producers either see it or their task is found here
+  ++idle_workers_;
+  work_available_.wait(lock, [this] { return !running_ || (worker_queue_.isRunning() && hasQueuedTask()); });
+  --idle_workers_;
+}
+
+template<typename T>
+void ThreadPool<T>::wakeIdleWorkers(size_t count) {
+  if (idle_workers_ > 0) {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    for (size_t i = 0; i < count; ++i) {
+      work_available_.notify_one();
+    }
+  }
+}
+
 template<typename T>
 void ThreadPool<T>::manage_delayed_queue() {
+  std::vector<Worker<T>> ready_tasks;
   while (running_) {
-    std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-
-    // Put the tasks ready to run in the worker queue
-    while (!delayed_worker_queue_.empty() && delayed_worker_queue_.top().getNextExecutionTime() <= std::chrono::steady_clock::now()) {
-      // I'm very sorry for this - committee must has been seriously drunk when the interface of prio queue was submitted.
-      Worker<T> task = std::move(const_cast<Worker<T>&>(delayed_worker_queue_.top()));
-      delayed_worker_queue_.pop();
-      worker_queue_.enqueue(std::move(task));
+    {
+      std::unique_lock<std::mutex> lock(delayed_tasks_mutex_);
+      delayed_tasks_.advance(std::chrono::steady_clock::now(), [&ready_tasks](Worker<T>&& task) { ready_tasks.push_back(std::move(task)); });
+      if (ready_tasks.empty()) {
+        if (!running_) {
+          break;
+        }
+        const auto wake_up = delayed_tasks_.nextWakeUp();
+        delayed_scheduler_wake_up_ = wake_up.value_or(std::chrono::steady_clock::time_point::max());
+        if (wake_up) {
+          delayed_task_available_.wait_until(lock, *wake_up);
+        } else {
+          delayed_task_available_.wait(lock);
+        }
+        continue;
+      }
     }
-    if (delayed_worker_queue_.empty()) {
-      delayed_task_available_.wait(lock);
-    } else {
-      auto wait_time = delayed_worker_queue_.top().getNextExecutionTime() - std::chrono::steady_clock::now();
-      delayed_task_available_.wait_for(lock, std::max(wait_time, std::chrono::steady_clock::duration(1ms)));
+    // hand over the ready tasks to the workers in one batch, without holding up the ones scheduling new delayed tasks
+    const size_t ready_task_count = ready_tasks.size();
+    worker_queue_.enqueueAll(ready_tasks);
+    ready_tasks.clear();
+    if (work_stealing_) {
+      wakeIdleWorkers(ready_task_count);
     }
   }
 }
@@ -126,10 +243,27 @@ template<typename T>
 void ThreadPool<T>::execute(Worker<T> &&task, std::future<T> &future) {
   {
     std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-    task_status_[task.getIdentifier()] = true;
+    auto& state = task_states_[task.getIdentifier()];
+    if (!state || !state->enabled) {
+      state = std::make_shared<TaskRunState>();
+    }
+    task.run_state_ = state;
   }
   future = std::move(task.getPromise()->get_future());
   worker_queue_.enqueue(std::move(task));
+  if (work_stealing_) {
+    wakeIdleWorkers(1);
+  }
+}
+
+template<typename T>
+std::thread ThreadPool<T>::createWorkerThread(const std::shared_ptr<WorkerThread>& worker_thread) {
+  if (work_stealing_) {
+    // threads started later by the thread manager might share their home queue with another one, which only affects locality
+    const size_t home_queue_index = next_home_queue_index_++ % worker_queues_.size();
+    return createThread([this, worker_thread, home_queue_index] { run_tasks_work_stealing(worker_thread, home_queue_index); });
+  }
+  return createThread([this, worker_thread] { run_tasks(worker_thread); });
 }
 
 template<typename T>
@@ -138,7 +272,7 @@ void ThreadPool<T>::manageWorkers() {
     std::stringstream thread_name;
     thread_name << name_ << " #" << i;
     auto worker_thread = std::make_shared<WorkerThread>(thread_name.str());
-    worker_thread->thread_ = createThread([this, worker_thread] { run_tasks(worker_thread); });
+    worker_thread->thread_ = createWorkerThread(worker_thread);
     thread_queue_.push_back(worker_thread);
     current_workers_++;
   }
@@ -170,7 +304,7 @@ void ThreadPool<T>::manageWorkers() {
         } else if (thread_manager_->canIncrease() && max_worker_threads_ > current_workers_) {  // increase slowly
           std::unique_lock<std::mutex> worker_queue_lock(worker_queue_mutex_);
           auto worker_thread = std::make_shared<WorkerThread>();
-          worker_thread->thread_ = createThread([this, worker_thread] { run_tasks(worker_thread); });
+          worker_thread->thread_ = createWorkerThread(worker_thread);
           if (daemon_threads_) {
             worker_thread->thread_.detach();
           }
@@ -219,6 +353,17 @@ void ThreadPool<T>::start() {
   if (!running_) {
     thread_manager_ = createThreadManager();
 
+    {
+      std::lock_guard<std::mutex> queue_lock(worker_queue_mutex_);
+      worker_queues_.clear();
+      if (work_stealing_) {
+        for (int i = 0; i < std::max(max_worker_threads_, 1); ++i) {
+          worker_queues_.push_back(std::make_unique<ConcurrentQueue<Worker<T>>>());
+        }
+      }
+      next_home_queue_index_ = 0;
+    }
+
     running_ = true;
     worker_queue_.start();
     manager_thread_ = std::thread(&ThreadPool::manageWorkers, this);
@@ -231,33 +376,40 @@ void ThreadPool<T>::start() {
 template<typename T>
 void ThreadPool<T>::stopTasks(const TaskId &identifier) {
   std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-  task_status_[identifier] = false;
-
-  // remove tasks belonging to identifier from worker_queue_
-  worker_queue_.remove([&] (const Worker<T>& worker) { return worker.getIdentifier() == identifier; });
-
-  // also remove from delayed_worker_queue_
-  decltype(delayed_worker_queue_) new_delayed_worker_queue;
-  while (!delayed_worker_queue_.empty()) {
-    Worker<T> task = std::move(const_cast<Worker<T>&>(delayed_worker_queue_.top()));
-    delayed_worker_queue_.pop();
-    if (task.getIdentifier() != identifier) {
-      new_delayed_worker_queue.push(std::move(task));
-    }
+  std::shared_ptr<TaskRunState> state;
+  if (auto it = task_states_.find(identifier); it != task_states_.end()) {
+    state = it->second;
+    state->enabled = false;
+    task_states_.erase(it);
+  }
+
+  // remove tasks belonging to identifier from worker_queue_ and the per-worker queues
+  const auto belongs_to_task = [&] (const Worker<T>& worker) { return worker.getIdentifier() == identifier; };
+  worker_queue_.remove(belongs_to_task);
+  for (auto& queue : worker_queues_) {
+    queue->remove(belongs_to_task);
+  }
+
+  // also remove from the delayed tasks
+  {
+    std::lock_guard<std::mutex> delayed_lock(delayed_tasks_mutex_);
+    delayed_tasks_.cancel(identifier);
   }
-  delayed_worker_queue_ = std::move(new_delayed_worker_queue);
+  lock.unlock();
 
-  // if tasks are in progress, wait for their completion
-  task_run_complete_.wait(lock, [&] () {
-    auto iter = running_task_count_by_id_.find(identifier);
-    return iter == running_task_count_by_id_.end() || iter->second == 0;
-  });
+  // if tasks are in progress, wait for their completion, instances rescheduled in the meantime won't be run anymore
+  if (state) {
+    std::unique_lock<std::mutex> run_complete_lock(task_run_complete_mutex_);
+    task_run_complete_.wait(run_complete_lock, [&] { return state->running_count == 0; });
+  }
 }
 
 template<typename T>
 void ThreadPool<T>::resume() {
   if (!worker_queue_.isRunning()) {
     worker_queue_.start();
+    std::lock_guard<std::mutex> idle_lock(idle_mutex_);
+    work_available_.notify_all();
   }
 }
 
@@ -276,7 +428,13 @@ void ThreadPool<T>::shutdown() {
 
     drain();
 
-    task_status_.clear();
+    {
+      std::lock_guard<std::mutex> worker_lock(worker_queue_mutex_);
+      for (auto& [identifier, state] : task_states_) {
+        state->enabled = false;
+      }
+      task_states_.clear();
+    }
     if (manager_thread_.joinable()) {
       manager_thread_.join();
     }
@@ -285,7 +443,7 @@ void ThreadPool<T>::shutdown() {
       // this lock ensures that the delayed_scheduler_thread_
       // is not between checking the running_ and before the cv_.wait*
       // as then, it would survive the notify_all call
-      std::lock_guard<std::mutex> worker_lock(worker_queue_mutex_);
+      std::lock_guard<std::mutex> delayed_lock(delayed_tasks_mutex_);
       delayed_task_available_.notify_all();
     }
     if (delayed_scheduler_thread_.joinable()) {
@@ -299,11 +457,16 @@ void ThreadPool<T>::shutdown() {
 
     thread_queue_.clear();
     current_workers_ = 0;
-    while (!delayed_worker_queue_.empty()) {
-      delayed_worker_queue_.pop();
+    {
+      std::lock_guard<std::mutex> delayed_lock(delayed_tasks_mutex_);
+      delayed_tasks_.clear();
+      delayed_scheduler_wake_up_ = std::chrono::steady_clock::time_point::max();
     }
 
     worker_queue_.clear();
+    for (auto& queue : worker_queues_) {
+      queue->clear();
+    }
   }
 }
 
@@ -45,6 +45,11 @@ class SingleProcessorTestController : public TestController {
       : processor_{plan->addProcessor(processor, processor->getName())}
   {}
 
+  SingleProcessorTestController(const std::shared_ptr<core::Processor>& processor, std::shared_ptr<core::ContentRepository> content_repo)
+      : plan{createPlan(PlanConfig{.content_repo = std::move(content_repo)})},
+        processor_{plan->addProcessor(processor, processor->getName())}
+  {}
+
   auto trigger() {
     plan->runProcessor(processor_);
     std::unordered_map<core::Relationship, std::vector<std::shared_ptr<core::FlowFile>>> result;
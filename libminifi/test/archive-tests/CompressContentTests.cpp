@@ -44,6 +44,7 @@
 #include "processors/PutFile.h"
 #include "utils/file/FileUtils.h"
 #include "../Utils.h"
+#include "../SingleProcessorTestController.h"
 #include "utils/gsl.h"
 
 class ReadCallback {
@@ -619,6 +620,56 @@ TEST_CASE_METHOD(TestController, "RawGzipCompressionDecompression", "[compressfi
   LogTestController::getInstance().reset();
 }
 
+TEST_CASE("Raw zstd and LZ4 compression and decompression", "[compressfiletest10]") {
+  const auto [format, magic_number, extension] = GENERATE(
+      std::make_tuple(std::string{"zstd"}, std::string{"\x28\xB5\x2F\xFD"}, std::string{".zst"}),
+      std::make_tuple(std::string{"lz4"}, std::string{"\x04\x22\x4D\x18"}, std::string{".lz4"}));
+  const std::string content = utils::StringUtils::repeat("Repeated repeated repeated repeated repeated stuff.", 10000);
+
+  auto compress_content = std::make_shared<minifi::processors::CompressContent>("CompressContent");
+  minifi::test::SingleProcessorTestController compress_controller{compress_content};
+  compress_content->setProperty(minifi::processors::CompressContent::CompressMode, toString(CompressionMode::Compress));
+  compress_content->setProperty(minifi::processors::CompressContent::CompressFormat, format);
+  compress_content->setProperty(minifi::processors::CompressContent::UpdateFileName, "true");
+  compress_content->setProperty(minifi::processors::CompressContent::EncapsulateInTar, "false");
+  compress_content->setProperty(minifi::processors::CompressContent::ZstdWorkerCount, "2");
+  compress_content->setProperty(minifi::processors::CompressContent::ZstdLongDistanceMatching, "true");
+
+  auto compressed = compress_controller.trigger(content, {{core::SpecialFlowAttribute::FILENAME, "src.txt"}});
+  REQUIRE(compressed.at(minifi::processors::CompressContent::Success).size() == 1);
+  const auto compressed_flow_file = compressed.at(minifi::processors::CompressContent::Success)[0];
+  const auto compressed_content = compress_controller.plan->getContent(compressed_flow_file);
+  CHECK(compressed_content.size() < content.size());
+  CHECK(compressed_content.starts_with(magic_number));
+  CHECK(compressed_flow_file->getAttribute(core::SpecialFlowAttribute::FILENAME) == "src.txt" + extension);
+
+  auto decompress_content = std::make_shared<minifi::processors::CompressContent>("DecompressContent");
+  minifi::test::SingleProcessorTestController decompress_controller{decompress_content};
+  decompress_content->setProperty(minifi::processors::CompressContent::CompressMode, toString(CompressionMode::Decompress));
+  decompress_content->setProperty(minifi::processors::CompressContent::CompressFormat, toString(CompressionFormat::USE_MIME_TYPE));
+  decompress_content->setProperty(minifi::processors::CompressContent::UpdateFileName, "true");
+  decompress_content->setProperty(minifi::processors::CompressContent::EncapsulateInTar, "false");
+
+  auto decompressed = decompress_controller.trigger(compressed_content, {
+      {core::SpecialFlowAttribute::FILENAME, *compressed_flow_file->getAttribute(core::SpecialFlowAttribute::FILENAME)},
+      {core::SpecialFlowAttribute::MIME_TYPE, *compressed_flow_file->getAttribute(core::SpecialFlowAttribute::MIME_TYPE)}});
+  REQUIRE(decompressed.at(minifi::processors::CompressContent::Success).size() == 1);
+  const auto decompressed_flow_file = decompressed.at(minifi::processors::CompressContent::Success)[0];
+  CHECK(decompress_controller.plan->getContent(decompressed_flow_file) == content);
+  CHECK(decompressed_flow_file->getAttribute(core::SpecialFlowAttribute::FILENAME) == "src.txt");
+}
+
+TEST_CASE("TAR encapsulation is not supported with zstd compression", "[compressfiletest11]") {
+  auto compress_content = std::make_shared<minifi::processors::CompressContent>("CompressContent");
+  minifi::test::SingleProcessorTestController controller{compress_content};
+  compress_content->setProperty(minifi::processors::CompressContent::CompressFormat, toString(CompressionFormat::ZSTD));
+  compress_content->setProperty(minifi::processors::CompressContent::EncapsulateInTar, "true");
+
+  auto result = controller.trigger("content");
+  CHECK(result.at(minifi::processors::CompressContent::Failure).size() == 1);
+  CHECK(result.at(minifi::processors::CompressContent::Success).empty());
+}
+
 TEST_CASE_METHOD(CompressTestController, "Batch CompressFileGZip", "[compressFileBatchTest]") {
   std::vector<std::string> flowFileContents{
     utils::StringUtils::repeat("0", 1000), utils::StringUtils::repeat("1", 1000),
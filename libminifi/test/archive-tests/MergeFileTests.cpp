@@ -153,7 +153,7 @@ class MergeTestController : public TestController {
     LogTestController::getInstance().setTrace<minifi::Connection>();
     LogTestController::getInstance().setTrace<minifi::core::Connectable>();
 
-    std::shared_ptr<TestRepository> repo = std::make_shared<TestRepository>();
+    repo_ = std::make_shared<TestRepository>();
     auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
     content_repo->initialize(std::make_shared<minifi::Configure>());
 
@@ -166,7 +166,7 @@ class MergeTestController : public TestController {
     REQUIRE(logAttributeuuid);
 
     // output from merge processor to log attribute
-    output_ = std::make_unique<minifi::Connection>(repo, content_repo, "logattributeconnection");
+    output_ = std::make_unique<minifi::Connection>(repo_, content_repo, "logattributeconnection");
     output_->addRelationship(minifi::processors::MergeContent::Merge);
     output_->setSource(merge_content_processor_.get());
     output_->setDestination(log_attribute_processor_.get());
@@ -174,7 +174,7 @@ class MergeTestController : public TestController {
     output_->setDestinationUUID(logAttributeuuid);
     merge_content_processor_->addConnection(output_.get());
     // input to merge processor
-    input_ = std::make_unique<minifi::Connection>(repo, content_repo, "mergeinput");
+    input_ = std::make_unique<minifi::Connection>(repo_, content_repo, "mergeinput");
     input_->setDestination(merge_content_processor_.get());
     input_->setDestinationUUID(processoruuid);
     merge_content_processor_->addConnection(input_.get());
@@ -186,7 +186,7 @@ class MergeTestController : public TestController {
     log_attribute_processor_->incrementActiveTasks();
     log_attribute_processor_->setScheduledState(core::ScheduledState::RUNNING);
 
-    context_ = std::make_shared<core::ProcessContext>(std::make_shared<core::ProcessorNode>(merge_content_processor_.get()), nullptr, repo, repo, content_repo);
+    context_ = std::make_shared<core::ProcessContext>(std::make_shared<core::ProcessorNode>(merge_content_processor_.get()), nullptr, repo_, repo_, content_repo);
 
     for (size_t i = 0; i < 6; ++i) {
       flowFileContents_[i] = utils::StringUtils::repeat(std::to_string(i), 32);
@@ -198,6 +198,7 @@ class MergeTestController : public TestController {
   }
 
   std::string flowFileContents_[6];
+  std::shared_ptr<TestRepository> repo_;
   std::shared_ptr<core::ProcessContext> context_;
   std::unique_ptr<core::Processor> merge_content_processor_;
   std::unique_ptr<core::Processor> log_attribute_processor_;
@@ -825,6 +826,84 @@ TEST_CASE_METHOD(MergeTestController, "Batch Size", "[testMergeFileBatchSize]")
   }
 }
 
+TEST_CASE_METHOD(MergeTestController, "Binned flow files are only persisted in Repository bin staging mode", "[testMergeFileBinStaging]") {
+  context_->setProperty(minifi::processors::MergeContent::MergeFormat, minifi::processors::merge_content_options::MERGE_FORMAT_CONCAT_VALUE);
+  context_->setProperty(minifi::processors::MergeContent::MergeStrategy, minifi::processors::merge_content_options::MERGE_STRATEGY_BIN_PACK);
+  context_->setProperty(minifi::processors::BinFiles::BatchSize, "10");
+  context_->setProperty(minifi::processors::BinFiles::MinEntries, "3");
+  context_->setProperty(minifi::processors::BinFiles::MaxEntries, "3");
+
+  bool binned_flow_files_persisted = false;
+  SECTION("Repository") {
+    context_->setProperty(minifi::processors::BinFiles::BinStaging, "Repository");
+    binned_flow_files_persisted = true;
+  }
+  SECTION("In Memory") {
+    context_->setProperty(minifi::processors::BinFiles::BinStaging, "In Memory");
+  }
+
+  // the incoming flow files are committed by an upstream processor, which persists their records in the flow file repository
+  auto upstream_processor = std::make_unique<minifi::processors::LogAttribute>("upstream");
+  input_->setSource(upstream_processor.get());
+  input_->setSourceUUID(upstream_processor->getUUID());
+  input_->addRelationship(minifi::processors::LogAttribute::Success);
+  upstream_processor->addConnection(input_.get());
+  auto upstream_context = std::make_shared<core::ProcessContext>(std::make_shared<core::ProcessorNode>(upstream_processor.get()), nullptr, repo_, repo_,
+      context_->getContentRepository());
+
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  const auto enqueue_flow_file = [&](const std::string& content) {
+    core::ProcessSession upstream_session(upstream_context);
+    const auto flow = upstream_session.create();
+    upstream_session.writeBuffer(flow, content);
+    upstream_session.transfer(flow, minifi::processors::LogAttribute::Success);
+    upstream_session.commit();
+    flow_files.push_back(flow);
+  };
+  const auto trigger = [&] {
+    auto session = std::make_shared<core::ProcessSession>(context_);
+    merge_content_processor_->onTrigger(context_, session);
+    session->commit();
+  };
+
+  auto factory = std::make_shared<core::ProcessSessionFactory>(context_);
+  merge_content_processor_->onSchedule(context_, factory);
+
+  enqueue_flow_file(flowFileContents_[0]);
+  enqueue_flow_file(flowFileContents_[1]);
+  const auto records_before_binning = repo_->getRepoMap();
+  for (const auto& flow : flow_files) {
+    REQUIRE(records_before_binning.contains(flow->getUUIDStr()));
+  }
+
+  trigger();
+  const auto records_while_binned = repo_->getRepoMap();
+  for (const auto& flow : flow_files) {
+    REQUIRE(records_while_binned.contains(flow->getUUIDStr()));
+    if (binned_flow_files_persisted) {
+      // the record is rewritten as owned by MergeContent
+      CHECK(records_while_binned.at(flow->getUUIDStr()) != records_before_binning.at(flow->getUUIDStr()));
+    } else {
+      CHECK(records_while_binned.at(flow->getUUIDStr()) == records_before_binning.at(flow->getUUIDStr()));
+    }
+  }
+  std::set<std::shared_ptr<core::FlowFile>> expiredFlowRecords;
+  REQUIRE_FALSE(output_->poll(expiredFlowRecords));
+
+  enqueue_flow_file(flowFileContents_[2]);
+  trigger();
+  const auto merged = output_->poll(expiredFlowRecords);
+  REQUIRE(merged);
+  core::ProcessSession session(context_);
+  FixedBuffer callback(gsl::narrow<size_t>(merged->getSize()));
+  session.read(merged, std::ref(callback));
+  CHECK(callback.to_string() == flowFileContents_[0] + flowFileContents_[1] + flowFileContents_[2]);
+  const auto records_after_merge = repo_->getRepoMap();
+  for (const auto& flow : flow_files) {
+    CHECK_FALSE(records_after_merge.contains(flow->getUUIDStr()));
+  }
+}
+
 TEST_CASE_METHOD(MergeTestController, "Maximum Group Size is respected", "[testMergeFileMaximumGroupSize]") {
   // each flowfile content is 32 bytes
   for (auto& ff : flowFileContents_) {
@@ -0,0 +1,162 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "Connection.h"
+#include "Funnel.h"
+#include "SwapManager.h"
+#include "core/FlowFile.h"
+#include "core/ProcessContext.h"
+#include "core/ProcessSession.h"
+#include "core/ProcessorNode.h"
+#include "core/repository/VolatileProvenanceRepository.h"
+#include "utils/Id.h"
+
+namespace org::apache::nifi::minifi::benchmarks {
+
+/**
+ * Keeps the swapped out flow files in memory, so that swapping only costs the bookkeeping of the queue.
+ */
+class InMemorySwapManager : public SwapManager {
+ public:
+  void store(std::vector<std::shared_ptr<core::FlowFile>> flow_files) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& flow_file : flow_files) {
+      auto id = flow_file->getUUID();
+      swapped_.emplace(id, std::move(flow_file));
+    }
+  }
+
+  std::future<std::vector<std::shared_ptr<core::FlowFile>>> load(std::vector<SwappedFlowFile> flow_files) override {
+    std::vector<std::shared_ptr<core::FlowFile>> result;
+    result.reserve(flow_files.size());
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& swapped : flow_files) {
+        if (auto node = swapped_.extract(swapped.id)) {
+          result.push_back(std::move(node.mapped()));
+        }
+      }
+    }
+    std::promise<std::vector<std::shared_ptr<core::FlowFile>>> promise;
+    promise.set_value(std::move(result));
+    return promise.get_future();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<utils::Identifier, std::shared_ptr<core::FlowFile>> swapped_;
+};
+
+/**
+ * A funnel feeding back into itself, so that each session cycle transfers flow files through a real connection.
+ */
+class SessionBenchmarkFlow {
+ public:
+  SessionBenchmarkFlow(std::shared_ptr<core::Repository> flow_repo, std::shared_ptr<core::ContentRepository> content_repo)
+      : funnel_(std::make_unique<Funnel>("benchmark-funnel")),
+        connection_(std::make_unique<Connection>(flow_repo, content_repo, "benchmark-loop")) {
+    funnel_->initialize();
+    connection_->addRelationship(Funnel::Success);
+    connection_->setSourceUUID(funnel_->getUUID());
+    connection_->setDestinationUUID(funnel_->getUUID());
+    funnel_->addConnection(connection_.get());
+    auto provenance_repo = std::make_shared<core::repository::VolatileProvenanceRepository>();
+    context_ = std::make_shared<core::ProcessContext>(std::make_shared<core::ProcessorNode>(funnel_.get()), nullptr, provenance_repo, std::move(flow_repo), std::move(content_repo));
+  }
+
+  /**
+   * Creates, writes and commits batch_size flow files in one session, then consumes and commits them in another one.
+   */
+  void runCycle(size_t batch_size, std::span<const std::byte> content) {
+    {
+      core::ProcessSession producer(context_);
+      for (size_t i = 0; i < batch_size; ++i) {
+        auto flow_file = producer.create();
+        producer.writeBuffer(flow_file, content);
+        producer.transfer(flow_file, Funnel::Success);
+      }
+      producer.commit();
+    }
+    {
+      core::ProcessSession consumer(context_);
+      for (size_t i = 0; i < batch_size; ++i) {
+        auto flow_file = consumer.get();
+        benchmark::DoNotOptimize(flow_file);
+        consumer.remove(flow_file);
+      }
+      consumer.commit();
+    }
+  }
+
+ private:
+  std::unique_ptr<Funnel> funnel_;
+  std::unique_ptr<Connection> connection_;
+  std::shared_ptr<core::ProcessContext> context_;
+};
+
+/**
+ * Runs the create/commit/get/remove cycle of SessionBenchmarkFlow, with Args({content size, batch size}).
+ */
+inline void runSessionBenchmark(benchmark::State& state, SessionBenchmarkFlow& flow) {
+  const auto content_size = static_cast<size_t>(state.range(0));
+  const auto batch_size = static_cast<size_t>(state.range(1));
+  const std::vector<std::byte> content(content_size, std::byte{'x'});
+  for (auto _ : state) {
+    flow.runCycle(batch_size, content);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch_size));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(batch_size * content_size));
+}
+
+class TemporaryDirectory {
+ public:
+  TemporaryDirectory()
+      : path_(std::filesystem::temp_directory_path() / ("minifi-benchmark-" + utils::IdGenerator::getIdGenerator()->generate().to_string())) {
+    std::filesystem::create_directories(path_);
+  }
+
+  TemporaryDirectory(const TemporaryDirectory&) = delete;
+  TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+  ~TemporaryDirectory() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+  }
+
+  const std::filesystem::path& path() const {
+    return path_;
+  }
+
+ private:
+  std::filesystem::path path_;
+};
+
+}  // namespace org::apache::nifi::minifi::benchmarks
@@ -0,0 +1,62 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "FlowFileRecord.h"
+#include "impl/expression/Expression.h"
+
+namespace org::apache::nifi::minifi::benchmarks {
+
+namespace {
+
+void BM_ExpressionCompile(benchmark::State& state, const std::string& expression_string) {
+  for (auto _ : state) {
+    auto compiled = expression::compile(expression_string);
+    benchmark::DoNotOptimize(compiled);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ExpressionEvaluate(benchmark::State& state, const std::string& expression_string) {
+  auto flow_file = std::make_shared<FlowFileRecord>();
+  flow_file->setAttribute("filename", "sensor-reading-0042.json");
+  flow_file->setAttribute("sensor.value", "1234");
+  const auto compiled = expression::compile(expression_string);
+  const expression::Parameters parameters{flow_file};
+  for (auto _ : state) {
+    auto result = compiled(parameters).asString();
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_ExpressionCompile, attribute, std::string{"${filename}"});
+BENCHMARK_CAPTURE(BM_ExpressionCompile, function_chain, std::string{"${filename:toUpper():append('.processed')}"});
+
+BENCHMARK_CAPTURE(BM_ExpressionEvaluate, attribute, std::string{"${filename}"});
+BENCHMARK_CAPTURE(BM_ExpressionEvaluate, function_chain, std::string{"${filename:toUpper():append('.processed')}"});
+BENCHMARK_CAPTURE(BM_ExpressionEvaluate, regex, std::string{"${filename:replaceAll('[0-9]+', 'N')}"});
+BENCHMARK_CAPTURE(BM_ExpressionEvaluate, arithmetic, std::string{"${sensor.value:plus(1):multiply(2)}"});
+BENCHMARK_CAPTURE(BM_ExpressionEvaluate, constant, std::string{"${literal('prefix'):append('-suffix')}"});
+
+}  // namespace org::apache::nifi::minifi::benchmarks
@@ -0,0 +1,105 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "BenchmarkUtils.h"
+#include "Connection.h"
+#include "FlowFileRecord.h"
+#include "core/repository/VolatileContentRepository.h"
+#include "core/repository/VolatileFlowFileRepository.h"
+#include "utils/FlowFileQueue.h"
+
+namespace org::apache::nifi::minifi::benchmarks {
+
+namespace {
+
+std::vector<std::shared_ptr<core::FlowFile>> createFlowFiles(size_t count) {
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  flow_files.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    flow_files.push_back(std::make_shared<FlowFileRecord>());
+  }
+  return flow_files;
+}
+
+/**
+ * Pushes range(0) flow files, then pops all of them. A non-zero range(1) is the swap threshold of the queue,
+ * so that the flow files over it are swapped out and loaded back while popping.
+ */
+void BM_FlowFileQueuePushPop(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto swap_threshold = static_cast<size_t>(state.range(1));
+  const auto flow_files = createFlowFiles(count);
+  utils::FlowFileQueue queue(swap_threshold > 0 ? std::make_shared<InMemorySwapManager>() : nullptr);
+  if (swap_threshold > 0) {
+    queue.setTargetSize(swap_threshold);
+    queue.setMinSize(swap_threshold / 2);
+    queue.setMaxSize(swap_threshold * 3 / 2);
+  }
+  for (auto _ : state) {
+    for (const auto& flow_file : flow_files) {
+      queue.push(flow_file);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      // swapped in flow files might arrive after a short wait
+      auto flow_file = queue.tryPop(std::chrono::milliseconds(100));
+      benchmark::DoNotOptimize(flow_file);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+/**
+ * Puts range(0) flow files into a connection, then polls all of them, with the same swapping setup as above.
+ */
+void BM_ConnectionPutPoll(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto swap_threshold = static_cast<size_t>(state.range(1));
+  const auto flow_files = createFlowFiles(count);
+  auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  auto flow_repo = std::make_shared<core::repository::VolatileFlowFileRepository>();
+  Connection connection(flow_repo, content_repo, std::make_shared<InMemorySwapManager>(), "benchmark-connection", utils::IdGenerator::getIdGenerator()->generate());
+  if (swap_threshold > 0) {
+    connection.setSwapThreshold(swap_threshold);
+  }
+  std::set<std::shared_ptr<core::FlowFile>> expired;
+  for (auto _ : state) {
+    for (const auto& flow_file : flow_files) {
+      connection.put(flow_file);
+    }
+    size_t polled = 0;
+    while (polled < count) {
+      if (auto flow_file = connection.poll(expired)) {
+        ++polled;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+}  // namespace
+
+BENCHMARK(BM_FlowFileQueuePushPop)->ArgsProduct({{1000, 100000}, {0, 1000}});
+BENCHMARK(BM_ConnectionPutPoll)->ArgsProduct({{1000, 100000}, {0, 1000}});
+
+}  // namespace org::apache::nifi::minifi::benchmarks
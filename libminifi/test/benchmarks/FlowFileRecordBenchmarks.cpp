@@ -0,0 +1,78 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "FlowFileRecord.h"
+#include "core/repository/VolatileContentRepository.h"
+#include "io/BufferStream.h"
+#include "utils/Id.h"
+
+namespace org::apache::nifi::minifi::benchmarks {
+
+namespace {
+
+std::shared_ptr<FlowFileRecord> createFlowFile(size_t attribute_count) {
+  auto flow_file = std::make_shared<FlowFileRecord>();
+  for (size_t i = 0; i < attribute_count; ++i) {
+    flow_file->addAttribute("attribute." + std::to_string(i), "value of attribute " + std::to_string(i));
+  }
+  return flow_file;
+}
+
+/**
+ * Serializes a flow file with range(0) attributes.
+ */
+void BM_FlowFileRecordSerialize(benchmark::State& state) {
+  const auto flow_file = createFlowFile(static_cast<size_t>(state.range(0)));
+  int64_t bytes = 0;
+  for (auto _ : state) {
+    io::BufferStream stream;
+    flow_file->Serialize(stream);
+    bytes += static_cast<int64_t>(stream.size());
+    benchmark::DoNotOptimize(stream.getBuffer().data());
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(bytes);
+}
+
+/**
+ * Deserializes a flow file with range(0) attributes.
+ */
+void BM_FlowFileRecordDeSerialize(benchmark::State& state) {
+  const auto flow_file = createFlowFile(static_cast<size_t>(state.range(0)));
+  io::BufferStream stream;
+  flow_file->Serialize(stream);
+  auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  for (auto _ : state) {
+    utils::Identifier container;
+    auto deserialized = FlowFileRecord::DeSerialize(stream.getBuffer(), content_repo, container);
+    benchmark::DoNotOptimize(deserialized);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_FlowFileRecordSerialize)->Arg(0)->Arg(8)->Arg(64);
+BENCHMARK(BM_FlowFileRecordDeSerialize)->Arg(0)->Arg(8)->Arg(64);
+
+}  // namespace org::apache::nifi::minifi::benchmarks
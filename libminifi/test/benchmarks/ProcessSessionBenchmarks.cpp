@@ -0,0 +1,46 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "BenchmarkUtils.h"
+#include "core/repository/VolatileContentRepository.h"
+#include "core/repository/VolatileFlowFileRepository.h"
+#include "properties/Configure.h"
+
+namespace org::apache::nifi::minifi::benchmarks {
+
+namespace {
+
+void BM_ProcessSessionVolatileRepositories(benchmark::State& state) {
+  auto configuration = std::make_shared<Configure>();
+  auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(configuration);
+  auto flow_repo = std::make_shared<core::repository::VolatileFlowFileRepository>();
+  flow_repo->initialize(configuration);
+  flow_repo->loadComponent(content_repo);
+  SessionBenchmarkFlow flow(flow_repo, content_repo);
+  runSessionBenchmark(state, flow);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ProcessSessionVolatileRepositories)->ArgsProduct({{0, 1024, 64 * 1024}, {1, 100}});
+
+}  // namespace org::apache::nifi::minifi::benchmarks
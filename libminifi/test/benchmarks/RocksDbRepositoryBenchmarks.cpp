@@ -0,0 +1,58 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "BenchmarkUtils.h"
+#include "DatabaseContentRepository.h"
+#include "FlowFileRepository.h"
+#include "properties/Configure.h"
+
+namespace org::apache::nifi::minifi::benchmarks {
+
+namespace {
+
+void BM_ProcessSessionRocksDbRepositories(benchmark::State& state) {
+  TemporaryDirectory directory;
+  auto configuration = std::make_shared<Configure>();
+  configuration->set(Configure::nifi_flowfile_repository_directory_default, (directory.path() / "flowfile_repository").string());
+  configuration->set(Configure::nifi_dbcontent_repository_directory_default, (directory.path() / "content_repository").string());
+
+  auto content_repo = std::make_shared<core::repository::DatabaseContentRepository>();
+  auto flow_repo = std::make_shared<core::repository::FlowFileRepository>("benchmark-flowfile-repository");
+  if (!content_repo->initialize(configuration) || !flow_repo->initialize(configuration)) {
+    state.SkipWithError("Could not initialize the RocksDB repositories");
+    return;
+  }
+  flow_repo->loadComponent(content_repo);
+  content_repo->start();
+  flow_repo->start();
+  {
+    SessionBenchmarkFlow flow(flow_repo, content_repo);
+    runSessionBenchmark(state, flow);
+  }
+  flow_repo->stop();
+  content_repo->stop();
+}
+
+}  // namespace
+
+BENCHMARK(BM_ProcessSessionRocksDbRepositories)->ArgsProduct({{0, 1024, 64 * 1024}, {1, 100}})->UseRealTime();
+
+}  // namespace org::apache::nifi::minifi::benchmarks
@@ -0,0 +1,58 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <future>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "utils/ThreadPool.h"
+
+namespace org::apache::nifi::minifi::benchmarks {
+
+namespace {
+
+constexpr size_t TASKS_PER_ITERATION = 1000;
+
+/**
+ * Dispatches single-run tasks to a pool of range(0) threads, with work-stealing enabled if range(1) is non-zero.
+ */
+void BM_ThreadPoolDispatch(benchmark::State& state) {
+  utils::ThreadPool<int> pool(static_cast<int>(state.range(0)), false, nullptr, "BenchmarkPool");
+  pool.setWorkStealing(state.range(1) != 0);
+  pool.start();
+  std::vector<std::future<int>> futures(TASKS_PER_ITERATION);
+  for (auto _ : state) {
+    for (auto& future : futures) {
+      utils::Worker<int> worker([] { return 1; }, "benchmark-task");
+      pool.execute(std::move(worker), future);
+    }
+    int completed = 0;
+    for (auto& future : futures) {
+      completed += future.get();
+    }
+    benchmark::DoNotOptimize(completed);
+  }
+  pool.shutdown();
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(TASKS_PER_ITERATION));
+}
+
+}  // namespace
+
+BENCHMARK(BM_ThreadPoolDispatch)->ArgsProduct({{1, 4, 16}, {0, 1}})->UseRealTime();
+
+}  // namespace org::apache::nifi::minifi::benchmarks
@@ -33,6 +33,7 @@
 #include "unit/ProvenanceTestHelper.h"
 #include "repository/VolatileContentRepository.h"
 #include "utils/file/FileUtils.h"
+#include "utils/Id.h"
 
 static std::string config_yaml; // NOLINT
 
@@ -245,3 +246,66 @@ TEST_CASE_METHOD(PersistentStateStorageTestsFixture, "PersistentStateStorageTest
   REQUIRE(true == controller->get(key, res));
   REQUIRE(value == res);
 }
+
+TEST_CASE_METHOD(PersistentStateStorageTestsFixture, "PersistentStateStorageTestsFixture state manager stores the state keys as separate entries", "[statemanager]") {
+  const auto component_id = minifi::utils::IdGenerator::getIdGenerator()->generate();
+  const core::StateManager::State state = {
+      {"foobar", "234"},
+      {"buzz", "value"},
+  };
+  REQUIRE(controller->getStateManager(component_id)->set(state));
+
+  std::string res;
+  REQUIRE(controller->get(minifi::controllers::KeyValueStateStorage::getStateEntryKey(component_id, "foobar"), res));
+  REQUIRE("234" == res);
+
+  const core::StateManager::State changed_state = {
+      {"foobar", "234"},
+      {"fizz", "new"},
+  };
+  REQUIRE(controller->getStateManager(component_id)->set(changed_state));
+  REQUIRE(false == controller->get(minifi::controllers::KeyValueStateStorage::getStateEntryKey(component_id, "buzz"), res));
+
+  SECTION("without persistence") {
+  }
+  SECTION("with persistence") {
+    controller->persist();
+    loadYaml();
+  }
+
+  core::StateManager::State state_res;
+  REQUIRE(controller->getStateManager(component_id)->get(state_res));
+  REQUIRE(changed_state == state_res);
+  REQUIRE(changed_state == controller->getAllStates().at(component_id));
+
+  REQUIRE(controller->getStateManager(component_id)->clear());
+  std::unordered_map<std::string, std::string> kvs_res;
+  REQUIRE(controller->get(kvs_res));
+  REQUIRE(kvs_res.empty());
+}
+
+TEST_CASE_METHOD(PersistentStateStorageTestsFixture, "PersistentStateStorageTestsFixture state manager migrates the serialized state of earlier versions", "[statemanager]") {
+  const auto component_id = minifi::utils::IdGenerator::getIdGenerator()->generate();
+  const core::StateManager::State state = {
+      {"foobar", "234"},
+      {"buzz", "value"},
+  };
+  REQUIRE(controller->set(component_id.to_string(), minifi::controllers::KeyValueStateStorage::serialize(state)));
+
+  core::StateManager::State state_res;
+  REQUIRE(controller->getStateManager(component_id)->get(state_res));
+  REQUIRE(state == state_res);
+
+  auto changed_state = state;
+  changed_state["foobar"] = "345";
+  REQUIRE(controller->getStateManager(component_id)->set(changed_state));
+
+  std::string res;
+  REQUIRE(controller->get(minifi::controllers::KeyValueStateStorage::getStateEntryKey(component_id, "buzz"), res));
+  REQUIRE("value" == res);
+  REQUIRE(controller->get(component_id.to_string(), res));
+  REQUIRE(minifi::controllers::KeyValueStateStorage::deserialize(res).empty());
+
+  REQUIRE(controller->getStateManager(component_id)->get(state_res));
+  REQUIRE(changed_state == state_res);
+}
@@ -16,12 +16,16 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <chrono>
+#include <latch>
 #include <map>
 #include <memory>
 #include <string>
 #include <thread>
 #include <optional>
+#include <set>
+#include <vector>
 
 #include "core/Core.h"
 #include "core/repository/AtomicRepoEntries.h"
@@ -752,4 +756,114 @@ TEST_CASE("Content repositories are always running", "[TestRepoIsRunning]") {
   REQUIRE(content_repo->isRunning());
 }
 
+TEST_CASE("FlowFileRepository merges concurrent writes with group commit", "[TestGroupCommit]") {
+  TestController testController;
+  LogTestController::getInstance().setDebug<core::repository::FlowFileRepository>();
+  auto dir = testController.createTempDirectory();
+  auto repository = std::make_shared<core::repository::FlowFileRepository>("ff", dir.string(), 0ms, 0, 1ms);
+  auto configuration = std::make_shared<minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_flowfile_repository_rocksdb_group_commit_window, "20 ms");
+  SECTION("without sync") {}
+  SECTION("with sync") { configuration->set(minifi::Configure::nifi_flowfile_repository_rocksdb_sync, "true"); }
+  REQUIRE(repository->initialize(configuration));
+
+  constexpr size_t session_count = 8;
+  constexpr size_t flow_files_per_session = 10;
+  std::atomic<size_t> success_count{0};
+  std::latch sessions_ready{session_count};
+  std::vector<std::thread> sessions;
+  for (size_t session_idx = 0; session_idx < session_count; ++session_idx) {
+    sessions.emplace_back([&, session_idx] {
+      std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>> data;
+      for (size_t i = 0; i < flow_files_per_session; ++i) {
+        data.emplace_back("key_" + std::to_string(session_idx) + "_" + std::to_string(i), std::make_unique<minifi::io::BufferStream>("value_" + std::to_string(i)));
+      }
+      sessions_ready.arrive_and_wait();
+      if (repository->MultiPut(data)) {
+        ++success_count;
+      }
+    });
+  }
+  for (auto& session : sessions) {
+    session.join();
+  }
+  REQUIRE(success_count == session_count);
+  const auto batch_count = LogTestController::getInstance().countOccurrences("sessions in a single batch");
+  CHECK(batch_count > 0);
+  CHECK(batch_count < static_cast<int>(session_count));
+  CHECK(LogTestController::getInstance().matchesRegex("Writing [0-9]+ flow files of ([2-9]|[0-9]{2,}) sessions in a single batch", 0ms));
+
+  for (size_t session_idx = 0; session_idx < session_count; ++session_idx) {
+    for (size_t i = 0; i < flow_files_per_session; ++i) {
+      std::string value;
+      REQUIRE(repository->Get("key_" + std::to_string(session_idx) + "_" + std::to_string(i), value));
+      REQUIRE(value == "value_" + std::to_string(i));
+    }
+  }
+  repository->stop();
+}
+
+TEST_CASE("FlowFileRepository recovers flow files on multiple threads", "[TestParallelRecovery]") {
+  TestController testController;
+  LogTestController::getInstance().setDebug<core::repository::FlowFileRepository>();
+  auto ff_dir = testController.createTempDirectory();
+  auto content_dir = testController.createTempDirectory();
+
+  auto config = std::make_shared<minifi::Configure>();
+  config->set(minifi::Configure::nifi_flowfile_repository_directory_default, ff_dir.string());
+  config->set(minifi::Configure::nifi_dbcontent_repository_directory_default, content_dir.string());
+  config->set(minifi::Configure::nifi_flowfile_repository_rocksdb_recovery_threads, "4");
+
+  constexpr size_t flow_file_count = 100;
+  std::set<utils::Identifier> ff_ids;
+  auto connection_id = utils::IdGenerator::getIdGenerator()->generate();
+
+  {
+    auto ff_repo = std::make_shared<core::repository::FlowFileRepository>();
+    REQUIRE(ff_repo->initialize(config));
+    auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(config));
+    auto conn = std::make_shared<minifi::Connection>(ff_repo, content_repo, "TestConnection", connection_id);
+
+    std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>> flow_data;
+    for (size_t i = 0; i < flow_file_count; ++i) {
+      auto claim = std::make_shared<minifi::ResourceClaim>(content_repo);
+      auto ff = std::make_shared<minifi::FlowFileRecord>();
+      ff_ids.insert(ff->getUUID());
+      ff->setConnection(conn.get());
+      content_repo->write(*claim)->write("hello");
+      ff->setResourceClaim(claim);
+      auto stream = std::make_unique<minifi::io::BufferStream>();
+      ff->Serialize(*stream);
+      flow_data.emplace_back(ff->getUUIDStr(), std::move(stream));
+    }
+    // a record that cannot be deserialized
+    flow_data.emplace_back("invalid", std::make_unique<minifi::io::BufferStream>("invalid"));
+
+    REQUIRE(ff_repo->MultiPut(flow_data));
+  }
+
+  {
+    auto ff_repo = std::make_shared<core::repository::FlowFileRepository>();
+    REQUIRE(ff_repo->initialize(config));
+    auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(config));
+    auto conn = std::make_shared<minifi::Connection>(ff_repo, content_repo, "TestConnection", connection_id);
+
+    ff_repo->setConnectionMap({{connection_id.to_string(), conn.get()}});
+    ff_repo->loadComponent(content_repo);
+    CHECK(LogTestController::getInstance().contains("read 101, restored 100 flow files"));
+
+    std::set<utils::Identifier> restored_ids;
+    std::set<std::shared_ptr<core::FlowFile>> expired;
+    while (auto ff = conn->poll(expired)) {
+      restored_ids.insert(ff->getUUID());
+    }
+    REQUIRE(expired.empty());
+    REQUIRE(restored_ids == ff_ids);
+    std::string value;
+    REQUIRE_FALSE(ff_repo->Get("invalid", value));
+  }
+}
+
 }  // namespace
@@ -19,6 +19,8 @@
 #undef NDEBUG
 
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "SQLTestController.h"
 #include "processors/ExecuteSQL.h"
@@ -236,4 +238,58 @@ TEST_CASE("ExecuteSQL select query is malformed", "[ExecuteSQL7]") {
   REQUIRE(output.at(0) == input_file);
 }
 
+TEST_CASE("ExecuteSQL streams rows larger than the output buffer", "[ExecuteSQL8]") {
+  SQLTestController controller;
+
+  auto plan = controller.createSQLPlan("ExecuteSQL", {{"success", "d"}});
+  auto sql_proc = plan->getSQLProcessor();
+  sql_proc->setProperty(minifi::processors::ExecuteSQL::OutputFormat, "JSON");
+  sql_proc->setProperty(minifi::processors::ExecuteSQL::MaxRowsPerFlowFile, "2");
+  sql_proc->setProperty(minifi::processors::ExecuteSQL::SQLSelectQuery, "SELECT * FROM test_table ORDER BY int_col ASC");
+
+  const std::string long_text_a(10000, 'a');
+  const std::string long_text_b(5000, 'b');
+  const std::string long_text_c(3000, 'c');
+  controller.insertValues({{1, long_text_a}, {2, long_text_b}, {3, long_text_c}});
+
+  plan->run();
+
+  auto flow_files = plan->getOutputs({"success", "d"});
+  REQUIRE(flow_files.size() == 2);
+  CHECK(plan->getContent(flow_files[0]) == R"([{"int_col":1,"text_col":")" + long_text_a + R"("},{"int_col":2,"text_col":")" + long_text_b + R"("}])");
+  CHECK(flow_files[0]->getSize() == plan->getContent(flow_files[0]).size());
+  CHECK(plan->getContent(flow_files[1]) == R"([{"int_col":3,"text_col":")" + long_text_c + R"("}])");
+}
+
+TEST_CASE("ExecuteSQL writes the rows in the Arrow IPC streaming format", "[ExecuteSQL9]") {
+  SQLTestController controller;
+
+  auto plan = controller.createSQLPlan("ExecuteSQL", {{"success", "d"}});
+  auto sql_proc = plan->getSQLProcessor();
+  sql_proc->setProperty(minifi::processors::ExecuteSQL::OutputFormat, "Arrow-IPC");
+  sql_proc->setProperty(minifi::processors::ExecuteSQL::SQLSelectQuery, "SELECT * FROM test_table ORDER BY int_col ASC");
+
+  controller.insertValues({{11, "one"}, {22, "two"}});
+
+  plan->run();
+
+  auto flow_files = plan->getOutputs({"success", "d"});
+  REQUIRE(flow_files.size() == 1);
+  CHECK(flow_files[0]->getAttribute(minifi::processors::ExecuteSQL::RESULT_ROW_COUNT) == "2");
+
+  const auto content = plan->getContent(flow_files[0]);
+  CHECK(flow_files[0]->getSize() == content.size());
+  // the stream starts with the schema message
+  CHECK(content.starts_with("\xFF\xFF\xFF\xFF"));
+  CHECK(content.find("int_col") != std::string::npos);
+  CHECK(content.find("text_col") != std::string::npos);
+  // the body of the record batch, every buffer padded to 8 bytes, and the end-of-stream marker
+  const std::vector<uint8_t> record_batch_body_and_end_of_stream{
+    11, 0, 0, 0, 22, 0, 0, 0,  // values of int_col
+    0, 0, 0, 0, 3, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 0,  // offsets of text_col
+    'o', 'n', 'e', 't', 'w', 'o', 0, 0,  // characters of text_col
+    0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0};
+  CHECK(content.ends_with(std::string(record_batch_body_and_end_of_stream.begin(), record_batch_body_and_end_of_stream.end())));
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -0,0 +1,95 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/AtomicHistogram.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+
+TEST_CASE("An empty histogram reports zeros", "[AtomicHistogram]") {
+  utils::AtomicHistogram histogram;
+  const auto snapshot = histogram.getSnapshot();
+  CHECK(snapshot.count() == 0);
+  CHECK(snapshot.max() == 0);
+  CHECK(snapshot.mean() == 0.0);
+  CHECK(snapshot.percentile(0.99) == 0);
+}
+
+TEST_CASE("Small values are counted exactly", "[AtomicHistogram]") {
+  utils::AtomicHistogram histogram;
+  for (uint64_t value = 1; value <= 60; ++value) {
+    histogram.record(value);
+  }
+  const auto snapshot = histogram.getSnapshot();
+  CHECK(snapshot.count() == 60);
+  CHECK(snapshot.max() == 60);
+  CHECK(snapshot.mean() == Approx(30.5));
+  CHECK(snapshot.percentile(0.5) == 30);
+  CHECK(snapshot.percentile(0.9) == 54);
+  CHECK(snapshot.percentile(1.0) == 60);
+  CHECK(snapshot.percentile(0.0) == 1);
+}
+
+TEST_CASE("Every value falls into the bucket whose upper bound is the closest from above", "[AtomicHistogram]") {
+  for (uint64_t value : {0ULL, 1ULL, 31ULL, 32ULL, 63ULL, 64ULL, 65ULL, 66ULL, 1000ULL, 123456ULL, 987654321ULL, (1ULL << 36) - 1}) {
+    const auto index = utils::AtomicHistogram::bucketIndex(value);
+    REQUIRE(index < utils::AtomicHistogram::BUCKET_COUNT);
+    CHECK(utils::AtomicHistogram::bucketUpperBound(index) >= value);
+    if (index > 0) {
+      CHECK(utils::AtomicHistogram::bucketUpperBound(index - 1) < value);
+    }
+  }
+  CHECK(utils::AtomicHistogram::bucketIndex(UINT64_MAX) == utils::AtomicHistogram::BUCKET_COUNT - 1);
+}
+
+TEST_CASE("Percentiles of large values are within the relative error of the buckets", "[AtomicHistogram]") {
+  utils::AtomicHistogram histogram;
+  for (uint64_t value = 1; value <= 100000; ++value) {
+    histogram.record(value);
+  }
+  const auto snapshot = histogram.getSnapshot();
+  const double max_relative_error = 1.0 / utils::AtomicHistogram::SUB_BUCKET_COUNT;
+  CHECK(static_cast<double>(snapshot.percentile(0.5)) == Approx(50000).epsilon(max_relative_error));
+  CHECK(static_cast<double>(snapshot.percentile(0.99)) == Approx(99000).epsilon(max_relative_error));
+  CHECK(static_cast<double>(snapshot.percentile(0.999)) == Approx(99900).epsilon(max_relative_error));
+  CHECK(snapshot.percentile(1.0) == 100000);
+}
+
+TEST_CASE("Values can be recorded concurrently", "[AtomicHistogram]") {
+  utils::AtomicHistogram histogram;
+  std::vector<std::thread> threads;
+  for (uint64_t thread_index = 0; thread_index < 4; ++thread_index) {
+    threads.emplace_back([&histogram, thread_index] {
+      for (uint64_t value = 0; value < 10000; ++value) {
+        histogram.record(thread_index * 10000 + value);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto snapshot = histogram.getSnapshot();
+  CHECK(snapshot.count() == 40000);
+  CHECK(snapshot.max() == 39999);
+  CHECK(snapshot.mean() == Approx(19999.5));
+}
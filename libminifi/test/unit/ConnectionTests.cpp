@@ -14,6 +14,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <atomic>
+#include <thread>
+
 #include "Connection.h"
 
 #include "../TestBase.h"
@@ -125,3 +128,201 @@ TEST_CASE("Connection backpressure tests", "[Connection]") {
     CHECK_FALSE(connection->backpressureThresholdReached());
   }
 }
+
+TEST_CASE("Connection with concurrent queue", "[Connection]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto id_generator = utils::IdGenerator::getIdGenerator();
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection", id_generator->generate(), id_generator->generate(), id_generator->generate());
+  connection->setConcurrentQueue(true);
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+
+  SECTION("Flow files are polled in FIFO order") {
+    std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+    for (size_t i = 0; i < 10; ++i) {
+      flow_files.push_back(std::make_shared<core::FlowFile>());
+      flow_files.back()->setSize(10);
+    }
+    connection->multiPut(flow_files);
+    CHECK(connection->getQueueSize() == 10);
+    CHECK(connection->getQueueDataSize() == 100);
+    CHECK(connection->isWorkAvailable());
+    for (const auto& flow_file : flow_files) {
+      CHECK(flow_file == connection->poll(expired_flow_files));
+    }
+    CHECK(nullptr == connection->poll(expired_flow_files));
+    CHECK(connection->isEmpty());
+    CHECK(connection->getQueueDataSize() == 0);
+  }
+
+  SECTION("Penalized flow files are not returned until their penalty expires") {
+    const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+    penalized_flow_file->penalize(std::chrono::milliseconds{50});
+    connection->put(penalized_flow_file);
+    const auto flow_file = std::make_shared<core::FlowFile>();
+    connection->put(flow_file);
+
+    CHECK(connection->getQueueSize() == 2);
+    CHECK(flow_file == connection->poll(expired_flow_files));
+    CHECK(nullptr == connection->poll(expired_flow_files));
+    CHECK_FALSE(connection->isEmpty());
+    CHECK_FALSE(connection->isWorkAvailable());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{60});
+    CHECK(connection->isWorkAvailable());
+    CHECK(penalized_flow_file == connection->poll(expired_flow_files));
+    CHECK(connection->isEmpty());
+  }
+
+  SECTION("Drain empties both queues") {
+    const auto penalized_flow_file = std::make_shared<core::FlowFile>();
+    penalized_flow_file->penalize(std::chrono::seconds{10});
+    connection->put(penalized_flow_file);
+    connection->put(std::make_shared<core::FlowFile>());
+    CHECK(connection->getQueueSize() == 2);
+    connection->drain(false);
+    CHECK(connection->isEmpty());
+    CHECK(nullptr == connection->poll(expired_flow_files));
+  }
+
+  SECTION("Concurrent producers and consumers") {
+    constexpr size_t producer_count = 4;
+    constexpr size_t flow_files_per_producer = 1000;
+    std::atomic<size_t> polled_count{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producer_count; ++i) {
+      threads.emplace_back([&] {
+        for (size_t j = 0; j < flow_files_per_producer; ++j) {
+          connection->put(std::make_shared<core::FlowFile>());
+        }
+      });
+      threads.emplace_back([&] {
+        std::set<std::shared_ptr<core::FlowFile>> expired;
+        while (polled_count < producer_count * flow_files_per_producer) {
+          if (connection->poll(expired)) {
+            ++polled_count;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK(polled_count == producer_count * flow_files_per_producer);
+    CHECK(connection->isEmpty());
+  }
+
+  SECTION("The queue size stays consistent with concurrent producers and consumers") {
+    constexpr size_t producer_count = 4;
+    constexpr size_t flow_files_per_producer = 1000;
+    std::atomic<size_t> max_observed_size{0};
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < producer_count; ++i) {
+      producers.emplace_back([&] {
+        for (size_t j = 0; j < flow_files_per_producer; j += 2) {
+          std::vector<std::shared_ptr<core::FlowFile>> flow_files{std::make_shared<core::FlowFile>(), std::make_shared<core::FlowFile>()};
+          connection->multiPut(flow_files);
+        }
+      });
+      consumers.emplace_back([&] {
+        std::set<std::shared_ptr<core::FlowFile>> expired;
+        // leave some of the flow files in the queue
+        for (size_t j = 0; j < flow_files_per_producer / 2;) {
+          if (connection->poll(expired)) {
+            ++j;
+          }
+          const size_t size = connection->getQueueSize();
+          size_t max_size = max_observed_size;
+          while (size > max_size && !max_observed_size.compare_exchange_weak(max_size, size)) {}
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    for (auto& consumer : consumers) {
+      consumer.join();
+    }
+    // the size must never have wrapped around by being decremented below zero
+    CHECK(max_observed_size <= producer_count * flow_files_per_producer);
+    CHECK(connection->getQueueSize() == producer_count * flow_files_per_producer / 2);
+    size_t remaining_count = 0;
+    while (connection->poll(expired_flow_files)) {
+      ++remaining_count;
+    }
+    CHECK(remaining_count == producer_count * flow_files_per_producer / 2);
+    CHECK(connection->getQueueSize() == 0);
+    CHECK(connection->isEmpty());
+  }
+
+  SECTION("Draining does not lose the flow files put concurrently") {
+    constexpr size_t producer_count = 4;
+    constexpr size_t flow_files_per_producer = 1000;
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < producer_count; ++i) {
+      producers.emplace_back([&] {
+        for (size_t j = 0; j < flow_files_per_producer; ++j) {
+          connection->put(std::make_shared<core::FlowFile>());
+        }
+      });
+    }
+    for (size_t i = 0; i < 10; ++i) {
+      connection->drain(false);
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    const size_t queue_size = connection->getQueueSize();
+    size_t remaining_count = 0;
+    while (connection->poll(expired_flow_files)) {
+      ++remaining_count;
+    }
+    CHECK(remaining_count == queue_size);
+    CHECK(connection->isEmpty());
+  }
+}
+
+TEST_CASE("Connection::pollBatch() works correctly", "[pollBatch]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::Configure>());
+
+  const auto id_generator = utils::IdGenerator::getIdGenerator();
+  const auto connection = std::make_shared<minifi::Connection>(flow_repo, content_repo, "test_connection", id_generator->generate(), id_generator->generate(), id_generator->generate());
+  SECTION("with the default queue") {}
+  SECTION("with concurrent queue") { connection->setConcurrentQueue(true); }
+
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (size_t i = 0; i < 10; ++i) {
+    flow_files.push_back(std::make_shared<core::FlowFile>());
+    flow_files.back()->setSize(10);
+    connection->put(flow_files.back());
+  }
+  std::vector<std::shared_ptr<core::FlowFile>> expired_flow_files;
+
+  SECTION("the number of polled flow files is limited by max_count") {
+    const auto batch = connection->pollBatch(4, 0, expired_flow_files);
+    CHECK(batch == std::vector<std::shared_ptr<core::FlowFile>>(flow_files.begin(), flow_files.begin() + 4));
+    CHECK(connection->getQueueSize() == 6);
+    CHECK(connection->getQueueDataSize() == 60);
+    CHECK(connection->pollBatch(100, 0, expired_flow_files).size() == 6);
+    CHECK(connection->isEmpty());
+  }
+
+  SECTION("the size of polled flow files is limited by max_bytes") {
+    const auto batch = connection->pollBatch(100, 25, expired_flow_files);
+    CHECK(batch == std::vector<std::shared_ptr<core::FlowFile>>(flow_files.begin(), flow_files.begin() + 3));
+    CHECK(connection->getQueueSize() == 7);
+  }
+
+  SECTION("expired flow files are returned separately") {
+    connection->setFlowExpirationDuration(1ms);
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    CHECK(connection->pollBatch(100, 0, expired_flow_files).empty());
+    CHECK(expired_flow_files.size() == 10);
+    CHECK(connection->isEmpty());
+  }
+}
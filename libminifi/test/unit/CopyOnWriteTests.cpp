@@ -0,0 +1,101 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/CopyOnWrite.h"
+#include "core/FlowFile.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+
+TEST_CASE("CopyOnWrite copies share storage until modified", "[CopyOnWrite]") {
+  utils::CopyOnWrite<std::vector<int>> original{std::vector<int>{1, 2, 3}};
+  auto copy = original;
+  CHECK(original.isShared());
+  CHECK(&original.get() == &copy.get());
+
+  copy.getMutable().push_back(4);
+  CHECK_FALSE(original.isShared());
+  CHECK(original.get() == std::vector<int>{1, 2, 3});
+  CHECK(copy.get() == std::vector<int>{1, 2, 3, 4});
+}
+
+TEST_CASE("CopyOnWrite snapshots are not affected by later modifications", "[CopyOnWrite]") {
+  utils::CopyOnWrite<std::vector<int>> value{std::vector<int>{1}};
+  auto snapshot = value.share();
+  value.getMutable().push_back(2);
+  CHECK(*snapshot == std::vector<int>{1});
+  CHECK(value.get() == std::vector<int>{1, 2});
+}
+
+TEST_CASE("Leaked CopyOnWrite values are not shared anymore", "[CopyOnWrite]") {
+  utils::CopyOnWrite<std::vector<int>> value{std::vector<int>{1}};
+  auto* leaked = value.leak();
+  auto copy = value;
+  auto snapshot = value.share();
+  CHECK_FALSE(value.isShared());
+  leaked->push_back(2);
+  CHECK(value.get() == std::vector<int>{1, 2});
+  CHECK(copy.get() == std::vector<int>{1});
+  CHECK(*snapshot == std::vector<int>{1});
+}
+
+TEST_CASE("Moved-from CopyOnWrite instances hold an empty value", "[CopyOnWrite]") {
+  utils::CopyOnWrite<std::vector<int>> value{std::vector<int>{1, 2}};
+  auto copy = value;
+
+  SECTION("Move construction") {
+    auto moved = std::move(value);
+    CHECK(moved.get() == std::vector<int>{1, 2});
+    CHECK(&moved.get() == &copy.get());
+  }
+  SECTION("Move assignment") {
+    utils::CopyOnWrite<std::vector<int>> moved{std::vector<int>{3}};
+    moved = std::move(value);
+    CHECK(moved.get() == std::vector<int>{1, 2});
+    CHECK(&moved.get() == &copy.get());
+  }
+
+  CHECK(value.get().empty());  // NOLINT(bugprone-use-after-move)
+  CHECK_FALSE(value.isShared());
+  value.getMutable().push_back(4);
+  CHECK(value.get() == std::vector<int>{4});
+  CHECK(*value.share() == std::vector<int>{4});
+  CHECK(copy.get() == std::vector<int>{1, 2});
+}
+
+TEST_CASE("FlowFile attributes are shared with snapshots until modified", "[CopyOnWrite]") {
+  core::FlowFile flow_file;
+  flow_file.setAttribute("key", "value");
+  core::FlowFile snapshot;
+  snapshot = flow_file;
+  CHECK(&snapshot.getAttributeMap() == &flow_file.getAttributeMap());
+
+  flow_file.setAttribute("key", "new value");
+  CHECK(snapshot.getAttribute("key") == "value");
+  CHECK(flow_file.getAttribute("key") == "new value");
+
+  // removing a missing attribute does not detach the storage
+  snapshot = flow_file;
+  CHECK_FALSE(flow_file.removeAttribute("missing"));
+  CHECK(&snapshot.getAttributeMap() == &flow_file.getAttributeMap());
+}
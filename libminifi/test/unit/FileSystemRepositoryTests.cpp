@@ -25,6 +25,9 @@
 #endif
 #include <cstring>
 #include <list>
+#include <span>
+#include <string>
+#include <string_view>
 
 #include "utils/gsl.h"
 #include "utils/OsUtils.h"
@@ -177,4 +180,174 @@ TEST_CASE("FileSystemRepository removes non-existing resource file from purge li
   REQUIRE(content_repo->getPurgeList().empty());
 }
 
+TEST_CASE("FileSystemRepository packs small claims into slab segments") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_filesystem_content_repository_slab_max_claim_size, "10 B");
+  configuration->set(minifi::Configure::nifi_filesystem_content_repository_slab_segment_size, "16 B");
+  const auto slab_dir = dir / core::repository::FileSystemRepository::SLAB_DIRECTORY_NAME;
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+
+  auto write = [&] (const minifi::ResourceClaim& claim, std::string_view content, bool append = false) {
+    REQUIRE(content_repo->write(claim, append)->write(as_bytes(std::span(content))) == content.size());
+  };
+  auto read_all = [&] (const minifi::ResourceClaim& claim) {
+    auto stream = content_repo->read(claim);
+    std::string content(stream->size(), '\0');
+    REQUIRE(stream->read(as_writable_bytes(std::span(content))) == content.size());
+    return content;
+  };
+
+  {
+    auto first = std::make_unique<minifi::ResourceClaim>(content_repo);
+    auto second = std::make_unique<minifi::ResourceClaim>(content_repo);
+    auto third = std::make_unique<minifi::ResourceClaim>(content_repo);
+    write(*first, "first");
+    write(*second, "second");
+    write(*second, "!", true);
+    write(*third, "too large for a slab");
+
+    CHECK(read_all(*first) == "first");
+    CHECK(read_all(*second) == "second!");
+    CHECK(read_all(*third) == "too large for a slab");
+    CHECK(content_repo->getRepositoryEntryCount() == 3);
+    // only the large claim is stored in a separate file
+    CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger(), false).size() == 1);
+
+    // the appended claim did not fit into the first segment anymore
+    REQUIRE(minifi::utils::file::list_dir_all(slab_dir, testController.getLogger()).size() == 4);
+    first.reset();
+    CHECK(minifi::utils::file::list_dir_all(slab_dir, testController.getLogger()).size() == 2);
+    CHECK(content_repo->getRepositoryEntryCount() == 2);
+  }
+
+  CHECK(content_repo->getRepositoryEntryCount() == 0);
+  // the active segment is kept even if it is empty
+  CHECK(minifi::utils::file::list_dir_all(slab_dir, testController.getLogger()).size() == 2);
+  CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger(), false).empty());
+}
+
+TEST_CASE("FileSystemRepository restores slab entries and clears the orphans") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_filesystem_content_repository_slab_max_claim_size, "1 KB");
+
+  std::string kept_path;
+  std::string orphan_path;
+  {
+    auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+    minifi::ResourceClaim kept(content_repo);
+    minifi::ResourceClaim orphan(content_repo);
+    content_repo->write(kept)->write(as_bytes(std::span(std::string_view("kept"))));
+    content_repo->write(orphan)->write(as_bytes(std::span(std::string_view("orphan"))));
+    kept_path = kept.getContentFullPath();
+    orphan_path = orphan.getContentFullPath();
+    // ensure that the content is not deleted during resource claim destruction
+    content_repo->incrementStreamCount(kept);
+    content_repo->incrementStreamCount(orphan);
+  }
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  minifi::ResourceClaim kept(kept_path, content_repo);
+  minifi::ResourceClaim orphan(orphan_path, nullptr);
+  REQUIRE(content_repo->exists(kept));
+  REQUIRE(content_repo->exists(orphan));
+
+  content_repo->clearOrphans();
+  CHECK(content_repo->exists(kept));
+  CHECK_FALSE(content_repo->exists(orphan));
+  CHECK(content_repo->getRepositoryEntryCount() == 1);
+
+  auto stream = content_repo->read(kept);
+  std::string content(stream->size(), '\0');
+  REQUIRE(stream->read(as_writable_bytes(std::span(content))) == content.size());
+  CHECK(content == "kept");
+}
+
+TEST_CASE("FileSystemRepository spreads the claims over the fan-out directories") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+
+  std::string content_path;
+  {
+    auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+    minifi::ResourceClaim claim(content_repo);
+    content_repo->write(claim)->write("hi");
+    content_path = claim.getContentFullPath();
+    content_repo->incrementStreamCount(claim);
+  }
+  REQUIRE(minifi::utils::file::list_dir_all(dir, testController.getLogger(), false).size() == 1);
+
+  configuration->set(minifi::Configure::nifi_filesystem_content_repository_directory_fan_out, "4");
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  minifi::ResourceClaim old_claim(content_path, content_repo);
+  // existing files are moved to their bucket on startup
+  content_repo->clearOrphans();
+  CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger(), false).empty());
+  REQUIRE(content_repo->exists(old_claim));
+
+  {
+    minifi::ResourceClaim claim(content_repo);
+    content_repo->write(claim)->write(as_bytes(std::span(std::string_view("hello"))));
+    auto files = minifi::utils::file::list_dir_all(dir, testController.getLogger());
+    REQUIRE(files.size() == 2);
+    for (const auto& [parent, filename] : files) {
+      CHECK(parent.parent_path() == dir);
+    }
+    CHECK(content_repo->read(claim)->size() == 5);
+  }
+  CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger()).size() == 1);
+}
+
+
+TEST_CASE("FileSystemRepository maps the content of claims into memory") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::Configure>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_filesystem_content_repository_slab_max_claim_size, "8 B");
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+
+  auto as_string = [] (std::span<const std::byte> buffer) {
+    return std::string(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  };
+
+  minifi::ResourceClaim file_claim(content_repo);
+  minifi::ResourceClaim slab_claim(content_repo);
+  minifi::ResourceClaim empty_claim(content_repo);
+  content_repo->write(file_claim)->write(as_bytes(std::span(std::string_view("stored in a separate file"))));
+  content_repo->write(slab_claim)->write(as_bytes(std::span(std::string_view("packed"))));
+  content_repo->write(empty_claim);
+
+  auto mapped_file = content_repo->readMapped(file_claim);
+  REQUIRE(mapped_file);
+  CHECK(as_string(mapped_file->getBuffer()) == "stored in a separate file");
+  mapped_file->seek(10);
+  std::string rest(mapped_file->size() - 10, '\0');
+  REQUIRE(mapped_file->read(as_writable_bytes(std::span(rest))) == rest.size());
+  CHECK(rest == "separate file");
+
+  auto mapped_slab = content_repo->readMapped(slab_claim);
+  REQUIRE(mapped_slab);
+  CHECK(as_string(mapped_slab->getBuffer()) == "packed");
+
+  auto mapped_empty = content_repo->readMapped(empty_claim);
+  REQUIRE(mapped_empty);
+  CHECK(mapped_empty->getBuffer().empty());
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -0,0 +1,140 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "Connection.h"
+#include "FlowFileRecord.h"
+#include "core/repository/FileSystemRepository.h"
+#include "core/repository/VolatileContentRepository.h"
+#include "io/BufferStream.h"
+#include "properties/Configure.h"
+#include "utils/span.h"
+
+namespace org::apache::nifi::minifi::test {
+
+namespace {
+std::string toString(std::span<const std::byte> buffer) {
+  return utils::span_to<std::string>(utils::as_span<const char>(buffer));
+}
+}  // namespace
+
+TEST_CASE("FlowFileRecord round trip through the compact serialization format", "[FlowFileRecord]") {
+  TestController test_controller;
+  auto configuration = std::make_shared<Configure>();
+  configuration->set(Configure::nifi_dbcontent_repository_directory_default, test_controller.createTempDirectory().string());
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+
+  Connection connection(nullptr, nullptr, "connection");
+  auto claim = std::make_shared<ResourceClaim>(content_repo);
+  REQUIRE(claim->getContentId());
+
+  auto flow_file = std::make_shared<FlowFileRecord>();
+  flow_file->setAttribute(core::SpecialFlowAttribute::FILENAME, "data.json");
+  flow_file->setAttribute(core::SpecialFlowAttribute::MIME_TYPE, "application/json");
+  flow_file->setAttribute("custom.attribute", std::string(300, 'x'));
+  flow_file->setAttribute("empty.attribute", "");
+  flow_file->setResourceClaim(claim);
+  flow_file->setSize(123456);
+  flow_file->setOffset(42);
+  flow_file->setConnection(&connection);
+
+  io::BufferStream stream;
+  REQUIRE(flow_file->Serialize(stream));
+  const auto serialized = toString(stream.getBuffer());
+  CHECK(serialized.find(content_repo->getStoragePath()) == std::string::npos);
+  CHECK(serialized.find(core::SpecialFlowAttribute::MIME_TYPE) == std::string::npos);
+  CHECK(serialized.find("custom.attribute") != std::string::npos);
+
+  utils::Identifier container;
+  auto restored = FlowFileRecord::DeSerialize(stream.getBuffer(), content_repo, container);
+  REQUIRE(restored);
+  CHECK(restored->getUUID() == flow_file->getUUID());
+  CHECK(container == connection.getUUID());
+  CHECK(restored->getAttributes() == flow_file->getAttributes());
+  CHECK(restored->getSize() == 123456);
+  CHECK(restored->getOffset() == 42);
+  CHECK(restored->getEventTime() == std::chrono::time_point_cast<std::chrono::milliseconds>(flow_file->getEventTime()));
+  CHECK(restored->getEntryDate() == std::chrono::time_point_cast<std::chrono::milliseconds>(flow_file->getEntryDate()));
+  REQUIRE(restored->getResourceClaim());
+  CHECK(restored->getResourceClaim()->getContentFullPath() == claim->getContentFullPath());
+}
+
+TEST_CASE("FlowFileRecord keeps content paths outside of the content repository", "[FlowFileRecord]") {
+  auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  auto flow_file = std::make_shared<FlowFileRecord>();
+  flow_file->setResourceClaim(std::make_shared<ResourceClaim>("/some/other/location/content", nullptr));
+
+  io::BufferStream stream;
+  REQUIRE(flow_file->Serialize(stream));
+
+  utils::Identifier container;
+  auto restored = FlowFileRecord::DeSerialize(stream.getBuffer(), content_repo, container);
+  REQUIRE(restored);
+  CHECK(restored->getResourceClaim()->getContentFullPath() == "/some/other/location/content");
+  CHECK(container.isNil());
+}
+
+TEST_CASE("FlowFileRecord reads records in the legacy serialization format", "[FlowFileRecord]") {
+  auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  const auto uuid = utils::IdGenerator::getIdGenerator()->generate();
+  const auto container_id = utils::IdGenerator::getIdGenerator()->generate();
+
+  io::BufferStream stream;
+  stream.write(uint64_t{1700000000123});  // event time
+  stream.write(uint64_t{1700000000456});  // entry date
+  stream.write(uint64_t{1700000000789});  // lineage start date
+  stream.write(uuid);
+  stream.write(container_id);
+  stream.write(uint32_t{2});  // number of attributes
+  stream.write(std::string{"filename"}, true);
+  stream.write(std::string{"legacy.txt"}, true);
+  stream.write(std::string{"custom"}, true);
+  stream.write(std::string{"value"}, true);
+  stream.write(std::string{"/legacy/content/path"});
+  stream.write(uint64_t{10});  // size
+  stream.write(uint64_t{5});  // offset
+
+  utils::Identifier container;
+  auto restored = FlowFileRecord::DeSerialize(stream.getBuffer(), content_repo, container);
+  REQUIRE(restored);
+  CHECK(restored->getUUID() == uuid);
+  CHECK(container == container_id);
+  CHECK(restored->getEventTime() == std::chrono::system_clock::time_point{} + std::chrono::milliseconds(1700000000123));
+  CHECK(restored->getEntryDate() == std::chrono::system_clock::time_point{} + std::chrono::milliseconds(1700000000456));
+  CHECK(restored->getlineageStartDate() == std::chrono::system_clock::time_point{} + std::chrono::milliseconds(1700000000789));
+  CHECK(restored->getAttribute("filename") == "legacy.txt");
+  CHECK(restored->getAttribute("custom") == "value");
+  CHECK(restored->getResourceClaim()->getContentFullPath() == "/legacy/content/path");
+  CHECK(restored->getSize() == 10);
+  CHECK(restored->getOffset() == 5);
+}
+
+TEST_CASE("FlowFileRecord rejects records in an unknown serialization format", "[FlowFileRecord]") {
+  io::BufferStream stream;
+  stream.write(uint8_t{0x7F});
+  stream.write(uint64_t{0});
+  utils::Identifier container;
+  CHECK_FALSE(FlowFileRecord::DeSerialize(stream.getBuffer(), std::make_shared<core::repository::VolatileContentRepository>(), container));
+}
+
+}  // namespace org::apache::nifi::minifi::test
@@ -0,0 +1,71 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "io/Lz4Stream.h"
+#include "utils/gsl.h"
+#include "utils/span.h"
+
+namespace io = org::apache::nifi::minifi::io;
+
+TEST_CASE("Lz4 compression and decompression pipeline", "[basic]") {
+  io::BufferStream output;
+  io::Lz4DecompressStream decompressStream(gsl::make_not_null(&output));
+  const auto level = GENERATE(0, 9);
+  io::Lz4CompressStream compressStream(gsl::make_not_null(&decompressStream), level);
+
+  std::string original;
+  SECTION("Empty") {
+  }
+  SECTION("Simple content in two writes") {
+    REQUIRE(3 == compressStream.write(reinterpret_cast<const uint8_t*>("foo"), 3));
+    REQUIRE(3 == compressStream.write(reinterpret_cast<const uint8_t*>("bar"), 3));
+    original += "foobar";
+  }
+  SECTION("Large data") {
+    std::mt19937 gen(std::random_device { }());
+    std::uniform_int_distribution<> dist(0, 3);
+    std::vector<uint8_t> buf(100 * 1024U);
+    for (size_t i = 0U; i < 20U; i++) {
+      std::generate(buf.begin(), buf.end(), [&](){return dist(gen);});
+      original += std::string(reinterpret_cast<const char*>(buf.data()), buf.size());
+      REQUIRE(buf.size() == compressStream.write(buf.data(), buf.size()));
+    }
+  }
+
+  REQUIRE_FALSE(decompressStream.isFinished());
+  compressStream.close();
+
+  REQUIRE(compressStream.isFinished());
+  REQUIRE(decompressStream.isFinished());
+  REQUIRE(original == utils::span_to<std::string>(utils::as_span<const char>(output.getBuffer())));
+}
+
+TEST_CASE("Lz4 decompression of invalid data fails", "[basic]") {
+  io::BufferStream output;
+  io::Lz4DecompressStream decompressStream(gsl::make_not_null(&output));
+
+  const std::string invalid_data = "not lz4 data";
+  REQUIRE(io::isError(decompressStream.write(reinterpret_cast<const uint8_t*>(invalid_data.data()), invalid_data.size())));
+  REQUIRE_FALSE(decompressStream.isFinished());
+}
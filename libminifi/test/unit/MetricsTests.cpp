@@ -16,6 +16,9 @@
  * limitations under the License.
  */
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "../../include/core/state/nodes/QueueMetrics.h"
 #include "../../include/core/state/nodes/RepositoryMetrics.h"
@@ -285,4 +288,61 @@ TEST_CASE("Test commit runtime processor metrics", "[ProcessorMetrics]") {
   REQUIRE(metrics.getAverageSessionCommitRuntime() == 37ms);
 }
 
+TEST_CASE("Test runtime percentile processor metrics", "[ProcessorMetrics]") {
+  DummyProcessor dummy_processor("dummy");
+  minifi::core::ProcessorMetrics metrics(dummy_processor);
+
+  REQUIRE(metrics.getOnTriggerRuntimePercentile(0.99) == 0us);
+  REQUIRE(metrics.getSessionCommitRuntimePercentile(0.99) == 0us);
+
+  for (auto i = 0; i < 990; ++i) {
+    metrics.addLastOnTriggerRuntime(10us);
+    metrics.addLastSessionCommitRuntime(20us);
+  }
+  for (auto i = 0; i < 10; ++i) {
+    metrics.addLastOnTriggerRuntime(5000us);
+    metrics.addLastSessionCommitRuntime(7000us);
+  }
+
+  CHECK(metrics.getOnTriggerRuntimePercentile(0.5) == 10us);
+  CHECK(metrics.getOnTriggerRuntimePercentile(0.99) == 10us);
+  CHECK(metrics.getOnTriggerRuntimePercentile(0.999) == 5000us);
+  CHECK(metrics.getSessionCommitRuntimePercentile(0.5) == 20us);
+  CHECK(metrics.getSessionCommitRuntimePercentile(0.999) == 7000us);
+  // the moving average only covers the last 10 calls
+  CHECK(metrics.getAverageOnTriggerRuntime() == 5ms);
+
+  const auto published_metrics = metrics.calculateMetrics();
+  const auto p999 = ranges::find_if(published_metrics, [](const auto& metric) { return metric.name == "onTrigger_runtime_p999_milliseconds"; });
+  REQUIRE(p999 != published_metrics.end());
+  CHECK(p999->value == Approx(5.0));
+}
+
+TEST_CASE("Test relationship transfer counts of processor metrics", "[ProcessorMetrics]") {
+  DummyProcessor dummy_processor("dummy");
+  minifi::core::ProcessorMetrics metrics(dummy_processor);
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 4; ++i) {
+    threads.emplace_back([&metrics] {
+      for (auto j = 0; j < 1000; ++j) {
+        metrics.increaseRelationshipTransferCount("success");
+        metrics.increaseRelationshipTransferCount("failure", 2);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto published_metrics = metrics.calculateMetrics();
+  const auto get_metric_value = [&](const std::string& name) {
+    const auto it = ranges::find_if(published_metrics, [&](const auto& metric) { return metric.name == name; });
+    REQUIRE(it != published_metrics.end());
+    return it->value;
+  };
+  CHECK(get_metric_value("transferred_to_success") == 4000);
+  CHECK(get_metric_value("transferred_to_failure") == 8000);
+}
+
 }  // namespace org::apache::nifi::minifi::test
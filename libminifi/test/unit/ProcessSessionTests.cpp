@@ -16,10 +16,15 @@
  */
 
 #include <array>
+#include <chrono>
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "core/ProcessSession.h"
+#include "FlowFileRecord.h"
 #include "core/Resource.h"
 #include "../TestBase.h"
 #include "../Catch.h"
@@ -29,14 +34,24 @@
 #include "IntegrationTestUtils.h"
 #include "../Utils.h"
 
+using namespace std::literals::chrono_literals;
+
 namespace {
 
+const minifi::core::Relationship Success{"success", "everything is fine"};
+const minifi::core::Relationship Failure{"failure", "something has gone awry"};
+
 class Fixture {
  public:
   explicit Fixture(TestController::PlanConfig config = {}): plan_config_(std::move(config)) {}
 
   minifi::core::ProcessSession &processSession() { return *process_session_; }
 
+  minifi::core::Processor &processor() { return *dummy_processor_; }
+
+  // an additional incoming connection of the processor, besides its self-loop
+  minifi::Connection* addIncomingConnection() { return test_plan_->addConnection(nullptr, Success, dummy_processor_); }
+
  private:
   TestController test_controller_;
   TestController::PlanConfig plan_config_;
@@ -46,9 +61,6 @@ class Fixture {
   std::unique_ptr<minifi::core::ProcessSession> process_session_ = std::make_unique<core::ProcessSession>(context_);
 };
 
-const minifi::core::Relationship Success{"success", "everything is fine"};
-const minifi::core::Relationship Failure{"failure", "something has gone awry"};
-
 }  // namespace
 
 TEST_CASE("ProcessSession::existsFlowFileInRelationship works", "[existsFlowFileInRelationship]") {
@@ -171,3 +183,168 @@ TEST_CASE("ProcessSession::commit avoids dangling ResourceClaims when using Vola
   REQUIRE(flow_file_2->getResourceClaim()->exists());
   REQUIRE(flow_file_3->getResourceClaim()->exists());
 }
+
+TEST_CASE("ProcessSession::create shares the attributes of the parent", "[create]") {
+  Fixture fixture;
+  minifi::core::ProcessSession &process_session = fixture.processSession();
+
+  const auto parent = process_session.create();
+  parent->setAttribute("attr", "value");
+  const auto child = process_session.create(parent);
+  CHECK(child->shareAttributes() == parent->shareAttributes());
+
+  child->setAttribute("attr", "new value");
+  CHECK(child->getAttribute("attr") == "new value");
+  CHECK(parent->getAttribute("attr") == "value");
+
+  parent->setAttribute(minifi::core::SpecialFlowAttribute::DISCARD_REASON, "reason");
+  const auto other_child = process_session.create(parent);
+  CHECK_FALSE(other_child->getAttribute(minifi::core::SpecialFlowAttribute::DISCARD_REASON));
+  CHECK(other_child->getAttribute("attr") == "value");
+  CHECK(parent->getAttribute(minifi::core::SpecialFlowAttribute::DISCARD_REASON) == "reason");
+}
+
+namespace {
+
+std::shared_ptr<core::FlowFile> putFlowFile(minifi::Connection& connection, uint64_t size) {
+  auto flow_file = std::make_shared<minifi::FlowFileRecord>();
+  flow_file->setSize(size);
+  connection.put(flow_file);
+  return flow_file;
+}
+
+uint64_t totalSize(const std::vector<std::shared_ptr<core::FlowFile>>& flow_files) {
+  uint64_t result = 0;
+  for (const auto& flow_file : flow_files) {
+    result += flow_file->getSize();
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("ProcessSession::get(max_count) returns at most max_count flow files", "[getBatch]") {
+  Fixture fixture;
+  auto& process_session = fixture.processSession();
+  auto* connection_1 = fixture.addIncomingConnection();
+  auto* connection_2 = fixture.addIncomingConnection();
+  for (size_t i = 0; i < 3; ++i) {
+    putFlowFile(*connection_1, 10);
+    putFlowFile(*connection_2, 10);
+  }
+
+  const auto flow_files = process_session.get(4);
+  CHECK(flow_files.size() == 4);
+  CHECK(connection_1->getQueueSize() + connection_2->getQueueSize() == 2);
+  CHECK(process_session.get(100).size() == 2);
+  CHECK(connection_1->isEmpty());
+  CHECK(connection_2->isEmpty());
+  CHECK(process_session.get(100).empty());
+}
+
+TEST_CASE("ProcessSession::get(max_count, max_bytes) stops after the flow file reaching max_bytes", "[getBatch]") {
+  Fixture fixture;
+  auto& process_session = fixture.processSession();
+  auto* connection_1 = fixture.addIncomingConnection();
+
+  SECTION("from a single connection") {
+    for (size_t i = 0; i < 5; ++i) {
+      putFlowFile(*connection_1, 10);
+    }
+    const auto flow_files = process_session.get(100, 25);
+    CHECK(flow_files.size() == 3);
+    CHECK(totalSize(flow_files) == 30);
+    CHECK(connection_1->getQueueSize() == 2);
+    CHECK(connection_1->getQueueDataSize() == 20);
+  }
+
+  SECTION("from several connections") {
+    auto* connection_2 = fixture.addIncomingConnection();
+    for (size_t i = 0; i < 2; ++i) {
+      putFlowFile(*connection_1, 10);
+      putFlowFile(*connection_2, 10);
+    }
+    // the first connection is drained within the limit, the second one is polled with the remaining 5 bytes
+    const auto flow_files = process_session.get(100, 25);
+    CHECK(flow_files.size() == 3);
+    CHECK(totalSize(flow_files) == 30);
+    CHECK(connection_1->getQueueSize() + connection_2->getQueueSize() == 1);
+  }
+
+  SECTION("a single flow file larger than max_bytes is returned") {
+    const auto large_flow_file = putFlowFile(*connection_1, 100);
+    putFlowFile(*connection_1, 10);
+    CHECK(process_session.get(100, 25) == std::vector<std::shared_ptr<core::FlowFile>>{large_flow_file});
+    CHECK(connection_1->getQueueSize() == 1);
+  }
+}
+
+TEST_CASE("ProcessSession::get(max_count) polls each incoming connection once in round-robin order", "[getBatch]") {
+  Fixture fixture;
+  auto& process_session = fixture.processSession();
+  // the first flow file goes to the self-loop connection of the processor
+  process_session.transfer(process_session.create(), Success);
+  process_session.commit();
+  auto* connection_1 = fixture.addIncomingConnection();
+  auto* connection_2 = fixture.addIncomingConnection();
+  putFlowFile(*connection_1, 10);
+  putFlowFile(*connection_2, 10);
+
+  const auto flow_files = process_session.get(100);
+  REQUIRE(flow_files.size() == 3);
+  std::set<core::Connectable*> connections;
+  for (const auto& flow_file : flow_files) {
+    connections.insert(flow_file->getConnection());
+  }
+  CHECK(connections.size() == 3);
+  CHECK(connections.contains(connection_1));
+  CHECK(connections.contains(connection_2));
+
+  // the loop stopped when it picked the connection it started from again, so the round-robin continues with the second one
+  CHECK(fixture.processor().pickIncomingConnection() == flow_files[1]->getConnection());
+}
+
+TEST_CASE("ProcessSession::get(max_count) expires the expired flow files of all connections together", "[getBatch]") {
+  Fixture fixture;
+  auto& process_session = fixture.processSession();
+  std::set<utils::Identifier> expired_ids;
+  for (auto* connection : {fixture.addIncomingConnection(), fixture.addIncomingConnection()}) {
+    connection->setFlowExpirationDuration(1ms);
+    for (size_t i = 0; i < 2; ++i) {
+      expired_ids.insert(putFlowFile(*connection, 10)->getUUID());
+    }
+  }
+  std::this_thread::sleep_for(10ms);
+
+  CHECK(process_session.get(100).empty());
+  std::set<utils::Identifier> expire_event_ids;
+  for (const auto& event : process_session.getProvenanceReporter()->getEvents()) {
+    CHECK(event->getEventType() == minifi::provenance::ProvenanceEventRecord::ProvenanceEventType::EXPIRE);
+    expire_event_ids.insert(event->getFlowFileUuid());
+  }
+  CHECK(expire_event_ids == expired_ids);
+}
+
+TEST_CASE("ProcessSession::rollback puts back the flow files returned by get(max_count)", "[getBatch]") {
+  Fixture fixture;
+  auto& process_session = fixture.processSession();
+  auto* connection = fixture.addIncomingConnection();
+  for (size_t i = 0; i < 3; ++i) {
+    putFlowFile(*connection, 10)->setAttribute("attr", "original");
+  }
+
+  const auto flow_files = process_session.get(100);
+  REQUIRE(flow_files.size() == 3);
+  CHECK(connection->isEmpty());
+  for (const auto& flow_file : flow_files) {
+    flow_file->setAttribute("attr", "modified");
+  }
+
+  process_session.rollback();
+  CHECK(connection->getQueueSize() == 3);
+  for (const auto& flow_file : flow_files) {
+    CHECK(flow_file->getAttribute("attr") == "original");
+    CHECK(flow_file->isPenalized());
+    CHECK(flow_file->getConnection() == connection);
+  }
+}
@@ -59,7 +59,7 @@ class TestRepositoryBase : public T_BaseRepository {
 
   bool Put(const std::string& key, const uint8_t *buf, size_t bufLen) override {
     std::lock_guard<std::mutex> lock{repository_results_mutex_};
-    repository_results_.emplace(key, std::string{reinterpret_cast<const char*>(buf), bufLen});
+    repository_results_.insert_or_assign(key, std::string{reinterpret_cast<const char*>(buf), bufLen});
     return true;
   }
 
@@ -197,7 +197,7 @@ class TestFlowRepository : public org::apache::nifi::minifi::core::ThreadedRepos
 
   bool Put(const std::string& key, const uint8_t *buf, size_t bufLen) override {
     std::lock_guard<std::mutex> lock{repository_results_mutex_};
-    repository_results_.emplace(key, std::string{reinterpret_cast<const char*>(buf), bufLen});
+    repository_results_.insert_or_assign(key, std::string{reinterpret_cast<const char*>(buf), bufLen});
     return true;
   }
 
@@ -0,0 +1,97 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "utils/RegexSet.h"
+#include "../TestBase.h"
+#include "../Catch.h"
+
+namespace minifi = org::apache::nifi::minifi;
+using minifi::utils::Regex;
+using minifi::utils::RegexSet;
+
+namespace {
+std::vector<bool> expectedMatches(const std::vector<std::string>& patterns, const std::string& input, RegexSet::MatchMode mode, bool ignore_case) {
+  std::vector<Regex::Mode> flags;
+  if (ignore_case) {
+    flags.push_back(Regex::Mode::ICASE);
+  }
+  std::vector<bool> result;
+  for (const auto& pattern : patterns) {
+    const Regex regex(pattern, flags);
+    result.push_back(mode == RegexSet::MatchMode::FULL ? minifi::utils::regexMatch(input, regex) : minifi::utils::regexSearch(input, regex));
+  }
+  return result;
+}
+}  // namespace
+
+TEST_CASE("RegexSet gives the same results as utils::Regex", "[regexset]") {
+  const std::vector<std::string> patterns{
+    "ERROR", "^ERROR", "ERROR$", "^ERROR$", "error|warn", "^(error|warn)[: ]", "[0-9]+ms$", "[^a-z ]{3}", "\\w+@\\w+\\.com",
+    "a(b|cd)*e", "x?y+z{2,3}", "(ab){2}", "\\s\\S", "[[:alpha:]][[:digit:]]", "[a-]", "\\.\\*", "t.st", "^$", "^[-+]?[0-9]*\\.?[0-9]+$",
+    "(a)\\1"
+  };
+  const std::vector<std::string> inputs{
+    "", "ERROR", "error: disk full", "an ERROR occurred", "WARN slow request 250ms", "abcde", "acdcde", "xyyzz", "xyzzzz", "abab",
+    "mail user@example.com now", "TEST", "t\nst", "a-", ".*", "-12.5", "aa", "tab\there", "ABC 123"
+  };
+
+  for (auto mode : {RegexSet::MatchMode::FULL, RegexSet::MatchMode::PARTIAL}) {
+    for (bool ignore_case : {false, true}) {
+      RegexSet regex_set(patterns, mode, ignore_case);
+      REQUIRE(regex_set.size() == patterns.size());
+      for (const auto& input : inputs) {
+        INFO("input: '" << input << "', full match: " << (mode == RegexSet::MatchMode::FULL) << ", ignore case: " << ignore_case);
+        CHECK(regex_set.match(input) == expectedMatches(patterns, input, mode, ignore_case));
+      }
+    }
+  }
+}
+
+TEST_CASE("RegexSet uses utils::Regex for the patterns the automaton does not support", "[regexset]") {
+  RegexSet regex_set({"^(debug|info) ", "(a)\\1", "ab^c", "[0-9]{2,4}"}, RegexSet::MatchMode::PARTIAL);
+  CHECK(regex_set.isAutomatonBacked(0));
+  CHECK_FALSE(regex_set.isAutomatonBacked(1));
+  CHECK_FALSE(regex_set.isAutomatonBacked(2));
+  CHECK(regex_set.isAutomatonBacked(3));
+
+  CHECK(regex_set.match("info 42 aa") == std::vector<bool>{true, true, false, true});
+  CHECK(regex_set.match("warn 7 ab") == std::vector<bool>{false, false, false, false});
+}
+
+TEST_CASE("RegexSet rejects invalid patterns like utils::Regex", "[regexset]") {
+  REQUIRE_THROWS_WITH(RegexSet({"valid", "[Invalid)A(F)"}, RegexSet::MatchMode::PARTIAL), Catch::Contains("Regex Operation"));
+}
+
+TEST_CASE("RegexSet keeps working when the DFA outgrows its cache", "[regexset]") {
+  // the DFA of the first pattern has to remember the last 12 characters
+  const std::vector<std::string> patterns{"a[ab]{11}$", "b[ab]{10}a"};
+  RegexSet regex_set(patterns, RegexSet::MatchMode::PARTIAL);
+  uint32_t seed = 12345;
+  for (size_t iteration = 0; iteration < 500; ++iteration) {
+    std::string input;
+    for (size_t position = 0; position < 40; ++position) {
+      seed = seed * 1103515245 + 12345;
+      input += (seed >> 16) % 2 == 0 ? 'a' : 'b';
+    }
+    INFO("input: '" << input << "'");
+    REQUIRE(regex_set.match(input) == expectedMatches(patterns, input, RegexSet::MatchMode::PARTIAL, false));
+  }
+}
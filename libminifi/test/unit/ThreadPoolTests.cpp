@@ -19,9 +19,14 @@
 #include <utility>
 #include <future>
 #include <memory>
+#include <string>
+#include <vector>
 #include "../TestBase.h"
 #include "../Catch.h"
 #include "utils/ThreadPool.h"
+#include "utils/IntegrationTestUtils.h"
+#include "controllers/ThreadManagementService.h"
+#include "core/controller/ControllerServiceProvider.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -98,3 +103,124 @@ TEST_CASE("Worker wait time should be relative to the last run") {
   REQUIRE(worker_execution_time_points.size() == 2);
   CHECK(worker_execution_time_points[1] - worker_execution_time_points[0] >= wait_time_between_tasks);
 }
+
+TEST_CASE("Work-stealing ThreadPool runs every scheduled task", "[TPT3]") {
+  utils::ThreadPool<int> pool(4);
+  pool.setWorkStealing(true);
+  REQUIRE(pool.isWorkStealing());
+  pool.start();
+
+  std::vector<std::atomic<int>> counters(10);
+  std::vector<std::future<int>> futures(counters.size());
+  for (size_t i = 0; i < counters.size(); ++i) {
+    utils::Worker<int> functor([&counter = counters[i]]() { return ++counter; }, "id" + std::to_string(i), std::make_unique<WorkerNumberExecutions>(5));
+    pool.execute(std::move(functor), futures[i]);
+  }
+  for (auto& future : futures) {
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    CHECK(future.get() == 5);
+  }
+}
+
+TEST_CASE("Stopping tasks waits for their running instances in work-stealing mode", "[TPT4]") {
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(4);
+  pool.setWorkStealing(true);
+  pool.start();
+
+  std::atomic<int> running = 0;
+  std::atomic<int> runs = 0;
+  std::vector<std::future<utils::TaskRescheduleInfo>> futures(3);
+  for (auto& future : futures) {
+    utils::Worker<utils::TaskRescheduleInfo> worker([&]() {
+      ++running;
+      ++runs;
+      std::this_thread::sleep_for(1ms);
+      --running;
+      return utils::TaskRescheduleInfo::RetryImmediately();
+    }, "id", std::make_unique<utils::ComplexMonitor>());
+    pool.execute(std::move(worker), future);
+  }
+  REQUIRE(utils::verifyEventHappenedInPollTime(1s, [&] { return runs > 10; }));
+  REQUIRE(pool.isTaskRunning("id"));
+
+  pool.stopTasks("id");
+  CHECK(running == 0);
+  CHECK_FALSE(pool.isTaskRunning("id"));
+  const int runs_after_stop = runs;
+  std::this_thread::sleep_for(20ms);
+  CHECK(runs == runs_after_stop);
+}
+
+namespace {
+
+class ReducingThreadManager : public minifi::controllers::ThreadManagementService {
+ public:
+  explicit ReducingThreadManager(int reductions)
+      : ThreadManagementService("ThreadPoolManager"),
+        reductions_(reductions) {
+  }
+
+  static constexpr bool SupportsDynamicProperties = false;
+  ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
+
+  bool isAboveMax(const int /*new_tasks*/) override { return false; }
+  uint16_t getMaxThreads() override { return 2; }
+  bool shouldReduce() override { return reductions_ > 0; }
+  void reduce() override { --reductions_; }
+  bool canIncrease() override { return false; }
+
+  bool isReduced() const { return reductions_ <= 0; }
+
+ private:
+  std::atomic<int> reductions_;
+};
+
+class ThreadManagerProvider : public core::controller::ControllerServiceProvider {
+ public:
+  explicit ThreadManagerProvider(std::shared_ptr<core::controller::ControllerService> thread_manager)
+      : ControllerServiceProvider("ThreadManagerProvider"),
+        thread_manager_(std::move(thread_manager)) {
+  }
+
+  std::shared_ptr<core::controller::ControllerServiceNode> createControllerService(const std::string&, const std::string&, const std::string&, bool) override {
+    return nullptr;
+  }
+  std::shared_ptr<core::controller::ControllerService> getControllerService(const std::string& /*identifier*/) const override {
+    return thread_manager_;
+  }
+  void clearControllerServices() override {}
+  void enableAllControllerServices() override {}
+  void disableAllControllerServices() override {}
+  bool canEdit() override { return false; }
+
+ private:
+  std::shared_ptr<core::controller::ControllerService> thread_manager_;
+};
+
+}  // namespace
+
+TEST_CASE("Work-stealing ThreadPool keeps running the rescheduled task of a retired worker", "[TPT5]") {
+  const auto thread_manager = std::make_shared<ReducingThreadManager>(1);
+  ThreadManagerProvider controller_service_provider{thread_manager};
+  utils::ThreadPool<utils::TaskRescheduleInfo> pool(2);
+  pool.setWorkStealing(true);
+  pool.setControllerServiceProvider(&controller_service_provider);
+  pool.start();
+
+  std::atomic<int> runs = 0;
+  std::future<utils::TaskRescheduleInfo> future;
+  utils::Worker<utils::TaskRescheduleInfo> worker([&]() {
+    ++runs;
+    std::this_thread::sleep_for(1ms);
+    return utils::TaskRescheduleInfo::RetryImmediately();
+  }, "id", std::make_unique<utils::ComplexMonitor>());
+  pool.execute(std::move(worker), future);
+
+  // the only task is rescheduled to the queue of the busy worker, which is the one to retire, while the other one is idle
+  REQUIRE(utils::verifyEventHappenedInPollTime(5s, [&] { return thread_manager->isReduced(); }));
+  std::this_thread::sleep_for(50ms);
+  const int runs_after_reduction = runs;
+  CHECK(utils::verifyEventHappenedInPollTime(1s, [&] { return runs > runs_after_reduction + 10; }));
+
+  pool.stopTasks("id");
+}
@@ -0,0 +1,102 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../TestBase.h"
+#include "../Catch.h"
+#include "utils/TimerWheel.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+using namespace std::literals::chrono_literals;
+
+namespace {
+using Wheel = utils::TimerWheel<std::string, int>;
+const auto origin = std::chrono::steady_clock::time_point{} + 1h;
+
+std::vector<int> advance(Wheel& wheel, std::chrono::steady_clock::time_point now) {
+  std::vector<int> expired;
+  wheel.advance(now, [&](int value) { expired.push_back(value); });
+  return expired;
+}
+}  // namespace
+
+TEST_CASE("TimerWheel expires timers in the order of their deadline", "[TimerWheel]") {
+  Wheel wheel(1ms, origin);
+  wheel.schedule(origin + 30ms, "a", 3);
+  wheel.schedule(origin + 10ms, "b", 1);
+  wheel.schedule(origin + 20ms, "c", 2);
+  REQUIRE(wheel.size() == 3);
+
+  CHECK(advance(wheel, origin + 9ms).empty());
+  CHECK(advance(wheel, origin + 10ms) == std::vector<int>{1});
+  CHECK(advance(wheel, origin + 50ms) == std::vector<int>{2, 3});
+  CHECK(wheel.empty());
+  CHECK_FALSE(wheel.nextWakeUp());
+}
+
+TEST_CASE("TimerWheel moves far away timers down the levels", "[TimerWheel]") {
+  Wheel wheel(1ms, origin);
+  wheel.schedule(origin + 100ms, "a", 1);
+  wheel.schedule(origin + 5s, "b", 2);
+  wheel.schedule(origin + 10min, "c", 3);
+
+  std::vector<int> expired;
+  auto now = origin;
+  // always sleeping until the suggested wake up time should not miss any deadline
+  while (auto wake_up = wheel.nextWakeUp()) {
+    REQUIRE(*wake_up >= now);
+    now = *wake_up;
+    for (auto value : advance(wheel, now)) {
+      expired.push_back(value);
+      if (value == 1) { CHECK(now == origin + 100ms); }
+      if (value == 2) { CHECK(now == origin + 5s); }
+      if (value == 3) { CHECK(now == origin + 10min); }
+    }
+  }
+  CHECK(expired == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("TimerWheel never expires a timer before its deadline", "[TimerWheel]") {
+  Wheel wheel(10ms, origin);
+  wheel.schedule(origin + 15ms, "a", 1);
+  CHECK(advance(wheel, origin + 19ms).empty());
+  CHECK(advance(wheel, origin + 20ms) == std::vector<int>{1});
+
+  // deadlines in the past are expired on the next advance
+  wheel.schedule(origin, "b", 2);
+  CHECK(advance(wheel, origin + 20ms) == std::vector<int>{2});
+}
+
+TEST_CASE("TimerWheel cancels every timer of a key", "[TimerWheel]") {
+  Wheel wheel(1ms, origin);
+  wheel.schedule(origin + 10ms, "a", 1);
+  wheel.schedule(origin + 1s, "a", 2);
+  wheel.schedule(origin + 20ms, "b", 3);
+
+  CHECK(wheel.cancel("a") == 2);
+  CHECK(wheel.cancel("a") == 0);
+  CHECK(wheel.size() == 1);
+  CHECK(advance(wheel, origin + 2s) == std::vector<int>{3});
+
+  wheel.schedule(origin + 3s, "a", 4);
+  CHECK(advance(wheel, origin + 3s) == std::vector<int>{4});
+  CHECK(wheel.empty());
+}